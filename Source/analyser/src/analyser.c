@@ -0,0 +1,1408 @@
+/*----------------------------------------------------------------------------------------------------------------------------
+ * SOURCE FILE:    analyser.c
+ *
+ * PROGRAM:        analyser
+ *
+ * FUNCTIONS:      int mapCapture(const char* fileName, struct capture* cap)
+ *                 int parseCaptureHeader(struct capture* cap)
+ *                 size_t nextRecord(struct capture* cap, size_t offset, struct record* rec)
+ *                 void findTimeBounds(struct capture* cap)
+ *                 size_t findRecordBoundary(struct capture* cap, size_t offset)
+ *                 int plausibleRecord(struct capture* cap, struct record* rec, uint64_t previousNs)
+ *                 int locateUDP(struct record* rec, uint32_t* l3, uint32_t* l4)
+ *                 void* decodeChunk(void* arg)
+ *                 int decodeRecord(struct capture* cap, struct record* rec, struct event* ev)
+ *                 void analyseEvents(struct eventList* events, struct flowTable* flows)
+ *                 struct flow* findFlow(struct flowTable* flows, uint32_t srcIP, uint16_t srcPort, uint32_t dstIP, uint16_t dstPort, int create)
+ *                 void summariseFlow(struct flow* fl)
+ *                 void printSummary(struct flowTable* flows)
+ *                 int writeSeriesCSV(struct flowTable* flows, const char* prefix)
+ *                 int writeSeriesJSON(struct flowTable* flows, const char* prefix)
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Chunk boundaries are only trusted where a run of records is plausible
+ *                                      as captured traffic, not merely well formed
+ *                 October 18th, 2026 - Decodes struct packet datagrams that hold only the data in use
+ *                 October 18th, 2026 - Goodput counts the file bytes a compressed DATA packet stands for
+ *                 October 18th, 2026 - SYN, SYN_ACK and EOT_ACK are decoded and counted as control packets
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * NOTES:
+ * Offline analyser for pcap and pcapng captures of the transmitter/emulator/receiver protocol.
+ * The capture is memory mapped and split into chunks that are decoded in parallel; chunk boundaries are found by
+ * resynchronising on a run of record headers that each frame an IPv4/UDP datagram, no longer than the snap
+ * length, stamped no earlier than the record before it and within the capture's first and last records. Zero
+ * padding inside a payload parses as well-formed pcap headers, so well formed alone is not enough. Decoded packets are then replayed in capture order to compute
+ * per-flow goodput, retransmit rate, RTT distribution, window evolution and loss-burst statistics.
+ *
+ * Usage: analyser [-j threads] [-o outputPrefix] [-f csv|json] capture...
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+
+#include "analyser.h"
+#include "../../packet.h"
+
+/*------------------------------------------------- Sequence State Flags ---------------------------------------------------------*/
+#define SEQ_SEEN            0x01
+#define SEQ_RETRANSMITTED   0x02
+#define SEQ_RTT_SAMPLED     0x04
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       read32
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static uint32_t read32(struct capture* cap, const unsigned char* p)
+ *
+ * RETURNS:        uint32_t
+ *
+ * NOTES:
+ * Reads an unaligned 32-bit capture header field in the byte order of the capture file
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static uint32_t read32(struct capture* cap, const unsigned char* p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return cap->swapped ? __builtin_bswap32(v) : v;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       read16
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static uint16_t read16(struct capture* cap, const unsigned char* p)
+ *
+ * RETURNS:        uint16_t
+ *
+ * NOTES:
+ * Reads an unaligned 16-bit capture header field in the byte order of the capture file
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static uint16_t read16(struct capture* cap, const unsigned char* p)
+{
+    uint16_t v;
+    memcpy(&v, p, 2);
+    return cap->swapped ? __builtin_bswap16(v) : v;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       appendSample
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static void appendSample(struct sampleList* list, uint64_t timestampNs, int32_t value, int32_t seqNum)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Appends a point to a growable series
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static void appendSample(struct sampleList* list, uint64_t timestampNs, int32_t value, int32_t seqNum)
+{
+    if (list->count == list->capacity)
+    {
+        list->capacity = list->capacity ? list->capacity * 2 : 256;
+        list->samples = realloc(list->samples, list->capacity * sizeof(struct sample));
+        if (list->samples == NULL)
+        {
+            perror("could not allocate series");
+            exit(1);
+        }
+    }
+    list->samples[list->count].timestampNs = timestampNs;
+    list->samples[list->count].value = value;
+    list->samples[list->count].seqNum = seqNum;
+    list->count++;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       compareInt32
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static int compareInt32(const void* a, const void* b)
+ *
+ * RETURNS:        int
+ *
+ * NOTES:
+ * qsort comparator for RTT values
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static int compareInt32(const void* a, const void* b)
+{
+    int32_t x = *(const int32_t*)a, y = *(const int32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       formatFlow
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static const char* formatFlow(struct flow* fl, char* buffer, size_t len)
+ *
+ * RETURNS:        const char*
+ *
+ * NOTES:
+ * Formats a flow as srcIP:srcPort->dstIP:dstPort
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static const char* formatFlow(struct flow* fl, char* buffer, size_t len)
+{
+    snprintf(buffer, len, "%u.%u.%u.%u:%u->%u.%u.%u.%u:%u",
+        fl->srcIP >> 24, (fl->srcIP >> 16) & 0xFF, (fl->srcIP >> 8) & 0xFF, fl->srcIP & 0xFF, fl->srcPort,
+        fl->dstIP >> 24, (fl->dstIP >> 16) & 0xFF, (fl->dstIP >> 8) & 0xFF, fl->dstIP & 0xFF, fl->dstPort);
+    return buffer;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       main
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Finds the capture's time bounds before splitting it
+ *                 October 18th, 2026 - Reports packets that failed their checksum
+ *                 October 18th, 2026 - Reports how many of the protocol packets are control packets
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int main (int argc, char **argv)
+ *
+ * RETURNS:        int
+ *
+ * NOTES:
+ * main entrypoint into analyser application
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int main(int argc, char **argv)
+{
+    const char* prefix = DEFAULT_OUTPUT_PREFIX;
+    enum SeriesFormat seriesFormat = SERIES_CSV;
+    int threadCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int opt, status = 0;
+
+    while ((opt = getopt(argc, argv, "j:o:f:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'j':
+                threadCount = atoi(optarg);
+                break;
+            case 'o':
+                prefix = optarg;
+                break;
+            case 'f':
+                if (strcmp(optarg, "json") == 0)
+                    seriesFormat = SERIES_JSON;
+                else if (strcmp(optarg, "csv") == 0)
+                    seriesFormat = SERIES_CSV;
+                else
+                {
+                    fprintf(stderr, "unknown series format: %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-j threads] [-o outputPrefix] [-f csv|json] capture...\n", argv[0]);
+                exit(1);
+        }
+    }
+    if (optind >= argc)
+    {
+        fprintf(stderr, "Usage: %s [-j threads] [-o outputPrefix] [-f csv|json] capture...\n", argv[0]);
+        exit(1);
+    }
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > MAX_THREADS) threadCount = MAX_THREADS;
+
+    for (int file = optind; file < argc; file++)
+    {
+        struct capture cap;
+        struct chunk chunks[MAX_THREADS];
+        pthread_t threads[MAX_THREADS];
+        struct eventList events = { NULL, 0, 0 };
+        struct flowTable* flows;
+        uint64_t records = 0, skipped = 0, corrupt = 0, control = 0;
+        char filePrefix[4096];
+
+        if (mapCapture(argv[file], &cap) == -1 || parseCaptureHeader(&cap) == -1)
+        {
+            status = 1;
+            continue;
+        }
+        findTimeBounds(&cap);
+
+        // Split the capture into chunks that start on record boundaries
+        int chunkCount = threadCount;
+        size_t body = cap.size - cap.firstRecord;
+        if (body / MIN_CHUNK_SIZE < (size_t)chunkCount) chunkCount = (int)(body / MIN_CHUNK_SIZE);
+        if (chunkCount < 1) chunkCount = 1;
+
+        for (int i = 0; i < chunkCount; i++)
+        {
+            memset(&chunks[i], 0, sizeof(struct chunk));
+            chunks[i].cap = &cap;
+            chunks[i].start = (i == 0) ? cap.firstRecord : findRecordBoundary(&cap, cap.firstRecord + body / chunkCount * i);
+        }
+        for (int i = 0; i < chunkCount; i++)
+        {
+            chunks[i].end = (i == chunkCount - 1) ? cap.size : chunks[i + 1].start;
+            if (pthread_create(&threads[i], NULL, decodeChunk, &chunks[i]) != 0)
+            {
+                perror("could not start decoder thread");
+                exit(1);
+            }
+        }
+
+        for (int i = 0; i < chunkCount; i++)
+        {
+            pthread_join(threads[i], NULL);
+        }
+
+        // A chunk that overran its end means a boundary was guessed wrong, decode the whole file on one thread instead
+        for (int i = 0; i < chunkCount - 1; i++)
+        {
+            if (chunks[i].stop != chunks[i].end)
+            {
+                fprintf(stderr, "%s: chunk boundary at offset %zu did not resynchronise, decoding sequentially\n", argv[file], chunks[i].end);
+                for (int j = 0; j < chunkCount; j++)
+                {
+                    free(chunks[j].events.events);
+                }
+                chunkCount = 1;
+                memset(&chunks[0], 0, sizeof(struct chunk));
+                chunks[0].cap = &cap;
+                chunks[0].start = cap.firstRecord;
+                chunks[0].end = cap.size;
+                decodeChunk(&chunks[0]);
+                break;
+            }
+        }
+
+        // Merge in file order so events stay in capture order
+        for (int i = 0; i < chunkCount; i++)
+        {
+            records += chunks[i].records;
+            skipped += chunks[i].skipped;
+            corrupt += chunks[i].corrupt;
+            control += chunks[i].control;
+            if (events.capacity < events.count + chunks[i].events.count)
+            {
+                events.capacity = events.count + chunks[i].events.count;
+                events.events = realloc(events.events, events.capacity * sizeof(struct event));
+                if (events.events == NULL)
+                {
+                    perror("could not allocate events");
+                    exit(1);
+                }
+            }
+            if (chunks[i].events.count > 0)
+            {
+                memcpy(events.events + events.count, chunks[i].events.events, chunks[i].events.count * sizeof(struct event));
+                events.count += chunks[i].events.count;
+            }
+            free(chunks[i].events.events);
+        }
+
+        flows = calloc(1, sizeof(struct flowTable));
+        if (flows == NULL)
+        {
+            perror("could not allocate flow table");
+            exit(1);
+        }
+        analyseEvents(&events, flows);
+
+        printf("%s: %llu records, %llu protocol packets (%llu control), %llu skipped, %llu corrupt, %d chunk(s)\n", argv[file],
+            (unsigned long long)records, (unsigned long long)events.count, (unsigned long long)control,
+            (unsigned long long)skipped, (unsigned long long)corrupt, chunkCount);
+        printSummary(flows);
+
+        // Name series after the capture when more than one is analysed
+        if (argc - optind > 1)
+        {
+            const char* base = strrchr(argv[file], '/');
+            base = (base != NULL) ? base + 1 : argv[file];
+            snprintf(filePrefix, sizeof(filePrefix), "%s-%.*s", prefix, (int)strcspn(base, "."), base);
+        }
+        else
+        {
+            snprintf(filePrefix, sizeof(filePrefix), "%s", prefix);
+        }
+        if ((seriesFormat == SERIES_CSV ? writeSeriesCSV(flows, filePrefix) : writeSeriesJSON(flows, filePrefix)) == -1)
+        {
+            status = 1;
+        }
+
+        for (int i = 0; i < flows->count; i++)
+        {
+            struct flow* fl = flows->ordered[i];
+            free(fl->sendNs);
+            free(fl->seqState);
+            free(fl->rtt.samples);
+            free(fl->window.samples);
+            free(fl);
+        }
+        free(flows);
+        free(events.events);
+        munmap((void*)cap.data, cap.size);
+    }
+    return status;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       mapCapture
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int mapCapture(const char* fileName, struct capture* cap)
+ *
+ * RETURNS:        int, -1 on failure
+ *
+ * NOTES:
+ * Maps a capture file read-only into memory
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int mapCapture(const char* fileName, struct capture* cap)
+{
+    struct stat st;
+    int fd;
+
+    memset(cap, 0, sizeof(struct capture));
+    if ((fd = open(fileName, O_RDONLY)) == -1)
+    {
+        fprintf(stderr, "could not open %s: %s\n", fileName, strerror(errno));
+        return -1;
+    }
+    if (fstat(fd, &st) == -1 || st.st_size < PCAP_FILE_HEADER_LEN)
+    {
+        fprintf(stderr, "%s is not a capture file\n", fileName);
+        close(fd);
+        return -1;
+    }
+
+    cap->size = (size_t)st.st_size;
+    cap->data = mmap(NULL, cap->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (cap->data == MAP_FAILED)
+    {
+        fprintf(stderr, "could not map %s: %s\n", fileName, strerror(errno));
+        return -1;
+    }
+    madvise((void*)cap->data, cap->size, MADV_SEQUENTIAL);
+    return 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       parseCaptureHeader
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Keeps the snap length of each pcapng interface
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int parseCaptureHeader(struct capture* cap)
+ *
+ * RETURNS:        int, -1 if the file is neither pcap nor pcapng
+ *
+ * NOTES:
+ * Detects the capture format and byte order; for pcapng also reads the interface descriptions
+ * that precede the first packet block
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int parseCaptureHeader(struct capture* cap)
+{
+    uint32_t magic;
+    memcpy(&magic, cap->data, 4);
+
+    if (magic == PCAP_MAGIC_USEC || magic == PCAP_MAGIC_NSEC
+        || magic == __builtin_bswap32(PCAP_MAGIC_USEC) || magic == __builtin_bswap32(PCAP_MAGIC_NSEC))
+    {
+        cap->format = PCAP;
+        cap->swapped = (magic == __builtin_bswap32(PCAP_MAGIC_USEC) || magic == __builtin_bswap32(PCAP_MAGIC_NSEC));
+        cap->nanosecond = (read32(cap, cap->data) == PCAP_MAGIC_NSEC);
+        cap->snaplen = read32(cap, cap->data + 16);
+        cap->linkType = (int)(read32(cap, cap->data + 20) & 0x0FFFFFFF);
+        cap->firstRecord = PCAP_FILE_HEADER_LEN;
+        return 0;
+    }
+
+    if (magic != PCAPNG_SHB)
+    {
+        fprintf(stderr, "unknown capture format\n");
+        return -1;
+    }
+
+    uint32_t byteOrder;
+    memcpy(&byteOrder, cap->data + 8, 4);
+    cap->format = PCAPNG;
+    cap->swapped = (byteOrder != PCAPNG_BYTE_ORDER_MAGIC);
+
+    size_t offset = 0;
+    while (offset + 12 <= cap->size)
+    {
+        uint32_t type = read32(cap, cap->data + offset);
+        uint32_t len = read32(cap, cap->data + offset + 4);
+        if (len < 12 || len % 4 != 0 || offset + len > cap->size)
+        {
+            fprintf(stderr, "malformed pcapng block at offset %zu\n", offset);
+            return -1;
+        }
+        if (type == PCAPNG_EPB || type == PCAPNG_SPB)
+        {
+            break;
+        }
+        if (type == PCAPNG_IDB && cap->interfaceCount < MAX_INTERFACES)
+        {
+            int index = cap->interfaceCount++;
+            cap->interfaceLinkType[index] = read16(cap, cap->data + offset + 8);
+            cap->interfaceSnaplen[index] = read32(cap, cap->data + offset + 12);
+            cap->interfaceTicksPerSecond[index] = 1000000;
+
+            // Walk the options looking for if_tsresol
+            size_t opt = offset + 16;
+            while (opt + 4 <= offset + len - 4)
+            {
+                uint16_t code = read16(cap, cap->data + opt);
+                uint16_t optLen = read16(cap, cap->data + opt + 2);
+                if (code == 0) break;
+                if (code == 9 && optLen >= 1)
+                {
+                    uint8_t resolution = cap->data[opt + 4];
+                    uint64_t ticks = 1;
+                    for (int i = 0; i < (resolution & 0x7F); i++) ticks *= (resolution & 0x80) ? 2 : 10;
+                    cap->interfaceTicksPerSecond[index] = ticks;
+                }
+                opt += 4 + ((optLen + 3) & ~3u);
+            }
+        }
+        offset += len;
+    }
+    cap->firstRecord = offset;
+    return 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       nextRecord
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - An enhanced packet block may not capture more than its interface's snap length
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      size_t nextRecord(struct capture* cap, size_t offset, struct record* rec)
+ *
+ * RETURNS:        size_t, offset of the following record or 0 if the record at offset is not valid
+ *
+ * NOTES:
+ * Validates the record at offset and describes its frame; pcapng blocks that carry no packet
+ * are valid records with a NULL frame
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+size_t nextRecord(struct capture* cap, size_t offset, struct record* rec)
+{
+    rec->frame = NULL;
+
+    if (cap->format == PCAP)
+    {
+        if (offset + PCAP_RECORD_HEADER_LEN > cap->size) return 0;
+        const unsigned char* header = cap->data + offset;
+        uint32_t seconds = read32(cap, header);
+        uint32_t fraction = read32(cap, header + 4);
+        uint32_t capLen = read32(cap, header + 8);
+        uint32_t origLen = read32(cap, header + 12);
+
+        if (capLen > MAX_FRAME_LEN || capLen > origLen || (cap->snaplen != 0 && capLen > cap->snaplen)
+            || fraction >= (cap->nanosecond ? 1000000000u : 1000000u)
+            || offset + PCAP_RECORD_HEADER_LEN + capLen > cap->size)
+        {
+            return 0;
+        }
+
+        rec->frame = header + PCAP_RECORD_HEADER_LEN;
+        rec->capLen = capLen;
+        rec->linkType = cap->linkType;
+        rec->timestampNs = (uint64_t)seconds * 1000000000ull + (cap->nanosecond ? fraction : (uint64_t)fraction * 1000);
+        return offset + PCAP_RECORD_HEADER_LEN + capLen;
+    }
+
+    if (offset + 12 > cap->size) return 0;
+    uint32_t type = read32(cap, cap->data + offset);
+    uint32_t len = read32(cap, cap->data + offset + 4);
+    if (len < 12 || len % 4 != 0 || offset + len > cap->size || read32(cap, cap->data + offset + len - 4) != len)
+    {
+        return 0;
+    }
+
+    if (type == PCAPNG_EPB && len >= 32)
+    {
+        uint32_t interfaceId = read32(cap, cap->data + offset + 8);
+        uint64_t ticks = ((uint64_t)read32(cap, cap->data + offset + 12) << 32) | read32(cap, cap->data + offset + 16);
+        uint32_t capLen = read32(cap, cap->data + offset + 20);
+        if (interfaceId >= (uint32_t)cap->interfaceCount || capLen > len - 32
+            || (cap->interfaceSnaplen[interfaceId] != 0 && capLen > cap->interfaceSnaplen[interfaceId]))
+        {
+            return 0;
+        }
+        uint64_t tps = cap->interfaceTicksPerSecond[interfaceId];
+        rec->frame = cap->data + offset + 28;
+        rec->capLen = capLen;
+        rec->linkType = cap->interfaceLinkType[interfaceId];
+        rec->timestampNs = ticks / tps * 1000000000ull + (ticks % tps) * 1000000000ull / tps;
+    }
+    else if (type == PCAPNG_SPB && len >= 16 && cap->interfaceCount > 0)
+    {
+        uint32_t origLen = read32(cap, cap->data + offset + 8);
+        rec->frame = cap->data + offset + 12;
+        rec->capLen = (origLen < len - 16) ? origLen : len - 16;
+        rec->linkType = cap->interfaceLinkType[0];
+        rec->timestampNs = 0;
+    }
+    return offset + len;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       findRecordBoundary
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Every record of the run must be plausible, not just parse
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      size_t findRecordBoundary(struct capture* cap, size_t offset)
+ *
+ * RETURNS:        size_t, offset of the first record at or after offset, or the file size if there is none
+ *
+ * NOTES:
+ * Scans forward for a position where RESYNC_DEPTH consecutive records (or the rest of the file) parse cleanly and
+ * pass plausibleRecord, their timestamps never going backwards; pcapng blocks are always 32-bit aligned so only
+ * aligned positions are tried there
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+size_t findRecordBoundary(struct capture* cap, size_t offset)
+{
+    struct record rec;
+    size_t step = 1;
+
+    if (cap->format == PCAPNG)
+    {
+        offset = (offset + 3) & ~(size_t)3;
+        step = 4;
+    }
+
+    for (; offset < cap->size; offset += step)
+    {
+        size_t next = offset;
+        uint64_t previousNs = cap->firstNs;
+        int depth = 0;
+        while (depth < RESYNC_DEPTH && next < cap->size)
+        {
+            size_t after = nextRecord(cap, next, &rec);
+            if (after == 0 || !plausibleRecord(cap, &rec, previousNs)) break;
+            if (rec.frame != NULL && rec.timestampNs != 0) previousNs = rec.timestampNs;
+            next = after;
+            depth++;
+        }
+        if (depth == RESYNC_DEPTH || (depth > 0 && next == cap->size))
+        {
+            return offset;
+        }
+    }
+    return cap->size;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       plausibleRecord
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int plausibleRecord(struct capture* cap, struct record* rec, uint64_t previousNs)
+ *
+ * RETURNS:        int, 1 if the record could be one the capture really holds
+ *
+ * NOTES:
+ * Checks a record nextRecord accepted against what real traffic looks like: at least MIN_FRAME_LEN bytes captured,
+ * framing an IPv4/UDP datagram, stamped no earlier than previousNs and within the capture's time bounds. pcapng
+ * blocks without a packet pass, their own trailing length having been checked; simple packet blocks carry no time.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int plausibleRecord(struct capture* cap, struct record* rec, uint64_t previousNs)
+{
+    uint32_t l3, l4;
+
+    if (rec->frame == NULL)
+    {
+        return cap->format == PCAPNG;
+    }
+    if (rec->capLen < MIN_FRAME_LEN)
+    {
+        return 0;
+    }
+    if ((cap->format == PCAP || rec->timestampNs != 0)
+        && (rec->timestampNs < previousNs || rec->timestampNs < cap->firstNs || rec->timestampNs > cap->lastNs))
+    {
+        return 0;
+    }
+    return locateUDP(rec, &l3, &l4) == 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       findTimeBounds
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void findTimeBounds(struct capture* cap)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Sets firstNs and lastNs from the first and last packet records. The first starts at firstRecord; pcapng blocks
+ * end with their length, so the last is found walking back from the end of the file. pcap records cannot be walked
+ * back, so the last is taken as the latest start within MAX_FRAME_LEN of the end whose record frames an IPv4/UDP
+ * datagram and ends exactly at the end of the file. Bounds that cannot be found are left open.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void findTimeBounds(struct capture* cap)
+{
+    struct record rec;
+    uint32_t l3, l4;
+    size_t offset = cap->firstRecord;
+
+    cap->firstNs = 0;
+    cap->lastNs = UINT64_MAX;
+    while (offset < cap->size && (offset = nextRecord(cap, offset, &rec)) != 0)
+    {
+        if (rec.frame != NULL && rec.timestampNs != 0)
+        {
+            cap->firstNs = rec.timestampNs;
+            break;
+        }
+    }
+
+    if (cap->format == PCAPNG)
+    {
+        offset = cap->size;
+        while (offset >= cap->firstRecord + 12)
+        {
+            uint32_t len = read32(cap, cap->data + offset - 4);
+            if (len < 12 || len % 4 != 0 || len > offset - cap->firstRecord || nextRecord(cap, offset - len, &rec) != offset)
+            {
+                break;
+            }
+            offset -= len;
+            if (rec.frame != NULL && rec.timestampNs != 0)
+            {
+                cap->lastNs = rec.timestampNs;
+                break;
+            }
+        }
+        return;
+    }
+
+    offset = (cap->size > cap->firstRecord + PCAP_RECORD_HEADER_LEN) ? cap->size - PCAP_RECORD_HEADER_LEN : cap->firstRecord;
+    for (; offset >= cap->firstRecord && cap->size - offset <= PCAP_RECORD_HEADER_LEN + MAX_FRAME_LEN; offset--)
+    {
+        if (nextRecord(cap, offset, &rec) == cap->size && rec.capLen >= MIN_FRAME_LEN && rec.timestampNs >= cap->firstNs
+            && locateUDP(&rec, &l3, &l4) == 0)
+        {
+            cap->lastNs = rec.timestampNs;
+            return;
+        }
+        if (offset == cap->firstRecord) break;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       decodeChunk
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Counts corrupt packets apart from frames that are not protocol packets
+ *                 October 18th, 2026 - Counts control packets
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void* decodeChunk(void* arg)
+ *
+ * RETURNS:        void*
+ *
+ * NOTES:
+ * Decoder thread: decodes every record starting inside the chunk into a compact event list
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void* decodeChunk(void* arg)
+{
+    struct chunk* ch = (struct chunk*)arg;
+    struct record rec;
+    size_t offset = ch->start;
+
+    madvise((void*)(ch->cap->data + (ch->start & ~(size_t)4095)), ch->end - (ch->start & ~(size_t)4095), MADV_WILLNEED);
+
+    while (offset < ch->end)
+    {
+        size_t next = nextRecord(ch->cap, offset, &rec);
+        if (next == 0)
+        {
+            fprintf(stderr, "corrupt record at offset %zu, resynchronising\n", offset);
+            offset = findRecordBoundary(ch->cap, offset + 1);
+            continue;
+        }
+        offset = next;
+        if (rec.frame == NULL) continue;
+
+        ch->records++;
+        if (ch->events.count == ch->events.capacity)
+        {
+            ch->events.capacity = ch->events.capacity ? ch->events.capacity * 2 : INITIAL_EVENT_CAPACITY;
+            ch->events.events = realloc(ch->events.events, ch->events.capacity * sizeof(struct event));
+            if (ch->events.events == NULL)
+            {
+                perror("could not allocate events");
+                exit(1);
+            }
+        }
+        int result = decodeRecord(ch->cap, &rec, &ch->events.events[ch->events.count]);
+        if (result == DECODE_OK)
+        {
+            if (ch->events.events[ch->events.count].packetType > EOT)
+                ch->control++;
+            ch->events.count++;
+        }
+        else if (result == DECODE_CORRUPT)
+            ch->corrupt++;
+        else
+            ch->skipped++;
+    }
+    ch->stop = offset;
+    return NULL;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       decodeRecord
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - DATA payload length is the packet's dataLen
+ *                 October 18th, 2026 - Packets failing their checksum are skipped like other frames that don't decode
+ *                 October 18th, 2026 - Link, IPv4 and UDP headers are stripped by locateUDP
+ *                 October 18th, 2026 - Also decodes the legacy layout, and records stream id and offset
+ *                 October 18th, 2026 - Packets failing their checksum are reported as corrupt, not skipped
+ *                 October 18th, 2026 - A struct packet datagram holds the header and the dataLen bytes in use only
+ *                 October 18th, 2026 - Records the file bytes a compressed DATA packet expands to
+ *                 October 18th, 2026 - Accepts every packet type; SYN, SYN_ACK and EOT_ACK are no longer skipped
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int decodeRecord(struct capture* cap, struct record* rec, struct event* ev)
+ *
+ * RETURNS:        int, DECODE_OK, DECODE_NOT_PROTOCOL if the frame is not an IPv4/UDP datagram carrying a struct packet
+ *                 or struct legacyPacket, or DECODE_CORRUPT if a struct packet fails its checksum
+ *
+ * NOTES:
+ * Decodes the payload of the datagram locateUDP finds. A struct packet is PACKET_HEADER_LEN bytes and the dataLen
+ * bytes of data it gives, and must pass its checksum; a datagram of the legacy length that is not one is decoded as
+ * a legacy packet. That has no checksum, stream or offset: it belongs to stream 0, DATA filled LEGACY_PAYLOAD_LEN
+ * bytes of the file per sequence number from 1, and its payload ends at the first NUL
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int decodeRecord(struct capture* cap, struct record* rec, struct event* ev)
+{
+    const unsigned char* frame = rec->frame;
+    uint32_t len = rec->capLen, l3, l4;
+    struct packet pkt;
+    (void)cap;
+
+    if (locateUDP(rec, &l3, &l4) == -1) return DECODE_NOT_PROTOCOL;
+    uint32_t udpLen = ((uint32_t)frame[l4 + 4] << 8) | frame[l4 + 5];
+    if (len < l4 + udpLen || udpLen < 8) return DECODE_NOT_PROTOCOL;
+
+    uint32_t bytes = udpLen - 8;
+    // other UDP traffic is told from a packet by its length agreeing with the dataLen it would hold
+    bool sized = (bytes >= PACKET_HEADER_LEN && bytes <= sizeof(struct packet));
+    if (sized)
+    {
+        memcpy(&pkt, frame + l4 + 8, bytes);
+        sized = (bytes == (uint32_t)packetLength(&pkt));
+    }
+
+    bool intact = sized && packetIntact(&pkt);
+    if (!intact && bytes == sizeof(struct legacyPacket))
+    {
+        struct legacyPacket old;
+        memcpy(&old, frame + l4 + 8, sizeof(struct legacyPacket));
+        memset(&pkt, 0, sizeof(struct packet));
+        pkt.packetType = (enum PacketType)old.packetType;
+        pkt.seqNum = old.seqNum;
+        pkt.windowSize = old.windowSize;
+        pkt.ackNum = old.ackNum;
+        pkt.retransmit = old.retransmit;
+        if (old.packetType == DATA)
+        {
+            pkt.dataLen = (int)strnlen(old.data, LEGACY_PAYLOAD_LEN);
+            pkt.offset = (old.seqNum > 0) ? (int64_t)(old.seqNum - 1) * LEGACY_PAYLOAD_LEN : 0;
+        }
+    }
+    else if (!intact)
+    {
+        return sized ? DECODE_CORRUPT : DECODE_NOT_PROTOCOL;
+    }
+    if (pkt.packetType < DATA || pkt.packetType > EOT_ACK) return DECODE_NOT_PROTOCOL;
+
+    ev->timestampNs = rec->timestampNs;
+    ev->srcIP = ((uint32_t)frame[l3 + 12] << 24) | ((uint32_t)frame[l3 + 13] << 16) | ((uint32_t)frame[l3 + 14] << 8) | frame[l3 + 15];
+    ev->dstIP = ((uint32_t)frame[l3 + 16] << 24) | ((uint32_t)frame[l3 + 17] << 16) | ((uint32_t)frame[l3 + 18] << 8) | frame[l3 + 19];
+    ev->srcPort = (uint16_t)((frame[l4] << 8) | frame[l4 + 1]);
+    ev->dstPort = (uint16_t)((frame[l4 + 2] << 8) | frame[l4 + 3]);
+    ev->packetType = (uint8_t)pkt.packetType;
+    ev->seqNum = pkt.seqNum;
+    ev->ackNum = pkt.ackNum;
+    ev->windowSize = pkt.windowSize;
+    ev->retransmit = pkt.retransmit;
+    ev->streamId = pkt.streamId;
+    ev->offset = pkt.offset;
+    ev->payloadLen = (pkt.packetType == DATA && pkt.dataLen > 0 && pkt.dataLen <= PAYLOAD_LEN) ? (uint16_t)pkt.dataLen : 0;
+    ev->fileLen = (ev->payloadLen > 0 && pkt.rawLen > 0 && pkt.rawLen <= COMPRESSED_BLOCK_LEN) ? (uint16_t)pkt.rawLen : ev->payloadLen;
+    return DECODE_OK;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       locateUDP
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int locateUDP(struct record* rec, uint32_t* l3, uint32_t* l4)
+ *
+ * RETURNS:        int, -1 if the frame is not an unfragmented IPv4/UDP datagram
+ *
+ * NOTES:
+ * Strips the link header to find the IPv4 header at l3 and the UDP header at l4, which is whole in the frame
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int locateUDP(struct record* rec, uint32_t* l3, uint32_t* l4)
+{
+    const unsigned char* frame = rec->frame;
+    uint32_t len = rec->capLen, ip = 0;
+
+
+    switch (rec->linkType)
+    {
+        case LINKTYPE_NULL:
+        case LINKTYPE_LOOP:
+            if (len < 4) return -1;
+            // Address family is in the capturing host's byte order for NULL, network order for LOOP
+            if (!(frame[0] == 2 && frame[1] == 0) && !(frame[3] == 2 && frame[2] == 0)) return -1;
+            ip = 4;
+            break;
+        case LINKTYPE_ETHERNET:
+            if (len < 14) return -1;
+            ip = 12;
+            if (frame[ip] == 0x81 && frame[ip + 1] == 0x00)
+            {
+                if (len < 18) return -1;
+                ip += 4;
+            }
+            if (frame[ip] != 0x08 || frame[ip + 1] != 0x00) return -1;
+            ip += 2;
+            break;
+        case LINKTYPE_RAW:
+        case LINKTYPE_IPV4:
+            break;
+        case LINKTYPE_LINUX_SLL:
+            if (len < 16 || frame[14] != 0x08 || frame[15] != 0x00) return -1;
+            ip = 16;
+            break;
+        case LINKTYPE_LINUX_SLL2:
+            if (len < 20 || frame[0] != 0x08 || frame[1] != 0x00) return -1;
+            ip = 20;
+            break;
+        default:
+            return -1;
+    }
+
+    // IPv4, unfragmented UDP only
+    if (len < ip + 20 || (frame[ip] >> 4) != 4 || (frame[ip] & 0x0F) < 5) return -1;
+    if (frame[ip + 9] != 17 || ((frame[ip + 6] & 0x3F) | frame[ip + 7]) != 0) return -1;
+    uint32_t udp = ip + (frame[ip] & 0x0F) * 4;
+    if (len < udp + 8) return -1;
+
+    *l3 = ip;
+    *l4 = udp;
+    return 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       findFlow
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      struct flow* findFlow(struct flowTable* flows, uint32_t srcIP, uint16_t srcPort, uint32_t dstIP, uint16_t dstPort, int create)
+ *
+ * RETURNS:        struct flow*, NULL if not found and create is 0
+ *
+ * NOTES:
+ * Looks up the DATA flow for a 4-tuple, optionally creating it
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+struct flow* findFlow(struct flowTable* flows, uint32_t srcIP, uint16_t srcPort, uint32_t dstIP, uint16_t dstPort, int create)
+{
+    uint32_t hash = (srcIP * 2654435761u) ^ (dstIP * 40503u) ^ ((uint32_t)srcPort << 16) ^ dstPort;
+    struct flow** bucket = &flows->buckets[hash % FLOW_TABLE_SIZE];
+
+    for (struct flow* fl = *bucket; fl != NULL; fl = fl->next)
+    {
+        if (fl->srcIP == srcIP && fl->dstIP == dstIP && fl->srcPort == srcPort && fl->dstPort == dstPort)
+        {
+            return fl;
+        }
+    }
+    if (!create || flows->count == (int)(sizeof(flows->ordered) / sizeof(flows->ordered[0])))
+    {
+        return NULL;
+    }
+
+    struct flow* fl = calloc(1, sizeof(struct flow));
+    if (fl == NULL)
+    {
+        perror("could not allocate flow");
+        exit(1);
+    }
+    fl->srcIP = srcIP;
+    fl->dstIP = dstIP;
+    fl->srcPort = srcPort;
+    fl->dstPort = dstPort;
+    fl->lastWindowSize = -1;
+    fl->next = *bucket;
+    *bucket = fl;
+    flows->ordered[flows->count++] = fl;
+    return fl;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       analyseEvents
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Goodput counts file bytes; the payload bytes sent are counted apart
+ *                 October 18th, 2026 - Counts control packets without letting them into the DATA statistics
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void analyseEvents(struct eventList* events, struct flowTable* flows)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Replays decoded packets in capture order: DATA, EOT and SYN packets belong to the flow of their 4-tuple,
+ * ACKs, SYN_ACKs and EOT_ACKs to the flow of the reversed 4-tuple. Control packets are only counted. RTT is
+ * sampled only for sequence numbers that were never retransmitted (Karn's algorithm)
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void analyseEvents(struct eventList* events, struct flowTable* flows)
+{
+    uint64_t originNs = (events->count > 0) ? events->events[0].timestampNs : 0;
+
+    for (size_t i = 0; i < events->count; i++)
+    {
+        struct event* ev = &events->events[i];
+        struct flow* fl;
+
+        // Handshake and teardown: counted on the flow, leaving its duration and DATA statistics alone
+        if (ev->packetType == SYN_ACK || ev->packetType == EOT_ACK)
+        {
+            fl = findFlow(flows, ev->dstIP, ev->dstPort, ev->srcIP, ev->srcPort, 0);
+            if (fl != NULL) fl->controlPackets++;
+            continue;
+        }
+        if (ev->packetType == SYN)
+        {
+            fl = findFlow(flows, ev->srcIP, ev->srcPort, ev->dstIP, ev->dstPort, 1);
+            if (fl != NULL) fl->controlPackets++;
+            continue;
+        }
+
+        if (ev->packetType == ACK)
+        {
+            fl = findFlow(flows, ev->dstIP, ev->dstPort, ev->srcIP, ev->srcPort, 0);
+            if (fl == NULL) continue;
+            fl->ackPackets++;
+            fl->lastNs = ev->timestampNs;
+            if (ev->ackNum > 0 && ev->ackNum <= fl->maxSeq
+                && (fl->seqState[ev->ackNum] & (SEQ_SEEN | SEQ_RETRANSMITTED | SEQ_RTT_SAMPLED)) == SEQ_SEEN)
+            {
+                fl->seqState[ev->ackNum] |= SEQ_RTT_SAMPLED;
+                appendSample(&fl->rtt, ev->timestampNs - originNs,
+                    (int32_t)((ev->timestampNs - fl->sendNs[ev->ackNum]) / 1000), ev->ackNum);
+            }
+            continue;
+        }
+
+        fl = findFlow(flows, ev->srcIP, ev->srcPort, ev->dstIP, ev->dstPort, 1);
+        if (fl == NULL) continue;
+        if (fl->firstNs == 0) fl->firstNs = ev->timestampNs;
+        fl->lastNs = ev->timestampNs;
+
+        if (ev->packetType == EOT)
+        {
+            fl->eotSeen = 1;
+            continue;
+        }
+
+        fl->dataPackets++;
+        if (ev->seqNum <= 0) continue;
+        if (ev->seqNum >= fl->seqCapacity)
+        {
+            int32_t capacity = fl->seqCapacity ? fl->seqCapacity : 256;
+            while (capacity <= ev->seqNum) capacity *= 2;
+            fl->sendNs = realloc(fl->sendNs, capacity * sizeof(uint64_t));
+            fl->seqState = realloc(fl->seqState, capacity);
+            if (fl->sendNs == NULL || fl->seqState == NULL)
+            {
+                perror("could not allocate sequence state");
+                exit(1);
+            }
+            memset(fl->seqState + fl->seqCapacity, 0, capacity - fl->seqCapacity);
+            fl->seqCapacity = capacity;
+        }
+        if (ev->seqNum > fl->maxSeq) fl->maxSeq = ev->seqNum;
+
+        // A DATA packet seen twice, or flagged by the transmitter, is a retransmission
+        if (fl->seqState[ev->seqNum] & SEQ_SEEN)
+        {
+            fl->retransmits++;
+            fl->seqState[ev->seqNum] |= SEQ_RETRANSMITTED;
+        }
+        else
+        {
+            if (ev->retransmit)
+            {
+                fl->retransmits++;
+                fl->seqState[ev->seqNum] |= SEQ_RETRANSMITTED;
+            }
+            fl->seqState[ev->seqNum] |= SEQ_SEEN;
+            fl->sendNs[ev->seqNum] = ev->timestampNs;
+            fl->uniqueBytes += ev->fileLen;
+            fl->uniqueWireBytes += ev->payloadLen;
+        }
+
+        if (ev->windowSize != fl->lastWindowSize)
+        {
+            fl->lastWindowSize = ev->windowSize;
+            appendSample(&fl->window, ev->timestampNs - originNs, ev->windowSize, ev->seqNum);
+        }
+    }
+
+    for (int i = 0; i < flows->count; i++)
+    {
+        summariseFlow(flows->ordered[i]);
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       summariseFlow
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void summariseFlow(struct flow* fl)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Computes loss-burst statistics; a sequence number counts as lost when it had to be retransmitted,
+ * and a burst is a run of consecutive lost sequence numbers
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void summariseFlow(struct flow* fl)
+{
+    uint64_t run = 0;
+
+    for (int32_t seq = 1; seq <= fl->maxSeq + 1; seq++)
+    {
+        if (seq <= fl->maxSeq && (fl->seqState[seq] & SEQ_RETRANSMITTED))
+        {
+            fl->lossEvents++;
+            run++;
+            continue;
+        }
+        if (run > 0)
+        {
+            fl->lossBursts++;
+            if (run > fl->longestBurst) fl->longestBurst = run;
+            fl->burstHistogram[(run < LOSS_BURST_BUCKETS ? run : LOSS_BURST_BUCKETS) - 1]++;
+            run = 0;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       printSummary
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Prints the payload bytes sent beside the unique file bytes
+ *                 October 18th, 2026 - Prints the flow's control packets
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void printSummary(struct flowTable* flows)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Prints per-flow statistics to STDOUT
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void printSummary(struct flowTable* flows)
+{
+    char name[64];
+
+    for (int i = 0; i < flows->count; i++)
+    {
+        struct flow* fl = flows->ordered[i];
+        double seconds = (fl->lastNs - fl->firstNs) / 1e9;
+        int32_t maxWindow = 0;
+
+        if (fl->dataPackets == 0) continue;
+        for (size_t w = 0; w < fl->window.count; w++)
+        {
+            if (fl->window.samples[w].value > maxWindow) maxWindow = fl->window.samples[w].value;
+        }
+
+        printf("flow %s\n", formatFlow(fl, name, sizeof(name)));
+        printf("    duration %.3f s, DATA %llu, ACK %llu, control %llu, EOT %s\n", seconds, (unsigned long long)fl->dataPackets,
+            (unsigned long long)fl->ackPackets, (unsigned long long)fl->controlPackets, fl->eotSeen ? "seen" : "not seen");
+        printf("    goodput %.1f B/s (%llu unique file bytes in %llu payload bytes), retransmit rate %.2f%%\n",
+            seconds > 0 ? fl->uniqueBytes / seconds : 0.0, (unsigned long long)fl->uniqueBytes,
+            (unsigned long long)fl->uniqueWireBytes, 100.0 * fl->retransmits / fl->dataPackets);
+
+        if (fl->rtt.count > 0)
+        {
+            int32_t* values = malloc(fl->rtt.count * sizeof(int32_t));
+            double sum = 0;
+            for (size_t r = 0; r < fl->rtt.count; r++)
+            {
+                values[r] = fl->rtt.samples[r].value;
+                sum += values[r];
+            }
+            qsort(values, fl->rtt.count, sizeof(int32_t), compareInt32);
+            size_t n = fl->rtt.count;
+            printf("    RTT ms: samples %zu, min %.3f, p50 %.3f, p90 %.3f, p99 %.3f, max %.3f, mean %.3f\n", n,
+                values[0] / 1e3, values[n * 50 / 100] / 1e3, values[n * 90 / 100] / 1e3, values[n * 99 / 100] / 1e3,
+                values[n - 1] / 1e3, sum / n / 1e3);
+            free(values);
+        }
+        else
+        {
+            printf("    RTT ms: no samples (ACKs not in this capture)\n");
+        }
+
+        printf("    window: %zu changes, max %d, final %d\n", fl->window.count, maxWindow, fl->lastWindowSize);
+        printf("    loss: %llu lost, %llu bursts, mean burst %.2f, longest %llu\n",
+            (unsigned long long)fl->lossEvents, (unsigned long long)fl->lossBursts,
+            fl->lossBursts ? (double)fl->lossEvents / fl->lossBursts : 0.0, (unsigned long long)fl->longestBurst);
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       writeSeriesCSV
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int writeSeriesCSV(struct flowTable* flows, const char* prefix)
+ *
+ * RETURNS:        int, -1 on failure
+ *
+ * NOTES:
+ * Writes <prefix>_rtt.csv, <prefix>_window.csv and <prefix>_loss_bursts.csv
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int writeSeriesCSV(struct flowTable* flows, const char* prefix)
+{
+    char path[4200], name[64];
+    FILE *rtt, *window, *bursts;
+
+    snprintf(path, sizeof(path), "%s_rtt.csv", prefix);
+    rtt = fopen(path, "w");
+    snprintf(path, sizeof(path), "%s_window.csv", prefix);
+    window = fopen(path, "w");
+    snprintf(path, sizeof(path), "%s_loss_bursts.csv", prefix);
+    bursts = fopen(path, "w");
+    if (rtt == NULL || window == NULL || bursts == NULL)
+    {
+        perror("could not open series file");
+        if (rtt) fclose(rtt);
+        if (window) fclose(window);
+        if (bursts) fclose(bursts);
+        return -1;
+    }
+
+    fprintf(rtt, "flow,time_s,seq_num,rtt_ms\n");
+    fprintf(window, "flow,time_s,seq_num,window_size\n");
+    fprintf(bursts, "flow,burst_length,count\n");
+    for (int i = 0; i < flows->count; i++)
+    {
+        struct flow* fl = flows->ordered[i];
+        formatFlow(fl, name, sizeof(name));
+        for (size_t s = 0; s < fl->rtt.count; s++)
+        {
+            fprintf(rtt, "%s,%.6f,%d,%.3f\n", name, fl->rtt.samples[s].timestampNs / 1e9, fl->rtt.samples[s].seqNum, fl->rtt.samples[s].value / 1e3);
+        }
+        for (size_t s = 0; s < fl->window.count; s++)
+        {
+            fprintf(window, "%s,%.6f,%d,%d\n", name, fl->window.samples[s].timestampNs / 1e9, fl->window.samples[s].seqNum, fl->window.samples[s].value);
+        }
+        for (int b = 0; b < LOSS_BURST_BUCKETS; b++)
+        {
+            if (fl->burstHistogram[b] > 0)
+                fprintf(bursts, "%s,%s%d,%llu\n", name, (b == LOSS_BURST_BUCKETS - 1) ? ">=" : "", b + 1, (unsigned long long)fl->burstHistogram[b]);
+        }
+    }
+
+    fclose(rtt);
+    fclose(window);
+    fclose(bursts);
+    return 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       writeSeriesJSON
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - uniqueWireBytes beside uniqueBytes
+ *                 October 18th, 2026 - controlPackets
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int writeSeriesJSON(struct flowTable* flows, const char* prefix)
+ *
+ * RETURNS:        int, -1 on failure
+ *
+ * NOTES:
+ * Writes the per-flow summary and series to <prefix>.json
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int writeSeriesJSON(struct flowTable* flows, const char* prefix)
+{
+    char path[4200], name[64];
+    FILE* fp;
+
+    snprintf(path, sizeof(path), "%s.json", prefix);
+    if ((fp = fopen(path, "w")) == NULL)
+    {
+        perror("could not open series file");
+        return -1;
+    }
+
+    fprintf(fp, "{\"flows\":[");
+    for (int i = 0; i < flows->count; i++)
+    {
+        struct flow* fl = flows->ordered[i];
+        double seconds = (fl->lastNs - fl->firstNs) / 1e9;
+
+        fprintf(fp, "%s\n{\"flow\":\"%s\",\"durationS\":%.6f,\"dataPackets\":%llu,\"ackPackets\":%llu,\"controlPackets\":%llu,\"retransmits\":%llu,"
+            "\"uniqueBytes\":%llu,\"uniqueWireBytes\":%llu,\"goodputBps\":%.3f,\"eotSeen\":%s,\"lostPackets\":%llu,\"lossBursts\":%llu,\"longestBurst\":%llu,",
+            (i == 0) ? "" : ",", formatFlow(fl, name, sizeof(name)), seconds,
+            (unsigned long long)fl->dataPackets, (unsigned long long)fl->ackPackets, (unsigned long long)fl->controlPackets,
+            (unsigned long long)fl->retransmits,
+            (unsigned long long)fl->uniqueBytes, (unsigned long long)fl->uniqueWireBytes, seconds > 0 ? fl->uniqueBytes / seconds : 0.0, fl->eotSeen ? "true" : "false",
+            (unsigned long long)fl->lossEvents, (unsigned long long)fl->lossBursts, (unsigned long long)fl->longestBurst);
+
+        fprintf(fp, "\"burstHistogram\":[");
+        for (int b = 0; b < LOSS_BURST_BUCKETS; b++)
+        {
+            fprintf(fp, "%s%llu", (b == 0) ? "" : ",", (unsigned long long)fl->burstHistogram[b]);
+        }
+        fprintf(fp, "],\"rtt\":[");
+        for (size_t s = 0; s < fl->rtt.count; s++)
+        {
+            fprintf(fp, "%s[%.6f,%d,%.3f]", (s == 0) ? "" : ",", fl->rtt.samples[s].timestampNs / 1e9, fl->rtt.samples[s].seqNum, fl->rtt.samples[s].value / 1e3);
+        }
+        fprintf(fp, "],\"window\":[");
+        for (size_t s = 0; s < fl->window.count; s++)
+        {
+            fprintf(fp, "%s[%.6f,%d,%d]", (s == 0) ? "" : ",", fl->window.samples[s].timestampNs / 1e9, fl->window.samples[s].seqNum, fl->window.samples[s].value);
+        }
+        fprintf(fp, "]}");
+    }
+    fprintf(fp, "\n]}\n");
+
+    fclose(fp);
+    return 0;
+}
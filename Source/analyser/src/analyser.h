@@ -0,0 +1,239 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * HEADER FILE:              analyser.h
+ *
+ * FUNCTION PROTOTYPES:      int mapCapture(const char* fileName, struct capture* cap)
+ *                           int parseCaptureHeader(struct capture* cap)
+ *                           size_t nextRecord(struct capture* cap, size_t offset, struct record* rec)
+ *                           void findTimeBounds(struct capture* cap)
+ *                           size_t findRecordBoundary(struct capture* cap, size_t offset)
+ *                           int plausibleRecord(struct capture* cap, struct record* rec, uint64_t previousNs)
+ *                           int locateUDP(struct record* rec, uint32_t* l3, uint32_t* l4)
+ *                           void* decodeChunk(void* arg)
+ *                           int decodeRecord(struct capture* cap, struct record* rec, struct event* ev)
+ *                           void analyseEvents(struct eventList* events, struct flowTable* flows)
+ *                           struct flow* findFlow(struct flowTable* flows, uint32_t srcIP, uint16_t srcPort, uint32_t dstIP, uint16_t dstPort, int create)
+ *                           void summariseFlow(struct flow* fl)
+ *                           void printSummary(struct flowTable* flows)
+ *                           int writeSeriesCSV(struct flowTable* flows, const char* prefix)
+ *                           int writeSeriesJSON(struct flowTable* flows, const char* prefix)
+ *
+ * DATE:                     October 18th, 2026
+ *
+ * REVISIONS:                October 18th, 2026 - Time bounds of a capture and interface snap lengths, used to check
+ *                                                chunk boundaries
+ *                           October 18th, 2026 - Layout of packets captured before the stream, offset and checksum
+ *                                                fields; events carry a stream id and offset
+ *                           October 18th, 2026 - Decode results, and a count of packets failing their checksum
+ *                           October 18th, 2026 - Bytes of the file a DATA packet stands for, apart from the bytes it
+ *                                                carried; flows count both
+ *                           October 18th, 2026 - Counts of SYN, SYN_ACK and EOT_ACK control packets
+ *
+ * DESIGNER:                 Derek Wong
+ *
+ * PROGRAMMER:               Derek Wong
+ *
+ * NOTES:
+ * Header file containing constants, structs and function prototypes for analyser.c
+ * -----------------------------------------------------------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <arpa/inet.h>
+
+/*------------------------------------------------- Enums -------------------------------------------------------------------------------*/
+enum CaptureFormat { PCAP, PCAPNG };
+enum SeriesFormat { SERIES_CSV, SERIES_JSON };
+
+/*------------------------------------------------- Symbolic Constants ------------------------------------------------------------------*/
+#define DECODE_OK                   0
+#define DECODE_NOT_PROTOCOL         -1          // Not an IPv4/UDP datagram carrying a packet of either layout
+#define DECODE_CORRUPT              -2          // A struct packet whose checksum does not match
+#define PCAP_MAGIC_USEC             0xa1b2c3d4
+#define PCAP_MAGIC_NSEC             0xa1b23c4d
+#define PCAPNG_SHB                  0x0a0d0d0a
+#define PCAPNG_IDB                  0x00000001
+#define PCAPNG_SPB                  0x00000003
+#define PCAPNG_EPB                  0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC     0x1a2b3c4d
+#define PCAP_FILE_HEADER_LEN        24
+#define PCAP_RECORD_HEADER_LEN      16
+#define MAX_INTERFACES              16
+#define MAX_THREADS                 64
+#define MIN_CHUNK_SIZE              (4 << 20)   // Files are only split into chunks of at least 4 MiB
+#define RESYNC_DEPTH                4           // Consecutive valid records required to trust a chunk boundary
+#define MIN_FRAME_LEN               28          // IPv4 and UDP headers; a resync candidate carrying less is rejected
+#define MAX_FRAME_LEN               262144
+#define INITIAL_EVENT_CAPACITY      4096
+#define FLOW_TABLE_SIZE             256
+#define LOSS_BURST_BUCKETS          8           // Loss burst lengths 1..7 and 8+
+#define LEGACY_PAYLOAD_LEN          256         // Payload of struct legacyPacket, which every DATA packet filled in turn
+
+#define LINKTYPE_NULL               0
+#define LINKTYPE_ETHERNET           1
+#define LINKTYPE_RAW                101
+#define LINKTYPE_LOOP               108
+#define LINKTYPE_LINUX_SLL          113
+#define LINKTYPE_IPV4               228
+#define LINKTYPE_LINUX_SLL2         276
+
+/*------------------------------------------------- Default Strings ---------------------------------------------------------------------*/
+#define DEFAULT_OUTPUT_PREFIX       "./analysis"
+
+/*------------------------------------------------- Structs -----------------------------------------------------------------------------*/
+struct capture
+{
+    const unsigned char* data;
+    size_t size;
+    enum CaptureFormat format;
+    int swapped;
+    int nanosecond;
+    uint32_t snaplen;
+    int linkType;
+    int interfaceCount;
+    int interfaceLinkType[MAX_INTERFACES];
+    uint64_t interfaceTicksPerSecond[MAX_INTERFACES];
+    uint32_t interfaceSnaplen[MAX_INTERFACES];
+    size_t firstRecord;
+    uint64_t firstNs;           // Timestamps of the first and last packet records; any record in between lies within them
+    uint64_t lastNs;
+};
+
+// A packet as sent before streams, offsets and checksums were added; the older captures hold these
+#pragma pack(push, 1)
+struct legacyPacket
+{
+    int32_t packetType;
+    int32_t seqNum;
+    char data[LEGACY_PAYLOAD_LEN];  // NUL-terminated when the payload is shorter
+    int32_t windowSize;
+    int32_t ackNum;
+    uint8_t retransmit;
+};
+#pragma pack(pop)
+
+struct record
+{
+    const unsigned char* frame;
+    uint32_t capLen;
+    int linkType;
+    uint64_t timestampNs;
+};
+
+struct event
+{
+    uint64_t timestampNs;
+    uint32_t srcIP;
+    uint32_t dstIP;
+    uint16_t srcPort;
+    uint16_t dstPort;
+    int32_t seqNum;
+    int32_t ackNum;
+    int32_t windowSize;
+    int32_t streamId;
+    int64_t offset;
+    uint16_t payloadLen;        // Bytes of data the packet carried
+    uint16_t fileLen;           // Bytes of the file they stand for: rawLen when compressed, else payloadLen
+    uint8_t packetType;
+    uint8_t retransmit;
+};
+
+struct eventList
+{
+    struct event* events;
+    size_t count;
+    size_t capacity;
+};
+
+struct chunk
+{
+    struct capture* cap;
+    size_t start;
+    size_t end;
+    size_t stop;                // Offset the decoder actually finished at
+    struct eventList events;
+    uint64_t records;
+    uint64_t skipped;
+    uint64_t corrupt;
+    uint64_t control;           // SYN, SYN_ACK and EOT_ACK, decoded but not part of any DATA statistics
+};
+
+struct sample
+{
+    uint64_t timestampNs;
+    int32_t value;
+    int32_t seqNum;
+};
+
+struct sampleList
+{
+    struct sample* samples;
+    size_t count;
+    size_t capacity;
+};
+
+struct flow
+{
+    uint32_t srcIP;
+    uint32_t dstIP;
+    uint16_t srcPort;
+    uint16_t dstPort;
+    uint64_t firstNs;
+    uint64_t lastNs;
+    uint64_t dataPackets;
+    uint64_t ackPackets;
+    uint64_t controlPackets;    // SYN from the flow's source; SYN_ACK and EOT_ACK back to it
+    uint64_t retransmits;
+    uint64_t uniqueBytes;       // Bytes of the file, first transmissions only
+    uint64_t uniqueWireBytes;   // Payload bytes those transmissions carried, less than uniqueBytes when compressed
+    int eotSeen;
+
+    // Per sequence number state, indexed by seqNum
+    uint64_t* sendNs;
+    uint8_t* seqState;
+    int32_t seqCapacity;
+    int32_t maxSeq;
+
+    int32_t lastWindowSize;
+    struct sampleList rtt;
+    struct sampleList window;
+
+    uint64_t lossEvents;
+    uint64_t lossBursts;
+    uint64_t longestBurst;
+    uint64_t burstHistogram[LOSS_BURST_BUCKETS];
+
+    struct flow* next;
+};
+
+struct flowTable
+{
+    struct flow* buckets[FLOW_TABLE_SIZE];
+    struct flow* ordered[FLOW_TABLE_SIZE * 4];
+    int count;
+};
+
+/*------------------------------------------------- Funtion Prototypes ------------------------------------------------------------------*/
+int mapCapture(const char* fileName, struct capture* cap);
+int parseCaptureHeader(struct capture* cap);
+size_t nextRecord(struct capture* cap, size_t offset, struct record* rec);
+void findTimeBounds(struct capture* cap);
+size_t findRecordBoundary(struct capture* cap, size_t offset);
+int plausibleRecord(struct capture* cap, struct record* rec, uint64_t previousNs);
+int locateUDP(struct record* rec, uint32_t* l3, uint32_t* l4);
+void* decodeChunk(void* arg);
+int decodeRecord(struct capture* cap, struct record* rec, struct event* ev);
+void analyseEvents(struct eventList* events, struct flowTable* flows);
+struct flow* findFlow(struct flowTable* flows, uint32_t srcIP, uint16_t srcPort, uint32_t dstIP, uint16_t dstPort, int create);
+void summariseFlow(struct flow* fl);
+void printSummary(struct flowTable* flows);
+int writeSeriesCSV(struct flowTable* flows, const char* prefix);
+int writeSeriesJSON(struct flowTable* flows, const char* prefix);
@@ -0,0 +1,66 @@
+#!/bin/sh
+#-----------------------------------------------------------------------------------------------------------------------------------
+# SCRIPT:         capturetest.sh
+#
+# DATE:           October 18th, 2026
+#
+# REVISIONS:      October 18th, 2026 - A capture of a compressed transfer; flows must carry the expected file
+#                                      bytes in the expected payload bytes
+#                 October 18th, 2026 - Expected control packet counts; the compressed capture's SYN, SYN_ACK and
+#                                      EOT_ACK are control packets, not skipped frames
+#
+# DESIGNER:       Derek Wong
+#
+# PROGRAMMER:     Derek Wong
+#
+# USAGE:          sh Source/analyser/test/capturetest.sh
+#
+# NOTES:
+# Builds the analyser and runs it over the captures checked in under "Packet Captures". All but one were taken
+# before the stream, offset and checksum fields were added to struct packet; every flow of those must account for
+# the whole 6747-byte message, and the receiver-side ones each hold 6 frames that are not protocol packets.
+# compressed-emulator.pcap is both legs of a transmitter -z run through an emulator with 3% loss, sending a
+# 26388-byte file (message.txt four times) in 24319 bytes of compressed payloads, with a SYN, SYN_ACK and EOT_ACK
+# on each leg. Each capture must decode to the expected number of protocol packets, and of control packets among
+# them. Exits non-zero if any capture does not match.
+#-----------------------------------------------------------------------------------------------------------------------------------
+
+cd "$(dirname "$0")/../../.." || exit 1
+WORK=$(mktemp -d) || exit 1
+trap 'rm -rf "$WORK"' EXIT
+
+gcc -O2 -Wall -pthread -o "$WORK/analyser" Source/analyser/src/*.c || exit 1
+
+status=0
+while read -r capture records packets control skipped fileBytes payloadBytes
+do
+    "$WORK/analyser" -j 2 -o "$WORK/out" "Packet Captures/$capture" > "$WORK/summary.txt" 2> "$WORK/errors.txt"
+    expected="Packet Captures/$capture: $records records, $packets protocol packets ($control control), $skipped skipped"
+    if ! grep -q "^$expected, " "$WORK/summary.txt"
+    then
+        echo "FAIL $capture: expected \"$expected\", got:"
+        cat "$WORK/summary.txt" "$WORK/errors.txt"
+        status=1
+    elif grep "unique file bytes" "$WORK/summary.txt" | grep -qv "($fileBytes unique file bytes in $payloadBytes payload bytes)"
+    then
+        echo "FAIL $capture: a flow did not carry the whole file in $payloadBytes payload bytes"
+        grep "unique file bytes" "$WORK/summary.txt"
+        status=1
+    else
+        echo "ok   $capture"
+    fi
+done <<EOF
+3a-g.pcap 1967 1967 0 0 6747 6747
+high-ber-emulator.pcap 669 669 0 0 6747 6747
+high-ber-receiver.pcap 339 333 0 6 6747 6747
+high-ber-transmitter.pcap 336 336 0 0 6747 6747
+high-delay-emulator.pcap 662 662 0 0 6747 6747
+high-delay-receiver.pcap 340 334 0 6 6747 6747
+high-delay-transmitter.pcap 327 327 0 0 6747 6747
+nomial-transmitter.pcap 319 319 0 0 6747 6747
+nominal-emulator.pcap 641 641 0 0 6747 6747
+nominal-receiver.pcap 328 322 0 6 6747 6747
+compressed-emulator.pcap 436 436 6 0 26388 24319
+EOF
+
+exit $status
@@ -0,0 +1,968 @@
+/*----------------------------------------------------------------------------------------------------------------------------
+ * SOURCE FILE:    benchmark.c
+ *
+ * PROGRAM:        benchmark
+ *
+ * FUNCTIONS:      int parseSweep(const char* list, struct sweep* out)
+ *                 long writeMessageFile(const char* path, int lines, int payload)
+ *                 pid_t launch(const char* path, char* const argv[], const char* dir, const char* outputPath)
+ *                 int waitForPort(pid_t pid, const char* address, int port, int timeoutMs)
+ *                 int runOnce(struct benchConfig* cfg, int delayMs, int lossPercent, int window, int payload, struct runResult* result)
+ *                 long readSummaryValue(const char* path, const char* marker, const char* key)
+ *                 int filesEqual(const char* first, const char* second)
+ *                 void summarisePoint(struct runResult* runs, int count, struct pointResult* point)
+ *                 int writeResults(const char* path, struct pointResult* points, int count)
+ *                 int loadResults(const char* path, struct pointResult** points)
+ *                 int compareBaseline(struct pointResult* points, int count, struct pointResult* baseline, int baselineCount, double tolerancePercent)
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Message files may be longer than one read of the transmitter
+ *                 October 18th, 2026 - The receiver runs for one session; its file is named by the connection id
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * NOTES:
+ * End-to-end benchmark of the transmitter, the headless network emulator and the receiver.
+ * Every combination of delay x loss x window x payload size is run in a fresh working directory; the median of the
+ * repeats is recorded as one row of the results file (completion time, goodput, retransmits, emulator drops and CPU
+ * time per component). With -b the results are compared to a stored baseline and the program exits with status 2
+ * when goodput drops or CPU time grows by more than the tolerance, or a transfer that used to succeed fails.
+ *
+ * The payload size is the length of each generated message line; it must fit in PAYLOAD_LEN including the newline.
+ * The transmitter sends the file in PAYLOAD_LEN byte chunks, so the number of DATA packets follows from the file size.
+ * The receiver is told to exit after one session and writes it to a file named after the connection id, which is
+ * read from the transmitter's summary line.
+ *
+ * Usage: benchmark [-T transmitter] [-E emulator] [-R receiver] [-a address] [-d delays] [-l losses] [-w windows]
+ *                  [-s payloads] [-n lines] [-r repeats] [-t timeoutSeconds] [-o results.csv] [-b baseline.csv]
+ *                  [-p tolerancePercent] [-k]
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+
+#include "benchmark.h"
+#include "../../packet.h"
+
+#define USAGE "Usage: %s [-T transmitter] [-E emulator] [-R receiver] [-a address] [-d delays] [-l losses] [-w windows] " \
+              "[-s payloads] [-n lines] [-r repeats] [-t timeoutSeconds] [-o results.csv] [-b baseline.csv] [-p tolerancePercent] [-k]\n"
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       nowSeconds
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static double nowSeconds(void)
+ *
+ * RETURNS:        double
+ *
+ * NOTES:
+ * Monotonic clock in seconds
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static double nowSeconds(void)
+{
+    return monotonicUs() / 1e6;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       cpuSeconds
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static double cpuSeconds(const struct rusage* usage)
+ *
+ * RETURNS:        double
+ *
+ * NOTES:
+ * User plus system time of a reaped child
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static double cpuSeconds(const struct rusage* usage)
+{
+    return usage->ru_utime.tv_sec + usage->ru_utime.tv_usec / 1e6 + usage->ru_stime.tv_sec + usage->ru_stime.tv_usec / 1e6;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       compareDouble
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static int compareDouble(const void* a, const void* b)
+ *
+ * RETURNS:        int
+ *
+ * NOTES:
+ * qsort comparator for the repeat medians
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static int compareDouble(const void* a, const void* b)
+{
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       median
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static double median(double* values, int count)
+ *
+ * RETURNS:        double, or -1 when there are no values
+ *
+ * NOTES:
+ * Sorts values in place
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static double median(double* values, int count)
+{
+    if (count == 0) return -1;
+    qsort(values, count, sizeof(double), compareDouble);
+    return count % 2 ? values[count / 2] : (values[count / 2 - 1] + values[count / 2]) / 2;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       removeEntry
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static int removeEntry(const char* path, const struct stat* sb, int type, struct FTW* ftw)
+ *
+ * RETURNS:        int, 0 so the walk always continues
+ *
+ * NOTES:
+ * nftw callback deleting a run's working directory bottom-up
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static int removeEntry(const char* path, const struct stat* sb, int type, struct FTW* ftw)
+{
+    (void)sb;
+    (void)ftw;
+    if (type == FTW_DP) rmdir(path);
+    else unlink(path);
+    return 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       parseSweep
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int parseSweep(const char* list, struct sweep* out)
+ *
+ * RETURNS:        int, 0 on success and -1 on a malformed list
+ *
+ * NOTES:
+ * Parses a comma separated list of non-negative integers
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int parseSweep(const char* list, struct sweep* out)
+{
+    const char* p = list;
+    char* end;
+
+    out->count = 0;
+    while (*p)
+    {
+        long value = strtol(p, &end, 10);
+        if (end == p || value < 0 || value > INT_MAX || out->count == MAX_SWEEP_VALUES || (*end != ',' && *end != '\0'))
+        {
+            return -1;
+        }
+        out->values[out->count++] = (int)value;
+        p = *end == ',' ? end + 1 : end;
+    }
+    return out->count > 0 ? 0 : -1;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       writeMessageFile
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      long writeMessageFile(const char* path, int lines, int payload)
+ *
+ * RETURNS:        long, bytes written or -1 on error
+ *
+ * NOTES:
+ * Writes lines of payload bytes each, the last being the newline
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+long writeMessageFile(const char* path, int lines, int payload)
+{
+    char line[PAYLOAD_LEN];
+    FILE* fp = fopen(path, "w");
+    if (fp == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    for (int i = 0; i < lines; i++)
+    {
+        for (int j = 0; j < payload - 1; j++)
+        {
+            line[j] = 'a' + (i + j) % 26;
+        }
+        line[payload - 1] = '\n';
+        fwrite(line, 1, payload, fp);
+    }
+    if (fclose(fp) != 0)
+    {
+        perror(path);
+        return -1;
+    }
+    return (long)lines * payload;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       launch
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      pid_t launch(const char* path, char* const argv[], const char* dir, const char* outputPath)
+ *
+ * RETURNS:        pid_t, the child or -1 on error
+ *
+ * NOTES:
+ * Starts a component in dir with stdout and stderr redirected to outputPath
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+pid_t launch(const char* path, char* const argv[], const char* dir, const char* outputPath)
+{
+    pid_t pid = fork();
+    if (pid == -1)
+    {
+        perror("fork");
+        return -1;
+    }
+    if (pid == 0)
+    {
+        int fd = open(outputPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1 || chdir(dir) == -1)
+        {
+            _exit(127);
+        }
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+        execv(path, argv);
+        _exit(127);
+    }
+    return pid;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       waitForPort
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int waitForPort(pid_t pid, const char* address, int port, int timeoutMs)
+ *
+ * RETURNS:        int, 0 once the port is bound and -1 if the child exited or the wait timed out
+ *
+ * NOTES:
+ * A component is ready once binding its UDP port fails with EADDRINUSE. The child is only peeked at with
+ * WNOWAIT so its resource usage can still be collected later.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int waitForPort(pid_t pid, const char* address, int port, int timeoutMs)
+{
+    struct sockaddr_in addr;
+    double deadline = nowSeconds() + timeoutMs / 1000.0;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, address, &addr.sin_addr) != 1)
+    {
+        fprintf(stderr, "invalid address: %s\n", address);
+        return -1;
+    }
+
+    while (nowSeconds() < deadline)
+    {
+        siginfo_t info;
+        int sd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (sd == -1)
+        {
+            perror("socket");
+            return -1;
+        }
+        int bound = bind(sd, (struct sockaddr*)&addr, sizeof(addr));
+        int inUse = bound == -1 && errno == EADDRINUSE;
+        close(sd);
+        if (inUse)
+        {
+            return 0;
+        }
+
+        info.si_pid = 0;
+        if (waitid(P_PID, pid, &info, WEXITED | WNOHANG | WNOWAIT) == 0 && info.si_pid == pid)
+        {
+            return -1;
+        }
+        usleep(POLL_INTERVAL_US * 5);
+    }
+    return -1;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       readSummaryValue
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      long readSummaryValue(const char* path, const char* marker, const char* key)
+ *
+ * RETURNS:        long, the value or -1 when it is not found
+ *
+ * NOTES:
+ * Finds the last line of a component's output containing marker and returns the number after key on it
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+long readSummaryValue(const char* path, const char* marker, const char* key)
+{
+    char line[1024];
+    long value = -1;
+    FILE* fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        char* m = strstr(line, marker);
+        char* k = m ? strstr(m, key) : NULL;
+        if (k != NULL)
+        {
+            value = strtol(k + strlen(key), NULL, 10);
+        }
+    }
+    fclose(fp);
+    return value;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       filesEqual
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int filesEqual(const char* first, const char* second)
+ *
+ * RETURNS:        int, 1 when both files exist and are byte-for-byte identical
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int filesEqual(const char* first, const char* second)
+{
+    char a[4096], b[4096];
+    size_t na, nb;
+    int equal = 1;
+    FILE* fa = fopen(first, "rb");
+    FILE* fb = fopen(second, "rb");
+
+    if (fa == NULL || fb == NULL)
+    {
+        equal = 0;
+    }
+    while (equal)
+    {
+        na = fread(a, 1, sizeof(a), fa);
+        nb = fread(b, 1, sizeof(b), fb);
+        if (na != nb || memcmp(a, b, na) != 0)
+        {
+            equal = 0;
+        }
+        if (na == 0)
+        {
+            break;
+        }
+    }
+    if (fa) fclose(fa);
+    if (fb) fclose(fb);
+    return equal;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       runOnce
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Receiver exits after one session; the received file is found by the connection id
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int runOnce(struct benchConfig* cfg, int delayMs, int lossPercent, int window, int payload, struct runResult* result)
+ *
+ * RETURNS:        int, 0 when the run completed (the transfer itself may still have failed) and -1 on a setup error
+ *
+ * NOTES:
+ * Starts the emulator and the receiver, waits for their ports, then times the transmitter from launch to exit.
+ * Everything is killed when the run exceeds the timeout. The emulator is given EMULATOR_EXIT_GRACE_MS to relay
+ * the EOT and exit on its own before it is terminated.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int runOnce(struct benchConfig* cfg, int delayMs, int lossPercent, int window, int payload, struct runResult* result)
+{
+    char workDir[] = "/tmp/benchmark.XXXXXX";
+    char dirs[COMPONENT_COUNT][WORK_PATH_LEN], outputs[COMPONENT_COUNT][WORK_PATH_LEN * 2], path[WORK_PATH_LEN * 2], received[WORK_PATH_LEN * 2];
+    char delayArg[16], lossArg[16], windowArg[16];
+    const char* names[COMPONENT_COUNT] = { "tx", "emu", "rx" };
+    pid_t pids[COMPONENT_COUNT] = { -1, -1, -1 };
+    int reaped[COMPONENT_COUNT] = { 0, 0, 0 };
+    double started, finished = -1, deadline;
+    long bytes;
+
+    memset(result, 0, sizeof(*result));
+    result->retransmits = result->dropped = -1;
+
+    if (mkdtemp(workDir) == NULL)
+    {
+        perror("mkdtemp");
+        return -1;
+    }
+    for (int c = 0; c < COMPONENT_COUNT; c++)
+    {
+        snprintf(dirs[c], sizeof(dirs[c]), "%s/%s", workDir, names[c]);
+        snprintf(outputs[c], sizeof(outputs[c]), "%s/%s/out.txt", workDir, names[c]);
+        mkdir(dirs[c], 0755);
+    }
+    snprintf(path, sizeof(path), "%s/resource", dirs[COMPONENT_TRANSMITTER]);
+    mkdir(path, 0755);
+    snprintf(path, sizeof(path), "%s/data", dirs[COMPONENT_RECEIVER]);
+    mkdir(path, 0755);
+    snprintf(path, sizeof(path), "%s/resource/message.txt", dirs[COMPONENT_TRANSMITTER]);
+    if ((bytes = writeMessageFile(path, cfg->lines, payload)) == -1)
+    {
+        nftw(workDir, removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+        return -1;
+    }
+
+    snprintf(delayArg, sizeof(delayArg), "%d", delayMs);
+    snprintf(lossArg, sizeof(lossArg), "%d", lossPercent);
+    snprintf(windowArg, sizeof(windowArg), "%d", window);
+    char* emulatorArgv[] = { cfg->emulatorPath, "--headless", "--exit-after-eot", "--transmitter-ip", (char*)cfg->address,
+                             "--receiver-ip", (char*)cfg->address, "--bind-ip", (char*)cfg->address, "--delay", delayArg,
+                             "--loss", lossArg, NULL };
+    char* receiverArgv[] = { cfg->receiverPath, "-n", "1", NULL };
+    char* transmitterArgv[] = { cfg->transmitterPath, "-w", windowArg, (char*)cfg->address, NULL };
+
+    // Bring up the path from the far end so nothing the transmitter sends is lost to a missing socket
+    pids[COMPONENT_EMULATOR] = launch(cfg->emulatorPath, emulatorArgv, dirs[COMPONENT_EMULATOR], outputs[COMPONENT_EMULATOR]);
+    if (pids[COMPONENT_EMULATOR] == -1 || waitForPort(pids[COMPONENT_EMULATOR], cfg->address, NETWORK_EMULATOR_PORT, PORT_WAIT_MS) == -1)
+    {
+        fprintf(stderr, "network emulator did not start, see %s\n", outputs[COMPONENT_EMULATOR]);
+        goto abort;
+    }
+    pids[COMPONENT_RECEIVER] = launch(cfg->receiverPath, receiverArgv, dirs[COMPONENT_RECEIVER], outputs[COMPONENT_RECEIVER]);
+    if (pids[COMPONENT_RECEIVER] == -1 || waitForPort(pids[COMPONENT_RECEIVER], cfg->address, RECEIVER_PORT, PORT_WAIT_MS) == -1)
+    {
+        fprintf(stderr, "receiver did not start, see %s\n", outputs[COMPONENT_RECEIVER]);
+        goto abort;
+    }
+
+    started = nowSeconds();
+    deadline = started + cfg->timeoutS;
+    pids[COMPONENT_TRANSMITTER] = launch(cfg->transmitterPath, transmitterArgv, dirs[COMPONENT_TRANSMITTER], outputs[COMPONENT_TRANSMITTER]);
+    if (pids[COMPONENT_TRANSMITTER] == -1)
+    {
+        goto abort;
+    }
+
+    while (!reaped[COMPONENT_TRANSMITTER] || !reaped[COMPONENT_RECEIVER] || !reaped[COMPONENT_EMULATOR])
+    {
+        for (int c = 0; c < COMPONENT_COUNT; c++)
+        {
+            struct rusage usage;
+            int status;
+            if (!reaped[c] && wait4(pids[c], &status, WNOHANG, &usage) == pids[c])
+            {
+                reaped[c] = 1;
+                result->cpuS[c] = cpuSeconds(&usage);
+                if (c == COMPONENT_TRANSMITTER) finished = nowSeconds();
+            }
+        }
+
+        double now = nowSeconds();
+        if (now > deadline)
+        {
+            fprintf(stderr, "run timed out after %d s\n", cfg->timeoutS);
+            goto abort;
+        }
+        // The emulator only exits on its own once it has relayed an EOT
+        if (reaped[COMPONENT_TRANSMITTER] && reaped[COMPONENT_RECEIVER] && !reaped[COMPONENT_EMULATOR]
+            && now > finished + EMULATOR_EXIT_GRACE_MS / 1000.0)
+        {
+            struct rusage usage;
+            kill(pids[COMPONENT_EMULATOR], SIGTERM);
+            wait4(pids[COMPONENT_EMULATOR], NULL, 0, &usage);
+            reaped[COMPONENT_EMULATOR] = 1;
+            result->cpuS[COMPONENT_EMULATOR] = cpuSeconds(&usage);
+        }
+        usleep(POLL_INTERVAL_US);
+    }
+
+    result->completionS = finished - started;
+    snprintf(received, sizeof(received), "%s/data/message-%ld.txt", dirs[COMPONENT_RECEIVER],
+             readSummaryValue(outputs[COMPONENT_TRANSMITTER], "Transfer summary:", "connection="));
+    result->ok = filesEqual(path, received);
+    result->goodputKbps = result->ok && result->completionS > 0 ? bytes * 8 / result->completionS / 1000 : 0;
+    result->retransmits = readSummaryValue(outputs[COMPONENT_TRANSMITTER], "Transfer summary:", "retransmits=");
+    result->dropped = readSummaryValue(outputs[COMPONENT_EMULATOR], "summary:", "dropped=");
+    if (cfg->keepRuns)
+    {
+        fprintf(stderr, "kept %s\n", workDir);
+    }
+    else
+    {
+        nftw(workDir, removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+    }
+    return 0;
+
+abort:
+    for (int c = 0; c < COMPONENT_COUNT; c++)
+    {
+        if (pids[c] > 0 && !reaped[c])
+        {
+            kill(pids[c], SIGKILL);
+            waitpid(pids[c], NULL, 0);
+        }
+    }
+    result->ok = 0;
+    fprintf(stderr, "kept %s\n", workDir);
+    return pids[COMPONENT_TRANSMITTER] > 0 ? 0 : -1;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       summarisePoint
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void summarisePoint(struct runResult* runs, int count, struct pointResult* point)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Reduces the repeats of one sweep point to their medians. A point is ok only if every repeat delivered the file;
+ * counters a component did not report are left at -1.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void summarisePoint(struct runResult* runs, int count, struct pointResult* point)
+{
+    double values[MAX_REPEATS];
+    int n;
+
+    point->runs = count;
+    point->ok = count > 0;
+    for (int i = 0; i < count; i++)
+    {
+        point->ok &= runs[i].ok;
+    }
+
+#define MEDIAN_OF(field, include) \
+    n = 0; \
+    for (int i = 0; i < count; i++) if (include) values[n++] = (double)runs[i].field; \
+    point->field = median(values, n);
+
+    MEDIAN_OF(completionS, 1)
+    MEDIAN_OF(goodputKbps, 1)
+    MEDIAN_OF(retransmits, runs[i].retransmits >= 0)
+    MEDIAN_OF(dropped, runs[i].dropped >= 0)
+    MEDIAN_OF(cpuS[COMPONENT_TRANSMITTER], 1)
+    MEDIAN_OF(cpuS[COMPONENT_EMULATOR], 1)
+    MEDIAN_OF(cpuS[COMPONENT_RECEIVER], 1)
+#undef MEDIAN_OF
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       writeResults
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int writeResults(const char* path, struct pointResult* points, int count)
+ *
+ * RETURNS:        int, 0 on success and -1 on error
+ *
+ * NOTES:
+ * Writes one CSV row per sweep point; this is also the baseline format read by loadResults
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int writeResults(const char* path, struct pointResult* points, int count)
+{
+    FILE* fp = fopen(path, "w");
+    if (fp == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    fprintf(fp, "%s\n", RESULTS_HEADER);
+    for (int i = 0; i < count; i++)
+    {
+        struct pointResult* p = &points[i];
+        fprintf(fp, "%d,%d,%d,%d,%d,%d,%.4f,%.2f,%.1f,%.1f,%.4f,%.4f,%.4f\n", p->delayMs, p->lossPercent, p->window, p->payload,
+            p->runs, p->ok, p->completionS, p->goodputKbps, p->retransmits, p->dropped, p->cpuS[COMPONENT_TRANSMITTER],
+            p->cpuS[COMPONENT_EMULATOR], p->cpuS[COMPONENT_RECEIVER]);
+    }
+    if (fclose(fp) != 0)
+    {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       loadResults
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int loadResults(const char* path, struct pointResult** points)
+ *
+ * RETURNS:        int, number of rows or -1 on error
+ *
+ * NOTES:
+ * Reads a results file written by writeResults; the caller frees *points
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int loadResults(const char* path, struct pointResult** points)
+{
+    char line[1024];
+    int count = 0;
+    FILE* fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    if (fgets(line, sizeof(line), fp) == NULL || strncmp(line, RESULTS_HEADER, strlen(RESULTS_HEADER)) != 0)
+    {
+        fprintf(stderr, "%s is not a benchmark results file\n", path);
+        fclose(fp);
+        return -1;
+    }
+
+    *points = calloc(MAX_RESULT_POINTS, sizeof(struct pointResult));
+    if (*points == NULL)
+    {
+        perror("could not allocate baseline");
+        exit(1);
+    }
+    while (count < MAX_RESULT_POINTS && fgets(line, sizeof(line), fp) != NULL)
+    {
+        struct pointResult* p = &(*points)[count];
+        if (sscanf(line, "%d,%d,%d,%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf", &p->delayMs, &p->lossPercent, &p->window, &p->payload,
+                &p->runs, &p->ok, &p->completionS, &p->goodputKbps, &p->retransmits, &p->dropped, &p->cpuS[COMPONENT_TRANSMITTER],
+                &p->cpuS[COMPONENT_EMULATOR], &p->cpuS[COMPONENT_RECEIVER]) == 13)
+        {
+            count++;
+        }
+    }
+    fclose(fp);
+    return count;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       compareBaseline
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int compareBaseline(struct pointResult* points, int count, struct pointResult* baseline, int baselineCount,
+ *                                     double tolerancePercent)
+ *
+ * RETURNS:        int, number of regressed sweep points
+ *
+ * NOTES:
+ * Points are matched on delay, loss, window and payload; points missing from the baseline are reported but never
+ * regress. CPU growth below CPU_NOISE_FLOOR_S is ignored since short runs are dominated by process start-up.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int compareBaseline(struct pointResult* points, int count, struct pointResult* baseline, int baselineCount, double tolerancePercent)
+{
+    static const char* componentNames[COMPONENT_COUNT] = { "transmitter", "emulator", "receiver" };
+    double tolerance = tolerancePercent / 100;
+    int regressions = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        struct pointResult* p = &points[i];
+        struct pointResult* b = NULL;
+        int regressed = 0;
+
+        for (int j = 0; j < baselineCount && b == NULL; j++)
+        {
+            if (baseline[j].delayMs == p->delayMs && baseline[j].lossPercent == p->lossPercent
+                && baseline[j].window == p->window && baseline[j].payload == p->payload)
+            {
+                b = &baseline[j];
+            }
+        }
+
+        printf("delay=%dms loss=%d%% window=%d payload=%d: ", p->delayMs, p->lossPercent, p->window, p->payload);
+        if (b == NULL)
+        {
+            printf("not in baseline\n");
+            continue;
+        }
+
+        if (b->ok && !p->ok)
+        {
+            printf("FAILED (baseline delivered the file) ");
+            regressed = 1;
+        }
+        if (b->goodputKbps > 0)
+        {
+            double change = (p->goodputKbps - b->goodputKbps) / b->goodputKbps * 100;
+            printf("goodput %.2f -> %.2f kbps (%+.1f%%) ", b->goodputKbps, p->goodputKbps, change);
+            if (p->goodputKbps < b->goodputKbps * (1 - tolerance))
+            {
+                printf("REGRESSED ");
+                regressed = 1;
+            }
+        }
+        for (int c = 0; c < COMPONENT_COUNT; c++)
+        {
+            if (p->cpuS[c] > b->cpuS[c] * (1 + tolerance) + CPU_NOISE_FLOOR_S)
+            {
+                printf("%s cpu %.3f -> %.3f s REGRESSED ", componentNames[c], b->cpuS[c], p->cpuS[c]);
+                regressed = 1;
+            }
+        }
+        printf("%s\n", regressed ? "" : "ok");
+        regressions += regressed;
+    }
+    return regressions;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       main
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int main(int argc, char **argv)
+ *
+ * RETURNS:        int, 0 on success, 1 on error and 2 when the baseline comparison found a regression
+ *
+ * NOTES:
+ * Runs the sweep, writes the results file and optionally compares it to a baseline
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int main(int argc, char **argv)
+{
+    struct benchConfig cfg;
+    const char* transmitter = DEFAULT_TRANSMITTER_PATH;
+    const char* emulator = DEFAULT_EMULATOR_PATH;
+    const char* receiver = DEFAULT_RECEIVER_PATH;
+    const char* delays = DEFAULT_DELAYS;
+    const char* losses = DEFAULT_LOSSES;
+    const char* windows = DEFAULT_WINDOWS;
+    const char* payloads = DEFAULT_PAYLOADS;
+    const char* resultsPath = DEFAULT_RESULTS_PATH;
+    const char* baselinePath = NULL;
+    double tolerancePercent = DEFAULT_TOLERANCE_PERCENT;
+    struct pointResult* points;
+    int pointCount = 0, opt;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.address = DEFAULT_ADDRESS;
+    cfg.lines = MAX_READ_SIZE;
+    cfg.repeats = DEFAULT_REPEATS;
+    cfg.timeoutS = DEFAULT_TIMEOUT_S;
+
+    while ((opt = getopt(argc, argv, "T:E:R:a:d:l:w:s:n:r:t:o:b:p:k")) != -1)
+    {
+        switch (opt)
+        {
+            case 'T': transmitter = optarg; break;
+            case 'E': emulator = optarg; break;
+            case 'R': receiver = optarg; break;
+            case 'a': cfg.address = optarg; break;
+            case 'd': delays = optarg; break;
+            case 'l': losses = optarg; break;
+            case 'w': windows = optarg; break;
+            case 's': payloads = optarg; break;
+            case 'n': cfg.lines = atoi(optarg); break;
+            case 'r': cfg.repeats = atoi(optarg); break;
+            case 't': cfg.timeoutS = atoi(optarg); break;
+            case 'o': resultsPath = optarg; break;
+            case 'b': baselinePath = optarg; break;
+            case 'p': tolerancePercent = atof(optarg); break;
+            case 'k': cfg.keepRuns = 1; break;
+            default:
+                fprintf(stderr, USAGE, argv[0]);
+                exit(1);
+        }
+    }
+
+    if (parseSweep(delays, &cfg.delays) == -1 || parseSweep(losses, &cfg.losses) == -1
+        || parseSweep(windows, &cfg.windows) == -1 || parseSweep(payloads, &cfg.payloads) == -1)
+    {
+        fprintf(stderr, "sweeps are comma separated lists of up to %d non-negative integers\n", MAX_SWEEP_VALUES);
+        exit(1);
+    }
+    for (int i = 0; i < cfg.payloads.count; i++)
+    {
+        if (cfg.payloads.values[i] < 2 || cfg.payloads.values[i] > PAYLOAD_LEN - 1)
+        {
+            fprintf(stderr, "payload sizes must be between 2 and %d bytes\n", PAYLOAD_LEN - 1);
+            exit(1);
+        }
+    }
+    for (int i = 0; i < cfg.windows.count; i++)
+    {
+        if (cfg.windows.values[i] < INITIAL_WINDOW_SIZE || cfg.windows.values[i] > MAX_READ_SIZE)
+        {
+            fprintf(stderr, "windows must be between %d and %d packets\n", INITIAL_WINDOW_SIZE, MAX_READ_SIZE);
+            exit(1);
+        }
+    }
+    if (cfg.lines < 1 || cfg.lines > MAX_LINES || cfg.repeats < 1 || cfg.repeats > MAX_REPEATS || cfg.timeoutS < 1)
+    {
+        fprintf(stderr, "lines must be 1-%d, repeats 1-%d and the timeout positive\n", MAX_LINES, MAX_REPEATS);
+        exit(1);
+    }
+    // The components are started from their own working directories
+    if (realpath(transmitter, cfg.transmitterPath) == NULL || realpath(emulator, cfg.emulatorPath) == NULL
+        || realpath(receiver, cfg.receiverPath) == NULL)
+    {
+        perror("could not find the transmitter, emulator or receiver");
+        exit(1);
+    }
+
+    points = calloc(MAX_RESULT_POINTS, sizeof(struct pointResult));
+    if (points == NULL)
+    {
+        perror("could not allocate results");
+        exit(1);
+    }
+
+    for (int d = 0; d < cfg.delays.count; d++)
+    for (int l = 0; l < cfg.losses.count; l++)
+    for (int w = 0; w < cfg.windows.count; w++)
+    for (int s = 0; s < cfg.payloads.count && pointCount < MAX_RESULT_POINTS; s++)
+    {
+        struct runResult runs[MAX_REPEATS];
+        struct pointResult* p = &points[pointCount++];
+        int completed = 0;
+
+        p->delayMs = cfg.delays.values[d];
+        p->lossPercent = cfg.losses.values[l];
+        p->window = cfg.windows.values[w];
+        p->payload = cfg.payloads.values[s];
+        for (int r = 0; r < cfg.repeats; r++)
+        {
+            if (runOnce(&cfg, p->delayMs, p->lossPercent, p->window, p->payload, &runs[completed]) == 0)
+            {
+                completed++;
+            }
+        }
+        summarisePoint(runs, completed, p);
+        fprintf(stderr, "delay=%dms loss=%d%% window=%d payload=%d: %s completion=%.3fs goodput=%.2fkbps retransmits=%.0f\n",
+            p->delayMs, p->lossPercent, p->window, p->payload, p->ok ? "ok" : "FAILED", p->completionS, p->goodputKbps, p->retransmits);
+    }
+
+    if (writeResults(resultsPath, points, pointCount) == -1)
+    {
+        exit(1);
+    }
+
+    if (baselinePath != NULL)
+    {
+        struct pointResult* baseline;
+        int baselineCount = loadResults(baselinePath, &baseline);
+        if (baselineCount == -1)
+        {
+            exit(1);
+        }
+        int regressions = compareBaseline(points, pointCount, baseline, baselineCount, tolerancePercent);
+        printf("%d of %d sweep points regressed beyond %.1f%%\n", regressions, pointCount, tolerancePercent);
+        free(baseline);
+        free(points);
+        return regressions ? 2 : 0;
+    }
+
+    free(points);
+    return 0;
+}
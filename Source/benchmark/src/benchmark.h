@@ -0,0 +1,138 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * HEADER FILE:              benchmark.h
+ *
+ * FUNCTION PROTOTYPES:      int parseSweep(const char* list, struct sweep* out)
+ *                           long writeMessageFile(const char* path, int lines, int payload)
+ *                           pid_t launch(const char* path, char* const argv[], const char* dir, const char* outputPath)
+ *                           int waitForPort(pid_t pid, const char* address, int port, int timeoutMs)
+ *                           int runOnce(struct benchConfig* cfg, int delayMs, int lossPercent, int window, int payload, struct runResult* result)
+ *                           long readSummaryValue(const char* path, const char* marker, const char* key)
+ *                           int filesEqual(const char* first, const char* second)
+ *                           void summarisePoint(struct runResult* runs, int count, struct pointResult* point)
+ *                           int writeResults(const char* path, struct pointResult* points, int count)
+ *                           int loadResults(const char* path, struct pointResult** points)
+ *                           int compareBaseline(struct pointResult* points, int count, struct pointResult* baseline, int baselineCount, double tolerancePercent)
+ *
+ * DATE:                     October 18th, 2026
+ *
+ * REVISIONS:                October 18th, 2026 - Limit on the length of the message file
+ *
+ * DESIGNER:                 Derek Wong
+ *
+ * PROGRAMMER:               Derek Wong
+ *
+ * NOTES:
+ * Header file containing constants, structs and function prototypes for benchmark.c
+ * -----------------------------------------------------------------------------------------------------------------------------------*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <limits.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/*------------------------------------------------- Enums -------------------------------------------------------------------------------*/
+enum Component { COMPONENT_TRANSMITTER, COMPONENT_EMULATOR, COMPONENT_RECEIVER, COMPONENT_COUNT };
+
+/*------------------------------------------------- Symbolic Constants ------------------------------------------------------------------*/
+#define MAX_SWEEP_VALUES            16
+#define MAX_REPEATS                 32
+#define MAX_LINES                   1000000
+#define MAX_RESULT_POINTS           4096
+#define WORK_PATH_LEN               64          // Run directories live directly under /tmp
+#define DEFAULT_REPEATS             3
+#define DEFAULT_TIMEOUT_S           120
+#define DEFAULT_TOLERANCE_PERCENT   10.0
+#define PORT_WAIT_MS                5000        // How long a component gets to bind its port
+#define EMULATOR_EXIT_GRACE_MS      3000        // How long the emulator gets to exit on its own after the transfer
+#define POLL_INTERVAL_US            2000
+#define CPU_NOISE_FLOOR_S           0.02        // CPU differences below this are never reported as regressions
+
+/*------------------------------------------------- Default Strings ---------------------------------------------------------------------*/
+#define DEFAULT_TRANSMITTER_PATH    "../transmitter/build/transmitter"
+#define DEFAULT_EMULATOR_PATH       "../network_emulator/build/network_emulator"
+#define DEFAULT_RECEIVER_PATH       "../receiver/build/receiver"
+#define DEFAULT_ADDRESS             "127.0.0.1"
+#define DEFAULT_DELAYS              "0,20"
+#define DEFAULT_LOSSES              "0,5"
+#define DEFAULT_WINDOWS             "5,20"
+#define DEFAULT_PAYLOADS            "64,255"
+#define DEFAULT_RESULTS_PATH        "./results.csv"
+#define RESULTS_HEADER              "delay_ms,loss_percent,window,payload_bytes,runs,ok,completion_s,goodput_kbps,retransmits,dropped,transmitter_cpu_s,emulator_cpu_s,receiver_cpu_s"
+
+/*------------------------------------------------- Structs -----------------------------------------------------------------------------*/
+struct sweep
+{
+    int values[MAX_SWEEP_VALUES];
+    int count;
+};
+
+struct benchConfig
+{
+    char transmitterPath[PATH_MAX];
+    char emulatorPath[PATH_MAX];
+    char receiverPath[PATH_MAX];
+    const char* address;
+    struct sweep delays;
+    struct sweep losses;
+    struct sweep windows;
+    struct sweep payloads;
+    int lines;
+    int repeats;
+    int timeoutS;
+    int keepRuns;
+};
+
+struct runResult
+{
+    int ok;                         // The receiver's file matches the transmitter's
+    double completionS;             // Transmitter launch to transmitter exit
+    double goodputKbps;
+    long retransmits;               // -1 when the transmitter did not report it
+    long dropped;                   // -1 when the emulator did not report it
+    double cpuS[COMPONENT_COUNT];   // User plus system time
+};
+
+struct pointResult
+{
+    int delayMs;
+    int lossPercent;
+    int window;
+    int payload;
+    int runs;
+    int ok;
+    double completionS;
+    double goodputKbps;
+    double retransmits;
+    double dropped;
+    double cpuS[COMPONENT_COUNT];
+};
+
+/*------------------------------------------------- Funtion Prototypes ------------------------------------------------------------------*/
+int parseSweep(const char* list, struct sweep* out);
+long writeMessageFile(const char* path, int lines, int payload);
+pid_t launch(const char* path, char* const argv[], const char* dir, const char* outputPath);
+int waitForPort(pid_t pid, const char* address, int port, int timeoutMs);
+int runOnce(struct benchConfig* cfg, int delayMs, int lossPercent, int window, int payload, struct runResult* result);
+long readSummaryValue(const char* path, const char* marker, const char* key);
+int filesEqual(const char* first, const char* second);
+void summarisePoint(struct runResult* runs, int count, struct pointResult* point);
+int writeResults(const char* path, struct pointResult* points, int count);
+int loadResults(const char* path, struct pointResult** points);
+int compareBaseline(struct pointResult* points, int count, struct pointResult* baseline, int baselineCount, double tolerancePercent);
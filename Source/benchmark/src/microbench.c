@@ -0,0 +1,735 @@
+/*----------------------------------------------------------------------------------------------------------------------------
+ * SOURCE FILE:    microbench.c
+ *
+ * PROGRAM:        microbench
+ *
+ * FUNCTIONS:      void runCase(const struct benchCase* bc, double minTimeS, struct caseResult* result)
+ *                 int writeCaseResults(const char* path, struct caseResult* results, int count)
+ *                 int loadCaseResults(const char* path, struct caseResult* results, int max)
+ *                 int compareCaseBaseline(struct caseResult* results, int count, struct caseResult* baseline, int baselineCount, double tolerancePercent)
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Follows the allocation-free packet helper API
+ *                 October 18th, 2026 - Reorder case buffers packet pool handles; packet pool alloc/free case
+ *                 October 18th, 2026 - Reorder case flushes into a receiver session
+ *                 October 18th, 2026 - Reorder case replaced by placement at the packet's offset
+ *                 October 18th, 2026 - Packet checksum cases, with the CPU's CRC instruction and with the table fallback
+ *                 October 18th, 2026 - Compression cases for a span of payloads; placement passes the worker
+ *                 October 18th, 2026 - Notes why the runner is not built on Google Benchmark
+ *                 October 18th, 2026 - Encode, decode and checksum cases cover the header and the data in use only
+ *                 October 18th, 2026 - Opens the log file in the scratch directory before the logging cases run
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * NOTES:
+ * Microbenchmarks of the per-packet paths shared by the transmitter and the receiver: packet construction, encoding
+ * to and decoding from a datagram, sealing and checking the checksum, the string helpers, logging, unACK tracking, receiver data placement, the packet pool and compressing payloads.
+ * The transmitter and receiver sources are compiled into this program so the cases call the real functions.
+ * Every case is repeated with a growing iteration count until it has run for the minimum time, then reported as
+ * ns/op and heap allocations/op; allocations are counted by interposing malloc, calloc and realloc.
+ * With -b the results are compared to a stored baseline and the program exits with status 2 when a case got slower
+ * than the tolerance or allocates more than it did.
+ *
+ * Cases run in a scratch directory so the log and data files they write are thrown away; console logging is sent
+ * to /dev/null while a case runs.
+ *
+ * The runner follows Google Benchmark's conventions (auto-scaled iterations, per-op reporting, a name filter) but is
+ * written in C rather than built on the library, which is C++: the transmitter and receiver sources compiled in
+ * here are C that does not build as C++ (case labels that jump past initialisations, implicit conversions from
+ * void*), and the review gate needs the baseline comparison and its exit status in the program itself rather than
+ * in the library's separate compare.py script. It builds with the C compiler alone: gcc -O2 -pthread microbench.c
+ *
+ * Usage: microbench [-f filter] [-t minTimeSeconds] [-o results.csv] [-b baseline.csv] [-p tolerancePercent]
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+
+#include "microbench.h"
+
+// The programs under test are compiled in; their entry points and the symbols they both define are renamed
+#define main transmitterMain
+#include "../../transmitter/src/transmitter.c"
+#undef main
+
+#define main receiverMain
+#define latencyDumpRequested receiverLatencyDumpRequested
+#define requestLatencyDump receiverRequestLatencyDump
+#include "../../receiver/src/receiver.c"
+#undef main
+#undef latencyDumpRequested
+#undef requestLatencyDump
+
+#define USAGE "Usage: %s [-f filter] [-t minTimeSeconds] [-o results.csv] [-b baseline.csv] [-p tolerancePercent]\n"
+
+/*------------------------------------------------- Allocation Counting -----------------------------------------------------------*/
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+
+static uint64_t allocationCount = 0;
+
+void* malloc(size_t size)
+{
+    allocationCount++;
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    allocationCount++;
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    allocationCount++;
+    return __libc_realloc(ptr, size);
+}
+
+/*------------------------------------------------- Shared Case State -------------------------------------------------------------*/
+static struct packet benchPacket;
+static char datagram[sizeof(struct packet)];
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       fillDataPacket
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static void fillDataPacket(struct packet* pkt, int seqNum)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Builds a DATA packet carrying a typical 64 byte message line
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static void fillDataPacket(struct packet* pkt, int seqNum)
+{
+    memset(pkt, 0, sizeof(*pkt));
+    pkt->packetType = DATA;
+    pkt->seqNum = seqNum;
+    memset(pkt->data, 'x', 63);
+    pkt->data[63] = '\n';
+    pkt->dataLen = 64;
+    pkt->offset = (int64_t)(seqNum - 1) * 64;
+    pkt->windowSize = BENCH_WINDOW_SIZE;
+    pkt->retransmit = false;
+}
+
+/*------------------------------------------------- Cases -------------------------------------------------------------------------*/
+static void benchMakeACK(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        benchPacket.seqNum = (int)i;
+        makePacket(&benchPacket, ACK);
+        DO_NOT_OPTIMIZE(benchPacket.ackNum);
+    }
+}
+
+static void benchMakeEOT(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        makePacket(&benchPacket, EOT);
+        DO_NOT_OPTIMIZE(benchPacket.packetType);
+    }
+}
+
+static void benchCopy(uint64_t iterations)
+{
+    fillDataPacket(&benchPacket, 1);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        struct packet copyPkt;
+        copyPacket(&copyPkt, &benchPacket);
+        DO_NOT_OPTIMIZE(&copyPkt);
+    }
+}
+
+// The wire format is the packed struct up to the end of the data in use, so encoding is the copy into the datagram
+// buffer handed to sendto
+static void benchEncode(uint64_t iterations)
+{
+    fillDataPacket(&benchPacket, 1);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        benchPacket.seqNum = (int)i;
+        memcpy(datagram, &benchPacket, (size_t)packetLength(&benchPacket));
+        DO_NOT_OPTIMIZE(datagram[0]);
+    }
+}
+
+static void benchDecode(uint64_t iterations)
+{
+    struct packet pkt;
+    fillDataPacket(&benchPacket, 1);
+    int length = packetLength(&benchPacket);
+    memcpy(datagram, &benchPacket, (size_t)length);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        memcpy(&pkt, datagram, (size_t)length);
+        if (pkt.packetType != DATA && pkt.packetType != ACK && pkt.packetType != EOT) abort();
+        DO_NOT_OPTIMIZE(&pkt);
+    }
+}
+
+static void benchSeal(uint64_t iterations)
+{
+    fillDataPacket(&benchPacket, 1);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        benchPacket.seqNum = (int)i;
+        sealPacket(&benchPacket);
+        DO_NOT_OPTIMIZE(benchPacket.checksum);
+    }
+}
+
+static void benchVerify(uint64_t iterations)
+{
+    fillDataPacket(&benchPacket, 1);
+    sealPacket(&benchPacket);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        if (!packetIntact(&benchPacket)) abort();
+        DO_NOT_OPTIMIZE(&benchPacket);
+    }
+}
+
+// What packetIntact costs on a CPU without a CRC32C instruction
+static void benchVerifySoftware(uint64_t iterations)
+{
+    fillDataPacket(&benchPacket, 1);
+    sealPacket(&benchPacket);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        uint32_t crc = crc32cSoftware(~0u, (const unsigned char*)&benchPacket, offsetof(struct packet, checksum));
+        crc = ~crc32cSoftware(crc, (const unsigned char*)benchPacket.data, (size_t)benchPacket.dataLen);
+        if (crc != benchPacket.checksum) abort();
+        DO_NOT_OPTIMIZE(crc);
+    }
+}
+
+static void benchTypeToString(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        const char* type = packetTypeToString((int)(i % 3), i & 1);
+        DO_NOT_OPTIMIZE(type);
+    }
+}
+
+static void benchRetransmitToString(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        const char* retransmit = retransmitToString(i & 1);
+        DO_NOT_OPTIMIZE(retransmit);
+    }
+}
+
+static void benchLogMessage(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        logToFile(INFO, NULL, "sent DATA packet (seqNum: %d)", (int)i);
+    }
+}
+
+static void benchLogPacket(uint64_t iterations)
+{
+    fillDataPacket(&benchPacket, 1);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        benchPacket.seqNum = (int)i;
+        logToFile(INFO, &benchPacket, "received DATA (seqNum: %d)", benchPacket.seqNum);
+    }
+}
+
+// Steady state of a full window: each op sends one packet and has the oldest one acknowledged
+static void benchUnACKSlide(uint64_t iterations)
+{
+    struct node* head = NULL;
+    for (int seq = 1; seq < BENCH_WINDOW_SIZE; seq++)
+    {
+        appendToUnACKs(&head, seq);
+    }
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        int seq = BENCH_WINDOW_SIZE + (int)i;
+        appendToUnACKs(&head, seq);
+        deleteFromUnACKs(&head, seq - BENCH_WINDOW_SIZE + 1);
+    }
+    freeUnACKs(&head);
+}
+
+static void benchUnACKCount(uint64_t iterations)
+{
+    struct node* head = NULL;
+    for (int seq = 1; seq <= BENCH_WINDOW_SIZE; seq++)
+    {
+        appendToUnACKs(&head, seq);
+    }
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        int count = getUnACKCount(head);
+        DO_NOT_OPTIMIZE(count);
+    }
+    freeUnACKs(&head);
+}
+
+// Worst case ordering: every window arrives reversed and each packet, received into a pool slot, is written at its
+// offset and its range recorded as in the receiver's DATA path. One op is one packet.
+static void benchPlace(uint64_t iterations)
+{
+    static struct packetPool pool;
+    static struct session session;
+    static struct receiverWorker worker;
+    struct packetPoolCache cache;
+
+    packetPoolInit(&pool, PACKET_POOL_CACHE_SIZE);
+    packetPoolCacheInit(&cache, &pool);
+    if ((session.fileFd = open("data/message.txt", O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0)
+    {
+        perror("could not open output file");
+        exit(1);
+    }
+    session.fileBase = 0;
+    intervalSetClear(&session.received);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        int64_t seq = (int64_t)(i - i % BENCH_WINDOW_SIZE) + BENCH_WINDOW_SIZE - (int64_t)(i % BENCH_WINDOW_SIZE);
+        packetHandle handle = packetPoolAlloc(&cache);
+        struct packet* pkt = packetPoolGet(&pool, handle);
+        fillDataPacket(pkt, (int)seq);
+        if (!intervalSetContains(&session.received, pkt->offset, pkt->offset + pkt->dataLen))
+        {
+            saveData(&worker, &session, pkt);
+            intervalSetAdd(&session.received, pkt->offset, pkt->offset + pkt->dataLen);
+        }
+        packetPoolFree(&cache, handle);
+    }
+    close(session.fileFd);
+    intervalSetDestroy(&session.received);
+    packetPoolDestroy(&pool);
+}
+
+// A packet taken from and returned to the pool through a per-thread cache, as every stage does per datagram
+static void benchPoolAllocFree(uint64_t iterations)
+{
+    static struct packetPool pool;
+    struct packetPoolCache cache;
+
+    packetPoolInit(&pool, PACKET_POOL_CACHE_SIZE * 2);
+    packetPoolCacheInit(&cache, &pool);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        packetHandle handle = packetPoolAlloc(&cache);
+        if (handle == PACKET_HANDLE_NONE)
+        {
+            fprintf(stderr, "packet pool exhausted\n");
+            exit(1);
+        }
+        DO_NOT_OPTIMIZE(packetPoolGet(&pool, handle));
+        packetPoolFree(&cache, handle);
+    }
+    packetPoolDestroy(&pool);
+}
+
+// Two payload lengths of repetitive records, the smallest span the transmitter compresses into one payload
+static int fillRecords(char* span)
+{
+    int length = 0;
+    for (int i = 0; length + 64 <= 2 * PAYLOAD_LEN; i++)
+    {
+        length += snprintf(span + length, 64, "{\"sensor\":\"temp-01\",\"value\":%d,\"ok\":true}\n", 18 + i % 7);
+    }
+    return length;
+}
+
+static void benchCompress(uint64_t iterations)
+{
+    static struct lz4Context ctx;
+    char span[2 * PAYLOAD_LEN];
+    char payload[PAYLOAD_LEN];
+    int length = fillRecords(span);
+
+    lz4Init(&ctx);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        int compressedLen = lz4Compress(&ctx, span, length, payload, PAYLOAD_LEN);
+        DO_NOT_OPTIMIZE(compressedLen);
+    }
+}
+
+static void benchDecompress(uint64_t iterations)
+{
+    static struct lz4Context ctx;
+    char span[2 * PAYLOAD_LEN];
+    char payload[PAYLOAD_LEN];
+    int length = fillRecords(span);
+    int compressedLen;
+
+    lz4Init(&ctx);
+    if ((compressedLen = lz4Compress(&ctx, span, length, payload, PAYLOAD_LEN)) == 0)
+    {
+        fprintf(stderr, "records did not compress into a payload\n");
+        exit(1);
+    }
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        int expandedLen = lz4Decompress(payload, compressedLen, span, (int)sizeof(span));
+        DO_NOT_OPTIMIZE(expandedLen);
+    }
+}
+
+static const struct benchCase cases[] =
+{
+    { "packet/makeACK", benchMakeACK },
+    { "packet/makeEOT", benchMakeEOT },
+    { "packet/copy", benchCopy },
+    { "packet/encode", benchEncode },
+    { "packet/decode", benchDecode },
+    { "packet/seal", benchSeal },
+    { "packet/verify", benchVerify },
+    { "packet/verifySoftware", benchVerifySoftware },
+    { "packet/typeToString", benchTypeToString },
+    { "packet/retransmitToString", benchRetransmitToString },
+    { "logger/message", benchLogMessage },
+    { "logger/packet", benchLogPacket },
+    { "unACKs/slideWindow", benchUnACKSlide },
+    { "unACKs/count", benchUnACKCount },
+    { "receiver/place", benchPlace },
+    { "pool/allocFree", benchPoolAllocFree },
+    { "lz4/compress", benchCompress },
+    { "lz4/decompress", benchDecompress },
+};
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       removeEntry
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static int removeEntry(const char* path, const struct stat* sb, int type, struct FTW* ftw)
+ *
+ * RETURNS:        int, 0 so the walk always continues
+ *
+ * NOTES:
+ * nftw callback deleting the scratch directory bottom-up
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static int removeEntry(const char* path, const struct stat* sb, int type, struct FTW* ftw)
+{
+    (void)sb;
+    (void)ftw;
+    if (type == FTW_DP) rmdir(path);
+    else unlink(path);
+    return 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       runCase
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void runCase(const struct benchCase* bc, double minTimeS, struct caseResult* result)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Grows the iteration count until one run of the case lasts at least minTimeS and reports that run
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void runCase(const struct benchCase* bc, double minTimeS, struct caseResult* result)
+{
+    uint64_t iterations = 1;
+
+    for (;;)
+    {
+        uint64_t allocations = allocationCount;
+        uint64_t start = monotonicUs();
+        bc->run(iterations);
+        double elapsedS = (monotonicUs() - start) / 1e6;
+        allocations = allocationCount - allocations;
+
+        if (elapsedS >= minTimeS || iterations >= MAX_ITERATIONS)
+        {
+            snprintf(result->name, sizeof(result->name), "%s", bc->name);
+            result->iterations = iterations;
+            result->nsPerOp = elapsedS * 1e9 / iterations;
+            result->allocsPerOp = (double)allocations / iterations;
+            return;
+        }
+
+        // Aim a little past the minimum so the next run is usually the last
+        double scale = elapsedS > 0 ? minTimeS * 1.4 / elapsedS : 100;
+        if (scale < 2) scale = 2;
+        if (scale > 100) scale = 100;
+        iterations = (uint64_t)(iterations * scale);
+        if (iterations > MAX_ITERATIONS) iterations = MAX_ITERATIONS;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       writeCaseResults
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int writeCaseResults(const char* path, struct caseResult* results, int count)
+ *
+ * RETURNS:        int, 0 on success and -1 on error
+ *
+ * NOTES:
+ * Writes one CSV row per case; this is also the baseline format read by loadCaseResults
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int writeCaseResults(const char* path, struct caseResult* results, int count)
+{
+    FILE* fp = fopen(path, "w");
+    if (fp == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    fprintf(fp, "%s\n", MICROBENCH_RESULTS_HEADER);
+    for (int i = 0; i < count; i++)
+    {
+        fprintf(fp, "%s,%llu,%.3f,%.4f\n", results[i].name, (unsigned long long)results[i].iterations, results[i].nsPerOp,
+            results[i].allocsPerOp);
+    }
+    if (fclose(fp) != 0)
+    {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       loadCaseResults
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int loadCaseResults(const char* path, struct caseResult* results, int max)
+ *
+ * RETURNS:        int, number of rows or -1 on error
+ *
+ * NOTES:
+ * Reads a results file written by writeCaseResults
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int loadCaseResults(const char* path, struct caseResult* results, int max)
+{
+    char line[256];
+    int count = 0;
+    FILE* fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    if (fgets(line, sizeof(line), fp) == NULL || strncmp(line, MICROBENCH_RESULTS_HEADER, strlen(MICROBENCH_RESULTS_HEADER)) != 0)
+    {
+        fprintf(stderr, "%s is not a microbench results file\n", path);
+        fclose(fp);
+        return -1;
+    }
+
+    while (count < max && fgets(line, sizeof(line), fp) != NULL)
+    {
+        unsigned long long iterations;
+        struct caseResult* r = &results[count];
+        if (sscanf(line, "%63[^,],%llu,%lf,%lf", r->name, &iterations, &r->nsPerOp, &r->allocsPerOp) == 4)
+        {
+            r->iterations = iterations;
+            count++;
+        }
+    }
+    fclose(fp);
+    return count;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       compareCaseBaseline
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int compareCaseBaseline(struct caseResult* results, int count, struct caseResult* baseline, int baselineCount,
+ *                                         double tolerancePercent)
+ *
+ * RETURNS:        int, number of regressed cases
+ *
+ * NOTES:
+ * Cases are matched by name. Time regresses beyond the tolerance; allocation counts are deterministic, so any
+ * increase regresses.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int compareCaseBaseline(struct caseResult* results, int count, struct caseResult* baseline, int baselineCount, double tolerancePercent)
+{
+    int regressions = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        struct caseResult* r = &results[i];
+        struct caseResult* b = NULL;
+        int regressed = 0;
+
+        for (int j = 0; j < baselineCount && b == NULL; j++)
+        {
+            if (strcmp(baseline[j].name, r->name) == 0) b = &baseline[j];
+        }
+
+        printf("%-28s ", r->name);
+        if (b == NULL)
+        {
+            printf("not in baseline\n");
+            continue;
+        }
+
+        printf("%10.1f -> %10.1f ns/op (%+6.1f%%) %8.3f -> %8.3f allocs/op ", b->nsPerOp, r->nsPerOp,
+            b->nsPerOp > 0 ? (r->nsPerOp - b->nsPerOp) / b->nsPerOp * 100 : 0.0, b->allocsPerOp, r->allocsPerOp);
+        if (r->nsPerOp > b->nsPerOp * (1 + tolerancePercent / 100))
+        {
+            printf("SLOWER ");
+            regressed = 1;
+        }
+        if (r->allocsPerOp > b->allocsPerOp + 0.0005)
+        {
+            printf("MORE ALLOCATIONS ");
+            regressed = 1;
+        }
+        printf("%s\n", regressed ? "" : "ok");
+        regressions += regressed;
+    }
+    return regressions;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       main
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int main(int argc, char **argv)
+ *
+ * RETURNS:        int, 0 on success, 1 on error and 2 when the baseline comparison found a regression
+ *
+ * NOTES:
+ * Runs the cases matching the filter, prints a table and optionally writes and compares results
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int main(int argc, char **argv)
+{
+    static struct caseResult results[MAX_CASES], baseline[MAX_CASES];
+    const char* filter = NULL;
+    const char* resultsPath = NULL;
+    const char* baselinePath = NULL;
+    double minTimeS = DEFAULT_MIN_TIME_S;
+    double tolerancePercent = DEFAULT_TOLERANCE_PERCENT;
+    char scratchDir[] = "/tmp/microbench.XXXXXX";
+    char originalDir[PATH_MAX];
+    int resultCount = 0, opt, consoleFd, nullFd;
+
+    while ((opt = getopt(argc, argv, "f:t:o:b:p:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'f': filter = optarg; break;
+            case 't': minTimeS = atof(optarg); break;
+            case 'o': resultsPath = optarg; break;
+            case 'b': baselinePath = optarg; break;
+            case 'p': tolerancePercent = atof(optarg); break;
+            default:
+                fprintf(stderr, USAGE, argv[0]);
+                exit(1);
+        }
+    }
+
+    // Result and baseline paths stay relative to where the program was started
+    if (getcwd(originalDir, sizeof(originalDir)) == NULL || mkdtemp(scratchDir) == NULL || chdir(scratchDir) == -1
+        || mkdir("data", 0755) == -1)
+    {
+        perror("could not set up a scratch directory");
+        exit(1);
+    }
+    openLog();
+    consoleFd = dup(STDOUT_FILENO);
+    nullFd = open("/dev/null", O_WRONLY);
+
+    printf("%-28s %14s %14s %14s\n", "Case", "Time (ns/op)", "Allocs/op", "Iterations");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        if (filter != NULL && strstr(cases[i].name, filter) == NULL)
+        {
+            continue;
+        }
+
+        struct caseResult* r = &results[resultCount++];
+        fflush(stdout);
+        dup2(nullFd, STDOUT_FILENO);
+        runCase(&cases[i], minTimeS, r);
+        fflush(stdout);
+        dup2(consoleFd, STDOUT_FILENO);
+        printf("%-28s %14.1f %14.3f %14llu\n", r->name, r->nsPerOp, r->allocsPerOp, (unsigned long long)r->iterations);
+    }
+
+    if (chdir(originalDir) == -1)
+    {
+        perror(originalDir);
+    }
+    nftw(scratchDir, removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+
+    if (resultsPath != NULL && writeCaseResults(resultsPath, results, resultCount) == -1)
+    {
+        exit(1);
+    }
+    if (baselinePath != NULL)
+    {
+        int baselineCount = loadCaseResults(baselinePath, baseline, MAX_CASES);
+        if (baselineCount == -1)
+        {
+            exit(1);
+        }
+        printf("\n");
+        int regressions = compareCaseBaseline(results, resultCount, baseline, baselineCount, tolerancePercent);
+        printf("%d of %d cases regressed beyond %.1f%%\n", regressions, resultCount, tolerancePercent);
+        return regressions ? 2 : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * HEADER FILE:              microbench.h
+ *
+ * FUNCTION PROTOTYPES:      void runCase(const struct benchCase* bc, double minTimeS, struct caseResult* result)
+ *                           int writeCaseResults(const char* path, struct caseResult* results, int count)
+ *                           int loadCaseResults(const char* path, struct caseResult* results, int max)
+ *                           int compareCaseBaseline(struct caseResult* results, int count, struct caseResult* baseline, int baselineCount, double tolerancePercent)
+ *
+ * DATE:                     October 18th, 2026
+ *
+ * REVISIONS:                N/A
+ *
+ * DESIGNER:                 Derek Wong
+ *
+ * PROGRAMMER:               Derek Wong
+ *
+ * NOTES:
+ * Header file containing constants, structs and function prototypes for microbench.c
+ * -----------------------------------------------------------------------------------------------------------------------------------*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <limits.h>
+#include <getopt.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/*------------------------------------------------- Symbolic Constants ------------------------------------------------------------------*/
+#define MAX_CASES                   64
+#define MAX_CASE_NAME_LEN           64
+#define DEFAULT_MIN_TIME_S          0.2         // Each case is repeated until it has run at least this long
+#define MAX_ITERATIONS              1000000000ULL
+#define DEFAULT_TOLERANCE_PERCENT   10.0
+#define BENCH_WINDOW_SIZE           20          // Window used by the unACK and placement cases, MAX_WINDOW_SIZE of the protocol
+
+/*------------------------------------------------- Default Strings ---------------------------------------------------------------------*/
+#define MICROBENCH_RESULTS_HEADER   "name,iterations,ns_per_op,allocs_per_op"
+
+/*------------------------------------------------- Macros ------------------------------------------------------------------------------*/
+// Keeps the compiler from discarding work whose result is otherwise unused
+#define DO_NOT_OPTIMIZE(value)      __asm__ volatile("" : : "g"(value) : "memory")
+
+/*------------------------------------------------- Structs -----------------------------------------------------------------------------*/
+struct benchCase
+{
+    const char* name;
+    void (*run)(uint64_t iterations);   // Performs the operation iterations times
+};
+
+struct caseResult
+{
+    char name[MAX_CASE_NAME_LEN];
+    uint64_t iterations;
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+/*------------------------------------------------- Funtion Prototypes ------------------------------------------------------------------*/
+void runCase(const struct benchCase* bc, double minTimeS, struct caseResult* result);
+int writeCaseResults(const char* path, struct caseResult* results, int count);
+int loadCaseResults(const char* path, struct caseResult* results, int max);
+int compareCaseBaseline(struct caseResult* results, int count, struct caseResult* baseline, int baselineCount, double tolerancePercent);
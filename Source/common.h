@@ -2,10 +2,12 @@
  * HEADER FILE:              common.h
  *
  * FUNCTIONS:                long delay(struct timeval t1, struct timeval t2)
+ *                           uint64_t monotonicUs(void)
  *
  * DATE:                     December 3rd, 2020
  *
- * REVISIONS:                N/A
+ * REVISIONS:                October 18th, 2026 - Added monotonicUs for latency measurements
+ *                           October 18th, 2026 - Maximum number of streams of one transfer
  *
  * DESIGNER:                 Derek Wong
  *
@@ -18,7 +20,9 @@
 #ifndef COMMON_H
 #define COMMON_H
 
+#include <stdint.h>
 #include <sys/time.h>
+#include <time.h>
 
 /*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
 #define NETWORK_EMULATOR_PORT       50001
@@ -28,6 +32,7 @@
 #define INITIAL_WINDOW_SIZE         1
 #define MAX_WINDOW_SIZE             20
 #define INITIAL_SEQ_NUM             1
+#define MAX_STREAMS                 8
 
 /*------------------------------------------------- Default Strings ------------------------------------------------------------------*/
 #define TRANSMITTER_IP                  "192.168.1.72"
@@ -61,4 +66,30 @@ long delay(struct timeval t1, struct timeval t2)
     return(d);
 }
 
+/*---------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       monotonicUs
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      uint64_t monotonicUs(void)
+ *
+ * RETURNS:        uint64_t
+ *
+ * NOTES:
+ * microseconds on a clock that is not affected by wall clock adjustments, for measuring intervals
+ * -------------------------------------------------------------------------------------------------------------------------------------*/
+uint64_t monotonicUs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
 #endif
@@ -0,0 +1,350 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * HEADER FILE:              crc32c.h
+ *
+ * FUNCTIONS:                uint32_t crc32cUpdate(uint32_t crc, const void* data, size_t length)
+ *                           uint32_t crc32cCombine(uint32_t crc1, uint32_t crc2, int64_t length2)
+ *                           bool crc32cHardware(void)
+ *                           uint32_t crc32cSoftware(uint32_t crc, const unsigned char* data, size_t length)
+ *                           uint32_t crc32cX86(uint32_t crc, const unsigned char* data, size_t length)
+ *                           uint32_t crc32cArm(uint32_t crc, const unsigned char* data, size_t length)
+ *                           uint32_t crc32cMatrixTimes(const uint32_t* matrix, uint32_t vector)
+ *
+ * DATE:                     October 18th, 2026
+ *
+ * REVISIONS:                N/A
+ *
+ * DESIGNER:                 Derek Wong
+ *
+ * PROGRAMMER:               Derek Wong
+ *
+ * NOTES:
+ * Header file containing the CRC32C (Castagnoli) checksum used for packets and whole files.
+ * crc32cUpdate follows zlib's crc32 convention: start from 0 and pass the previous result back in to checksum data
+ * arriving in pieces. It uses the CPU's CRC32 instruction where there is one, SSE4.2 on x86-64 or the CRC extension
+ * on AArch64, checked once at run time so the binaries need no special flags; elsewhere it falls back to a
+ * slicing-by-8 table built on first use. crc32cCombine joins the checksums of two adjacent pieces without their
+ * data, so ranges checksummed separately, by the streams of a transfer, give the checksum of the whole.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+    #define CRC32C_X86
+#elif defined(__aarch64__) && defined(__GNUC__) && defined(__linux__)
+    #define CRC32C_ARM
+    #include <arm_acle.h>
+    #include <sys/auxv.h>
+    #include <asm/hwcap.h>
+#endif
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define CRC32C_POLYNOMIAL   0x82F63B78u         // Castagnoli polynomial, bit reversed
+
+/*------------------------------------------------ Globals --------------------------------------------------------------------------*/
+static uint32_t crc32cTables[8][256];
+static volatile int crc32cTablesBuilt = 0;
+static volatile int crc32cHardwareState = -1;   // -1 until the CPU has been checked
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       crc32cHardware
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool crc32cHardware(void)
+ *
+ * RETURNS:        bool, true if the CPU has a CRC32C instruction
+ *
+ * NOTES:
+ * The answer is cached; threads racing on the first call store the same value
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline bool crc32cHardware(void)
+{
+    int state = crc32cHardwareState;
+
+    if (state < 0)
+    {
+#if defined(CRC32C_X86)
+        state = __builtin_cpu_supports("sse4.2") ? 1 : 0;
+#elif defined(CRC32C_ARM)
+        state = (getauxval(AT_HWCAP) & HWCAP_CRC32) ? 1 : 0;
+#else
+        state = 0;
+#endif
+        crc32cHardwareState = state;
+    }
+    return state == 1;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       crc32cSoftware
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      uint32_t crc32cSoftware(uint32_t crc, const unsigned char* data, size_t length)
+ *
+ * RETURNS:        uint32_t, the updated register, not inverted
+ *
+ * NOTES:
+ * Slicing-by-8: eight table lookups per eight bytes. The tables are built on first use; threads racing to build
+ * them write the same values.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline uint32_t crc32cSoftware(uint32_t crc, const unsigned char* data, size_t length)
+{
+    if (!__atomic_load_n(&crc32cTablesBuilt, __ATOMIC_ACQUIRE))
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                value = (value & 1) ? (value >> 1) ^ CRC32C_POLYNOMIAL : value >> 1;
+            }
+            crc32cTables[0][i] = value;
+        }
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            for (int slice = 1; slice < 8; slice++)
+            {
+                uint32_t previous = crc32cTables[slice - 1][i];
+                crc32cTables[slice][i] = (previous >> 8) ^ crc32cTables[0][previous & 0xFF];
+            }
+        }
+        __atomic_store_n(&crc32cTablesBuilt, 1, __ATOMIC_RELEASE);
+    }
+
+    while (length >= 8)
+    {
+        uint32_t low, high;
+        memcpy(&low, data, 4);
+        memcpy(&high, data + 4, 4);
+        low ^= crc;
+        crc = crc32cTables[7][low & 0xFF] ^ crc32cTables[6][(low >> 8) & 0xFF]
+            ^ crc32cTables[5][(low >> 16) & 0xFF] ^ crc32cTables[4][low >> 24]
+            ^ crc32cTables[3][high & 0xFF] ^ crc32cTables[2][(high >> 8) & 0xFF]
+            ^ crc32cTables[1][(high >> 16) & 0xFF] ^ crc32cTables[0][high >> 24];
+        data += 8;
+        length -= 8;
+    }
+    while (length-- > 0)
+    {
+        crc = (crc >> 8) ^ crc32cTables[0][(crc ^ *data++) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(CRC32C_X86)
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       crc32cX86
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      uint32_t crc32cX86(uint32_t crc, const unsigned char* data, size_t length)
+ *
+ * RETURNS:        uint32_t, the updated register, not inverted
+ *
+ * NOTES:
+ * SSE4.2 crc32 eight bytes at a time; only called once crc32cHardware has said the instruction is there
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+__attribute__((target("sse4.2")))
+static inline uint32_t crc32cX86(uint32_t crc, const unsigned char* data, size_t length)
+{
+    uint64_t crc64 = crc;
+
+    while (length >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, data, 8);
+        crc64 = __builtin_ia32_crc32di(crc64, word);
+        data += 8;
+        length -= 8;
+    }
+    crc = (uint32_t)crc64;
+    while (length-- > 0)
+    {
+        crc = __builtin_ia32_crc32qi(crc, *data++);
+    }
+    return crc;
+}
+#endif
+
+#if defined(CRC32C_ARM)
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       crc32cArm
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      uint32_t crc32cArm(uint32_t crc, const unsigned char* data, size_t length)
+ *
+ * RETURNS:        uint32_t, the updated register, not inverted
+ *
+ * NOTES:
+ * ARMv8 crc32c eight bytes at a time; only called once crc32cHardware has said the instruction is there
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+__attribute__((target("+crc")))
+static inline uint32_t crc32cArm(uint32_t crc, const unsigned char* data, size_t length)
+{
+    while (length >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, data, 8);
+        crc = __crc32cd(crc, word);
+        data += 8;
+        length -= 8;
+    }
+    while (length-- > 0)
+    {
+        crc = __crc32cb(crc, *data++);
+    }
+    return crc;
+}
+#endif
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       crc32cUpdate
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      uint32_t crc32cUpdate(uint32_t crc, const void* data, size_t length)
+ *
+ * RETURNS:        uint32_t, the checksum of everything passed so far
+ *
+ * NOTES:
+ * crc is 0 for the first piece and the previous result for the ones after it
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline uint32_t crc32cUpdate(uint32_t crc, const void* data, size_t length)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+
+    crc = ~crc;
+#if defined(CRC32C_X86)
+    if (crc32cHardware())
+        return ~crc32cX86(crc, bytes, length);
+#elif defined(CRC32C_ARM)
+    if (crc32cHardware())
+        return ~crc32cArm(crc, bytes, length);
+#endif
+    return ~crc32cSoftware(crc, bytes, length);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       crc32cMatrixTimes
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      uint32_t crc32cMatrixTimes(const uint32_t* matrix, uint32_t vector)
+ *
+ * RETURNS:        uint32_t, matrix times vector over GF(2)
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline uint32_t crc32cMatrixTimes(const uint32_t* matrix, uint32_t vector)
+{
+    uint32_t sum = 0;
+
+    for (; vector != 0; vector >>= 1, matrix++)
+    {
+        if (vector & 1)
+            sum ^= *matrix;
+    }
+    return sum;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       crc32cCombine
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      uint32_t crc32cCombine(uint32_t crc1, uint32_t crc2, int64_t length2)
+ *
+ * RETURNS:        uint32_t, the checksum of a piece with checksum crc1 followed by one of length2 bytes with checksum crc2
+ *
+ * NOTES:
+ * zlib's method: crc1 is run through length2 zero bytes by squaring the one-zero-bit operator, O(log length2)
+ * 32x32 bit matrix products, and the result added to crc2
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline uint32_t crc32cCombine(uint32_t crc1, uint32_t crc2, int64_t length2)
+{
+    uint32_t odd[32], even[32];     // Operators for an odd and an even power of two zero bits
+
+    if (length2 <= 0)
+        return crc1;
+
+    // Operator for one zero bit
+    odd[0] = CRC32C_POLYNOMIAL;
+    for (int n = 1; n < 32; n++)
+        odd[n] = 1u << (n - 1);
+
+    // Two zero bits, then four; the loop starts from one byte
+    for (int n = 0; n < 32; n++)
+        even[n] = crc32cMatrixTimes(odd, odd[n]);
+    for (int n = 0; n < 32; n++)
+        odd[n] = crc32cMatrixTimes(even, even[n]);
+
+    for (;;)
+    {
+        for (int n = 0; n < 32; n++)
+            even[n] = crc32cMatrixTimes(odd, odd[n]);
+        if (length2 & 1)
+            crc1 = crc32cMatrixTimes(even, crc1);
+        length2 >>= 1;
+        if (length2 == 0)
+            break;
+
+        for (int n = 0; n < 32; n++)
+            odd[n] = crc32cMatrixTimes(even, even[n]);
+        if (length2 & 1)
+            crc1 = crc32cMatrixTimes(odd, crc1);
+        length2 >>= 1;
+        if (length2 == 0)
+            break;
+    }
+    return crc1 ^ crc2;
+}
+
+#endif
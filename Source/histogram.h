@@ -0,0 +1,366 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * HEADER FILE:              histogram.h
+ *
+ * FUNCTIONS:                void histogramInit(struct histogram* h)
+ *                           int histogramBucketIndex(uint64_t value)
+ *                           uint64_t histogramBucketLowest(int index)
+ *                           uint64_t histogramBucketHighest(int index)
+ *                           void histogramRecord(struct histogram* h, uint64_t value)
+ *                           void histogramMerge(struct histogram* dst, const struct histogram* src)
+ *                           uint64_t histogramValueAtPercentile(const struct histogram* h, double percentile)
+ *                           double histogramMean(const struct histogram* h)
+ *                           int histogramFormat(const struct histogram* h, char* buffer, size_t len, const char* unit)
+ *
+ * DATE:                     October 18th, 2026
+ *
+ * REVISIONS:                N/A
+ *
+ * DESIGNER:                 Derek Wong
+ *
+ * PROGRAMMER:               Derek Wong
+ *
+ * NOTES:
+ * Header file containing a fixed-size, HDR-style latency histogram shared by the transmitter, receiver and network emulator.
+ * Values below HISTOGRAM_LINEAR_LIMIT get a bucket each; above that every power of two is split into
+ * HISTOGRAM_SUB_BUCKETS buckets, so any recorded value is reported to within 1/HISTOGRAM_SUB_BUCKETS of itself.
+ * Recording is a bucket index computation and a few relaxed atomic updates: O(1), lock-free and allocation free,
+ * so any number of threads may record into one histogram while another reads it.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define HISTOGRAM_SUB_BUCKET_BITS   6                                   // 64 buckets per power of two, about 1.6% precision
+#define HISTOGRAM_SUB_BUCKETS       (1 << HISTOGRAM_SUB_BUCKET_BITS)
+#define HISTOGRAM_LINEAR_LIMIT      (2 * HISTOGRAM_SUB_BUCKETS)         // Values below this are recorded exactly
+#define HISTOGRAM_MAX_BITS          40                                  // Values from 2^40 up share the last bucket
+#define HISTOGRAM_BUCKETS           (HISTOGRAM_LINEAR_LIMIT + (HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BUCKET_BITS - 1) * HISTOGRAM_SUB_BUCKETS)
+
+/*------------------------------------------------ Structs --------------------------------------------------------------------------*/
+struct histogram
+{
+    uint64_t counts[HISTOGRAM_BUCKETS];
+    uint64_t totalCount;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+};
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       histogramInit
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void histogramInit(struct histogram* h)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Empties a histogram; not safe against concurrent recording
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void histogramInit(struct histogram* h)
+{
+    memset(h, 0, sizeof(struct histogram));
+    h->min = UINT64_MAX;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       histogramBucketIndex
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int histogramBucketIndex(uint64_t value)
+ *
+ * RETURNS:        int
+ *
+ * NOTES:
+ * Maps a value to its bucket: the exponent picks a group of HISTOGRAM_SUB_BUCKETS and
+ * the bits just below the leading one pick the bucket within it
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline int histogramBucketIndex(uint64_t value)
+{
+    if (value < HISTOGRAM_LINEAR_LIMIT)
+    {
+        return (int)value;
+    }
+
+    int exponent = 63 - __builtin_clzll(value);
+    if (exponent >= HISTOGRAM_MAX_BITS)
+    {
+        return HISTOGRAM_BUCKETS - 1;
+    }
+    int shift = exponent - HISTOGRAM_SUB_BUCKET_BITS;
+    return HISTOGRAM_LINEAR_LIMIT + (exponent - HISTOGRAM_SUB_BUCKET_BITS - 1) * HISTOGRAM_SUB_BUCKETS
+        + (int)((value >> shift) & (HISTOGRAM_SUB_BUCKETS - 1));
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       histogramBucketLowest
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      uint64_t histogramBucketLowest(int index)
+ *
+ * RETURNS:        uint64_t
+ *
+ * NOTES:
+ * Smallest value that is recorded into a bucket
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline uint64_t histogramBucketLowest(int index)
+{
+    if (index < HISTOGRAM_LINEAR_LIMIT)
+    {
+        return (uint64_t)index;
+    }
+
+    int group = (index - HISTOGRAM_LINEAR_LIMIT) / HISTOGRAM_SUB_BUCKETS;
+    int subBucket = (index - HISTOGRAM_LINEAR_LIMIT) % HISTOGRAM_SUB_BUCKETS;
+    return (uint64_t)(HISTOGRAM_SUB_BUCKETS + subBucket) << (group + 1);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       histogramBucketHighest
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      uint64_t histogramBucketHighest(int index)
+ *
+ * RETURNS:        uint64_t
+ *
+ * NOTES:
+ * Largest value that is recorded into a bucket; the last bucket is open ended
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline uint64_t histogramBucketHighest(int index)
+{
+    if (index < HISTOGRAM_LINEAR_LIMIT)
+    {
+        return (uint64_t)index;
+    }
+    if (index == HISTOGRAM_BUCKETS - 1)
+    {
+        return UINT64_MAX;
+    }
+    return histogramBucketLowest(index + 1) - 1;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       histogramRecord
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void histogramRecord(struct histogram* h, uint64_t value)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Records one value; several threads may record into the same histogram at once
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void histogramRecord(struct histogram* h, uint64_t value)
+{
+    uint64_t seen;
+
+    __atomic_fetch_add(&h->counts[histogramBucketIndex(value)], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->sum, value, __ATOMIC_RELAXED);
+
+    seen = __atomic_load_n(&h->min, __ATOMIC_RELAXED);
+    while (value < seen && !__atomic_compare_exchange_n(&h->min, &seen, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+    seen = __atomic_load_n(&h->max, __ATOMIC_RELAXED);
+    while (value > seen && !__atomic_compare_exchange_n(&h->max, &seen, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+
+    // Published last so a reader never sees more values than the buckets hold
+    __atomic_fetch_add(&h->totalCount, 1, __ATOMIC_RELEASE);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       histogramMerge
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void histogramMerge(struct histogram* dst, const struct histogram* src)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Adds src to dst; src may still be recording, dst must be private to the caller.
+ * The total is derived from the buckets read so that percentiles of dst are always consistent.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void histogramMerge(struct histogram* dst, const struct histogram* src)
+{
+    uint64_t min, max;
+
+    __atomic_load_n(&src->totalCount, __ATOMIC_ACQUIRE);
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        uint64_t count = __atomic_load_n(&src->counts[i], __ATOMIC_RELAXED);
+        dst->counts[i] += count;
+        dst->totalCount += count;
+    }
+    dst->sum += __atomic_load_n(&src->sum, __ATOMIC_RELAXED);
+
+    min = __atomic_load_n(&src->min, __ATOMIC_RELAXED);
+    max = __atomic_load_n(&src->max, __ATOMIC_RELAXED);
+    if (min < dst->min) dst->min = min;
+    if (max > dst->max) dst->max = max;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       histogramValueAtPercentile
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      uint64_t histogramValueAtPercentile(const struct histogram* h, double percentile)
+ *
+ * RETURNS:        uint64_t
+ *
+ * NOTES:
+ * Smallest bucket bound that at least percentile (0 - 100) of the values are at or below, clamped to the
+ * recorded min and max; 0 for an empty histogram
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline uint64_t histogramValueAtPercentile(const struct histogram* h, double percentile)
+{
+    uint64_t total = 0, target, seen = 0;
+    uint64_t min = __atomic_load_n(&h->min, __ATOMIC_RELAXED);
+    uint64_t max = __atomic_load_n(&h->max, __ATOMIC_RELAXED);
+
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        total += __atomic_load_n(&h->counts[i], __ATOMIC_RELAXED);
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    if (percentile < 0) percentile = 0;
+    if (percentile > 100) percentile = 100;
+    target = (uint64_t)(percentile / 100.0 * (double)total + 0.5);
+    if (target == 0) target = 1;
+
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        seen += __atomic_load_n(&h->counts[i], __ATOMIC_RELAXED);
+        if (seen >= target)
+        {
+            uint64_t value = histogramBucketHighest(i);
+            if (value > max) value = max;
+            if (value < min) value = min;
+            return value;
+        }
+    }
+    return max;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       histogramMean
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      double histogramMean(const struct histogram* h)
+ *
+ * RETURNS:        double
+ *
+ * NOTES:
+ * Exact mean of the recorded values; 0 for an empty histogram
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline double histogramMean(const struct histogram* h)
+{
+    uint64_t count = __atomic_load_n(&h->totalCount, __ATOMIC_ACQUIRE);
+    return (count == 0) ? 0 : (double)__atomic_load_n(&h->sum, __ATOMIC_RELAXED) / (double)count;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       histogramFormat
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int histogramFormat(const struct histogram* h, char* buffer, size_t len, const char* unit)
+ *
+ * RETURNS:        int, the snprintf result
+ *
+ * NOTES:
+ * Writes a one-line summary (count, min, p50, p90, p99, p99.9, max, mean) into buffer without allocating
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline int histogramFormat(const struct histogram* h, char* buffer, size_t len, const char* unit)
+{
+    uint64_t count = __atomic_load_n(&h->totalCount, __ATOMIC_ACQUIRE);
+
+    if (count == 0)
+    {
+        return snprintf(buffer, len, "count=0");
+    }
+    return snprintf(buffer, len, "count=%llu min=%llu%s p50=%llu%s p90=%llu%s p99=%llu%s p99.9=%llu%s max=%llu%s mean=%.1f%s",
+        (unsigned long long)count,
+        (unsigned long long)__atomic_load_n(&h->min, __ATOMIC_RELAXED), unit,
+        (unsigned long long)histogramValueAtPercentile(h, 50), unit,
+        (unsigned long long)histogramValueAtPercentile(h, 90), unit,
+        (unsigned long long)histogramValueAtPercentile(h, 99), unit,
+        (unsigned long long)histogramValueAtPercentile(h, 99.9), unit,
+        (unsigned long long)__atomic_load_n(&h->max, __ATOMIC_RELAXED), unit,
+        histogramMean(h), unit);
+}
+
+#endif
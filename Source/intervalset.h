@@ -0,0 +1,265 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * HEADER FILE:              intervalset.h
+ *
+ * FUNCTIONS:                void intervalSetInit(struct intervalSet* set)
+ *                           void intervalSetDestroy(struct intervalSet* set)
+ *                           void intervalSetClear(struct intervalSet* set)
+ *                           bool intervalSetContains(const struct intervalSet* set, int64_t start, int64_t end)
+ *                           bool intervalSetAdd(struct intervalSet* set, int64_t start, int64_t end)
+ *                           int64_t intervalSetPrefix(const struct intervalSet* set)
+ *
+ * DATE:                     October 18th, 2026
+ *
+ * REVISIONS:                N/A
+ *
+ * DESIGNER:                 Derek Wong
+ *
+ * PROGRAMMER:               Derek Wong
+ *
+ * NOTES:
+ * Header file containing a set of half-open byte ranges [start, end), kept as a sorted array of disjoint intervals.
+ * Adding a range merges it with every interval it overlaps or touches, so the array only holds one interval per gap
+ * still open: data arriving in order, on any number of streams, keeps it at a handful of entries. Lookups are a
+ * binary search; the array grows by doubling and is never shrunk, so a set that has seen its worst case does not
+ * allocate again.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef INTERVALSET_H
+#define INTERVALSET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define INTERVAL_SET_INITIAL_CAPACITY   16
+
+/*------------------------------------------------ Structs --------------------------------------------------------------------------*/
+struct interval
+{
+    int64_t start;
+    int64_t end;                    // One past the last byte
+};
+
+struct intervalSet
+{
+    struct interval* intervals;     // Sorted by start, disjoint and not touching
+    int count;
+    int capacity;
+};
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       intervalSetInit
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void intervalSetInit(struct intervalSet* set)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Prepares an empty set; nothing is allocated until the first range is added
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void intervalSetInit(struct intervalSet* set)
+{
+    set->intervals = NULL;
+    set->count = 0;
+    set->capacity = 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       intervalSetDestroy
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void intervalSetDestroy(struct intervalSet* set)
+ *
+ * RETURNS:        void
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void intervalSetDestroy(struct intervalSet* set)
+{
+    free(set->intervals);
+    intervalSetInit(set);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       intervalSetClear
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void intervalSetClear(struct intervalSet* set)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Empties the set but keeps its array for reuse
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void intervalSetClear(struct intervalSet* set)
+{
+    set->count = 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       intervalSetFirstEndingAfter
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int intervalSetFirstEndingAfter(const struct intervalSet* set, int64_t position)
+ *
+ * RETURNS:        int, index of the first interval with end >= position, or count if there is none
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline int intervalSetFirstEndingAfter(const struct intervalSet* set, int64_t position)
+{
+    int low = 0, high = set->count;
+
+    while (low < high)
+    {
+        int middle = (low + high) / 2;
+        if (set->intervals[middle].end < position)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       intervalSetContains
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool intervalSetContains(const struct intervalSet* set, int64_t start, int64_t end)
+ *
+ * RETURNS:        bool, true if every byte of [start, end) is in the set
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline bool intervalSetContains(const struct intervalSet* set, int64_t start, int64_t end)
+{
+    int i = intervalSetFirstEndingAfter(set, end);
+
+    return i < set->count && set->intervals[i].start <= start;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       intervalSetAdd
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool intervalSetAdd(struct intervalSet* set, int64_t start, int64_t end)
+ *
+ * RETURNS:        bool, false if the array could not grow; the set is left as it was
+ *
+ * NOTES:
+ * Adds [start, end), merging it with the intervals it overlaps or touches. An empty range is ignored.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline bool intervalSetAdd(struct intervalSet* set, int64_t start, int64_t end)
+{
+    if (end <= start)
+    {
+        return true;
+    }
+
+    // [first, last) are the intervals that overlap or touch the new range
+    int first = intervalSetFirstEndingAfter(set, start);
+    int last = first;
+    while (last < set->count && set->intervals[last].start <= end)
+    {
+        last++;
+    }
+
+    if (first == last)
+    {
+        if (set->count == set->capacity)
+        {
+            int capacity = (set->capacity == 0) ? INTERVAL_SET_INITIAL_CAPACITY : set->capacity * 2;
+            struct interval* intervals = (struct interval*)realloc(set->intervals, sizeof(struct interval) * (size_t)capacity);
+            if (intervals == NULL)
+            {
+                return false;
+            }
+            set->intervals = intervals;
+            set->capacity = capacity;
+        }
+        memmove(&set->intervals[first + 1], &set->intervals[first], sizeof(struct interval) * (size_t)(set->count - first));
+        set->intervals[first].start = start;
+        set->intervals[first].end = end;
+        set->count++;
+        return true;
+    }
+
+    if (set->intervals[first].start < start)
+    {
+        start = set->intervals[first].start;
+    }
+    if (set->intervals[last - 1].end > end)
+    {
+        end = set->intervals[last - 1].end;
+    }
+    set->intervals[first].start = start;
+    set->intervals[first].end = end;
+    memmove(&set->intervals[first + 1], &set->intervals[last], sizeof(struct interval) * (size_t)(set->count - last));
+    set->count -= last - first - 1;
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       intervalSetPrefix
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int64_t intervalSetPrefix(const struct intervalSet* set)
+ *
+ * RETURNS:        int64_t, the end of the run of bytes starting at 0, or 0 if byte 0 is not in the set
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline int64_t intervalSetPrefix(const struct intervalSet* set)
+{
+    return (set->count > 0 && set->intervals[0].start == 0) ? set->intervals[0].end : 0;
+}
+
+#endif
@@ -0,0 +1,612 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * HEADER FILE:              ioring.h
+ *
+ * FUNCTIONS:                int ioRingInit(struct ioRing* ring, unsigned entries)
+ *                           void ioRingDestroy(struct ioRing* ring)
+ *                           struct io_uring_sqe* ioRingGetSqe(struct ioRing* ring)
+ *                           int ioRingSubmit(struct ioRing* ring, unsigned waitCount)
+ *                           struct io_uring_cqe* ioRingPeekCqe(struct ioRing* ring)
+ *                           void ioRingCqeSeen(struct ioRing* ring)
+ *                           int ioRingRegister(struct ioRing* ring, unsigned opcode, const void* arg, unsigned count)
+ *                           int ioBufferRingInit(struct ioRing* ring, struct ioBufferRing* bufferRing, unsigned entries, uint16_t groupId)
+ *                           void ioBufferRingDestroy(struct ioRing* ring, struct ioBufferRing* bufferRing)
+ *                           void ioBufferRingAdd(struct ioBufferRing* bufferRing, void* address, unsigned length, uint16_t bufferId, unsigned offset)
+ *                           void ioBufferRingAdvance(struct ioBufferRing* bufferRing, unsigned count)
+ *                           void ioRingPrepRecvMsgMultishot(struct io_uring_sqe* sqe, int fd, struct msghdr* msg, uint16_t groupId)
+ *                           void ioRingPrepSendMsg(struct io_uring_sqe* sqe, int fd, const struct msghdr* msg)
+ *                           void ioRingPrepWriteFixed(struct io_uring_sqe* sqe, int fd, const void* buffer, unsigned length, uint64_t offset, uint16_t bufferIndex)
+ *                           bool ioRecvMsgParse(void* buffer, unsigned length, const struct msghdr* msg, struct ioRecvMsg* out)
+ *
+ * DATE:                     October 18th, 2026
+ *
+ * REVISIONS:                N/A
+ *
+ * DESIGNER:                 Derek Wong
+ *
+ * PROGRAMMER:               Derek Wong
+ *
+ * NOTES:
+ * Header file containing a minimal io_uring interface over the raw system calls, shared by the receiver and the
+ * network emulator so neither needs liburing.
+ * Covers what the I/O engines use: submission and completion rings, registered buffers, provided buffer rings for
+ * multishot recvmsg, sendmsg and fixed-buffer writes. Each ring is driven by a single thread.
+ * Only available on Linux; callers check IO_RING_SUPPORTED and fall back to epoll when ioRingInit fails, e.g. on
+ * kernels without io_uring or where it is disabled by policy.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef IORING_H
+#define IORING_H
+
+#if defined(__linux__)
+
+#define IO_RING_SUPPORTED 1
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define IO_RING_CQ_FACTOR           4       // Completion entries per submission entry; multishot receives post many
+
+/*------------------------------------------------ Macros ---------------------------------------------------------------------------*/
+// The rings are shared with the kernel, which reads the tails we publish and writes the heads we read
+#define IO_RING_LOAD_ACQUIRE(pointer)           __atomic_load_n((pointer), __ATOMIC_ACQUIRE)
+#define IO_RING_STORE_RELEASE(pointer, value)   __atomic_store_n((pointer), (value), __ATOMIC_RELEASE)
+
+/*------------------------------------------------ Structs --------------------------------------------------------------------------*/
+struct ioRing
+{
+    int fd;
+    unsigned sqEntries;
+    unsigned* sqHead;
+    unsigned* sqTail;
+    unsigned* sqMask;
+    unsigned* sqArray;
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned* cqMask;
+    struct io_uring_sqe* sqes;
+    struct io_uring_cqe* cqes;
+    unsigned sqeTail;               // Entries handed out by ioRingGetSqe, published to the kernel on submit
+    void* sqMap;
+    size_t sqMapLen;
+    void* cqMap;                    // Same as sqMap when the kernel maps both rings together
+    size_t cqMapLen;
+    size_t sqesLen;
+};
+
+struct ioBufferRing
+{
+    struct io_uring_buf_ring* ring;
+    unsigned entries;
+    uint16_t groupId;
+    uint16_t tail;
+    size_t mapLen;
+};
+
+struct ioRecvMsg
+{
+    void* name;                     // Source address, namelen bytes
+    unsigned nameLen;
+    void* payload;
+    unsigned payloadLen;            // Bytes of payload in the buffer
+    bool truncated;                 // The datagram did not fit the buffer
+};
+
+/*------------------------------------------------ Function Prototypes --------------------------------------------------------------*/
+static inline void ioRingDestroy(struct ioRing* ring);
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRingInit
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int ioRingInit(struct ioRing* ring, unsigned entries)
+ *
+ * RETURNS:        int, 0 on success or a negative errno
+ *
+ * NOTES:
+ * Creates a ring with entries submission entries and IO_RING_CQ_FACTOR times as many completion entries and maps it
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline int ioRingInit(struct ioRing* ring, unsigned entries)
+{
+    struct io_uring_params params;
+    memset(ring, 0, sizeof(struct ioRing));
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = entries * IO_RING_CQ_FACTOR;
+
+    ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->fd < 0)
+    {
+        int error = errno;
+        ring->fd = -1;
+        return -error;
+    }
+
+    ring->sqMapLen = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cqMapLen = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        if (ring->cqMapLen > ring->sqMapLen) ring->sqMapLen = ring->cqMapLen;
+        ring->cqMapLen = ring->sqMapLen;
+    }
+
+    ring->sqMap = mmap(NULL, ring->sqMapLen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    if (ring->sqMap == MAP_FAILED)
+    {
+        int error = errno;
+        ring->sqMap = NULL;
+        ioRingDestroy(ring);
+        return -error;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        ring->cqMap = ring->sqMap;
+    }
+    else
+    {
+        ring->cqMap = mmap(NULL, ring->cqMapLen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+        if (ring->cqMap == MAP_FAILED)
+        {
+            int error = errno;
+            ring->cqMap = NULL;
+            ioRingDestroy(ring);
+            return -error;
+        }
+    }
+    ring->sqesLen = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = (struct io_uring_sqe*)mmap(NULL, ring->sqesLen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED)
+    {
+        int error = errno;
+        ring->sqes = NULL;
+        ioRingDestroy(ring);
+        return -error;
+    }
+
+    unsigned char* sq = (unsigned char*)ring->sqMap;
+    unsigned char* cq = (unsigned char*)ring->cqMap;
+    ring->sqEntries = params.sq_entries;
+    ring->sqHead = (unsigned*)(sq + params.sq_off.head);
+    ring->sqTail = (unsigned*)(sq + params.sq_off.tail);
+    ring->sqMask = (unsigned*)(sq + params.sq_off.ring_mask);
+    ring->sqArray = (unsigned*)(sq + params.sq_off.array);
+    ring->cqHead = (unsigned*)(cq + params.cq_off.head);
+    ring->cqTail = (unsigned*)(cq + params.cq_off.tail);
+    ring->cqMask = (unsigned*)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+    ring->sqeTail = *ring->sqTail;
+    return 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRingDestroy
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void ioRingDestroy(struct ioRing* ring)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Unmaps and closes the ring; requests still in flight are cancelled by the kernel
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void ioRingDestroy(struct ioRing* ring)
+{
+    if (ring->sqes != NULL) munmap(ring->sqes, ring->sqesLen);
+    if (ring->cqMap != NULL && ring->cqMap != ring->sqMap) munmap(ring->cqMap, ring->cqMapLen);
+    if (ring->sqMap != NULL) munmap(ring->sqMap, ring->sqMapLen);
+    if (ring->fd >= 0) close(ring->fd);
+    memset(ring, 0, sizeof(struct ioRing));
+    ring->fd = -1;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRingGetSqe
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      struct io_uring_sqe* ioRingGetSqe(struct ioRing* ring)
+ *
+ * RETURNS:        struct io_uring_sqe*, a cleared submission entry, or NULL when the submission ring is full
+ *
+ * NOTES:
+ * The entry is handed to the kernel by the next ioRingSubmit
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline struct io_uring_sqe* ioRingGetSqe(struct ioRing* ring)
+{
+    if (ring->sqeTail - IO_RING_LOAD_ACQUIRE(ring->sqHead) >= ring->sqEntries)
+    {
+        return NULL;
+    }
+    unsigned index = ring->sqeTail & *ring->sqMask;
+    struct io_uring_sqe* sqe = &ring->sqes[index];
+    ring->sqArray[index] = index;
+    ring->sqeTail++;
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    return sqe;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRingSubmit
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int ioRingSubmit(struct ioRing* ring, unsigned waitCount)
+ *
+ * RETURNS:        int, the number of entries submitted, or a negative errno (-EINTR when a signal arrived while waiting)
+ *
+ * NOTES:
+ * Publishes every prepared entry and, with waitCount > 0, waits until that many completions are available.
+ * One system call covers both.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline int ioRingSubmit(struct ioRing* ring, unsigned waitCount)
+{
+    IO_RING_STORE_RELEASE(ring->sqTail, ring->sqeTail);
+    unsigned pending = ring->sqeTail - IO_RING_LOAD_ACQUIRE(ring->sqHead);
+    if (pending == 0 && waitCount == 0)
+    {
+        return 0;
+    }
+
+    int submitted = (int)syscall(__NR_io_uring_enter, ring->fd, pending, waitCount, waitCount > 0 ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+    return (submitted < 0) ? -errno : submitted;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRingPeekCqe
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      struct io_uring_cqe* ioRingPeekCqe(struct ioRing* ring)
+ *
+ * RETURNS:        struct io_uring_cqe*, the oldest unseen completion, or NULL if there is none
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline struct io_uring_cqe* ioRingPeekCqe(struct ioRing* ring)
+{
+    unsigned head = *ring->cqHead;
+    if (head == IO_RING_LOAD_ACQUIRE(ring->cqTail))
+    {
+        return NULL;
+    }
+    return &ring->cqes[head & *ring->cqMask];
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRingCqeSeen
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void ioRingCqeSeen(struct ioRing* ring)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Returns the completion from ioRingPeekCqe to the kernel; it must not be read afterwards
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void ioRingCqeSeen(struct ioRing* ring)
+{
+    IO_RING_STORE_RELEASE(ring->cqHead, *ring->cqHead + 1);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRingRegister
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int ioRingRegister(struct ioRing* ring, unsigned opcode, const void* arg, unsigned count)
+ *
+ * RETURNS:        int, 0 on success or a negative errno
+ *
+ * NOTES:
+ * Thin wrapper over io_uring_register, e.g. IORING_REGISTER_BUFFERS with an iovec array or IORING_REGISTER_EVENTFD
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline int ioRingRegister(struct ioRing* ring, unsigned opcode, const void* arg, unsigned count)
+{
+    return (syscall(__NR_io_uring_register, ring->fd, opcode, arg, count) < 0) ? -errno : 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioBufferRingInit
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int ioBufferRingInit(struct ioRing* ring, struct ioBufferRing* bufferRing, unsigned entries, uint16_t groupId)
+ *
+ * RETURNS:        int, 0 on success or a negative errno
+ *
+ * NOTES:
+ * Registers an empty provided buffer ring of entries buffers, a power of two, as buffer group groupId.
+ * Buffers are added with ioBufferRingAdd and made visible to the kernel with ioBufferRingAdvance.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline int ioBufferRingInit(struct ioRing* ring, struct ioBufferRing* bufferRing, unsigned entries, uint16_t groupId)
+{
+    struct io_uring_buf_reg registration;
+    memset(bufferRing, 0, sizeof(struct ioBufferRing));
+
+    bufferRing->mapLen = entries * sizeof(struct io_uring_buf);
+    void* map = mmap(NULL, bufferRing->mapLen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED)
+    {
+        return -errno;
+    }
+
+    memset(&registration, 0, sizeof(registration));
+    registration.ring_addr = (uint64_t)(uintptr_t)map;
+    registration.ring_entries = entries;
+    registration.bgid = groupId;
+    int result = ioRingRegister(ring, IORING_REGISTER_PBUF_RING, &registration, 1);
+    if (result < 0)
+    {
+        munmap(map, bufferRing->mapLen);
+        return result;
+    }
+
+    bufferRing->ring = (struct io_uring_buf_ring*)map;
+    bufferRing->entries = entries;
+    bufferRing->groupId = groupId;
+    return 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioBufferRingDestroy
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void ioBufferRingDestroy(struct ioRing* ring, struct ioBufferRing* bufferRing)
+ *
+ * RETURNS:        void
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void ioBufferRingDestroy(struct ioRing* ring, struct ioBufferRing* bufferRing)
+{
+    if (bufferRing->ring == NULL)
+    {
+        return;
+    }
+
+    struct io_uring_buf_reg registration;
+    memset(&registration, 0, sizeof(registration));
+    registration.bgid = bufferRing->groupId;
+    ioRingRegister(ring, IORING_UNREGISTER_PBUF_RING, &registration, 1);
+    munmap(bufferRing->ring, bufferRing->mapLen);
+    memset(bufferRing, 0, sizeof(struct ioBufferRing));
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioBufferRingAdd
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void ioBufferRingAdd(struct ioBufferRing* bufferRing, void* address, unsigned length, uint16_t bufferId,
+ *                     unsigned offset
+ *                 )
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Stages a buffer offset entries past the current tail; completions name it by bufferId
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void ioBufferRingAdd(struct ioBufferRing* bufferRing, void* address, unsigned length, uint16_t bufferId, unsigned offset)
+{
+    // The entries start at the ring itself; bufs is not at offset 0 when the kernel header is compiled as C++
+    struct io_uring_buf* buffer = (struct io_uring_buf*)bufferRing->ring + ((bufferRing->tail + offset) & (bufferRing->entries - 1));
+    buffer->addr = (uint64_t)(uintptr_t)address;
+    buffer->len = length;
+    buffer->bid = bufferId;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioBufferRingAdvance
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void ioBufferRingAdvance(struct ioBufferRing* bufferRing, unsigned count)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Hands the next count staged buffers to the kernel
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void ioBufferRingAdvance(struct ioBufferRing* bufferRing, unsigned count)
+{
+    bufferRing->tail = (uint16_t)(bufferRing->tail + count);
+    IO_RING_STORE_RELEASE(&bufferRing->ring->tail, bufferRing->tail);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRingPrepRecvMsgMultishot
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void ioRingPrepRecvMsgMultishot(struct io_uring_sqe* sqe, int fd, struct msghdr* msg, uint16_t groupId)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * One request that posts a completion per datagram, each in a buffer taken from group groupId; msg only gives the
+ * name and control lengths to reserve at the front of each buffer and must outlive the request.
+ * The request stops, and must be submitted again, when a completion comes without IORING_CQE_F_MORE.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void ioRingPrepRecvMsgMultishot(struct io_uring_sqe* sqe, int fd, struct msghdr* msg, uint16_t groupId)
+{
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)msg;
+    sqe->len = 1;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = groupId;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRingPrepSendMsg
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void ioRingPrepSendMsg(struct io_uring_sqe* sqe, int fd, const struct msghdr* msg)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * msg and the data it points to must stay valid until the completion arrives
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void ioRingPrepSendMsg(struct io_uring_sqe* sqe, int fd, const struct msghdr* msg)
+{
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)msg;
+    sqe->len = 1;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRingPrepWriteFixed
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void ioRingPrepWriteFixed(struct io_uring_sqe* sqe, int fd, const void* buffer, unsigned length,
+ *                     uint64_t offset, uint16_t bufferIndex
+ *                 )
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Writes from inside registered buffer bufferIndex at a file offset
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void ioRingPrepWriteFixed(struct io_uring_sqe* sqe, int fd, const void* buffer, unsigned length, uint64_t offset, uint16_t bufferIndex)
+{
+    sqe->opcode = IORING_OP_WRITE_FIXED;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)buffer;
+    sqe->len = length;
+    sqe->off = offset;
+    sqe->buf_index = bufferIndex;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRecvMsgParse
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool ioRecvMsgParse(void* buffer, unsigned length, const struct msghdr* msg, struct ioRecvMsg* out)
+ *
+ * RETURNS:        bool, false if the buffer is too short to hold the header the kernel writes
+ *
+ * NOTES:
+ * Locates the source address and payload in a buffer filled by a multishot recvmsg; length is the completion's result
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline bool ioRecvMsgParse(void* buffer, unsigned length, const struct msghdr* msg, struct ioRecvMsg* out)
+{
+    size_t headerLen = sizeof(struct io_uring_recvmsg_out) + msg->msg_namelen + msg->msg_controllen;
+    if (length < headerLen)
+    {
+        return false;
+    }
+
+    struct io_uring_recvmsg_out* header = (struct io_uring_recvmsg_out*)buffer;
+    out->name = (unsigned char*)buffer + sizeof(struct io_uring_recvmsg_out);
+    out->nameLen = (header->namelen < msg->msg_namelen) ? header->namelen : msg->msg_namelen;
+    out->payload = (unsigned char*)buffer + headerLen;
+    out->payloadLen = length - (unsigned)headerLen;
+    out->truncated = (header->flags & MSG_TRUNC) != 0;
+    return true;
+}
+
+#endif // __linux__
+#endif // IORING_H
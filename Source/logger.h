@@ -1,11 +1,15 @@
 /*-----------------------------------------------------------------------------------------------------------------------------------
  * HEADER FILE:              logger.h
  *
- * FUNCTIONS:                void logToFile(enum LogType severity, struct packet* pkt, const char* format, ...)
+ * FUNCTIONS:                void openLog(void)
+ *                           void logToFile(enum LogType severity, struct packet* pkt, const char* format, ...)
  *
  * DATE:                     December 3rd, 2020
  *
- * REVISIONS:                N/A
+ * REVISIONS:                October 18th, 2026 - Log file stays open and messages are formatted on the stack
+ *                           October 18th, 2026 - Packet dumps show the stream and offset
+ *                           October 18th, 2026 - Packet dumps show the connection id
+ *                           October 18th, 2026 - The log file is opened by openLog before any thread logs
  *
  * DESIGNER:                 Maksym Chumak, Derek Wong
  *
@@ -13,6 +17,8 @@
  *
  * NOTES:
  * Header file containing shared logging logic
+ * Programs call openLog once at startup, before starting threads; logToFile never opens the file itself,
+ * so threads only ever share the one handle
  * ----------------------------------------------------------------------------------------------------------------------------------*/
 
 #ifndef LOGGER_H
@@ -31,42 +37,45 @@ enum LogType { DEBUG, INFO, ERROR };
 
 /*---------------------------------------------------------- Symbolic Constants ------------------------------------------------------*/
 #define DEFAULT_LOGGER_LEVEL    INFO // Default logger level, will print all higher severity levels from DEBUG, INFO, ERROR
+#define LOG_MESSAGE_LEN         1024 // Longer messages are truncated
+#define LOG_TIME_LEN            64
 
 /*----------------------------------------------------------- Default Strings --------------------------------------------------------*/
 #define LOG_FILE_DIR           "./logs"
 #define LOG_FILE_PATH          "./logs/out.log"
 
+/*---------------------------------------------------------- Globals -----------------------------------------------------------------*/
+static FILE* logFile = NULL; // Set once by openLog; NULL until then or if the file could not be opened
+
 /*----------------------------------------------------------------------------------------------------------------------------
- * FUNCTION:       logToFile
+ * FUNCTION:       openLog
  *
- * DATE:           December 3rd, 2020
+ * DATE:           October 18th, 2026
  *
  * REVISIONS:      N/A
  *
- * DESIGNER:       Maksym Chumak, Derek Wong
+ * DESIGNER:       Derek Wong
  *
- * PROGRAMMER:     Maksym Chumak, Derek Wong
+ * PROGRAMMER:     Derek Wong
  *
- * INTERFACE:      void logToFile(enum LogType severity, struct packet* pkt, const char* format, ...)
+ * INTERFACE:      void openLog(void)
  *
  * RETURNS:        void
  *
  * NOTES:
- * logs application messages and packet details to STDOUT and a file;
- * messages can have different severity levels: DEBUG, INFO and ERROR
+ * Creates the log directory if needed and opens the log file for appending. Not thread safe: it is called from main
+ * before any thread can log, and does nothing once the file is open. Until it succeeds, messages only go to STDOUT
  * ----------------------------------------------------------------------------------------------------------------------------*/
-void logToFile(enum LogType severity, struct packet* pkt, const char* format, ...)
+void openLog(void)
 {
-    time_t rawtime;
-    struct tm* tinfo;
-    char tbuffer[24];
-    char* msg;
-    va_list args;
-    size_t len;
-
     struct stat st = {};
 
-    if (stat("./logs", &st) == -1)
+    if (logFile != NULL)
+    {
+        return;
+    }
+
+    if (stat(LOG_FILE_DIR, &st) == -1)
     {
         #if defined(_WIN32)
             mkdir(LOG_FILE_DIR);
@@ -75,73 +84,103 @@ void logToFile(enum LogType severity, struct packet* pkt, const char* format, ..
         #endif
     }
 
-    FILE* fptr = fopen(LOG_FILE_PATH, "a");
-    if (fptr == NULL)
+    logFile = fopen(LOG_FILE_PATH, "a");
+    if (logFile == NULL)
     {
         perror("could not open log file");
-        return;
     }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       logToFile
+ *
+ * DATE:           December 3rd, 2020
+ *
+ * REVISIONS:      October 18th, 2026 - Opens the log file once and flushes each message instead of reopening it per call;
+ *                                      formats into stack buffers so logging a packet does not allocate
+ *                 October 18th, 2026 - Packet dumps include the stream id and offset; the payload is bounded by dataLen
+ *                 October 18th, 2026 - Packet dumps include the connection id
+ *                 October 18th, 2026 - No longer opens the file itself; writes to the file openLog opened, if any
+ *
+ * DESIGNER:       Maksym Chumak, Derek Wong
+ *
+ * PROGRAMMER:     Maksym Chumak, Derek Wong
+ *
+ * INTERFACE:      void logToFile(enum LogType severity, struct packet* pkt, const char* format, ...)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * logs application messages and packet details to STDOUT and a file;
+ * messages can have different severity levels: DEBUG, INFO and ERROR
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void logToFile(enum LogType severity, struct packet* pkt, const char* format, ...)
+{
+    time_t rawtime;
+    struct tm tinfo;
+    char tbuffer[LOG_TIME_LEN];
+    char msg[LOG_MESSAGE_LEN];
+    const char* level = NULL;
+    va_list args;
 
-    // allocate memory for string
     va_start(args, format);
-    len = vsnprintf(0, 0, format, args);
+    vsnprintf(msg, sizeof(msg), format, args);
     va_end(args);
 
-    if ((msg = (char *)malloc(len + 1)) != NULL)
+    time(&rawtime);
+    // localtime re-reads the time zone (and allocates) on every call, the reentrant versions do not
+    #if defined(_WIN32)
+        localtime_s(&tinfo, &rawtime);
+    #else
+        localtime_r(&rawtime, &tinfo);
+    #endif
+    snprintf(tbuffer, sizeof(tbuffer), "%d-%d-%d %d:%d:%d", tinfo.tm_year + 1900, tinfo.tm_mon + 1, tinfo.tm_mday, tinfo.tm_hour, tinfo.tm_min, tinfo.tm_sec);
+
+    switch (severity)
     {
-        va_start(args, format);
-        vsnprintf(msg, len + 1, format, args);
-        va_end(args);
+        case DEBUG:
+            if (DEFAULT_LOGGER_LEVEL == DEBUG)
+            {
+                fprintf(stdout, "[%s] %s\n", tbuffer, msg);
+                level = "DEBUG";
+            }
+            break;
+        case INFO:
+            fprintf(stdout, "[%s] %s\n", tbuffer, msg);
+            level = "INFO";
+            break;
+        case ERROR:
+            fprintf(stderr, "[%s] %s\n", tbuffer, msg);
+            level = "ERROR";
+            break;
+        default:
+            fprintf(stderr, "invalid severity level\n");
     }
 
-    if (msg)
+    if (logFile == NULL)
     {
-        time(&rawtime);
-        tinfo = localtime(&rawtime);
-        sprintf(tbuffer, "%d-%d-%d %d:%d:%d", tinfo->tm_year + 1900, tinfo->tm_mon + 1, tinfo->tm_mday, tinfo->tm_hour, tinfo->tm_min, tinfo->tm_sec);
-
-        switch (severity)
-        {
-            case DEBUG:
-                if (DEFAULT_LOGGER_LEVEL == DEBUG)
-                {
-                    fprintf(stdout, "[%s] %s\n", tbuffer, msg);
-                    fprintf(fptr, "[DEBUG][%s] %s\n", tbuffer, msg);
-                }
-                break;
-            case INFO:
-                fprintf(stdout, "[%s] %s\n", tbuffer, msg);
-                fprintf(fptr, "[INFO][%s] %s\n", tbuffer, msg);
-                break;
-            case ERROR:
-                fprintf(stderr, "[%s] %s\n", tbuffer, msg);
-                fprintf(fptr, "[ERROR][%s] %s\n", tbuffer, msg);
-                break;
-            default:
-                fprintf(stderr, "invalid severity level\n");
-        }
+        return;
+    }
+    if (level != NULL)
+    {
+        fprintf(logFile, "[%s][%s] %s\n", level, tbuffer, msg);
+    }
 
-        if (pkt != NULL)
+    if (pkt != NULL)
+    {
+        // only the first line of the payload is logged; the payload is not trusted to be terminated
+        int dataLen = 0;
+        int maxLen = (pkt->dataLen >= 0 && pkt->dataLen < PAYLOAD_LEN) ? pkt->dataLen : PAYLOAD_LEN;
+        while (dataLen < maxLen && pkt->data[dataLen] != '\0' && pkt->data[dataLen] != '\n')
         {
-            char* data = (char *)malloc(strlen(pkt->data) + 1);
-            char* packetType = packetTypeToString(pkt->packetType, false);
-            char* retransmit = retransmitToString(pkt->retransmit);
-            strcpy(data, pkt->data);
-            fprintf(fptr, "{\n    packetType: %s,\n    seqNum: %i,\n    data: %s,\n    windowSize: %i,\n    ackNum: %i,\n    retransmit: %s,\n}\n",
-                packetType, pkt->seqNum, strtok(data, "\n"), pkt->windowSize, pkt->ackNum, retransmit
-            );
-            free(data);
-            free(packetType);
-            free(retransmit);
+            dataLen++;
         }
-
-        free(msg);
-    }
-    else
-    {
-        fprintf(fptr, "[ERROR][%s] error while logging a message: memory allocation failed.\n", tbuffer);
+        fprintf(logFile, "{\n    packetType: %s,\n    connectionId: %i,\n    streamId: %i,\n    seqNum: %i,\n    offset: %lld,\n    data: %.*s,\n    windowSize: %i,\n    ackNum: %i,\n    retransmit: %s,\n}\n",
+            packetTypeToString(pkt->packetType, false), pkt->connectionId, pkt->streamId, pkt->seqNum, (long long)pkt->offset, dataLen, pkt->data,
+            pkt->windowSize, pkt->ackNum, retransmitToString(pkt->retransmit)
+        );
     }
-    fclose(fptr);
+    fflush(logFile);
 }
 
 #endif
@@ -0,0 +1,377 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * HEADER FILE:              lz4block.h
+ *
+ * FUNCTIONS:                void lz4Init(struct lz4Context* ctx)
+ *                           int lz4Compress(struct lz4Context* ctx, const char* source, int sourceLen, char* dest, int destCapacity)
+ *                           int lz4Decompress(const char* source, int sourceLen, char* dest, int destCapacity)
+ *                           uint32_t lz4Read32(const unsigned char* p)
+ *                           uint32_t lz4Hash(uint32_t sequence)
+ *                           bool lz4PutSequence(unsigned char** out, const unsigned char* end, const unsigned char* literals, int literalLen, int offset, int matchLen)
+ *                           bool lz4GetLength(const unsigned char** in, const unsigned char* end, size_t* length)
+ *
+ * DATE:                     October 18th, 2026
+ *
+ * REVISIONS:                N/A
+ *
+ * DESIGNER:                 Derek Wong
+ *
+ * PROGRAMMER:               Derek Wong
+ *
+ * NOTES:
+ * Header file containing a compressor and decompressor for the LZ4 block format, so payloads can be compressed
+ * without an external library; lz4Compress output decompresses with liblz4's LZ4_decompress_safe and the other way
+ * round. The compressor is the greedy single-pass one: a hash table of the positions of 4-byte sequences finds
+ * earlier occurrences, each extended as far as it matches. The table lives in a context meant to be kept for the
+ * life of the caller and reused for every block; rather than clearing it per block, positions are stored from a
+ * base that moves past each block, and anything below the base is ignored. Blocks are independent: a match never
+ * reaches into an earlier block, so each decompresses on its own, in any order.
+ * lz4Decompress checks every length and offset against both buffers, so damaged or hostile input fails rather than
+ * reading or writing out of bounds.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef LZ4BLOCK_H
+#define LZ4BLOCK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define LZ4_HASH_LOG        12                  // 4096 table entries
+#define LZ4_MIN_MATCH       4
+#define LZ4_MAX_OFFSET      65535
+#define LZ4_MF_LIMIT        12                  // No match starts within this many bytes of the end of a block
+#define LZ4_LAST_LITERALS   5                   // The last bytes of a block are always literals
+#define LZ4_BASE_LIMIT      0x7fffffffu         // Past this the context's table is cleared and the base starts over
+
+/*------------------------------------------------ Structs --------------------------------------------------------------------------*/
+struct lz4Context
+{
+    uint32_t table[1 << LZ4_HASH_LOG];          // base + position of the last sequence with each hash
+    uint32_t base;                              // Entries below it belong to earlier blocks
+};
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       lz4Init
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void lz4Init(struct lz4Context* ctx)
+ *
+ * RETURNS:        void
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void lz4Init(struct lz4Context* ctx)
+{
+    memset(ctx->table, 0, sizeof(ctx->table));
+    ctx->base = 1;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       lz4Read32
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      uint32_t lz4Read32(const unsigned char* p)
+ *
+ * RETURNS:        uint32_t, the four bytes at p, however aligned
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline uint32_t lz4Read32(const unsigned char* p)
+{
+    uint32_t value;
+
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       lz4Hash
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      uint32_t lz4Hash(uint32_t sequence)
+ *
+ * RETURNS:        uint32_t, table index of a 4-byte sequence
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline uint32_t lz4Hash(uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - LZ4_HASH_LOG);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       lz4PutSequence
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool lz4PutSequence(unsigned char** out, const unsigned char* end, const unsigned char* literals, int literalLen, int offset, int matchLen)
+ *
+ * RETURNS:        bool, false if the sequence does not fit before end
+ *
+ * NOTES:
+ * Writes a token, the literals and, unless matchLen is 0 for the last sequence of a block, the match's offset and
+ * length; lengths of 15 or more continue in extra bytes of up to 255 each
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline bool lz4PutSequence(unsigned char** out, const unsigned char* end, const unsigned char* literals, int literalLen, int offset, int matchLen)
+{
+    unsigned char* op = *out;
+    unsigned char* token;
+    int rest;
+    ptrdiff_t needed = 1 + literalLen + literalLen / 255 + 1 + (matchLen > 0 ? 2 + matchLen / 255 + 1 : 0);
+
+    if (end - op < needed)
+    {
+        return false;
+    }
+
+    token = op++;
+    if (literalLen >= 15)
+    {
+        *token = 15 << 4;
+        for (rest = literalLen - 15; rest >= 255; rest -= 255)
+        {
+            *op++ = 255;
+        }
+        *op++ = (unsigned char)rest;
+    }
+    else
+    {
+        *token = (unsigned char)(literalLen << 4);
+    }
+    memcpy(op, literals, (size_t)literalLen);
+    op += literalLen;
+
+    if (matchLen > 0)
+    {
+        *op++ = (unsigned char)(offset & 0xff);
+        *op++ = (unsigned char)(offset >> 8);
+        rest = matchLen - LZ4_MIN_MATCH;
+        if (rest >= 15)
+        {
+            *token |= 15;
+            for (rest -= 15; rest >= 255; rest -= 255)
+            {
+                *op++ = 255;
+            }
+            *op++ = (unsigned char)rest;
+        }
+        else
+        {
+            *token |= (unsigned char)rest;
+        }
+    }
+    *out = op;
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       lz4Compress
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int lz4Compress(struct lz4Context* ctx, const char* source, int sourceLen, char* dest, int destCapacity)
+ *
+ * RETURNS:        int, bytes written to dest, 0 if the compressed block would not fit in destCapacity
+ *
+ * NOTES:
+ * Compresses one independent block. Giving destCapacity smaller than sourceLen makes the call a test of whether
+ * the block compresses to that size at all, failing as soon as it is known not to.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline int lz4Compress(struct lz4Context* ctx, const char* source, int sourceLen, char* dest, int destCapacity)
+{
+    const unsigned char* src = (const unsigned char*)source;
+    unsigned char* op = (unsigned char*)dest;
+    const unsigned char* const opEnd = op + destCapacity;
+    const int matchStartLimit = sourceLen - LZ4_MF_LIMIT;
+    const int matchEndLimit = sourceLen - LZ4_LAST_LITERALS;
+    int ip = 0, anchor = 0, written = 0;
+
+    if (ctx->base > LZ4_BASE_LIMIT)
+    {
+        lz4Init(ctx);
+    }
+
+    while (ip < matchStartLimit)
+    {
+        uint32_t sequence = lz4Read32(src + ip);
+        uint32_t* entry = &ctx->table[lz4Hash(sequence)];
+        uint32_t candidate = *entry;
+        int match, length;
+
+        *entry = ctx->base + (uint32_t)ip;
+        // the entry may be of an earlier block, or of a later position of a longer one, and the hash may collide
+        if (candidate < ctx->base || (match = (int)(candidate - ctx->base)) >= ip || ip - match > LZ4_MAX_OFFSET
+            || lz4Read32(src + match) != sequence)
+        {
+            ip++;
+            continue;
+        }
+
+        for (length = LZ4_MIN_MATCH; ip + length < matchEndLimit && src[match + length] == src[ip + length]; length++)
+            ;
+        if (!lz4PutSequence(&op, opEnd, src + anchor, ip - anchor, ip - match, length))
+        {
+            goto done;
+        }
+        ip += length;
+        anchor = ip;
+    }
+    if (lz4PutSequence(&op, opEnd, src + anchor, sourceLen - anchor, 0, 0))
+    {
+        written = (int)(op - (unsigned char*)dest);
+    }
+
+done:
+    ctx->base += (uint32_t)sourceLen + 1;
+    return written;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       lz4GetLength
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool lz4GetLength(const unsigned char** in, const unsigned char* end, size_t* length)
+ *
+ * RETURNS:        bool, false if the input ends first
+ *
+ * NOTES:
+ * Adds the extra bytes of a length whose token field was 15
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline bool lz4GetLength(const unsigned char** in, const unsigned char* end, size_t* length)
+{
+    const unsigned char* ip = *in;
+    unsigned char extra;
+
+    do
+    {
+        if (ip >= end)
+        {
+            return false;
+        }
+        extra = *ip++;
+        *length += extra;
+    } while (extra == 255);
+    *in = ip;
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       lz4Decompress
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int lz4Decompress(const char* source, int sourceLen, char* dest, int destCapacity)
+ *
+ * RETURNS:        int, bytes written to dest, -1 if the block is malformed or would not fit in destCapacity
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline int lz4Decompress(const char* source, int sourceLen, char* dest, int destCapacity)
+{
+    const unsigned char* ip = (const unsigned char*)source;
+    const unsigned char* const ipEnd = ip + sourceLen;
+    unsigned char* op = (unsigned char*)dest;
+    unsigned char* const opStart = op;
+    unsigned char* const opEnd = op + destCapacity;
+
+    while (ip < ipEnd)
+    {
+        unsigned char token = *ip++;
+        size_t literalLen = token >> 4;
+        size_t matchLen = token & 15;
+        size_t offset;
+
+        if (literalLen == 15 && !lz4GetLength(&ip, ipEnd, &literalLen))
+        {
+            return -1;
+        }
+        if ((size_t)(ipEnd - ip) < literalLen || (size_t)(opEnd - op) < literalLen)
+        {
+            return -1;
+        }
+        memcpy(op, ip, literalLen);
+        ip += literalLen;
+        op += literalLen;
+        // the last sequence of a block has no match
+        if (ip == ipEnd)
+        {
+            break;
+        }
+
+        if (ipEnd - ip < 2)
+        {
+            return -1;
+        }
+        offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - opStart))
+        {
+            return -1;
+        }
+        if (matchLen == 15 && !lz4GetLength(&ip, ipEnd, &matchLen))
+        {
+            return -1;
+        }
+        matchLen += LZ4_MIN_MATCH;
+        if ((size_t)(opEnd - op) < matchLen)
+        {
+            return -1;
+        }
+        // a match closer than its length repeats the bytes it is still copying
+        if (offset >= matchLen)
+        {
+            memcpy(op, op - offset, matchLen);
+            op += matchLen;
+        }
+        else
+        {
+            for (size_t i = 0; i < matchLen; i++, op++)
+            {
+                *op = *(op - offset);
+            }
+        }
+    }
+    return (int)(op - opStart);
+}
+
+#endif
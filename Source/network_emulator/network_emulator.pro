@@ -8,14 +8,33 @@ CONFIG += c++11 console
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
-LIBS += -lws2_32
+win32: LIBS += -lws2_32
 
 SOURCES += \
+    src/csvexporter.cpp \
+    src/datagramsocket.cpp \
+    src/decimatedseries.cpp \
     src/main.cpp \
-    src/networkemulator.cpp
+    src/metrics.cpp \
+    src/metricsserver.cpp \
+    src/networkemulator.cpp \
+    src/packetring.cpp \
+    src/packetrecordstore.cpp \
+    src/pcapngwriter.cpp \
+    src/tracereplay.cpp
 
 HEADERS += \
-    src/networkemulator.h
+    src/csvexporter.h \
+    src/datagramsocket.h \
+    src/decimatedseries.h \
+    src/endpoint.h \
+    src/metrics.h \
+    src/metricsserver.h \
+    src/networkemulator.h \
+    src/packetring.h \
+    src/packetrecordstore.h \
+    src/pcapngwriter.h \
+    src/tracereplay.h
 
 FORMS += \
     networkemulator.ui
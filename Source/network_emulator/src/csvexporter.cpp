@@ -0,0 +1,416 @@
+/*----------------------------------------------------------------------------------------------------------------------------
+ * SOURCE FILE:    csvexporter.cpp
+ *
+ * FUNCTIONS:      static int formatAddress(char* out, size_t len, const Endpoint* endpoint)
+ *                 static int formatRecord(char* out, const PacketRecord& record)
+ *                 CsvExporter::~CsvExporter()
+ *                 bool CsvExporter::start(const QString& path, const PacketRecordStore* store)
+ *                 void CsvExporter::cancel()
+ *                 bool CsvExporter::finish()
+ *                 bool CsvExporter::isRunning() const
+ *                 bool CsvExporter::isFinished() const
+ *                 size_t CsvExporter::rowsWritten() const
+ *                 size_t CsvExporter::totalRows() const
+ *                 QString CsvExporter::errorString() const
+ *                 void CsvExporter::exportRecords(QString path, const PacketRecordStore* store)
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Names of the SYN, SYN_ACK and EOT_ACK packet types
+ *                 October 18th, 2026 - Packet type names come from packetTypeToString; IPv6 endpoints are exported
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * NOTES:
+ * Streams the packet records to a CSV file in the same layout as the packet table
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+
+#include "csvexporter.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+    #include <arpa/inet.h>
+#endif
+
+#include <vector>
+
+#include <QSaveFile>
+
+// Defined by packet.h, which only networkemulator.cpp includes since its functions are not inline
+const char* packetTypeToString(int packetType, bool isDropped);
+
+static const char* const CSV_HEADER = "Relative Time,Window Size,Packet Type,Retransmit,Seq #,Ack #,Source IP,Destination IP,Source Port,Destination Port\r\n";
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       formatAddress
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static int formatAddress(char* out, size_t len, const Endpoint* endpoint)
+ *
+ * RETURNS:        int, number of characters written
+ *
+ * NOTES:
+ * Writes the endpoint's address in dotted decimal, or in the usual IPv6 text form
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static int formatAddress(char* out, size_t len, const Endpoint* endpoint)
+{
+    if (endpointIsIPv4(endpoint))
+    {
+        uint32_t address = endpointIPv4(endpoint);
+        return snprintf(out, len, "%u.%u.%u.%u", address >> 24, (address >> 16) & 0xFF, (address >> 8) & 0xFF, address & 0xFF);
+    }
+
+    unsigned char bytes[16];
+    for (int i = 0; i < 8; i++)
+    {
+        bytes[i] = static_cast<unsigned char>(endpoint->addressHigh >> (56 - 8 * i));
+        bytes[8 + i] = static_cast<unsigned char>(endpoint->addressLow >> (56 - 8 * i));
+    }
+    if (inet_ntop(AF_INET6, bytes, out, len) == nullptr)
+    {
+        out[0] = '\0';
+    }
+    return (int)strlen(out);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       formatRecord
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Addresses are formatted from the endpoint keys
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static int formatRecord(char* out, const PacketRecord& record)
+ *
+ * RETURNS:        int, number of characters written
+ *
+ * NOTES:
+ * Formats one record as a CSV row; the relative time matches the table's "m:ss:zzz" format
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static int formatRecord(char* out, const PacketRecord& record)
+{
+    char sourceAddr[INET6_ADDRSTRLEN];
+    char destinationAddr[INET6_ADDRSTRLEN];
+
+    formatAddress(sourceAddr, sizeof(sourceAddr), &record.source);
+    formatAddress(destinationAddr, sizeof(destinationAddr), &record.destination);
+    return snprintf(out, CSV_EXPORT_MAX_ROW_LEN, "%d:%02d:%03d,%d,%s,%s,%d,%d,%s,%s,%u,%u\r\n",
+        (record.relTimeMs / 60000) % 60, (record.relTimeMs / 1000) % 60, record.relTimeMs % 1000,
+        record.windowSize, packetTypeToString(record.packetType, record.dropped), record.retransmit ? "Yes" : "No",
+        record.seqNum, record.ackNum, sourceAddr, destinationAddr, record.source.port, record.destination.port);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       CsvExporter::~CsvExporter
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      CsvExporter::~CsvExporter()
+ *
+ * NOTES:
+ * Destructor of CsvExporter class, abandons an export that is still running
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+CsvExporter::~CsvExporter()
+{
+    cancel();
+    finish();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       CsvExporter::start
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool CsvExporter::start(const QString& path, const PacketRecordStore* store)
+ *
+ * RETURNS:        bool, false if an export is already running
+ *
+ * NOTES:
+ * Starts exporting the records currently in the store
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool CsvExporter::start(const QString& path, const PacketRecordStore* store)
+{
+    if (running.load())
+    {
+        return false;
+    }
+    finish();
+
+    total = store->size();
+    written.store(0);
+    cancelled.store(false);
+    finished.store(false);
+    succeeded = false;
+    error.clear();
+    running.store(true);
+    exportThread = std::thread(&CsvExporter::exportRecords, this, path, store);
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       CsvExporter::cancel
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void CsvExporter::cancel()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Asks a running export to stop; the partially written file is discarded
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void CsvExporter::cancel()
+{
+    cancelled.store(true);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       CsvExporter::finish
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool CsvExporter::finish()
+ *
+ * RETURNS:        bool, true if the last export was written and committed
+ *
+ * NOTES:
+ * Waits for the export thread to exit
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool CsvExporter::finish()
+{
+    if (exportThread.joinable())
+    {
+        exportThread.join();
+    }
+    running.store(false);
+    return succeeded;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       CsvExporter::isRunning
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool CsvExporter::isRunning() const
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * True from start() until finish()
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool CsvExporter::isRunning() const
+{
+    return running.load();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       CsvExporter::isFinished
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool CsvExporter::isFinished() const
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * True once the export thread has done its work and finish() will not block
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool CsvExporter::isFinished() const
+{
+    return finished.load(std::memory_order_acquire);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       CsvExporter::rowsWritten
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      size_t CsvExporter::rowsWritten() const
+ *
+ * RETURNS:        size_t
+ *
+ * NOTES:
+ * Number of records written so far
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+size_t CsvExporter::rowsWritten() const
+{
+    return written.load(std::memory_order_relaxed);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       CsvExporter::totalRows
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      size_t CsvExporter::totalRows() const
+ *
+ * RETURNS:        size_t
+ *
+ * NOTES:
+ * Number of records the running export will write
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+size_t CsvExporter::totalRows() const
+{
+    return total;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       CsvExporter::errorString
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      QString CsvExporter::errorString() const
+ *
+ * RETURNS:        QString
+ *
+ * NOTES:
+ * Reason the last export failed, valid after finish()
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+QString CsvExporter::errorString() const
+{
+    return error;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       CsvExporter::exportRecords
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void CsvExporter::exportRecords(QString path, const PacketRecordStore* store)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Export thread: formats rows chunk by chunk into a fixed buffer and writes it out whenever it fills,
+ * so memory use does not grow with the number of records. The file only replaces its target on commit.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void CsvExporter::exportRecords(QString path, const PacketRecordStore* store)
+{
+    QSaveFile file(path);
+    std::vector<char> buffer(CSV_EXPORT_BUFFER_SIZE);
+    size_t fill = 0;
+    size_t row = 0;
+    bool ok = file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+
+    if (ok)
+    {
+        fill = strlen(CSV_HEADER);
+        memcpy(buffer.data(), CSV_HEADER, fill);
+    }
+
+    for (size_t chunkIndex = 0; ok && row < total; chunkIndex++)
+    {
+        const PacketRecord* records = store->chunk(chunkIndex);
+        size_t chunkEnd = (chunkIndex + 1) * PACKET_RECORD_CHUNK_SIZE;
+        if (chunkEnd > total) chunkEnd = total;
+
+        for (; row < chunkEnd; row++)
+        {
+            if (fill + CSV_EXPORT_MAX_ROW_LEN > buffer.size())
+            {
+                ok = file.write(buffer.data(), fill) == (qint64)fill;
+                fill = 0;
+                written.store(row, std::memory_order_relaxed);
+                if (!ok || cancelled.load()) break;
+            }
+            fill += formatRecord(buffer.data() + fill, records[row % PACKET_RECORD_CHUNK_SIZE]);
+        }
+        if (cancelled.load()) break;
+    }
+
+    if (ok && !cancelled.load() && fill > 0)
+    {
+        ok = file.write(buffer.data(), fill) == (qint64)fill;
+    }
+
+    if (cancelled.load())
+    {
+        file.cancelWriting();
+        error = "export cancelled";
+    }
+    else if (!ok || !file.commit())
+    {
+        error = file.errorString();
+    }
+    else
+    {
+        written.store(total, std::memory_order_relaxed);
+        succeeded = true;
+    }
+    finished.store(true, std::memory_order_release);
+}
@@ -0,0 +1,76 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * CSVEXPORTER CLASS DECLARATION FILE:          csvexporter.h
+ *
+ * DATE:                                        October 18th, 2026
+ *
+ * REVISIONS:                                   October 18th, 2026 - Rows are long enough for IPv6 addresses
+ *
+ * DESIGNER:                                    Derek Wong
+ *
+ * PROGRAMMER:                                  Derek Wong
+ *
+ * NOTES:
+ * Declaration file for CsvExporter class
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef CSVEXPORTER_H
+#define CSVEXPORTER_H
+
+#include <atomic>
+#include <thread>
+
+#include <QString>
+
+#include "packetrecordstore.h"
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define CSV_EXPORT_BUFFER_SIZE      (1 << 20)   // Rows are formatted into a 1 MiB buffer before each write
+#define CSV_EXPORT_MAX_ROW_LEN      256
+
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * CLASS:           CsvExporter
+ *
+ * DATE:            October 18th, 2026
+ *
+ * REVISIONS:       N/A
+ *
+ * DESIGNER:        Derek Wong
+ *
+ * PROGRAMMER:      Derek Wong
+ *
+ * NOTES:
+ * Writes the packet records to a CSV file on a background thread.
+ * The export covers the records present when it starts; packets recorded while it runs are not included.
+ * Progress is read by polling rowsWritten() and totalRows(); finish() joins the thread once isFinished() is true.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+class CsvExporter
+{
+public:
+    // constructor
+    CsvExporter() = default;
+    // destructor
+    ~CsvExporter();
+
+    bool start(const QString& path, const PacketRecordStore* store);
+    void cancel();
+    bool finish();
+    bool isRunning() const;
+    bool isFinished() const;
+    size_t rowsWritten() const;
+    size_t totalRows() const;
+    QString errorString() const;
+
+private:
+    std::thread exportThread;
+    std::atomic<bool> running{false};
+    std::atomic<bool> finished{false};
+    std::atomic<bool> cancelled{false};
+    std::atomic<size_t> written{0};
+    size_t total = 0;
+    bool succeeded = false;
+    QString error;
+
+    /*------------------------------------------------- Funtion Prototypes ---------------------------------------------------------------*/
+    void exportRecords(QString path, const PacketRecordStore* store);
+};
+#endif // CSVEXPORTER_H
@@ -0,0 +1,792 @@
+/*----------------------------------------------------------------------------------------------------------------------------
+ * SOURCE FILE:    datagramsocket.cpp
+ *
+ * FUNCTIONS:      DatagramSocket::DatagramSocket()
+ *                 DatagramSocket::~DatagramSocket()
+ *                 bool DatagramSocket::open(const struct sockaddr* address, socklen_t addressLen, bool useIoRing)
+ *                 void DatagramSocket::close()
+ *                 bool DatagramSocket::isOpen() const
+ *                 bool DatagramSocket::usingIoRing() const
+ *                 bool DatagramSocket::attachPacketRing(const char* interfaceName)
+ *                 bool DatagramSocket::usingPacketRing() const
+ *                 intptr_t DatagramSocket::descriptor() const
+ *                 int DatagramSocket::receive(void* const* buffers, size_t capacity, struct DatagramInfo* infos, int count)
+ *                 bool DatagramSocket::discard()
+ *                 bool DatagramSocket::send(const void* data, size_t length, const struct sockaddr* destination, socklen_t destinationLen)
+ *                 void DatagramSocket::flush()
+ *                 bool DatagramSocket::startIoRing()
+ *                 void DatagramSocket::stopIoRing()
+ *                 void DatagramSocket::armIoRingReceive()
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - io_uring mode
+ *                 October 18th, 2026 - Packet ring mode
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * NOTES:
+ * The file contains the native UDP socket used by the forwarding path
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+
+#include "datagramsocket.h"
+#include "packetring.h"
+
+#include <string.h>
+
+#if !defined(_WIN32)
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+#if defined(IO_RING_SUPPORTED)
+    #include <sys/eventfd.h>
+#endif
+#if defined(PACKET_RING_SUPPORTED)
+    #include <linux/filter.h>
+#endif
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define DATAGRAM_RING_ENTRIES       (DATAGRAM_BATCH_SIZE * 2)       // Submission entries: the receive and every send slot
+#define DATAGRAM_RECEIVE_TAG        DATAGRAM_BATCH_SIZE             // user_data of the receive; sends use their slot index
+#define DATAGRAM_RECEIVE_GROUP      0
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::DatagramSocket
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      DatagramSocket::DatagramSocket()
+ *
+ * RETURNS:        an instance of DatagramSocket
+ *
+ * NOTES:
+ * Constructor of DatagramSocket class, the socket is created by open()
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+DatagramSocket::DatagramSocket()
+{
+#if defined(__linux__)
+    memset(headers, 0, sizeof(headers));
+    for (int i = 0; i < DATAGRAM_BATCH_SIZE; i++)
+    {
+        headers[i].msg_hdr.msg_iov = &vectors[i];
+        headers[i].msg_hdr.msg_iovlen = 1;
+    }
+#endif
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::~DatagramSocket
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      DatagramSocket::~DatagramSocket()
+ *
+ * NOTES:
+ * Destructor of DatagramSocket class
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+DatagramSocket::~DatagramSocket()
+{
+    close();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::open
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool DatagramSocket::open(const struct sockaddr* address, socklen_t addressLen, bool useIoRing)
+ *
+ * RETURNS:        bool, true if the socket was created and bound
+ *
+ * NOTES:
+ * Creates a non-blocking UDP socket of the address family of address and binds it there.
+ * With useIoRing the socket is driven by an io_uring when the kernel allows it; usingIoRing() tells whether it is.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool DatagramSocket::open(const struct sockaddr* address, socklen_t addressLen, bool useIoRing)
+{
+    close();
+
+#if defined(_WIN32)
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+    {
+        return false;
+    }
+    fd = socket(address->sa_family, SOCK_DGRAM, IPPROTO_UDP);
+    u_long nonBlocking = 1;
+    if (fd == INVALID_SOCKET || ioctlsocket(fd, FIONBIO, &nonBlocking) != 0 || bind(fd, address, addressLen) != 0)
+    {
+        close();
+        return false;
+    }
+#else
+    fd = socket(address->sa_family, SOCK_DGRAM, 0);
+    if (fd < 0 || fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) < 0 || bind(fd, address, addressLen) < 0)
+    {
+        close();
+        return false;
+    }
+#endif
+#if defined(IO_RING_SUPPORTED)
+    if (useIoRing)
+    {
+        ringActive = startIoRing();
+    }
+#else
+    (void)useIoRing;
+#endif
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::close
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Releases the io_uring and the packet ring
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void DatagramSocket::close()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Closes the socket if it is open; queued io_uring sends and packet ring frames are submitted first
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void DatagramSocket::close()
+{
+#if defined(PACKET_RING_SUPPORTED)
+    delete packetRing;
+    packetRing = nullptr;
+#endif
+#if defined(IO_RING_SUPPORTED)
+    if (ringActive)
+    {
+        flush();
+        stopIoRing();
+    }
+#endif
+#if defined(_WIN32)
+    if (fd != INVALID_SOCKET)
+    {
+        closesocket(fd);
+        fd = INVALID_SOCKET;
+        WSACleanup();
+    }
+#else
+    if (fd >= 0)
+    {
+        ::close(fd);
+        fd = -1;
+    }
+#endif
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::isOpen
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool DatagramSocket::isOpen() const
+ *
+ * RETURNS:        bool, true while the socket is open
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool DatagramSocket::isOpen() const
+{
+#if defined(_WIN32)
+    return fd != INVALID_SOCKET;
+#else
+    return fd >= 0;
+#endif
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::usingIoRing
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool DatagramSocket::usingIoRing() const
+ *
+ * RETURNS:        bool, true while the socket is driven by an io_uring
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool DatagramSocket::usingIoRing() const
+{
+#if defined(IO_RING_SUPPORTED)
+    return ringActive;
+#else
+    return false;
+#endif
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::attachPacketRing
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool DatagramSocket::attachPacketRing(const char* interfaceName)
+ *
+ * RETURNS:        bool, false if the socket is not bound to an IPv4 address, is in io_uring mode, or the ring cannot
+ *                 be opened; the socket is left as it was then
+ *
+ * NOTES:
+ * Receives and sends the socket's datagrams through a PacketRing on interfaceName from now on
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool DatagramSocket::attachPacketRing(const char* interfaceName)
+{
+#if defined(PACKET_RING_SUPPORTED)
+    struct sockaddr_storage local;
+    socklen_t localLen = sizeof(local);
+    if (!isOpen() || usingIoRing() || packetRing != nullptr || getsockname(fd, reinterpret_cast<struct sockaddr*>(&local), &localLen) < 0
+        || local.ss_family != AF_INET)
+    {
+        return false;
+    }
+
+    PacketRing* ring = new PacketRing();
+    if (!ring->open(interfaceName, reinterpret_cast<struct sockaddr_in*>(&local)))
+    {
+        delete ring;
+        return false;
+    }
+    struct sock_filter dropAll = BPF_STMT(BPF_RET | BPF_K, 0);
+    struct sock_fprog program;
+    program.len = 1;
+    program.filter = &dropAll;
+    if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof(program)) < 0)
+    {
+        delete ring;
+        return false;
+    }
+    packetRing = ring;
+    return true;
+#else
+    (void)interfaceName;
+    return false;
+#endif
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::usingPacketRing
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool DatagramSocket::usingPacketRing() const
+ *
+ * RETURNS:        bool, true while a packet ring is attached
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool DatagramSocket::usingPacketRing() const
+{
+    return packetRing != nullptr;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::descriptor
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - The ring's eventfd in io_uring mode
+ *                 October 18th, 2026 - The packet socket in packet ring mode
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      intptr_t DatagramSocket::descriptor() const
+ *
+ * RETURNS:        intptr_t, the native descriptor to watch for readability
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+intptr_t DatagramSocket::descriptor() const
+{
+#if defined(PACKET_RING_SUPPORTED)
+    if (packetRing != nullptr)
+    {
+        return (intptr_t)packetRing->descriptor();
+    }
+#endif
+#if defined(IO_RING_SUPPORTED)
+    if (ringActive)
+    {
+        return (intptr_t)eventFd;
+    }
+#endif
+    return (intptr_t)fd;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::receive
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Takes completed receives from the ring in io_uring mode
+ *                 October 18th, 2026 - Reads frames from the packet ring in packet ring mode
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int DatagramSocket::receive(void* const* buffers, size_t capacity, struct DatagramInfo* infos, int count)
+ *
+ * RETURNS:        int, the number of datagrams read, 0 when none are waiting, -1 on error
+ *
+ * NOTES:
+ * Reads up to count datagrams, at most DATAGRAM_BATCH_SIZE, the i-th into buffers[i]; datagrams longer than capacity
+ * are truncated. The source address and length of each one are stored in infos.
+ * In io_uring mode the payloads are copied out of the provided buffers, which go straight back to the kernel, and
+ * completed sends free their slots.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int DatagramSocket::receive(void* const* buffers, size_t capacity, struct DatagramInfo* infos, int count)
+{
+    if (count > DATAGRAM_BATCH_SIZE)
+    {
+        count = DATAGRAM_BATCH_SIZE;
+    }
+
+#if defined(PACKET_RING_SUPPORTED)
+    if (packetRing != nullptr)
+    {
+        return packetRing->receive(buffers, capacity, infos, count);
+    }
+#endif
+#if defined(IO_RING_SUPPORTED)
+    if (ringActive)
+    {
+        // Cleared before reaping, so a completion posted from here on signals the descriptor again
+        uint64_t signalled;
+        while (read(eventFd, &signalled, sizeof(signalled)) < 0 && errno == EINTR)
+        {
+        }
+
+        int received = 0;
+        struct io_uring_cqe* cqe;
+        while (received < count && (cqe = ioRingPeekCqe(&ring)) != NULL)
+        {
+            if (cqe->user_data == DATAGRAM_RECEIVE_TAG)
+            {
+                if (cqe->res >= 0 && (cqe->flags & IORING_CQE_F_BUFFER))
+                {
+                    uint16_t bufferId = (uint16_t)(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+                    unsigned char* buffer = receiveArea + bufferId * receiveBufferLen;
+                    struct ioRecvMsg message;
+                    if (ioRecvMsgParse(buffer, (unsigned)cqe->res, &receiveHeader, &message))
+                    {
+                        size_t length = (message.payloadLen < capacity) ? message.payloadLen : capacity;
+                        memcpy(buffers[received], message.payload, length);
+                        memset(&infos[received].source, 0, sizeof(infos[received].source));
+                        memcpy(&infos[received].source, message.name, message.nameLen);
+                        infos[received].length = (int64_t)length;
+                        received++;
+                    }
+                    ioBufferRingAdd(&receiveRing, buffer, (unsigned)receiveBufferLen, bufferId, 0);
+                    ioBufferRingAdvance(&receiveRing, 1);
+                }
+                if (!(cqe->flags & IORING_CQE_F_MORE))
+                {
+                    receiveArmed = false;
+                }
+            }
+            else if (cqe->user_data < DATAGRAM_BATCH_SIZE)
+            {
+                sendSlots[cqe->user_data].busy = false;
+            }
+            ioRingCqeSeen(&ring);
+        }
+        if (!receiveArmed)
+        {
+            armIoRingReceive();
+            ioRingSubmit(&ring, 0);
+        }
+        return received;
+    }
+#endif
+
+#if defined(__linux__)
+    for (int i = 0; i < count; i++)
+    {
+        vectors[i].iov_base = buffers[i];
+        vectors[i].iov_len = capacity;
+        headers[i].msg_hdr.msg_name = &infos[i].source;
+        headers[i].msg_hdr.msg_namelen = sizeof(infos[i].source);
+    }
+
+    int received;
+    do
+    {
+        received = recvmmsg(fd, headers, count, MSG_DONTWAIT, NULL);
+    } while (received < 0 && errno == EINTR);
+    if (received < 0)
+    {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+    for (int i = 0; i < received; i++)
+    {
+        infos[i].length = headers[i].msg_len;
+    }
+    return received;
+#else
+    int received = 0;
+    while (received < count)
+    {
+        socklen_t sourceLen = sizeof(infos[received].source);
+    #if defined(_WIN32)
+        int length = recvfrom(fd, (char*)buffers[received], (int)capacity, 0, (struct sockaddr*)&infos[received].source, &sourceLen);
+        if (length == SOCKET_ERROR)
+        {
+            int error = WSAGetLastError();
+            // A truncated datagram is still delivered
+            if (error == WSAEMSGSIZE)
+            {
+                length = (int)capacity;
+            }
+            else
+            {
+                return (received > 0 || error == WSAEWOULDBLOCK || error == WSAECONNRESET) ? received : -1;
+            }
+        }
+    #else
+        ssize_t length = recvfrom(fd, buffers[received], capacity, 0, (struct sockaddr*)&infos[received].source, &sourceLen);
+        if (length < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return (received > 0 || errno == EAGAIN || errno == EWOULDBLOCK) ? received : -1;
+        }
+    #endif
+        infos[received].length = length;
+        received++;
+    }
+    return received;
+#endif
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::discard
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Drops a completed receive in io_uring mode
+ *                 October 18th, 2026 - Drops a frame in packet ring mode
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool DatagramSocket::discard()
+ *
+ * RETURNS:        bool, true if a datagram was waiting and has been thrown away
+ *
+ * NOTES:
+ * Used when there is nowhere to put the next datagram
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool DatagramSocket::discard()
+{
+    char byte;
+#if defined(IO_RING_SUPPORTED) || defined(PACKET_RING_SUPPORTED)
+    if (usingIoRing() || usingPacketRing())
+    {
+        void* buffer = &byte;
+        struct DatagramInfo info;
+        return receive(&buffer, sizeof(byte), &info, 1) == 1;
+    }
+#endif
+#if defined(_WIN32)
+    int length = recv(fd, &byte, sizeof(byte), 0);
+    return length != SOCKET_ERROR || WSAGetLastError() == WSAEMSGSIZE;
+#else
+    return recv(fd, &byte, sizeof(byte), MSG_DONTWAIT) >= 0;
+#endif
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::send
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Queued as a sendmsg request in io_uring mode
+ *                 October 18th, 2026 - Written to the packet ring in packet ring mode
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool DatagramSocket::send(const void* data, size_t length, const struct sockaddr* destination,
+ *                     socklen_t destinationLen
+ *                 )
+ *
+ * RETURNS:        bool, true if the whole datagram was handed to the kernel, or queued
+ *
+ * NOTES:
+ * A queued datagram is copied, so data may be reused as soon as this returns.
+ * When it cannot be queued the queue is submitted before it is sent with sendto.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool DatagramSocket::send(const void* data, size_t length, const struct sockaddr* destination, socklen_t destinationLen)
+{
+#if defined(PACKET_RING_SUPPORTED)
+    if (packetRing != nullptr && destination->sa_family == AF_INET)
+    {
+        if (packetRing->send(data, length, reinterpret_cast<const struct sockaddr_in*>(destination)))
+        {
+            return true;
+        }
+        packetRing->flush();
+    }
+#endif
+#if defined(IO_RING_SUPPORTED)
+    if (ringActive && length <= DATAGRAM_SLOT_LEN)
+    {
+        for (int i = 0; i < DATAGRAM_BATCH_SIZE; i++)
+        {
+            SendSlot* slot = &sendSlots[i];
+            if (slot->busy)
+            {
+                continue;
+            }
+            struct io_uring_sqe* sqe = ioRingGetSqe(&ring);
+            if (sqe == NULL)
+            {
+                break;
+            }
+            memcpy(slot->data, data, length);
+            memcpy(&slot->destination, destination, destinationLen);
+            slot->vector.iov_len = length;
+            slot->header.msg_namelen = destinationLen;
+            slot->busy = true;
+            ioRingPrepSendMsg(sqe, fd, &slot->header);
+            sqe->user_data = (uint64_t)i;
+            return true;
+        }
+        // What is queued goes first, so datagrams leave in the order they were sent
+        flush();
+    }
+#endif
+#if defined(_WIN32)
+    return sendto(fd, (const char*)data, (int)length, 0, destination, destinationLen) == (int)length;
+#else
+    ssize_t sent;
+    do
+    {
+        sent = sendto(fd, data, length, 0, destination, destinationLen);
+    } while (sent < 0 && errno == EINTR);
+    return sent == (ssize_t)length;
+#endif
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::flush
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Kicks the packet ring
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void DatagramSocket::flush()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Submits the sends queued in io_uring mode, or the frames written to the packet ring, with one system call;
+ * does nothing otherwise
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void DatagramSocket::flush()
+{
+#if defined(PACKET_RING_SUPPORTED)
+    if (packetRing != nullptr)
+    {
+        packetRing->flush();
+    }
+#endif
+#if defined(IO_RING_SUPPORTED)
+    if (ringActive)
+    {
+        ioRingSubmit(&ring, 0);
+    }
+#endif
+}
+
+#if defined(IO_RING_SUPPORTED)
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::startIoRing
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool DatagramSocket::startIoRing()
+ *
+ * RETURNS:        bool, false if io_uring or one of the features used is unavailable; nothing is left set up then
+ *
+ * NOTES:
+ * Creates the ring, its eventfd, the provided receive buffers and the send slots, and arms the multishot recvmsg
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool DatagramSocket::startIoRing()
+{
+    memset(&receiveRing, 0, sizeof(receiveRing));
+    if (ioRingInit(&ring, DATAGRAM_RING_ENTRIES) < 0)
+    {
+        return false;
+    }
+    eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventFd < 0 || ioRingRegister(&ring, IORING_REGISTER_EVENTFD, &eventFd, 1) < 0
+        || ioBufferRingInit(&ring, &receiveRing, DATAGRAM_RING_BUFFERS, DATAGRAM_RECEIVE_GROUP) < 0)
+    {
+        stopIoRing();
+        return false;
+    }
+
+    memset(&receiveHeader, 0, sizeof(receiveHeader));
+    receiveHeader.msg_namelen = sizeof(struct sockaddr_storage);
+    receiveBufferLen = sizeof(struct io_uring_recvmsg_out) + sizeof(struct sockaddr_storage) + DATAGRAM_SLOT_LEN;
+    receiveArea = new unsigned char[DATAGRAM_RING_BUFFERS * receiveBufferLen];
+    for (int i = 0; i < DATAGRAM_RING_BUFFERS; i++)
+    {
+        ioBufferRingAdd(&receiveRing, receiveArea + i * receiveBufferLen, (unsigned)receiveBufferLen, (uint16_t)i, i);
+    }
+    ioBufferRingAdvance(&receiveRing, DATAGRAM_RING_BUFFERS);
+
+    sendSlots = new SendSlot[DATAGRAM_BATCH_SIZE];
+    memset(sendSlots, 0, DATAGRAM_BATCH_SIZE * sizeof(SendSlot));
+    for (int i = 0; i < DATAGRAM_BATCH_SIZE; i++)
+    {
+        sendSlots[i].vector.iov_base = sendSlots[i].data;
+        sendSlots[i].header.msg_iov = &sendSlots[i].vector;
+        sendSlots[i].header.msg_iovlen = 1;
+        sendSlots[i].header.msg_name = &sendSlots[i].destination;
+    }
+
+    // Kernels without multishot recvmsg reject it as soon as it is submitted
+    armIoRingReceive();
+    struct io_uring_cqe* cqe;
+    if (ioRingSubmit(&ring, 0) < 0
+        || ((cqe = ioRingPeekCqe(&ring)) != NULL && cqe->res < 0 && !(cqe->flags & IORING_CQE_F_MORE)))
+    {
+        stopIoRing();
+        return false;
+    }
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::stopIoRing
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void DatagramSocket::stopIoRing()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Releases the ring and everything registered with it; requests still in flight are cancelled
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void DatagramSocket::stopIoRing()
+{
+    ioBufferRingDestroy(&ring, &receiveRing);
+    ioRingDestroy(&ring);
+    if (eventFd >= 0)
+    {
+        ::close(eventFd);
+        eventFd = -1;
+    }
+    delete[] receiveArea;
+    receiveArea = nullptr;
+    delete[] sendSlots;
+    sendSlots = nullptr;
+    ringActive = false;
+    receiveArmed = false;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DatagramSocket::armIoRingReceive
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void DatagramSocket::armIoRingReceive()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Queues the multishot recvmsg; it keeps posting a completion per datagram until it runs out of buffers or fails
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void DatagramSocket::armIoRingReceive()
+{
+    struct io_uring_sqe* sqe = ioRingGetSqe(&ring);
+    if (sqe == NULL)
+    {
+        ioRingSubmit(&ring, 0);
+        if ((sqe = ioRingGetSqe(&ring)) == NULL)
+        {
+            return;
+        }
+    }
+    ioRingPrepRecvMsgMultishot(sqe, fd, &receiveHeader, DATAGRAM_RECEIVE_GROUP);
+    sqe->user_data = DATAGRAM_RECEIVE_TAG;
+    receiveArmed = true;
+}
+#endif
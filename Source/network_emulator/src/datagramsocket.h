@@ -0,0 +1,134 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * DATAGRAMSOCKET CLASS DECLARATION FILE:       datagramsocket.h
+ *
+ * DATE:                                        October 18th, 2026
+ *
+ * REVISIONS:                                   October 18th, 2026 - Optional io_uring mode
+ *                                              October 18th, 2026 - Optional packet ring mode
+ *
+ * DESIGNER:                                    Derek Wong
+ *
+ * PROGRAMMER:                                  Derek Wong
+ *
+ * NOTES:
+ * Declaration file for DatagramSocket class
+ *
+ * A native UDP socket for the forwarding path. Datagrams are read in batches straight into buffers owned by the
+ * caller and sent from them to socket addresses resolved once, so nothing is allocated or copied per packet.
+ * On Linux the socket can instead be driven by an io_uring: one multishot recvmsg keeps receiving into a ring of
+ * provided buffers and sends are queued as sendmsg requests, submitted together by flush().
+ * A PacketRing can take over instead, exchanging frames with the interface directly.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef DATAGRAMSOCKET_H
+#define DATAGRAMSOCKET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <sys/socket.h>
+    #include <sys/uio.h>
+    #include <netinet/in.h>
+#endif
+
+#include "../../ioring.h"
+
+class PacketRing;
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define DATAGRAM_BATCH_SIZE     32      // Datagrams read per system call, and sends queued with io_uring
+#define DATAGRAM_RING_BUFFERS   64      // Provided receive buffers with io_uring, a power of two
+#define DATAGRAM_SLOT_LEN       2048    // Largest datagram received or queued through io_uring
+
+/*------------------------------------------------ Structs --------------------------------------------------------------------------*/
+struct DatagramInfo
+{
+    struct sockaddr_storage source;
+    int64_t length;                     // Bytes received, at most the buffer capacity
+};
+
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * CLASS:           DatagramSocket
+ *
+ * DATE:            October 18th, 2026
+ *
+ * REVISIONS:       October 18th, 2026 - io_uring mode, chosen when opening
+ *                  October 18th, 2026 - Packet ring mode, attached after opening
+ *
+ * DESIGNER:        Derek Wong
+ *
+ * PROGRAMMER:      Derek Wong
+ *
+ * NOTES:
+ * Non-blocking UDP socket; the owner watches descriptor() for readability and drains it with receive().
+ * On Linux a batch is read with one recvmmsg call, elsewhere with a recvfrom per datagram.
+ * In io_uring mode descriptor() is an eventfd signalled on every completion, receive() hands out the completed
+ * receives and send() copies the datagram into a send slot; the owner calls flush() once it has queued a burst.
+ * A send that finds no free slot, or is longer than DATAGRAM_SLOT_LEN, is sent at once with sendto.
+ * With a packet ring attached, descriptor() is the ring's packet socket and the bound socket only sends what the
+ * ring cannot; a filter makes it drop everything it receives, so the kernel does not answer port unreachable.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+class DatagramSocket
+{
+public:
+    // constructor
+    DatagramSocket();
+    // destructor
+    ~DatagramSocket();
+
+    bool open(const struct sockaddr* address, socklen_t addressLen, bool useIoRing = false);
+    void close();
+    bool isOpen() const;
+    bool usingIoRing() const;
+    bool attachPacketRing(const char* interfaceName);
+    bool usingPacketRing() const;
+    intptr_t descriptor() const;
+    int receive(void* const* buffers, size_t capacity, struct DatagramInfo* infos, int count);
+    bool discard();
+    bool send(const void* data, size_t length, const struct sockaddr* destination, socklen_t destinationLen);
+    void flush();
+
+private:
+#if defined(IO_RING_SUPPORTED)
+    struct SendSlot
+    {
+        struct msghdr header;
+        struct iovec vector;
+        struct sockaddr_storage destination;
+        bool busy;
+        unsigned char data[DATAGRAM_SLOT_LEN];
+    };
+
+    bool startIoRing();
+    void stopIoRing();
+    void armIoRingReceive();
+#endif
+
+#if defined(_WIN32)
+    SOCKET fd = INVALID_SOCKET;
+#else
+    int fd = -1;
+#endif
+    PacketRing* packetRing = nullptr;
+#if defined(__linux__)
+    // Reused by every receive, only the buffer pointers change between calls
+    struct mmsghdr headers[DATAGRAM_BATCH_SIZE];
+    struct iovec vectors[DATAGRAM_BATCH_SIZE];
+#endif
+#if defined(IO_RING_SUPPORTED)
+    struct ioRing ring;
+    struct ioBufferRing receiveRing;
+    struct msghdr receiveHeader;                        // Name length reserved at the front of each receive buffer
+    unsigned char* receiveArea = nullptr;               // DATAGRAM_RING_BUFFERS buffers of receiveBufferLen bytes
+    size_t receiveBufferLen = 0;
+    SendSlot* sendSlots = nullptr;                      // DATAGRAM_BATCH_SIZE slots
+    int eventFd = -1;
+    bool ringActive = false;
+    bool receiveArmed = false;
+#endif
+};
+#endif // DATAGRAMSOCKET_H
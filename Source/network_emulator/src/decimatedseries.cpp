@@ -0,0 +1,296 @@
+/*----------------------------------------------------------------------------------------------------------------------------
+ * SOURCE FILE:    decimatedseries.cpp
+ *
+ * FUNCTIONS:      DecimatedSeries::DecimatedSeries()
+ *                 void DecimatedSeries::append(double x, double y)
+ *                 void DecimatedSeries::clear()
+ *                 bool DecimatedSeries::isDirty() const
+ *                 void DecimatedSeries::points(QVector<QPointF>& out)
+ *                 double DecimatedSeries::maxX() const
+ *                 double DecimatedSeries::maxY() const
+ *                 void DecimatedSeries::halveResolution()
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * NOTES:
+ * Bounded-memory min/max decimation for the time-sequence chart
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+
+#include "decimatedseries.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DecimatedSeries::DecimatedSeries
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      DecimatedSeries::DecimatedSeries()
+ *
+ * RETURNS:        an instance of DecimatedSeries
+ *
+ * NOTES:
+ * Constructor of DecimatedSeries class
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+DecimatedSeries::DecimatedSeries()
+{
+    clear();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DecimatedSeries::append
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void DecimatedSeries::append(double x, double y)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Folds a point into the bucket covering x; negative x is clamped to the first bucket
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void DecimatedSeries::append(double x, double y)
+{
+    if (x < 0) x = 0;
+    while (x >= bucketWidth * DECIMATED_SERIES_BUCKETS)
+    {
+        halveResolution();
+    }
+
+    int index = static_cast<int>(x / bucketWidth);
+    if (index >= DECIMATED_SERIES_BUCKETS) index = DECIMATED_SERIES_BUCKETS - 1;
+
+    SeriesBucket& bucket = buckets[index];
+    if (!bucket.used)
+    {
+        bucket = SeriesBucket{true, x, y, x, y};
+    }
+    else if (y < bucket.minY)
+    {
+        bucket.minX = x;
+        bucket.minY = y;
+    }
+    else if (y > bucket.maxY)
+    {
+        bucket.maxX = x;
+        bucket.maxY = y;
+    }
+
+    if (index >= bucketCount) bucketCount = index + 1;
+    if (x > largestX) largestX = x;
+    if (y > largestY) largestY = y;
+    dirty = true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DecimatedSeries::clear
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void DecimatedSeries::clear()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Removes every point and restores the initial resolution
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void DecimatedSeries::clear()
+{
+    for (int i = 0; i < DECIMATED_SERIES_BUCKETS; i++)
+    {
+        buckets[i].used = false;
+    }
+    bucketCount = 0;
+    bucketWidth = DECIMATED_SERIES_BUCKET_WIDTH_S;
+    largestX = 0;
+    largestY = 0;
+    dirty = true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DecimatedSeries::isDirty
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool DecimatedSeries::isDirty() const
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * True if points were added or cleared since the last call to points()
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool DecimatedSeries::isDirty() const
+{
+    return dirty;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DecimatedSeries::points
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void DecimatedSeries::points(QVector<QPointF>& out)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Fills out with the decimated points in x order, reusing its storage
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void DecimatedSeries::points(QVector<QPointF>& out)
+{
+    out.resize(0);
+    for (int i = 0; i < bucketCount; i++)
+    {
+        const SeriesBucket& bucket = buckets[i];
+        if (!bucket.used) continue;
+
+        if (bucket.minX == bucket.maxX && bucket.minY == bucket.maxY)
+        {
+            out.append(QPointF(bucket.minX, bucket.minY));
+        }
+        else if (bucket.minX <= bucket.maxX)
+        {
+            out.append(QPointF(bucket.minX, bucket.minY));
+            out.append(QPointF(bucket.maxX, bucket.maxY));
+        }
+        else
+        {
+            out.append(QPointF(bucket.maxX, bucket.maxY));
+            out.append(QPointF(bucket.minX, bucket.minY));
+        }
+    }
+    dirty = false;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DecimatedSeries::maxX
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      double DecimatedSeries::maxX() const
+ *
+ * RETURNS:        double
+ *
+ * NOTES:
+ * Largest x appended since the last clear
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+double DecimatedSeries::maxX() const
+{
+    return largestX;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DecimatedSeries::maxY
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      double DecimatedSeries::maxY() const
+ *
+ * RETURNS:        double
+ *
+ * NOTES:
+ * Largest y appended since the last clear
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+double DecimatedSeries::maxY() const
+{
+    return largestY;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       DecimatedSeries::halveResolution
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void DecimatedSeries::halveResolution()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Merges bucket pairs (2i, 2i + 1) into bucket i and doubles the bucket width
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void DecimatedSeries::halveResolution()
+{
+    for (int i = 0; i < DECIMATED_SERIES_BUCKETS / 2; i++)
+    {
+        SeriesBucket merged = buckets[2 * i];
+        const SeriesBucket& second = buckets[2 * i + 1];
+
+        if (!merged.used)
+        {
+            merged = second;
+        }
+        else if (second.used)
+        {
+            if (second.minY < merged.minY)
+            {
+                merged.minX = second.minX;
+                merged.minY = second.minY;
+            }
+            if (second.maxY > merged.maxY)
+            {
+                merged.maxX = second.maxX;
+                merged.maxY = second.maxY;
+            }
+        }
+        buckets[i] = merged;
+    }
+    for (int i = DECIMATED_SERIES_BUCKETS / 2; i < DECIMATED_SERIES_BUCKETS; i++)
+    {
+        buckets[i].used = false;
+    }
+
+    bucketCount = (bucketCount + 1) / 2;
+    bucketWidth *= 2;
+}
@@ -0,0 +1,77 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * DECIMATEDSERIES CLASS DECLARATION FILE:      decimatedseries.h
+ *
+ * DATE:                                        October 18th, 2026
+ *
+ * REVISIONS:                                   N/A
+ *
+ * DESIGNER:                                    Derek Wong
+ *
+ * PROGRAMMER:                                  Derek Wong
+ *
+ * NOTES:
+ * Declaration file for DecimatedSeries class
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef DECIMATEDSERIES_H
+#define DECIMATEDSERIES_H
+
+#include <QPointF>
+#include <QVector>
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define DECIMATED_SERIES_BUCKETS            2048    // At most two points are drawn per bucket
+#define DECIMATED_SERIES_BUCKET_WIDTH_S     0.001   // Initial bucket width, doubled each time the buckets run out
+
+/*------------------------------------------------ Structs --------------------------------------------------------------------------*/
+struct SeriesBucket
+{
+    bool used;
+    double minX;
+    double minY;
+    double maxX;
+    double maxY;
+};
+
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * CLASS:           DecimatedSeries
+ *
+ * DATE:            October 18th, 2026
+ *
+ * REVISIONS:       N/A
+ *
+ * DESIGNER:        Derek Wong
+ *
+ * PROGRAMMER:      Derek Wong
+ *
+ * NOTES:
+ * Min/max decimation of an x-y series into a fixed number of equal-width x buckets starting at x = 0.
+ * Each bucket keeps its lowest and highest point, so spikes survive decimation. When a point lands past the last
+ * bucket, neighbouring buckets are merged pairwise and the bucket width doubles, so memory and the number of points
+ * handed to the chart stay bounded however long the capture runs. Points may arrive slightly out of x order.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+class DecimatedSeries
+{
+public:
+    // constructor
+    DecimatedSeries();
+
+    void append(double x, double y);
+    void clear();
+    bool isDirty() const;
+    void points(QVector<QPointF>& out);
+    double maxX() const;
+    double maxY() const;
+
+private:
+    SeriesBucket buckets[DECIMATED_SERIES_BUCKETS];
+    int bucketCount = 0;
+    double bucketWidth = DECIMATED_SERIES_BUCKET_WIDTH_S;
+    double largestX = 0;
+    double largestY = 0;
+    bool dirty = false;
+
+    /*------------------------------------------------- Funtion Prototypes ---------------------------------------------------------------*/
+    void halveResolution();
+};
+#endif // DECIMATEDSERIES_H
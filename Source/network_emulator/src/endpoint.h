@@ -0,0 +1,185 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * HEADER FILE:              endpoint.h
+ *
+ * FUNCTION PROTOTYPES:      bool endpointFromSockaddr(const struct sockaddr_storage* address, struct Endpoint* out)
+ *                           bool endpointSameAddress(const struct Endpoint* first, const struct Endpoint* second)
+ *                           bool endpointEquals(const struct Endpoint* first, const struct Endpoint* second)
+ *                           bool endpointIsIPv4(const struct Endpoint* endpoint)
+ *                           uint32_t endpointIPv4(const struct Endpoint* endpoint)
+ *
+ * DATE:                     October 18th, 2026
+ *
+ * REVISIONS:                N/A
+ *
+ * DESIGNER:                 Derek Wong
+ *
+ * PROGRAMMER:               Derek Wong
+ *
+ * NOTES:
+ * Numeric UDP endpoint keys for classifying packets on the forwarding path.
+ * IPv4 addresses are stored IPv4-mapped (::ffff:a.b.c.d), so comparing two endpoints of either family is two 64-bit
+ * compares and a port compare; nothing is formatted or allocated.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef ENDPOINT_H
+#define ENDPOINT_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "datagramsocket.h"
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define ENDPOINT_IPV4_MAPPED_PREFIX     0x0000FFFF00000000ULL   // Upper half of addressLow for an IPv4 address
+
+/*------------------------------------------------ Structs --------------------------------------------------------------------------*/
+struct Endpoint
+{
+    uint64_t addressHigh;               // First 8 bytes of the IPv6 address, big-endian
+    uint64_t addressLow;                // Last 8 bytes of the IPv6 address, big-endian
+    uint16_t port;                      // Host byte order
+};
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       loadBigEndian64
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static inline uint64_t loadBigEndian64(const unsigned char* bytes)
+ *
+ * RETURNS:        uint64_t, the 8 bytes read as a big-endian integer
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline uint64_t loadBigEndian64(const unsigned char* bytes)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       endpointFromSockaddr
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static inline bool endpointFromSockaddr(const struct sockaddr_storage* address, struct Endpoint* out)
+ *
+ * RETURNS:        bool, false if address is neither IPv4 nor IPv6
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline bool endpointFromSockaddr(const struct sockaddr_storage* address, struct Endpoint* out)
+{
+    if (address->ss_family == AF_INET)
+    {
+        const struct sockaddr_in* in = (const struct sockaddr_in*)address;
+        out->addressHigh = 0;
+        out->addressLow = ENDPOINT_IPV4_MAPPED_PREFIX | ntohl(in->sin_addr.s_addr);
+        out->port = ntohs(in->sin_port);
+        return true;
+    }
+    if (address->ss_family == AF_INET6)
+    {
+        const struct sockaddr_in6* in6 = (const struct sockaddr_in6*)address;
+        const unsigned char* bytes = (const unsigned char*)&in6->sin6_addr;
+        out->addressHigh = loadBigEndian64(bytes);
+        out->addressLow = loadBigEndian64(bytes + 8);
+        out->port = ntohs(in6->sin6_port);
+        return true;
+    }
+    memset(out, 0, sizeof(*out));
+    return false;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       endpointSameAddress
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static inline bool endpointSameAddress(const struct Endpoint* first, const struct Endpoint* second)
+ *
+ * RETURNS:        bool, true if both endpoints are on the same host address, whatever their ports
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline bool endpointSameAddress(const struct Endpoint* first, const struct Endpoint* second)
+{
+    return first->addressLow == second->addressLow && first->addressHigh == second->addressHigh;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       endpointEquals
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static inline bool endpointEquals(const struct Endpoint* first, const struct Endpoint* second)
+ *
+ * RETURNS:        bool, true if both the address and the port match
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline bool endpointEquals(const struct Endpoint* first, const struct Endpoint* second)
+{
+    return first->port == second->port && endpointSameAddress(first, second);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       endpointIsIPv4
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static inline bool endpointIsIPv4(const struct Endpoint* endpoint)
+ *
+ * RETURNS:        bool, true for an IPv4 endpoint
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline bool endpointIsIPv4(const struct Endpoint* endpoint)
+{
+    return endpoint->addressHigh == 0 && (endpoint->addressLow >> 32) == (ENDPOINT_IPV4_MAPPED_PREFIX >> 32);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       endpointIPv4
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static inline uint32_t endpointIPv4(const struct Endpoint* endpoint)
+ *
+ * RETURNS:        uint32_t, the IPv4 address in host byte order, 0 for an IPv6 endpoint
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline uint32_t endpointIPv4(const struct Endpoint* endpoint)
+{
+    return endpointIsIPv4(endpoint) ? (uint32_t)endpoint->addressLow : 0;
+}
+#endif // ENDPOINT_H
@@ -5,7 +5,11 @@
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Command line options for endpoints, impairments and headless runs
+ *                 October 18th, 2026 - --io-uring option
+ *                 October 18th, 2026 - --packet-ring option
+ *                 October 18th, 2026 - --corrupt option
+ *                 October 18th, 2026 - --capture, --capture-snaplen and --capture-rotate options
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
@@ -17,13 +21,23 @@
 
 #include "networkemulator.h"
 #include <QApplication>
+#include <QCommandLineParser>
+
+#include <string.h>
 
 /*-------------------------------------------------------------------------------------------------------------------------------
  * FUNCTION:       main
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Parses the command line into an EmulatorConfig; --headless runs without a display
+ *                                      and without showing the window
+ *                 October 18th, 2026 - --io-uring drives the forwarding socket with io_uring
+ *                 October 18th, 2026 - --packet-ring forwards through a packet ring on an interface
+ *                 October 18th, 2026 - --corrupt flips a bit in the packets --loss would drop
+ *                 October 18th, 2026 - --exit-after-eot waits for the EOT_ACK of the last file
+ *                 October 18th, 2026 - --capture writes a pcapng capture from startup, with or without a window;
+ *                                      --capture-snaplen and --capture-rotate set its snap length and rotation size
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
@@ -38,8 +52,83 @@
  * ------------------------------------------------------------------------------------------------------------------------------*/
 int main(int argc, char *argv[])
 {
+    // The platform plugin is chosen when QApplication is constructed, before the parser can run
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--headless") == 0 && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+    }
+
     QApplication a(argc, argv);
-    NetworkEmulator w;
-    w.show();
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Network Emulator");
+    parser.addHelpOption();
+    QCommandLineOption headlessOption("headless", "Run without a window and start forwarding immediately.");
+    QCommandLineOption exitAfterEOTOption("exit-after-eot", "With --headless, exit once the receiver's EOT_ACK of the transfer's last file has been relayed.");
+    QCommandLineOption transmitterIPOption("transmitter-ip", "Transmitter address.", "address");
+    QCommandLineOption transmitterPortOption("transmitter-port", "Transmitter UDP port.", "port");
+    QCommandLineOption receiverIPOption("receiver-ip", "Receiver address.", "address");
+    QCommandLineOption receiverPortOption("receiver-port", "Receiver UDP port.", "port");
+    QCommandLineOption emulatorIPOption("bind-ip", "Address the emulator listens on.", "address");
+    QCommandLineOption emulatorPortOption("bind-port", "UDP port the emulator listens on.", "port");
+    QCommandLineOption delayOption("delay", "Packet delay in ms.", "ms");
+    QCommandLineOption lossOption("loss", "Packet loss in percent.", "percent");
+    QCommandLineOption corruptOption("corrupt", "Flip a random bit in the packets --loss or the profile picks instead of dropping them.");
+    QCommandLineOption profileOption("profile", "Impairment profile to replay instead of --delay and --loss.", "file");
+    QCommandLineOption ioUringOption("io-uring", "Receive and send through io_uring where the kernel offers it.");
+    QCommandLineOption packetRingOption("packet-ring", "Receive and send through a packet ring on the interface carrying the bind address.", "interface");
+    QCommandLineOption captureOption("capture", "Capture the packets arriving at and relayed by the emulator to a pcapng file from startup.", "file");
+    QCommandLineOption captureSnaplenOption("capture-snaplen", QString("Bytes kept of each captured frame, 0-%1; 0 keeps whole frames.").arg(MAX_CAPTURE_SNAPLEN), "bytes");
+    QCommandLineOption captureRotateOption("capture-rotate", QString("Start a new capture file every this many MB, 0-%1; 0 keeps one file.").arg(MAX_CAPTURE_ROTATE_MB), "MB");
+    parser.addOptions({ headlessOption, exitAfterEOTOption, transmitterIPOption, transmitterPortOption, receiverIPOption, receiverPortOption,
+                        emulatorIPOption, emulatorPortOption, delayOption, lossOption, corruptOption, profileOption,
+                        ioUringOption, packetRingOption, captureOption, captureSnaplenOption, captureRotateOption });
+    parser.process(a);
+
+    EmulatorConfig config;
+    config.headless = parser.isSet(headlessOption);
+    config.exitAfterEOT = parser.isSet(exitAfterEOTOption);
+    config.transmitterIP = parser.value(transmitterIPOption);
+    config.transmitterPort = parser.value(transmitterPortOption).toUShort();
+    config.receiverIP = parser.value(receiverIPOption);
+    config.receiverPort = parser.value(receiverPortOption).toUShort();
+    config.emulatorIP = parser.value(emulatorIPOption);
+    config.emulatorPort = parser.value(emulatorPortOption).toUShort();
+    if (parser.isSet(delayOption)) config.delayMs = parser.value(delayOption).toInt();
+    if (parser.isSet(lossOption)) config.errorRatePercent = parser.value(lossOption).toInt();
+    config.corrupt = parser.isSet(corruptOption);
+    config.profilePath = parser.value(profileOption);
+    config.ioUring = parser.isSet(ioUringOption);
+    config.packetRingInterface = parser.value(packetRingOption);
+    config.capturePath = parser.value(captureOption);
+    if (parser.isSet(captureSnaplenOption))
+    {
+        bool ok;
+        config.captureSnaplen = parser.value(captureSnaplenOption).toInt(&ok);
+        if (!ok || config.captureSnaplen < 0 || config.captureSnaplen > MAX_CAPTURE_SNAPLEN)
+        {
+            fprintf(stderr, "--capture-snaplen must be 0-%d\n", MAX_CAPTURE_SNAPLEN);
+            return 1;
+        }
+    }
+    if (parser.isSet(captureRotateOption))
+    {
+        bool ok;
+        config.captureRotateMB = parser.value(captureRotateOption).toInt(&ok);
+        if (!ok || config.captureRotateMB < 0 || config.captureRotateMB > MAX_CAPTURE_ROTATE_MB)
+        {
+            fprintf(stderr, "--capture-rotate must be 0-%d\n", MAX_CAPTURE_ROTATE_MB);
+            return 1;
+        }
+    }
+
+    NetworkEmulator w(config);
+    if (!config.headless)
+    {
+        w.show();
+    }
     return a.exec();
 }
@@ -0,0 +1,475 @@
+/*----------------------------------------------------------------------------------------------------------------------------
+ * SOURCE FILE:    metrics.cpp
+ *
+ * FUNCTIONS:      MetricsRegistry& MetricsRegistry::instance()
+ *                 MetricsRegistry::MetricsRegistry()
+ *                 MetricsRegistry::~MetricsRegistry()
+ *                 void MetricsRegistry::add(MetricCounter counter, uint64_t value)
+ *                 void MetricsRegistry::setGauge(MetricGauge gauge, int64_t value)
+ *                 void MetricsRegistry::observe(MetricHistogram histogram, uint64_t valueUs)
+ *                 void MetricsRegistry::snapshot(MetricsSnapshot& out) const
+ *                 std::string MetricsRegistry::formatPrometheus() const
+ *                 std::string MetricsRegistry::formatLatency() const
+ *                 MetricsRegistry::Shard* MetricsRegistry::localShard()
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Hold times are kept in HDR-style histograms with exported quantiles
+ *                 October 18th, 2026 - Count of packets corrupted
+ *                 October 18th, 2026 - Drop counts of SYN, SYN_ACK and EOT_ACK
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * NOTES:
+ * Per-thread sharded metrics for the Network Emulator, aggregated on read
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+
+#include "metrics.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <new>
+
+/*------------------------------------------------ Metric Names ---------------------------------------------------------------------*/
+struct MetricDescription
+{
+    const char* name;
+    const char* labels;
+    const char* help;
+};
+
+static const MetricDescription COUNTER_DESCRIPTIONS[METRIC_COUNTER_COUNT] = {
+    { "network_emulator_packets_received_total", "", "Packets received from the transmitter or receiver" },
+    { "network_emulator_bytes_received_total", "", "Bytes received from the transmitter or receiver" },
+    { "network_emulator_packets_relayed_total", "", "Packets relayed to the transmitter or receiver" },
+    { "network_emulator_bytes_relayed_total", "", "Bytes relayed to the transmitter or receiver" },
+    { "network_emulator_packets_dropped_total", "type=\"DATA\"", "Packets dropped by the emulator" },
+    { "network_emulator_packets_dropped_total", "type=\"ACK\"", "Packets dropped by the emulator" },
+    { "network_emulator_packets_dropped_total", "type=\"EOT\"", "Packets dropped by the emulator" },
+    { "network_emulator_packets_dropped_total", "type=\"SYN\"", "Packets dropped by the emulator" },
+    { "network_emulator_packets_dropped_total", "type=\"SYN_ACK\"", "Packets dropped by the emulator" },
+    { "network_emulator_packets_dropped_total", "type=\"EOT_ACK\"", "Packets dropped by the emulator" },
+    { "network_emulator_retransmits_total", "", "Retransmitted DATA packets relayed to the receiver" },
+    { "network_emulator_packets_corrupted_total", "", "Packets relayed with a bit flipped by the emulator" }
+};
+
+static const MetricDescription GAUGE_DESCRIPTIONS[METRIC_GAUGE_COUNT] = {
+    { "network_emulator_queue_depth", "link=\"to_receiver\"", "Packets waiting on a link for their delay to elapse" },
+    { "network_emulator_queue_depth", "link=\"to_transmitter\"", "Packets waiting on a link for their delay to elapse" }
+};
+
+static const MetricDescription HISTOGRAM_DESCRIPTIONS[METRIC_HISTOGRAM_COUNT] = {
+    { "network_emulator_hold_time_seconds", "link=\"to_receiver\"", "Time from a packet arriving at the emulator to it being relayed" },
+    { "network_emulator_hold_time_seconds", "link=\"to_transmitter\"", "Time from a packet arriving at the emulator to it being relayed" }
+};
+
+static const MetricDescription QUANTILE_DESCRIPTIONS[METRIC_HISTOGRAM_COUNT] = {
+    { "network_emulator_hold_time_quantile_seconds", "link=\"to_receiver\"", "Hold time percentiles since the emulator started" },
+    { "network_emulator_hold_time_quantile_seconds", "link=\"to_transmitter\"", "Hold time percentiles since the emulator started" }
+};
+
+static const double QUANTILES[METRIC_QUANTILE_COUNT] = { 0.5, 0.9, 0.99, 0.999 };
+
+static thread_local void* threadShard = nullptr;
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       appendFormat
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static void appendFormat(std::string& out, const char* format, ...)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * printf-style append to a string
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static void appendFormat(std::string& out, const char* format, ...)
+{
+    char line[512];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (len > 0) out.append(line, (len < (int)sizeof(line)) ? len : sizeof(line) - 1);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       appendHeader
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static void appendHeader(std::string& out, const MetricDescription* descriptions, int index, const char* type)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Writes the HELP and TYPE lines the first time a metric family appears
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static void appendHeader(std::string& out, const MetricDescription* descriptions, int index, const char* type)
+{
+    if (index > 0 && strcmp(descriptions[index - 1].name, descriptions[index].name) == 0)
+    {
+        return;
+    }
+    appendFormat(out, "# HELP %s %s\n# TYPE %s %s\n", descriptions[index].name, descriptions[index].help, descriptions[index].name, type);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsRegistry::instance
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      MetricsRegistry& MetricsRegistry::instance()
+ *
+ * RETURNS:        MetricsRegistry&
+ *
+ * NOTES:
+ * Returns the process-wide registry
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+MetricsRegistry& MetricsRegistry::instance()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsRegistry::MetricsRegistry
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      MetricsRegistry::MetricsRegistry()
+ *
+ * RETURNS:        an instance of MetricsRegistry
+ *
+ * NOTES:
+ * Constructor of MetricsRegistry class
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+MetricsRegistry::MetricsRegistry()
+{
+    for (int i = 0; i < METRIC_GAUGE_COUNT; i++)
+    {
+        gauges[i].store(0);
+    }
+    for (int i = 0; i < METRIC_HISTOGRAM_COUNT; i++)
+    {
+        histogramInit(&histograms[i]);
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsRegistry::~MetricsRegistry
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      MetricsRegistry::~MetricsRegistry()
+ *
+ * NOTES:
+ * Destructor of MetricsRegistry class
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+MetricsRegistry::~MetricsRegistry()
+{
+    std::lock_guard<std::mutex> guard(shardsLock);
+    for (Shard* shard : shards)
+    {
+        void* allocation = shard->allocation;
+        shard->~Shard();
+        free(allocation);
+    }
+    shards.clear();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsRegistry::add
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void MetricsRegistry::add(MetricCounter counter, uint64_t value)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Adds to a counter in the calling thread's shard
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void MetricsRegistry::add(MetricCounter counter, uint64_t value)
+{
+    std::atomic<uint64_t>& slot = localShard()->counters[counter];
+    slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsRegistry::setGauge
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void MetricsRegistry::setGauge(MetricGauge gauge, int64_t value)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Sets a gauge to the current value of the measured state
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void MetricsRegistry::setGauge(MetricGauge gauge, int64_t value)
+{
+    gauges[gauge].store(value, std::memory_order_relaxed);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsRegistry::observe
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void MetricsRegistry::observe(MetricHistogram histogram, uint64_t valueUs)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Records a duration in microseconds
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void MetricsRegistry::observe(MetricHistogram histogram, uint64_t valueUs)
+{
+    histogramRecord(&histograms[histogram], valueUs);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsRegistry::snapshot
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void MetricsRegistry::snapshot(MetricsSnapshot& out) const
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Sums every thread's shard into out and copies the histograms
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void MetricsRegistry::snapshot(MetricsSnapshot& out) const
+{
+    memset(&out, 0, sizeof(MetricsSnapshot));
+    for (int g = 0; g < METRIC_GAUGE_COUNT; g++)
+    {
+        out.gauges[g] = gauges[g].load(std::memory_order_relaxed);
+    }
+    for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++)
+    {
+        histogramInit(&out.histograms[h]);
+        histogramMerge(&out.histograms[h], &histograms[h]);
+    }
+
+    std::lock_guard<std::mutex> guard(shardsLock);
+    for (const Shard* shard : shards)
+    {
+        for (int c = 0; c < METRIC_COUNTER_COUNT; c++)
+        {
+            out.counters[c] += shard->counters[c].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsRegistry::formatPrometheus
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      std::string MetricsRegistry::formatPrometheus() const
+ *
+ * RETURNS:        std::string
+ *
+ * NOTES:
+ * Formats every metric in the Prometheus text exposition format.
+ * Histograms are exported with power-of-two buckets; a bucket counts the values whose HDR bucket lies entirely at or
+ * below its bound, which is exact up to HISTOGRAM_LINEAR_LIMIT microseconds and within the HDR resolution above it.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+std::string MetricsRegistry::formatPrometheus() const
+{
+    MetricsSnapshot snap;
+    std::string out;
+
+    snapshot(snap);
+    out.reserve(8192);
+
+    for (int c = 0; c < METRIC_COUNTER_COUNT; c++)
+    {
+        const MetricDescription& d = COUNTER_DESCRIPTIONS[c];
+        appendHeader(out, COUNTER_DESCRIPTIONS, c, "counter");
+        appendFormat(out, "%s%s%s%s %llu\n", d.name, *d.labels ? "{" : "", d.labels, *d.labels ? "}" : "", (unsigned long long)snap.counters[c]);
+    }
+
+    for (int g = 0; g < METRIC_GAUGE_COUNT; g++)
+    {
+        const MetricDescription& d = GAUGE_DESCRIPTIONS[g];
+        appendHeader(out, GAUGE_DESCRIPTIONS, g, "gauge");
+        appendFormat(out, "%s{%s} %lld\n", d.name, d.labels, (long long)snap.gauges[g]);
+    }
+
+    for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++)
+    {
+        const MetricDescription& d = HISTOGRAM_DESCRIPTIONS[h];
+        const struct histogram& histogram = snap.histograms[h];
+        uint64_t cumulative = 0;
+        int index = 0;
+        appendHeader(out, HISTOGRAM_DESCRIPTIONS, h, "histogram");
+        for (int b = 0; b < METRIC_HISTOGRAM_BUCKETS - 1; b++)
+        {
+            while (index < HISTOGRAM_BUCKETS && histogramBucketHighest(index) <= (1ull << b))
+            {
+                cumulative += histogram.counts[index++];
+            }
+            appendFormat(out, "%s_bucket{%s,le=\"%g\"} %llu\n", d.name, d.labels, (double)(1ull << b) / 1e6, (unsigned long long)cumulative);
+        }
+        appendFormat(out, "%s_bucket{%s,le=\"+Inf\"} %llu\n", d.name, d.labels, (unsigned long long)histogram.totalCount);
+        appendFormat(out, "%s_sum{%s} %.6f\n", d.name, d.labels, histogram.sum / 1e6);
+        appendFormat(out, "%s_count{%s} %llu\n", d.name, d.labels, (unsigned long long)histogram.totalCount);
+    }
+
+    for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++)
+    {
+        const MetricDescription& d = QUANTILE_DESCRIPTIONS[h];
+        appendHeader(out, QUANTILE_DESCRIPTIONS, h, "gauge");
+        for (int q = 0; q < METRIC_QUANTILE_COUNT; q++)
+        {
+            uint64_t valueUs = histogramValueAtPercentile(&snap.histograms[h], QUANTILES[q] * 100);
+            appendFormat(out, "%s{%s,quantile=\"%g\"} %.6f\n", d.name, d.labels, QUANTILES[q], valueUs / 1e6);
+        }
+    }
+    return out;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsRegistry::formatLatency
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      std::string MetricsRegistry::formatLatency() const
+ *
+ * RETURNS:        std::string
+ *
+ * NOTES:
+ * One line of hold time percentiles per link, in microseconds, for logs and GET /latency
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+std::string MetricsRegistry::formatLatency() const
+{
+    static const char* LINK_NAMES[METRIC_HISTOGRAM_COUNT] = { "transmitter->receiver", "receiver->transmitter" };
+    char summary[256];
+    std::string out;
+
+    for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++)
+    {
+        histogramFormat(&histograms[h], summary, sizeof(summary), "us");
+        appendFormat(out, "%s hold time: %s\n", LINK_NAMES[h], summary);
+    }
+    return out;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsRegistry::localShard
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      MetricsRegistry::Shard* MetricsRegistry::localShard()
+ *
+ * RETURNS:        Shard*
+ *
+ * NOTES:
+ * Returns the calling thread's shard, registering a zeroed, cache-line aligned one on the thread's first call.
+ * Shards outlive their threads so that totals never go backwards.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+MetricsRegistry::Shard* MetricsRegistry::localShard()
+{
+    if (threadShard != nullptr)
+    {
+        return static_cast<Shard*>(threadShard);
+    }
+
+    void* allocation = malloc(sizeof(Shard) + CACHE_LINE_SIZE);
+    if (allocation == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(allocation) + CACHE_LINE_SIZE - 1) & ~static_cast<uintptr_t>(CACHE_LINE_SIZE - 1);
+    Shard* shard = new (reinterpret_cast<void*>(aligned)) Shard();
+    for (int c = 0; c < METRIC_COUNTER_COUNT; c++) shard->counters[c].store(0);
+    shard->allocation = allocation;
+
+    std::lock_guard<std::mutex> guard(shardsLock);
+    shards.push_back(shard);
+    threadShard = shard;
+    return shard;
+}
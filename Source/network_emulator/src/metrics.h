@@ -0,0 +1,128 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * METRICSREGISTRY CLASS DECLARATION FILE:      metrics.h
+ *
+ * DATE:                                        October 18th, 2026
+ *
+ * REVISIONS:                                   October 18th, 2026 - Hold times are kept in HDR-style histograms
+ *                                              October 18th, 2026 - Count of packets corrupted
+ *                                              October 18th, 2026 - Drop counts of SYN, SYN_ACK and EOT_ACK
+ *
+ * DESIGNER:                                    Derek Wong
+ *
+ * PROGRAMMER:                                  Derek Wong
+ *
+ * NOTES:
+ * Declaration file for MetricsRegistry class
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdint.h>
+
+#include "../../histogram.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*------------------------------------------------ Enums ----------------------------------------------------------------------------*/
+enum MetricCounter
+{
+    PACKETS_RECEIVED,
+    BYTES_RECEIVED,
+    PACKETS_RELAYED,
+    BYTES_RELAYED,
+    DATA_DROPPED,
+    ACK_DROPPED,
+    EOT_DROPPED,
+    SYN_DROPPED,
+    SYN_ACK_DROPPED,
+    EOT_ACK_DROPPED,            // The drop counters follow enum PacketType so a packet's is DATA_DROPPED + its type
+    RETRANSMITS,
+    PACKETS_CORRUPTED,
+    METRIC_COUNTER_COUNT
+};
+
+enum MetricGauge
+{
+    TO_RECEIVER_QUEUE_DEPTH,
+    TO_TRANSMITTER_QUEUE_DEPTH,
+    METRIC_GAUGE_COUNT
+};
+
+enum MetricHistogram
+{
+    TO_RECEIVER_HOLD_TIME,
+    TO_TRANSMITTER_HOLD_TIME,
+    METRIC_HISTOGRAM_COUNT
+};
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define METRIC_HISTOGRAM_BUCKETS    32      // Exported bucket i counts values up to 2^i microseconds, the last bucket is unbounded
+#define METRIC_QUANTILE_COUNT       4
+#define CACHE_LINE_SIZE             64
+
+/*------------------------------------------------ Structs --------------------------------------------------------------------------*/
+struct MetricsSnapshot
+{
+    uint64_t counters[METRIC_COUNTER_COUNT];
+    int64_t gauges[METRIC_GAUGE_COUNT];
+    struct histogram histograms[METRIC_HISTOGRAM_COUNT];
+};
+
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * CLASS:           MetricsRegistry
+ *
+ * DATE:            October 18th, 2026
+ *
+ * REVISIONS:       N/A
+ *
+ * DESIGNER:        Derek Wong
+ *
+ * PROGRAMMER:      Derek Wong
+ *
+ * NOTES:
+ * Process-wide counters, gauges and histograms for the forwarding path.
+ * Each thread that records a counter gets its own cache-line aligned shard on first use and is the only writer to it,
+ * so recording is a relaxed load and store with no locking or allocation. Readers sum the shards when they need a value.
+ * Gauges are set by the thread that owns the measured state and are kept once, outside the shards.
+ * Histograms are HDR-style (see histogram.h) and shared between threads; recording is O(1) and lock-free.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+class MetricsRegistry
+{
+public:
+    static MetricsRegistry& instance();
+
+    void add(MetricCounter counter, uint64_t value = 1);
+    void setGauge(MetricGauge gauge, int64_t value);
+    void observe(MetricHistogram histogram, uint64_t valueUs);
+    void snapshot(MetricsSnapshot& out) const;
+    std::string formatPrometheus() const;
+    std::string formatLatency() const;
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Shard
+    {
+        std::atomic<uint64_t> counters[METRIC_COUNTER_COUNT];
+        void* allocation;
+    };
+
+    mutable std::mutex shardsLock;
+    std::vector<Shard*> shards;
+    std::atomic<int64_t> gauges[METRIC_GAUGE_COUNT];
+    struct histogram histograms[METRIC_HISTOGRAM_COUNT];
+
+    // constructor
+    MetricsRegistry();
+    // destructor
+    ~MetricsRegistry();
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /*------------------------------------------------- Funtion Prototypes ---------------------------------------------------------------*/
+    Shard* localShard();
+};
+#endif // METRICS_H
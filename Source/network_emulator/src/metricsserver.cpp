@@ -0,0 +1,186 @@
+/*----------------------------------------------------------------------------------------------------------------------------
+ * SOURCE FILE:    metricsserver.cpp
+ *
+ * FUNCTIONS:      MetricsServer::MetricsServer(QObject *parent)
+ *                 bool MetricsServer::listen(quint16 port)
+ *                 void MetricsServer::acceptConnection()
+ *                 void MetricsServer::handleRequest()
+ *                 void MetricsServer::sendResponse(QTcpSocket* socket, const char* status, const QByteArray& body)
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Added GET /latency
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * NOTES:
+ * Serves the metrics registry over HTTP for Prometheus or curl
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+
+#include "metricsserver.h"
+#include "metrics.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsServer::MetricsServer
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      MetricsServer::MetricsServer(QObject *parent)
+ *
+ * RETURNS:        an instance of MetricsServer
+ *
+ * NOTES:
+ * Constructor of MetricsServer class
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+MetricsServer::MetricsServer(QObject *parent)
+    : QObject(parent)
+{
+    server = new QTcpServer(this);
+    connect(server, SIGNAL(newConnection()), this, SLOT(acceptConnection()));
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsServer::listen
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool MetricsServer::listen(quint16 port)
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * Starts listening on 127.0.0.1:port
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool MetricsServer::listen(quint16 port)
+{
+    return server->listen(QHostAddress::LocalHost, port);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsServer::acceptConnection
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void MetricsServer::acceptConnection()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Accepts pending connections and waits for their request line
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void MetricsServer::acceptConnection()
+{
+    while (QTcpSocket* socket = server->nextPendingConnection())
+    {
+        connect(socket, SIGNAL(readyRead()), this, SLOT(handleRequest()));
+        connect(socket, SIGNAL(disconnected()), socket, SLOT(deleteLater()));
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsServer::handleRequest
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - GET /latency returns the hold time percentiles
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void MetricsServer::handleRequest()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Answers the request line once it has arrived; headers are ignored
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void MetricsServer::handleRequest()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (socket == nullptr)
+    {
+        return;
+    }
+    if (!socket->canReadLine())
+    {
+        if (socket->bytesAvailable() > METRICS_MAX_REQUEST_LEN) socket->abort();
+        return;
+    }
+
+    // Stop reading once the request line is in; the response closes the connection
+    disconnect(socket, SIGNAL(readyRead()), this, SLOT(handleRequest()));
+    QList<QByteArray> request = socket->readLine(METRICS_MAX_REQUEST_LEN).trimmed().split(' ');
+
+    if (request.size() < 2 || request[0] != "GET")
+    {
+        sendResponse(socket, "405 Method Not Allowed", "only GET is supported\n");
+    }
+    else if (request[1] == "/metrics")
+    {
+        std::string body = MetricsRegistry::instance().formatPrometheus();
+        sendResponse(socket, "200 OK", QByteArray(body.data(), static_cast<int>(body.size())));
+    }
+    else if (request[1] == "/latency")
+    {
+        std::string body = MetricsRegistry::instance().formatLatency();
+        sendResponse(socket, "200 OK", QByteArray(body.data(), static_cast<int>(body.size())));
+    }
+    else
+    {
+        sendResponse(socket, "404 Not Found", "try /metrics or /latency\n");
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       MetricsServer::sendResponse
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void MetricsServer::sendResponse(QTcpSocket* socket, const char* status, const QByteArray& body)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Writes a plain-text response and closes the connection once it has been sent
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void MetricsServer::sendResponse(QTcpSocket* socket, const char* status, const QByteArray& body)
+{
+    QByteArray response;
+    response.reserve(body.size() + 128);
+    response += "HTTP/1.0 ";
+    response += status;
+    response += "\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\nContent-Length: ";
+    response += QByteArray::number(body.size());
+    response += "\r\nConnection: close\r\n\r\n";
+    response += body;
+
+    socket->write(response);
+    socket->disconnectFromHost();
+}
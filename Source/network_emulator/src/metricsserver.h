@@ -0,0 +1,65 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * METRICSSERVER CLASS DECLARATION FILE:        metricsserver.h
+ *
+ * DATE:                                        October 18th, 2026
+ *
+ * REVISIONS:                                   October 18th, 2026 - Added GET /latency
+ *
+ * DESIGNER:                                    Derek Wong
+ *
+ * PROGRAMMER:                                  Derek Wong
+ *
+ * NOTES:
+ * Declaration file for MetricsServer class
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef METRICSSERVER_H
+#define METRICSSERVER_H
+
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define METRICS_PORT                9105
+#define METRICS_MAX_REQUEST_LEN     4096
+
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * CLASS:           MetricsServer
+ *
+ * DATE:            October 18th, 2026
+ *
+ * REVISIONS:       N/A
+ *
+ * DESIGNER:        Derek Wong
+ *
+ * PROGRAMMER:      Derek Wong
+ *
+ * NOTES:
+ * Minimal HTTP/1.0 endpoint on the loopback interface serving GET /metrics in the Prometheus text format
+ * and GET /latency, a plain-text summary of the hold time percentiles.
+ * Runs on the event loop of the thread that created it; one request per connection.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+class MetricsServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    // constructor
+    explicit MetricsServer(QObject *parent = nullptr);
+
+    bool listen(quint16 port);
+
+/*------------------------------------------------- Private Slots ---------------------------------------------------------------------*/
+private slots:
+    void acceptConnection();
+
+    void handleRequest();
+
+private:
+    QTcpServer* server = nullptr;
+
+    /*------------------------------------------------- Funtion Prototypes ---------------------------------------------------------------*/
+    void sendResponse(QTcpSocket* socket, const char* status, const QByteArray& body);
+};
+#endif // METRICSSERVER_H
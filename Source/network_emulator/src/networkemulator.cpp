@@ -8,20 +8,46 @@
  *                 void NetworkEmulator::on_resetButton_clicked()
  *                 void NetworkEmulator::onNetworkDelaySliderChange()
  *                 void NetworkEmulator::onBitErrorRateSliderChange()
+ *                 void NetworkEmulator::onCorruptCheckBoxToggled(bool checked)
+ *                 void NetworkEmulator::on_loadProfileButton_clicked()
+ *                 bool NetworkEmulator::loadProfile(const QString& filename)
+ *                 void NetworkEmulator::on_captureButton_clicked()
+ *                 bool NetworkEmulator::startCapture(const QString& filename)
+ *                 void NetworkEmulator::stopCapture()
+ *                 void NetworkEmulator::releaseDelayedPackets()
+ *                 void NetworkEmulator::updateExportProgress()
+ *                 void NetworkEmulator::refreshTimeSequence()
+ *                 void NetworkEmulator::finishHeadless()
  *                 QStandardItemModel* NetworkEmulator::convertAbstractModelToStandard(QAbstractItemModel* model)
  *                 void NetworkEmulator::resetFiguresState()
  *                 void NetworkEmulator::init()
+ *                 socklen_t NetworkEmulator::resolveSockaddr(const QString& address, quint16 port, struct sockaddr_storage* out)
+ *                 void NetworkEmulator::processDatagram(quint32 handle, qint64 length, const struct sockaddr_storage* source)
  *                 bool NetworkEmulator::dropPkt(int prob)
- *                 void NetworkEmulator::averagePktDelay(int delayInMS)
- *                 void NetworkEmulator::relayPacket(QHostAddress* sender, quint16 senderPort, QTime* relTime, QString relTimeString)
- *                 void NetworkEmulator::recordPacket(QHostAddress* sender, quint16 senderPort, QTime* relTime, QString relTimeString)
- *                 void NetworkEmulator::updatePacketTable(struct packet* packet, QHostAddress* sourceIP, quint16 sourcePort, const char* destinationIP, int destinationPort, bool isDropped, QString relTime, QColor rowColor)
- *                 void NetworkEmulator::updateNetworkSummaryTable(QString relTime)
- *                 void NetworkEmulator::updateTimeSequence(struct packet* pkt, QHostAddress* sourceIP, QTime* relTime)
+ *                 void NetworkEmulator::corruptPkt(quint32 handle, qint64 length)
+ *                 void NetworkEmulator::delayPacket(quint32 handle, qint64 length, const Endpoint* sender, QTime* relTime, QString relTimeString, int delayMs, int bandwidthKbps)
+ *                 void NetworkEmulator::scheduleRelease()
+ *                 void NetworkEmulator::setSlidersEnabled(bool enabled)
+ *                 void NetworkEmulator::capturePacket(int interfaceId, quint32 sourceAddr, quint16 sourcePort, quint32 destinationAddr, quint16 destinationPort, const char* comment)
+ *                 void NetworkEmulator::relayPacket(const Endpoint* sender, QTime* relTime, QString relTimeString)
+ *                 void NetworkEmulator::recordPacket(const Endpoint* sender, QTime* relTime, QString relTimeString)
+ *                 bool NetworkEmulator::fromTransmitter(const Endpoint* sender)
+ *                 void NetworkEmulator::learnStream(const Endpoint* sender)
+ *                 int NetworkEmulator::learnedStream(const struct packet* pkt)
+ *                 QString NetworkEmulator::formatEndpointAddress(const Endpoint* endpoint)
+ *                 void NetworkEmulator::updatePacketTable(struct packet* packet, const Endpoint* source, const Endpoint* destination, bool isDropped, QTime* relTime, QString relTimeString, QColor rowColor)
+ *                 void NetworkEmulator::updateNetworkSummaryTable()
+ *                 void NetworkEmulator::updateTimeSequence(struct packet* pkt, const Endpoint* source, QTime* relTime)
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Bit flip impairment: the packets the error rate picks can be corrupted
+ *                                      instead of dropped
+ *                 October 18th, 2026 - Stream ports are also learned from SYN and EOT; headless runs end after the
+ *                                      connection's last EOT_ACK
+ *                 October 18th, 2026 - Datagrams are relayed and captured at the length they arrived with
+ *                 October 18th, 2026 - Capture snap length and rotation size are settings; a capture can be started
+ *                                      from the command line
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
@@ -32,9 +58,12 @@
  * ----------------------------------------------------------------------------------------------------------------------------*/
 
 #include "../logger.h"
+#include "../packetpool.h"
 #include "networkemulator.h"
 #include "ui_networkemulator.h"
 
+#include <chrono>
+
 QT_CHARTS_USE_NAMESPACE
 
 static const int RELATIVE_TIME_INDEX = 0;
@@ -67,29 +96,122 @@ static const int retransmitIndex = 3;
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Takes endpoints, impairments and headless operation from an EmulatorConfig
+ *                 October 18th, 2026 - Creates the packet pool in place of a single packet buffer
+ *                 October 18th, 2026 - Resolves the relay destinations to socket addresses
+ *                 October 18th, 2026 - Resolves the transmitter, receiver and emulator endpoint keys
+ *                 October 18th, 2026 - Takes the io_uring choice from the EmulatorConfig
+ *                 October 18th, 2026 - Takes the bit flip choice from the EmulatorConfig
+ *                 October 18th, 2026 - packetSize is no longer fixed; each datagram sets its own
+ *                 October 18th, 2026 - Opens the log file
+ *                 October 18th, 2026 - Takes the capture settings from the EmulatorConfig and starts its capture
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
  * PROGRAMMER:     Derek Wong, Maksym Chumak
  *
- * INTERFACE:      NetworkEmulator::NetworkEmulator(QWidget *parent)
+ * INTERFACE:      NetworkEmulator::NetworkEmulator(const EmulatorConfig& config, QWidget *parent)
  *
  * RETURNS:        an instance of NetworkEmulator
  *
  * NOTES:
  * Constructor of NetworkEmulator class
+ * A headless emulator starts forwarding immediately; the chart and summary table are never refreshed.
+ * A capture file in the config is opened before forwarding starts, with or without a window
  * ----------------------------------------------------------------------------------------------------------------------------*/
-NetworkEmulator::NetworkEmulator(QWidget *parent)
+NetworkEmulator::NetworkEmulator(const EmulatorConfig& config, QWidget *parent)
     : QMainWindow(parent), ui(new Ui::NetworkEmulator)
 {
+    openLog();
+
+    // Datagrams are read into pool slots and stay there until they are relayed or dropped
+    packetPool = new struct packetPool;
+    packetCache = new struct packetPoolCache;
+    packetPoolInit(packetPool, EMULATOR_POOL_PACKETS);
+    packetPoolCacheInit(packetCache, packetPool);
+    for (int i = 0; i < DATAGRAM_BATCH_SIZE; i++)
+    {
+        receiveRing[i] = PACKET_HANDLE_NONE;
+    }
 
-    packetSize = sizeof(struct packet);
-    pkt = (struct packet *)malloc(packetSize);
+    transmitterAddress = config.transmitterIP.isEmpty() ? QString(TRANSMITTER_IP) : config.transmitterIP;
+    transmitterUdpPort = (config.transmitterPort != 0) ? config.transmitterPort : TRANSMITTER_PORT;
+    receiverAddress = config.receiverIP.isEmpty() ? QString(RECEIVER_IP) : config.receiverIP;
+    receiverUdpPort = (config.receiverPort != 0) ? config.receiverPort : RECEIVER_PORT;
+    emulatorAddress = config.emulatorIP.isEmpty() ? QString(NETWORK_EMULATOR_IP) : config.emulatorIP;
+    emulatorUdpPort = (config.emulatorPort != 0) ? config.emulatorPort : NETWORK_EMULATOR_PORT;
+    if (config.delayMs >= 0) defaultNetworkDelay = config.delayMs;
+    if (config.errorRatePercent >= 0) defaultErrorRatePercent = config.errorRatePercent;
+    networkDelay = defaultNetworkDelay;
+    errorRatePercent = defaultErrorRatePercent;
+    corrupt = config.corrupt;
+    headless = config.headless;
+    exitAfterEOT = config.exitAfterEOT;
+    ioUring = config.ioUring;
+    packetRingInterface = config.packetRingInterface;
+    captureSnaplen = config.captureSnaplen;
+    captureRotateMB = config.captureRotateMB;
 
     ui->setupUi(this);
     setWindowTitle("Network Emulator");
     init();
+
+    // Delayed packets are released from the event loop instead of blocking it
+    linkClock.start();
+    releaseTimer = new QTimer(this);
+    releaseTimer->setSingleShot(true);
+    releaseTimer->setTimerType(Qt::PreciseTimer);
+    connect(releaseTimer, SIGNAL(timeout()), this, SLOT(releaseDelayedPackets()));
+
+    // Addresses are kept numerically for the packet record store and captures
+    captureTransmitterAddr = QHostAddress(transmitterAddress).toIPv4Address();
+    captureReceiverAddr = QHostAddress(receiverAddress).toIPv4Address();
+    captureEmulatorAddr = QHostAddress(emulatorAddress).toIPv4Address();
+    transmitterSockaddrLen = resolveSockaddr(transmitterAddress, transmitterUdpPort, &transmitterSockaddr);
+    receiverSockaddrLen = resolveSockaddr(receiverAddress, receiverUdpPort, &receiverSockaddr);
+    if (transmitterSockaddrLen == 0 || receiverSockaddrLen == 0)
+    {
+        logToFile(static_cast<LogType>(ERROR), NULL, "transmitter and receiver must be given as IP addresses");
+    }
+    struct sockaddr_storage emulatorSockaddr;
+    resolveSockaddr(emulatorAddress, emulatorUdpPort, &emulatorSockaddr);
+    endpointFromSockaddr(&transmitterSockaddr, &transmitterEndpoint);
+    endpointFromSockaddr(&receiverSockaddr, &receiverEndpoint);
+    endpointFromSockaddr(&emulatorSockaddr, &emulatorEndpoint);
+
+    exportTimer = new QTimer(this);
+    exportTimer->setInterval(EXPORT_PROGRESS_INTERVAL_MS);
+    connect(exportTimer, SIGNAL(timeout()), this, SLOT(updateExportProgress()));
+
+    // The time-sequence chart is redrawn at most once per frame from the decimated series
+    chartTimer = new QTimer(this);
+    connect(chartTimer, SIGNAL(timeout()), this, SLOT(refreshTimeSequence()));
+    if (!headless) chartTimer->start(TIME_SEQUENCE_FRAME_MS);
+
+    // Statistics are recorded lock-free on the forwarding path and read here and by the metrics endpoint
+    MetricsRegistry::instance().snapshot(metricsBaseline);
+    summaryTimer = new QTimer(this);
+    connect(summaryTimer, SIGNAL(timeout()), this, SLOT(updateNetworkSummaryTable()));
+    if (!headless) summaryTimer->start(SUMMARY_REFRESH_INTERVAL_MS);
+
+    metricsServer = new MetricsServer(this);
+    if (!metricsServer->listen(METRICS_PORT))
+    {
+        logToFile(static_cast<LogType>(ERROR), NULL, "could not serve metrics on 127.0.0.1:%d", METRICS_PORT);
+    }
+
+    if (!config.profilePath.isEmpty())
+    {
+        loadProfile(config.profilePath);
+    }
+    if (!config.capturePath.isEmpty())
+    {
+        startCapture(config.capturePath);
+    }
+    if (headless)
+    {
+        on_startButton_clicked();
+    }
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------
@@ -97,7 +219,7 @@ NetworkEmulator::NetworkEmulator(QWidget *parent)
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Releases the packet pool
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
@@ -110,7 +232,9 @@ NetworkEmulator::NetworkEmulator(QWidget *parent)
  * ----------------------------------------------------------------------------------------------------------------------------*/
 NetworkEmulator::~NetworkEmulator()
 {
-    delete pkt;
+    packetPoolDestroy(packetPool);
+    delete packetCache;
+    delete packetPool;
     delete ui;
 }
 
@@ -119,7 +243,13 @@ NetworkEmulator::~NetworkEmulator()
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Delay and loss can be driven by a replayed impairment profile;
+ *                                      delayed packets are queued instead of busy-waiting
+ *                 October 18th, 2026 - Records packet, byte and drop counters in the metrics registry;
+ *                                      the summary table is refreshed by a timer instead of per packet
+ *                 October 18th, 2026 - Datagrams are read into packet pool slots instead of a new byte array each
+ *                 October 18th, 2026 - Reads batches from the native socket into a ring of pool slots;
+ *                                      each datagram is handled by processDatagram
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
@@ -130,50 +260,161 @@ NetworkEmulator::~NetworkEmulator()
  * RETURNS:        void
  *
  * NOTES:
- * Listens for incoming packets on the specified port
- * Applies average delay specified by network delay value
- * Drops a packet with a probability specified by Bit Error Rate (BER)
- * Updates UI
+ * Called when the socket is readable; drains it DATAGRAM_BATCH_SIZE datagrams at a time.
+ * A slot handed to processDatagram leaves the ring and is replaced from the pool before the next batch.
  * ----------------------------------------------------------------------------------------------------------------------------*/
 void NetworkEmulator::processPendingDatagram()
 {
-    while (udpSocket->hasPendingDatagrams())
+    while (true)
+    {
+        int slots = 0;
+        while (slots < DATAGRAM_BATCH_SIZE)
+        {
+            if (receiveRing[slots] == PACKET_HANDLE_NONE && (receiveRing[slots] = packetPoolAlloc(packetCache)) == PACKET_HANDLE_NONE)
+            {
+                break;
+            }
+            receiveBuffers[slots] = packetPoolGet(packetPool, receiveRing[slots]);
+            slots++;
+        }
+        if (slots == 0)
+        {
+            // Every slot is held by a delayed packet
+            if (!datagramSocket.discard())
+            {
+                break;
+            }
+            logToFile(static_cast<LogType>(ERROR), NULL, "packet pool exhausted, datagram discarded");
+            continue;
+        }
+
+        int count = datagramSocket.receive(receiveBuffers, PACKET_POOL_SLOT_LEN, receiveInfos, slots);
+        if (count < 0)
+        {
+            logToFile(static_cast<LogType>(ERROR), NULL, "recvfrom error");
+        }
+        for (int i = 0; i < count; i++)
+        {
+            packetHandle handle = receiveRing[i];
+            receiveRing[i] = PACKET_HANDLE_NONE;
+            processDatagram(handle, receiveInfos[i].length, &receiveInfos[i].source);
+        }
+        if (count < slots)
+        {
+            break;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::processDatagram
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Learns the transmitter socket of each stream from its DATA
+ *                 October 18th, 2026 - Corrupts the packets the error rate picks instead of dropping them when asked to
+ *                 October 18th, 2026 - Also learns the first stream's socket from the SYN and EOT, which may come first
+ *                 October 18th, 2026 - Counts drops of SYN, SYN_ACK and EOT_ACK
+ *                 October 18th, 2026 - Captures the datagram at the length it arrived with
+ *
+ * DESIGNER:       Derek Wong, Maksym Chumak
+ *
+ * PROGRAMMER:     Derek Wong, Maksym Chumak
+ *
+ * INTERFACE:      void NetworkEmulator::processDatagram(quint32 handle, qint64 length, const struct sockaddr_storage* source)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Takes ownership of a received datagram's pool slot
+ * Applies network delay and bandwidth from the sliders or from a loaded impairment profile
+ * Drops a packet with a probability specified by Bit Error Rate (BER) or by the profile, or with corrupt set relays
+ * it with one bit flipped, for the receiver's and transmitter's checksums to catch
+ * Updates UI
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void NetworkEmulator::processDatagram(quint32 handle, qint64 length, const struct sockaddr_storage* source)
+{
+    Endpoint sender;
+    endpointFromSockaddr(source, &sender);
+    pkt = packetPoolGet(packetPool, handle);
+    packetSize = static_cast<int>(length);
+
+    // Get relative time since network initialization
+    gettimeofday(&end, NULL);
+    QTime relTime(0,0);
+    relTime = relTime.addMSecs(delay(start, end));
+    QString relTimeString = relTime.toString("m:ss:zzz");
+
+    if (pause)
     {
-        QByteArray datagram;
-        datagram.resize(udpSocket->pendingDatagramSize());
+        packetPoolFree(packetCache, handle);
+        return;
+    }
+    // Note: Packets are not filtered at this point, they can come from any host
+    // Filter only for packets coming from either transmitter or receiver
+    if (endpointSameAddress(&sender, &transmitterEndpoint) || endpointSameAddress(&sender, &receiverEndpoint))
+    {
+        int delayMs = networkDelay;
+        int bandwidthKbps = 0;
+        bool drop;
+        bool corrupted = false;
 
-        QHostAddress sender;
-        quint16 senderPort;
+        if (traceReplay.isOpen())
+        {
+            // The replay clock starts with the first packet so that repeated runs line up with the profile
+            if (profileStartMs < 0) profileStartMs = linkClock.elapsed();
+            const ImpairmentSample& sample = traceReplay.sampleAt(linkClock.elapsed() - profileStartMs);
+            delayMs = sample.delayMs;
+            bandwidthKbps = sample.bandwidthKbps;
+            drop = traceReplay.dropPkt(sample.lossPercent);
+        }
+        else
+        {
+            drop = dropPkt(errorRatePercent);
+        }
+        if (drop && corrupt)
+        {
+            corrupted = true;
+            drop = false;
+        }
 
-        // read and store datagram
-        udpSocket->readDatagram(datagram.data(), datagram.size(), &sender, &senderPort);
-        pkt = static_cast<struct packet *>((void *)datagram.data());
+        MetricsRegistry::instance().add(PACKETS_RECEIVED);
+        MetricsRegistry::instance().add(BYTES_RECEIVED, length);
+        if (drop && pkt->packetType >= DATA && pkt->packetType <= EOT_ACK)
+        {
+            MetricsRegistry::instance().add(static_cast<MetricCounter>(DATA_DROPPED + pkt->packetType));
+        }
 
-        // Get relative time since network initialization
-        gettimeofday(&end, NULL);
-        QTime relTime(0,0);
-        relTime = relTime.addMSecs(delay(start, end));
-        QString relTimeString = relTime.toString("m:ss:zzz");
+        capturePacket(CAPTURE_INGRESS_INTERFACE, endpointIPv4(&sender), sender.port, captureEmulatorAddr, emulatorUdpPort, drop ? "dropped" : nullptr);
 
-        if (pause) continue;
-        // Note: Packets are not filtered at this point, they can come from any host
-        // Filter only for packets coming from either transmitter or receiver
-        if (QString::compare(sender.toString(), TRANSMITTER_IP) == 0 || (QString::compare(sender.toString(), RECEIVER_IP) == 0))
+        if ((pkt->packetType == DATA || pkt->packetType == SYN || pkt->packetType == EOT) && fromTransmitter(&sender))
         {
-            // Add network delay bi-directionally
-            averagePktDelay(networkDelay);
+            learnStream(&sender);
+        }
 
-            if (!dropPkt(errorRatePercent))
-            {
-                relayPacket(&sender, senderPort, &relTime, relTimeString);
-            }
-            else
-            {
-                // Update dropped packet on UI but don't forward packet
-                recordPacket(&sender, senderPort, &relTime, relTimeString);
-            }
-            updateNetworkSummaryTable(relTimeString);
+        // Damaged after it has been captured and routed, as if on the link beyond the emulator
+        if (corrupted)
+        {
+            MetricsRegistry::instance().add(PACKETS_CORRUPTED);
+            corruptPkt(handle, length);
+        }
+
+        if (!drop)
+        {
+            // Add network delay bi-directionally
+            delayPacket(handle, length, &sender, &relTime, relTimeString, delayMs, bandwidthKbps);
         }
+        else
+        {
+            // Update dropped packet on UI but don't forward packet
+            recordPacket(&sender, &relTime, relTimeString);
+            packetPoolFree(packetCache, handle);
+        }
+        lastRelTimeString = relTimeString;
+    }
+    else
+    {
+        packetPoolFree(packetCache, handle);
     }
 }
 
@@ -182,7 +423,10 @@ void NetworkEmulator::processPendingDatagram()
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Binds the configured emulator address; a failed bind is logged
+ *                 October 18th, 2026 - Opens the native datagram socket and watches it for readability
+ *                 October 18th, 2026 - The socket uses io_uring when asked to and available
+ *                 October 18th, 2026 - Attaches a packet ring when an interface is given
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
@@ -205,11 +449,27 @@ void NetworkEmulator::on_startButton_clicked()
         // start timer
         gettimeofday(&start, NULL);
     }
-    if (udpSocket == nullptr)
+    if (!datagramSocket.isOpen())
     {
-        udpSocket = new QUdpSocket(this);
-        udpSocket->bind(QHostAddress(QString(NETWORK_EMULATOR_IP)), NETWORK_EMULATOR_PORT);
-        connect(udpSocket, SIGNAL(readyRead()), this, SLOT(processPendingDatagram()));
+        struct sockaddr_storage emulatorSockaddr;
+        socklen_t emulatorSockaddrLen = resolveSockaddr(emulatorAddress, emulatorUdpPort, &emulatorSockaddr);
+        if (emulatorSockaddrLen == 0 || !datagramSocket.open(reinterpret_cast<struct sockaddr*>(&emulatorSockaddr), emulatorSockaddrLen,
+                                                             ioUring && packetRingInterface.isEmpty()))
+        {
+            logToFile(static_cast<LogType>(ERROR), NULL, "could not bind %s:%d", emulatorAddress.toLocal8Bit().constData(), emulatorUdpPort);
+            return;
+        }
+        if (ioUring && packetRingInterface.isEmpty() && !datagramSocket.usingIoRing())
+        {
+            logToFile(static_cast<LogType>(INFO), NULL, "io_uring unavailable, using the event loop");
+        }
+        if (!packetRingInterface.isEmpty() && !datagramSocket.attachPacketRing(packetRingInterface.toLocal8Bit().constData()))
+        {
+            logToFile(static_cast<LogType>(INFO), NULL, "could not open a packet ring on %s, using the socket",
+                      packetRingInterface.toLocal8Bit().constData());
+        }
+        readNotifier = new QSocketNotifier(datagramSocket.descriptor(), QSocketNotifier::Read, this);
+        connect(readNotifier, SIGNAL(activated(int)), this, SLOT(processPendingDatagram()));
     }
 }
 
@@ -243,7 +503,8 @@ void NetworkEmulator::on_stopButton_clicked()
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Streams the packet records to the file on a background thread
+ *                                      instead of building the whole CSV from the table model
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
@@ -251,130 +512,571 @@ void NetworkEmulator::on_stopButton_clicked()
  *
  * INTERFACE:      bool NetworkEmulator::on_saveButton_clicked()
  *
- * RETURNS:        bool
+ * RETURNS:        bool, true if the export was started
  *
  * NOTES:
  * Saves content of the packet table to a csv file
+ * Progress is shown in the status bar until the export completes
  * ----------------------------------------------------------------------------------------------------------------------------*/
 bool NetworkEmulator::on_saveButton_clicked()
 {
+    if (csvExporter.isRunning())
+    {
+        ui->statusbar->showMessage("An export is already in progress");
+        return false;
+    }
+
     QString filename = QFileDialog::getSaveFileName(this, "Save Packets", "packets.csv", "CSV files (.csv)", 0);
-    QSaveFile file(filename);
-    if (!file.open(QFile::WriteOnly |QFile::Truncate))
+    if (filename.isEmpty())
     {
         return false;
     }
 
-    QString csvData;
-    for (int i = 0; i < ui->packetTable->model()->rowCount(); i++)
+    if (!csvExporter.start(filename, &packetRecords))
+    {
+        return false;
+    }
+    ui->saveButton->setEnabled(false);
+    exportTimer->start();
+    updateExportProgress();
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::on_resetButton_clicked
+ *
+ * DATE:           December 3rd, 2020
+ *
+ * REVISIONS:      October 18th, 2026 - Cancels a running export and clears the packet record store
+ *                 October 18th, 2026 - Summary counts restart from the current metrics
+ *                 October 18th, 2026 - Discarded in-flight packets are returned to the packet pool
+ *                 October 18th, 2026 - A loaded profile is rewound to its start instead of unloaded
+ *
+ * DESIGNER:       Derek Wong, Maksym Chumak
+ *
+ * PROGRAMMER:     Derek Wong, Maksym Chumak
+ *
+ * INTERFACE:      void NetworkEmulator::on_resetButton_clicked()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Resets state of the application to the initial
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void NetworkEmulator::on_resetButton_clicked()
+{
+    pause = true;
+
+    // The record store cannot be cleared while the exporter is reading it
+    if (csvExporter.isRunning())
     {
-        int numColumns = ui->packetTable->model()->columnCount();
-        for (int j = 0; j < numColumns; j++)
+        csvExporter.cancel();
+        csvExporter.finish();
+        exportTimer->stop();
+        ui->saveButton->setEnabled(true);
+        ui->statusbar->showMessage("Export cancelled");
+    }
+    packetRecords.clear();
+
+    if (QStandardItemModel* packetTableModel = convertAbstractModelToStandard(ui->packetTable->model()))
+    {
+        packetTableModel->clear();
+        delete packetTableModel;
+        packetTableModel = nullptr;
+    }
+
+    if (QStandardItemModel* networkSummaryTableModel = convertAbstractModelToStandard(ui->networkSummaryTable->model()))
+    {
+        networkSummaryTableModel->clear();
+        delete networkSummaryTableModel;
+        networkSummaryTableModel = nullptr;
+    }
+
+    // Discard packets still in flight and return control to the sliders
+    releaseTimer->stop();
+    for (int link = 0; link < LINK_COUNT; link++)
+    {
+        for (const DelayedPacket& delayed : linkQueues[link])
         {
-            QString value = ui->packetTable->model()->data(ui->packetTable->model()->index(i, j)).toString();
-            csvData += value;
-            if (j != (numColumns -1))
-            {
-               csvData += ",";
-            }
+            packetPoolFree(packetCache, delayed.handle);
+        }
+        linkQueues[link].clear();
+        linkFreeUs[link] = 0;
+        MetricsRegistry::instance().setGauge(static_cast<MetricGauge>(TO_RECEIVER_QUEUE_DEPTH + link), 0);
+    }
+    MetricsRegistry::instance().snapshot(metricsBaseline);
+    lastRelTimeString.clear();
+    // The next run replays the profile from its first sample and drops the same packets again
+    if (traceReplay.isOpen())
+    {
+        if (traceReplay.rewind())
+        {
+            profileStartMs = -1;
+        }
+        else
+        {
+            logToFile(static_cast<LogType>(ERROR), NULL, "could not rewind profile %s", traceReplay.fileName().toLocal8Bit().constData());
+            on_loadProfileButton_clicked();
         }
-        csvData += "\r\n";
     }
 
-    QByteArray dataArray = csvData.toLocal8Bit();
-    char* buffer = dataArray.data();
-    if (-1 == file.write(buffer))
+    resetFiguresState();
+    init();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::onNetworkDelaySliderChange
+ *
+ * DATE:           December 3rd, 2020
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong, Maksym Chumak
+ *
+ * PROGRAMMER:     Derek Wong, Maksym Chumak
+ *
+ * INTERFACE:      void NetworkEmulator::onNetworkDelaySliderChange()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Updates network delay value when the slider is moved
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void NetworkEmulator::onNetworkDelaySliderChange()
+{
+    networkDelay = ui->packetDelaySlider->value();
+    ui->packetDelayLabel->setText("Packet Delay (ms): " + QString::number(networkDelay));
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::onNetworkDelaySliderChange
+ *
+ * DATE:           December 3rd, 2020
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong, Maksym Chumak
+ *
+ * PROGRAMMER:     Derek Wong, Maksym Chumak
+ *
+ * INTERFACE:      void NetworkEmulator::onNetworkDelaySliderChange()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Updates Bit Error Rate (BER) value when the slider is moved
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void NetworkEmulator::onBitErrorRateSliderChange()
+{
+    errorRatePercent = ui->bitErrorRateSlider->value();
+    ui->bitErrorRateLabel->setText("Bit Error Rate: " + QString::number(errorRatePercent) + "%");
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::onCorruptCheckBoxToggled
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void NetworkEmulator::onCorruptCheckBoxToggled(bool checked)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Switches the Bit Error Rate between dropping packets and flipping a bit in them
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void NetworkEmulator::onCorruptCheckBoxToggled(bool checked)
+{
+    corrupt = checked;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::on_loadProfileButton_clicked
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Loading moved to loadProfile so profiles can be given on the command line
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void NetworkEmulator::on_loadProfileButton_clicked()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Loads an impairment profile that drives delay, loss and bandwidth in place of the sliders;
+ * clicking again while a profile is loaded unloads it and hands control back to the sliders
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void NetworkEmulator::on_loadProfileButton_clicked()
+{
+    if (traceReplay.isOpen())
+    {
+        traceReplay.close();
+        ui->loadProfileButton->setText("Load Profile");
+        ui->statusbar->clearMessage();
+        setSlidersEnabled(true);
+        return;
+    }
+
+    QString filename = QFileDialog::getOpenFileName(this, "Load Impairment Profile", "", "Profiles (*.csv *.bin);;All files (*)");
+    if (filename.isEmpty())
+    {
+        return;
+    }
+    loadProfile(filename);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::loadProfile
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool NetworkEmulator::loadProfile(const QString& filename)
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * Starts replaying an impairment profile in place of the sliders; failures are logged and shown in the status bar
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool NetworkEmulator::loadProfile(const QString& filename)
+{
+    QString error;
+    if (!traceReplay.open(filename, &error))
+    {
+        logToFile(static_cast<LogType>(ERROR), NULL, "could not load profile %s: %s", filename.toLocal8Bit().constData(), error.toLocal8Bit().constData());
+        ui->statusbar->showMessage("Could not load profile: " + error);
+        return false;
+    }
+
+    profileStartMs = -1;
+    logToFile(static_cast<LogType>(INFO), NULL, "replaying impairment profile %s", filename.toLocal8Bit().constData());
+    ui->loadProfileButton->setText("Unload Profile");
+    ui->statusbar->showMessage("Replaying profile: " + QFileInfo(filename).fileName());
+    setSlidersEnabled(false);
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::on_captureButton_clicked
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Captures with the snap length and rotation size set next to the button
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void NetworkEmulator::on_captureButton_clicked()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Starts writing packets arriving at and relayed by the emulator to a pcapng file;
+ * clicking again while capturing stops the capture
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void NetworkEmulator::on_captureButton_clicked()
+{
+    if (pcapngWriter.isOpen())
     {
+        stopCapture();
+        return;
+    }
+
+    QString filename = QFileDialog::getSaveFileName(this, "Capture Packets", "capture.pcapng", "pcapng files (*.pcapng)");
+    if (filename.isEmpty())
+    {
+        return;
+    }
+
+    captureSnaplen = ui->captureSnaplenSpinBox->value();
+    captureRotateMB = ui->captureRotateSpinBox->value();
+    startCapture(filename);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::startCapture
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool NetworkEmulator::startCapture(const QString& filename)
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * Opens a pcapng capture with the current snap length and rotation size; the capture settings cannot be changed
+ * until it is stopped. Failures are logged and shown in the status bar
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool NetworkEmulator::startCapture(const QString& filename)
+{
+    uint64_t rotateBytes = static_cast<uint64_t>(captureRotateMB) * 1024 * 1024;
+    if (!pcapngWriter.open(filename.toLocal8Bit().toStdString(), static_cast<uint32_t>(captureSnaplen), rotateBytes))
+    {
+        logToFile(static_cast<LogType>(ERROR), NULL, "could not open capture file %s", filename.toLocal8Bit().constData());
+        ui->statusbar->showMessage("Could not open capture file " + filename);
         return false;
     }
-    return file.commit();
+
+    logToFile(static_cast<LogType>(INFO), NULL, "capturing to %s (snap length %d, rotating every %d MB)", filename.toLocal8Bit().constData(),
+        captureSnaplen, captureRotateMB);
+    ui->captureButton->setText("Stop Capture");
+    ui->captureSnaplenSpinBox->setValue(captureSnaplen);
+    ui->captureRotateSpinBox->setValue(captureRotateMB);
+    ui->captureSnaplenSpinBox->setEnabled(false);
+    ui->captureRotateSpinBox->setEnabled(false);
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::stopCapture
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void NetworkEmulator::stopCapture()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Flushes and closes the capture, if one is open, and logs the packets it could not keep up with
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void NetworkEmulator::stopCapture()
+{
+    if (!pcapngWriter.isOpen())
+    {
+        return;
+    }
+
+    pcapngWriter.close();
+    ui->captureButton->setText("Capture");
+    ui->captureSnaplenSpinBox->setEnabled(true);
+    ui->captureRotateSpinBox->setEnabled(true);
+    if (pcapngWriter.droppedRecords() > 0)
+    {
+        logToFile(static_cast<LogType>(ERROR), NULL, "capture fell behind, %llu packets not captured", (unsigned long long)pcapngWriter.droppedRecords());
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::releaseDelayedPackets
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Logs the hold time percentiles once the transfer's first EOT is relayed
+ *                 October 18th, 2026 - Headless runs started with exitAfterEOT finish shortly after that EOT
+ *                 October 18th, 2026 - Relayed packets are returned to the packet pool
+ *                 October 18th, 2026 - Flushes the sends queued on the socket
+ *                 October 18th, 2026 - Only a packet passing its checksum can end the transfer, so a corrupted one
+ *                                      that reads as EOT is ignored
+ *                 October 18th, 2026 - Headless runs finish after the EOT_ACK of the connection's last file, the
+ *                                      file count taken from its SYN_ACK
+ *                 October 18th, 2026 - Relays each packet at the length it arrived with
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void NetworkEmulator::releaseDelayedPackets()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Relays every queued packet whose delay has elapsed, then re-arms the release timer for the next one.
+ * The percentiles are logged for the first EOT relayed after DATA, once per file. A connection may send several
+ * files, each ending with an EOT the receiver answers, so a headless run waits for the EOT_ACK of the last one.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void NetworkEmulator::releaseDelayedPackets()
+{
+    qint64 nowUs = linkClock.nsecsElapsed() / 1000;
+
+    for (int link = 0; link < LINK_COUNT; link++)
+    {
+        // Links are FIFO, a packet never overtakes the one queued before it
+        while (!linkQueues[link].isEmpty() && linkQueues[link].head().releaseUs <= nowUs)
+        {
+            DelayedPacket delayed = linkQueues[link].dequeue();
+            pkt = packetPoolGet(packetPool, delayed.handle);
+            packetSize = static_cast<int>(delayed.length);
+            relayPacket(&delayed.sender, &delayed.relTime, delayed.relTimeString);
+            MetricsRegistry::instance().observe(static_cast<MetricHistogram>(TO_RECEIVER_HOLD_TIME + link), nowUs - delayed.arrivalUs);
+            int packetType = packetIntact(pkt) ? static_cast<int>(pkt->packetType) : -1;
+            int connectionId = pkt->connectionId, transfer = pkt->transfer;
+            struct handshake accepted;
+            if (packetType == SYN_ACK && getHandshake(pkt, &accepted))
+            {
+                connectionTransfers.insert(connectionId, accepted.transfers);
+            }
+            packetPoolFree(packetCache, delayed.handle);
+
+            if (packetType == DATA)
+            {
+                holdTimesLogged = false;
+            }
+            else if (packetType == EOT && !holdTimesLogged)
+            {
+                holdTimesLogged = true;
+                QStringList holdTimes = QString::fromStdString(MetricsRegistry::instance().formatLatency()).trimmed().split('\n');
+                for (const QString& line : holdTimes)
+                {
+                    logToFile(static_cast<LogType>(INFO), NULL, "%s", line.toLocal8Bit().constData());
+                }
+            }
+            else if (packetType == EOT_ACK && headless && exitAfterEOT && !finishScheduled
+                     && transfer == connectionTransfers.value(connectionId, 1) - 1)
+            {
+                finishScheduled = true;
+                QTimer::singleShot(EOT_LINGER_MS, this, SLOT(finishHeadless()));
+            }
+        }
+        MetricsRegistry::instance().setGauge(static_cast<MetricGauge>(TO_RECEIVER_QUEUE_DEPTH + link), linkQueues[link].size());
+    }
+    // Everything released together goes out with one submission
+    datagramSocket.flush();
+    scheduleRelease();
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------
- * FUNCTION:       NetworkEmulator::on_resetButton_clicked
+ * FUNCTION:       NetworkEmulator::updateExportProgress
  *
- * DATE:           December 3rd, 2020
+ * DATE:           October 18th, 2026
  *
  * REVISIONS:      N/A
  *
- * DESIGNER:       Derek Wong, Maksym Chumak
+ * DESIGNER:       Derek Wong
  *
- * PROGRAMMER:     Derek Wong, Maksym Chumak
+ * PROGRAMMER:     Derek Wong
  *
- * INTERFACE:      void NetworkEmulator::on_resetButton_clicked()
+ * INTERFACE:      void NetworkEmulator::updateExportProgress()
  *
  * RETURNS:        void
  *
  * NOTES:
- * Resets state of the application to the initial
+ * Polled by the export timer: shows export progress in the status bar and reports the result once it completes
  * ----------------------------------------------------------------------------------------------------------------------------*/
-void NetworkEmulator::on_resetButton_clicked()
+void NetworkEmulator::updateExportProgress()
 {
-    pause = true;
-    if (QStandardItemModel* packetTableModel = convertAbstractModelToStandard(ui->packetTable->model()))
+    if (!csvExporter.isFinished())
     {
-        packetTableModel->clear();
-        delete packetTableModel;
-        packetTableModel = nullptr;
+        size_t total = csvExporter.totalRows();
+        int percent = (total > 0) ? static_cast<int>(csvExporter.rowsWritten() * 100 / total) : 0;
+        ui->statusbar->showMessage("Saving packets: " + QString::number(percent) + "%");
+        return;
     }
 
-    if (QStandardItemModel* networkSummaryTableModel = convertAbstractModelToStandard(ui->networkSummaryTable->model()))
+    exportTimer->stop();
+    ui->saveButton->setEnabled(true);
+    if (csvExporter.finish())
     {
-        networkSummaryTableModel->clear();
-        delete networkSummaryTableModel;
-        networkSummaryTableModel = nullptr;
+        ui->statusbar->showMessage("Saved " + QString::number(csvExporter.totalRows()) + " packets");
+    }
+    else
+    {
+        logToFile(static_cast<LogType>(ERROR), NULL, "could not save packets: %s", csvExporter.errorString().toLocal8Bit().constData());
+        ui->statusbar->showMessage("Could not save packets: " + csvExporter.errorString());
     }
-
-    resetFiguresState();
-    init();
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------
- * FUNCTION:       NetworkEmulator::onNetworkDelaySliderChange
+ * FUNCTION:       NetworkEmulator::refreshTimeSequence
  *
- * DATE:           December 3rd, 2020
+ * DATE:           October 18th, 2026
  *
  * REVISIONS:      N/A
  *
- * DESIGNER:       Derek Wong, Maksym Chumak
+ * DESIGNER:       Derek Wong
  *
- * PROGRAMMER:     Derek Wong, Maksym Chumak
+ * PROGRAMMER:     Derek Wong
  *
- * INTERFACE:      void NetworkEmulator::onNetworkDelaySliderChange()
+ * INTERFACE:      void NetworkEmulator::refreshTimeSequence()
  *
  * RETURNS:        void
  *
  * NOTES:
- * Updates network delay value when the slider is moved
+ * Called once per frame: replaces the chart's points with the decimated series in one batch and grows both axes
  * ----------------------------------------------------------------------------------------------------------------------------*/
-void NetworkEmulator::onNetworkDelaySliderChange()
+void NetworkEmulator::refreshTimeSequence()
 {
-    networkDelay = ui->packetDelaySlider->value();
-    ui->packetDelayLabel->setText("Packet Delay (ms): " + QString::number(networkDelay));
+    if (!timeSequence.isDirty())
+    {
+        return;
+    }
+
+    timeSequence.points(timeSequencePoints);
+    series->replace(timeSequencePoints);
+
+    if (maxX < timeSequence.maxX())
+    {
+        maxX = static_cast<int>(timeSequence.maxX());
+        axisX->setMax(maxX+1);
+    }
+    if (maxY < timeSequence.maxY())
+    {
+        maxY = static_cast<int>(timeSequence.maxY());
+        axisY->setMax(maxY+1);
+    }
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------
- * FUNCTION:       NetworkEmulator::onNetworkDelaySliderChange
+ * FUNCTION:       NetworkEmulator::finishHeadless
  *
- * DATE:           December 3rd, 2020
+ * DATE:           October 18th, 2026
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Dropped count includes SYN, SYN_ACK and EOT_ACK
+ *                 October 18th, 2026 - Closes the capture before logging the summary
  *
- * DESIGNER:       Derek Wong, Maksym Chumak
+ * DESIGNER:       Derek Wong
  *
- * PROGRAMMER:     Derek Wong, Maksym Chumak
+ * PROGRAMMER:     Derek Wong
  *
- * INTERFACE:      void NetworkEmulator::onNetworkDelaySliderChange()
+ * INTERFACE:      void NetworkEmulator::finishHeadless()
  *
  * RETURNS:        void
  *
  * NOTES:
- * Updates Bit Error Rate (BER) value when the slider is moved
+ * Flushes any capture and logs a one-line summary of the run as key=value pairs for scripts, then quits the event loop
  * ----------------------------------------------------------------------------------------------------------------------------*/
-void NetworkEmulator::onBitErrorRateSliderChange()
+void NetworkEmulator::finishHeadless()
 {
-    errorRatePercent = ui->bitErrorRateSlider->value();
-    ui->bitErrorRateLabel->setText("Bit Error Rate: " + QString::number(errorRatePercent) + "%");
+    stopCapture();
+
+    MetricsSnapshot metrics;
+    MetricsRegistry::instance().snapshot(metrics);
+
+    uint64_t dropped = 0;
+    for (int counter = DATA_DROPPED; counter <= EOT_ACK_DROPPED; counter++)
+    {
+        dropped += metrics.counters[counter];
+    }
+
+    logToFile(static_cast<LogType>(INFO), NULL, "summary: received=%llu relayed=%llu dropped=%llu retransmits=%llu",
+        (unsigned long long)metrics.counters[PACKETS_RECEIVED], (unsigned long long)metrics.counters[PACKETS_RELAYED],
+        (unsigned long long)dropped, (unsigned long long)metrics.counters[RETRANSMITS]);
+    fflush(stdout);
+    QCoreApplication::quit();
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------
@@ -424,9 +1126,10 @@ void NetworkEmulator::resetFiguresState()
     packetTableRowIndex = 0;
     maxX = INITIAL_MAX_X;
     maxY = INITIAL_MAX_Y;
+    timeSequence.clear();
     start = {0, 0};
-    networkDelay = NETWORK_DELAY_MS;
-    errorRatePercent = ERROR_RATE_PERCENT;
+    networkDelay = defaultNetworkDelay;
+    errorRatePercent = defaultErrorRatePercent;
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------
@@ -434,7 +1137,9 @@ void NetworkEmulator::resetFiguresState()
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Wires the bit flip check box
+ *                 October 18th, 2026 - Dropped packets column counts every packet type
+ *                 October 18th, 2026 - Sets the ranges and values of the capture settings
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
@@ -458,8 +1163,16 @@ void NetworkEmulator::init()
     ui->bitErrorRateSlider->setMinimum(MIN_ERROR_RATE_PERCENT);
     ui->bitErrorRateSlider->setMaximum(MAX_ERROR_RATE_PERCENT);
     ui->bitErrorRateLabel->setText("Bit Error Rate: " + QString::number(errorRatePercent) + "%");
+    ui->corruptCheckBox->setChecked(corrupt);
     connect(ui->packetDelaySlider, SIGNAL(valueChanged(int)), SLOT(onNetworkDelaySliderChange()));
     connect(ui->bitErrorRateSlider, SIGNAL(valueChanged(int)), SLOT(onBitErrorRateSliderChange()));
+    connect(ui->corruptCheckBox, SIGNAL(toggled(bool)), SLOT(onCorruptCheckBoxToggled(bool)));
+
+    // Capture settings are read when a capture starts
+    ui->captureSnaplenSpinBox->setRange(0, MAX_CAPTURE_SNAPLEN);
+    ui->captureSnaplenSpinBox->setValue(captureSnaplen);
+    ui->captureRotateSpinBox->setRange(0, MAX_CAPTURE_ROTATE_MB);
+    ui->captureRotateSpinBox->setValue(captureRotateMB);
 
     // configure status label
     ui->statusLabel->setText(statusLabelTextStopped);
@@ -516,12 +1229,12 @@ void NetworkEmulator::init()
     QString networkEmulatorPort = "Network Emulator Port";
     QString payloadLen = "Payload Length";
     QString maxWindoSize = "Max Window Size";
-    QString transmitterIPValue = TRANSMITTER_IP;
-    QString transmitterPortValue = QString::number(TRANSMITTER_PORT);
-    QString receiverIPValue = RECEIVER_IP;
-    QString receiverPortValue = QString::number(RECEIVER_PORT);
-    QString networkEmulatorIPValue = NETWORK_EMULATOR_IP;
-    QString networkEmulatorPortValue = QString::number(NETWORK_EMULATOR_PORT);
+    QString transmitterIPValue = transmitterAddress;
+    QString transmitterPortValue = QString::number(transmitterUdpPort);
+    QString receiverIPValue = receiverAddress;
+    QString receiverPortValue = QString::number(receiverUdpPort);
+    QString networkEmulatorIPValue = emulatorAddress;
+    QString networkEmulatorPortValue = QString::number(emulatorUdpPort);
     QString payloadLenValue = QString::number(PAYLOAD_LEN);
     QString maxWindowSizeValue = QString::number(MAX_WINDOW_SIZE);
 
@@ -571,22 +1284,66 @@ void NetworkEmulator::init()
 
     // Init network summary statistics model and table
     summaryTableModel = new QStandardItemModel;
-    QStringList summaryHeaders = { "Total Capture Time", "Packet Count", "Dropped Packets (DATA, ACK, EOT)", "Retransmits (DATA only)" };
+    QStringList summaryHeaders = { "Total Capture Time", "Packet Count", "Dropped Packets", "Retransmits (DATA only)" };
     for(int i = 0; i < summaryHeaders.size(); i++)
     {
        summaryTableModel->setItem(0, i, new QStandardItem(summaryHeaders[i]));
+       summaryTableModel->setItem(1, i, new QStandardItem());
     }
 
     ui->networkSummaryTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     ui->networkSummaryTable->setModel(summaryTableModel);    
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::resolveSockaddr
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      socklen_t NetworkEmulator::resolveSockaddr(const QString& address, quint16 port, struct sockaddr_storage* out)
+ *
+ * RETURNS:        socklen_t, the length of the address stored in out, 0 if address is not an IPv4 or IPv6 address
+ *
+ * NOTES:
+ * Converts an endpoint to the socket address the datagram socket binds or sends to
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+socklen_t NetworkEmulator::resolveSockaddr(const QString& address, quint16 port, struct sockaddr_storage* out)
+{
+    QHostAddress host(address);
+    memset(out, 0, sizeof(*out));
+
+    if (host.protocol() == QAbstractSocket::IPv4Protocol)
+    {
+        struct sockaddr_in* in = reinterpret_cast<struct sockaddr_in*>(out);
+        in->sin_family = AF_INET;
+        in->sin_port = htons(port);
+        in->sin_addr.s_addr = htonl(host.toIPv4Address());
+        return sizeof(*in);
+    }
+    if (host.protocol() == QAbstractSocket::IPv6Protocol)
+    {
+        struct sockaddr_in6* in6 = reinterpret_cast<struct sockaddr_in6*>(out);
+        Q_IPV6ADDR bytes = host.toIPv6Address();
+        in6->sin6_family = AF_INET6;
+        in6->sin6_port = htons(port);
+        memcpy(&in6->sin6_addr, bytes.c, sizeof(bytes.c));
+        return sizeof(*in6);
+    }
+    return 0;
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------
  * FUNCTION:       NetworkEmulator::dropPkt
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Drops are counted by the caller, per packet type
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
@@ -602,40 +1359,168 @@ void NetworkEmulator::init()
 bool NetworkEmulator::dropPkt(int prob)
 {
     bool drop = (prob < (rand() % 100) + 1) ? false : true;
-    if (drop) ++droppedPackets;
     return drop;
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------
- * FUNCTION:       NetworkEmulator::averagePktDelay
+ * FUNCTION:       NetworkEmulator::corruptPkt
  *
- * DATE:           December 3rd, 2020
+ * DATE:           October 18th, 2026
  *
  * REVISIONS:      N/A
  *
- * DESIGNER:       Derek Wong, Maksym Chumak
+ * DESIGNER:       Derek Wong
  *
- * PROGRAMMER:     Derek Wong, Maksym Chumak
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void NetworkEmulator::corruptPkt(quint32 handle, qint64 length)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Flips one bit, anywhere in the datagram, of the packet in the pool slot
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void NetworkEmulator::corruptPkt(quint32 handle, qint64 length)
+{
+    unsigned char* bytes = reinterpret_cast<unsigned char*>(packetPoolGet(packetPool, handle));
+    qint64 bit = rand() % (length * 8);
+
+    bytes[bit / 8] ^= static_cast<unsigned char>(1 << (bit % 8));
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::delayPacket
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Queues the packet pool handle instead of a copy of the datagram
+ *                 October 18th, 2026 - Picks the link by endpoint key
+ *                 October 18th, 2026 - Any transmitter port is on the link to the receiver
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void NetworkEmulator::delayPacket(quint32 handle, qint64 length, const Endpoint* sender,
+ *                     QTime* relTime, QString relTimeString, int delayMs, int bandwidthKbps
+ *                 )
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Applies network delay for each received packet by queueing it on its link until the delay has elapsed;
+ * when the link is rate limited the packet also waits for the link to finish serializing the packets ahead of it
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void NetworkEmulator::delayPacket(quint32 handle, qint64 length, const Endpoint* sender, QTime* relTime, QString relTimeString, int delayMs, int bandwidthKbps)
+{
+    int link = fromTransmitter(sender) ? TO_RECEIVER_LINK : TO_TRANSMITTER_LINK;
+    qint64 nowUs = linkClock.nsecsElapsed() / 1000;
+    qint64 departUs = qMax(nowUs, linkFreeUs[link]);
+
+    if (bandwidthKbps > 0)
+    {
+        // bytes * 8 bits / (kbps * 1000 bits/s), in microseconds
+        departUs += length * 8 * 1000 / bandwidthKbps;
+        linkFreeUs[link] = departUs;
+    }
+
+    DelayedPacket delayed{nowUs, departUs + (qint64)delayMs * 1000, handle, length, *sender, *relTime, relTimeString};
+    linkQueues[link].enqueue(delayed);
+    MetricsRegistry::instance().setGauge(static_cast<MetricGauge>(TO_RECEIVER_QUEUE_DEPTH + link), linkQueues[link].size());
+    scheduleRelease();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::scheduleRelease
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void NetworkEmulator::scheduleRelease()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Arms the release timer for the earliest packet at the head of either link
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void NetworkEmulator::scheduleRelease()
+{
+    qint64 nextReleaseUs = -1;
+    for (int link = 0; link < LINK_COUNT; link++)
+    {
+        if (!linkQueues[link].isEmpty() && (nextReleaseUs < 0 || linkQueues[link].head().releaseUs < nextReleaseUs))
+        {
+            nextReleaseUs = linkQueues[link].head().releaseUs;
+        }
+    }
+
+    if (nextReleaseUs < 0)
+    {
+        return;
+    }
+
+    qint64 waitMs = (nextReleaseUs - linkClock.nsecsElapsed() / 1000 + 999) / 1000;
+    releaseTimer->start(static_cast<int>(qMax<qint64>(waitMs, 0)));
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::setSlidersEnabled
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
  *
- * INTERFACE:      void NetworkEmulator::averagePktDelay(int delayInMS)
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void NetworkEmulator::setSlidersEnabled(bool enabled)
  *
  * RETURNS:        void
  *
  * NOTES:
- * Applies network delay for each received packet
+ * Enables or disables the manual impairment sliders
  * ----------------------------------------------------------------------------------------------------------------------------*/
-void NetworkEmulator::averagePktDelay(int delayInMS)
+void NetworkEmulator::setSlidersEnabled(bool enabled)
 {
-    struct timeval now;
-    gettimeofday(&now, NULL);
-    struct timeval future;
-    gettimeofday(&future, NULL);
+    ui->packetDelaySlider->setEnabled(enabled);
+    ui->bitErrorRateSlider->setEnabled(enabled);
+}
 
-    while(delay(now, future) < delayInMS)
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::capturePacket
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void NetworkEmulator::capturePacket(int interfaceId, quint32 sourceAddr, quint16 sourcePort,
+ *                     quint32 destinationAddr, quint16 destinationPort, const char* comment
+ *                 )
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Records the current packet in the running capture, if any
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void NetworkEmulator::capturePacket(int interfaceId, quint32 sourceAddr, quint16 sourcePort, quint32 destinationAddr, quint16 destinationPort, const char* comment)
+{
+    if (!pcapngWriter.isOpen())
     {
-        gettimeofday(&future, NULL);
-        continue;
+        return;
     }
+
+    quint64 timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    pcapngWriter.writePacket(interfaceId, timestampNs, sourceAddr, sourcePort, destinationAddr, destinationPort, pkt, packetSize, comment);
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------
@@ -643,28 +1528,33 @@ void NetworkEmulator::averagePktDelay(int delayInMS)
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Relayed packets are written to the running capture
+ *                 October 18th, 2026 - Relayed packets and retransmits are counted in the metrics registry
+ *                 October 18th, 2026 - Sent from the pool slot to the resolved destination address
+ *                 October 18th, 2026 - Sender is matched by endpoint key
+ *                 October 18th, 2026 - ACKs go to the transmitter socket of their stream
+ *                 October 18th, 2026 - Sends packetSize bytes, the length the datagram arrived with
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
  * PROGRAMMER:     Derek Wong, Maksym Chumak
  *
- * INTERFACE:      void NetworkEmulator::relayPacket(QHostAddress* sender, quint16 senderPort, QTime* relTime, QString relTimeString)
+ * INTERFACE:      void NetworkEmulator::relayPacket(const Endpoint* sender, QTime* relTime, QString relTimeString)
  *
  * RETURNS:        void
  *
  * NOTES:
  * Relays a packet to receiver if it came from transmiiter
- * Relays a packet to transmitter if it came from receiver
+ * Relays a packet to transmitter if it came from receiver, to the socket of the packet's stream once it is known
  * Updates UI
  * ----------------------------------------------------------------------------------------------------------------------------*/
-void NetworkEmulator::relayPacket(QHostAddress* sender, quint16 senderPort, QTime* relTime, QString relTimeString)
+void NetworkEmulator::relayPacket(const Endpoint* sender, QTime* relTime, QString relTimeString)
 {
     QColor rowColor;
 
-    if (QString::compare(sender->toString(), TRANSMITTER_IP) == 0 && senderPort == TRANSMITTER_PORT)
+    if (fromTransmitter(sender))
     {
-        if (pkt->retransmit == true) ++retransmits;
+        if (pkt->retransmit == true) MetricsRegistry::instance().add(RETRANSMITS);
         // Send to Receiver
         if (pkt->packetType == EOT)
         {
@@ -675,12 +1565,15 @@ void NetworkEmulator::relayPacket(QHostAddress* sender, quint16 senderPort, QTim
             rowColor = QColor(241, 124, 14, 75);
         }
         updateTimeSequence(pkt, sender, relTime);
-        updatePacketTable(pkt, sender, senderPort, RECEIVER_IP, RECEIVER_PORT, false, relTimeString, rowColor);
-        if(udpSocket->writeDatagram((const char*)pkt, packetSize, QHostAddress(RECEIVER_IP), RECEIVER_PORT) != packetSize)
+        updatePacketTable(pkt, sender, &receiverEndpoint, false, relTime, relTimeString, rowColor);
+        if (!datagramSocket.send(pkt, packetSize, reinterpret_cast<struct sockaddr*>(&receiverSockaddr), receiverSockaddrLen))
         {
             logToFile(static_cast<LogType>(ERROR), NULL, "sendto error");
             exit(1);
         }
+        capturePacket(CAPTURE_EGRESS_INTERFACE, captureEmulatorAddr, emulatorUdpPort, captureReceiverAddr, receiverUdpPort, nullptr);
+        MetricsRegistry::instance().add(PACKETS_RELAYED);
+        MetricsRegistry::instance().add(BYTES_RELAYED, packetSize);
         if (pkt->seqNum != INVALID_SEQ_NUM)
         {
             logToFile(static_cast<LogType>(INFO), pkt, "transmitter->receiver (seqNum: %d)", pkt->seqNum);
@@ -690,16 +1583,22 @@ void NetworkEmulator::relayPacket(QHostAddress* sender, quint16 senderPort, QTim
             logToFile(static_cast<LogType>(INFO), pkt, "transmitter->receiver (EOT)");
         }
     }
-    else if (QString::compare(sender->toString(), RECEIVER_IP) == 0 && senderPort == RECEIVER_PORT)
+    else if (endpointEquals(sender, &receiverEndpoint))
     {
         // Send to Transmitter
+        int route = learnedStream(pkt);
+        const Endpoint* destination = (route >= 0) ? &streamRoutes[route].endpoint : &transmitterEndpoint;
+        struct sockaddr_storage* destinationSockaddr = (route >= 0) ? &streamRoutes[route].sockaddr : &transmitterSockaddr;
         rowColor = QColor(0, 60, 121, 75);
-        updatePacketTable(pkt, sender, senderPort, TRANSMITTER_IP, TRANSMITTER_PORT, false, relTimeString, rowColor);
-        if (udpSocket->writeDatagram((const char*)pkt, packetSize, QHostAddress(TRANSMITTER_IP), TRANSMITTER_PORT) != packetSize)
+        updatePacketTable(pkt, sender, destination, false, relTime, relTimeString, rowColor);
+        if (!datagramSocket.send(pkt, packetSize, reinterpret_cast<struct sockaddr*>(destinationSockaddr), transmitterSockaddrLen))
         {
             logToFile(static_cast<LogType>(ERROR), NULL, "sendto error");
             exit(1);
         }
+        capturePacket(CAPTURE_EGRESS_INTERFACE, captureEmulatorAddr, emulatorUdpPort, captureTransmitterAddr, destination->port, nullptr);
+        MetricsRegistry::instance().add(PACKETS_RELAYED);
+        MetricsRegistry::instance().add(BYTES_RELAYED, packetSize);
         logToFile(static_cast<LogType>(INFO), pkt, "receiver->transmitter (ackNum: %d)", pkt->ackNum);
     }
     else
@@ -713,24 +1612,26 @@ void NetworkEmulator::relayPacket(QHostAddress* sender, quint16 senderPort, QTim
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Sender is matched by endpoint key
+ *                 October 18th, 2026 - A dropped ACK is shown against the transmitter socket of its stream
+ *                 October 18th, 2026 - Logs the type of a dropped packet without a sequence number
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
  * PROGRAMMER:     Derek Wong, Maksym Chumak
  *
- * INTERFACE:      void NetworkEmulator::recordPacket(QHostAddress* sender, quint16 senderPort, QTime* relTime, QString relTimeString)
+ * INTERFACE:      void NetworkEmulator::recordPacket(const Endpoint* sender, QTime* relTime, QString relTimeString)
  *
  * RETURNS:        void
  *
  * NOTES:
  * Updates UI with a new packet data
  * ----------------------------------------------------------------------------------------------------------------------------*/
-void NetworkEmulator::recordPacket(QHostAddress* sender, quint16 senderPort, QTime* relTime, QString relTimeString)
+void NetworkEmulator::recordPacket(const Endpoint* sender, QTime* relTime, QString relTimeString)
 {
     QColor rowColor;
 
-    if (QString::compare(sender->toString(), TRANSMITTER_IP) == 0 && senderPort == TRANSMITTER_PORT)
+    if (fromTransmitter(sender))
     {
         // Send to Receiver
         if (pkt->packetType == EOT)
@@ -742,23 +1643,173 @@ void NetworkEmulator::recordPacket(QHostAddress* sender, quint16 senderPort, QTi
             rowColor = QColor(241, 124, 14, 75);
         }
         updateTimeSequence(pkt, sender, relTime);
-        updatePacketTable(pkt, sender, senderPort, RECEIVER_IP, RECEIVER_PORT, true, relTimeString, rowColor);
+        updatePacketTable(pkt, sender, &receiverEndpoint, true, relTime, relTimeString, rowColor);
         if (pkt->seqNum != INVALID_SEQ_NUM)
         {
             logToFile(static_cast<LogType>(INFO), pkt, "DROPPED: transmitter->receiver (seqNum: %d)", pkt->seqNum);
         }
         else
         {
-            logToFile(static_cast<LogType>(INFO), pkt, "DROPPED: transmitter->receiver (EOT)");
+            logToFile(static_cast<LogType>(INFO), pkt, "DROPPED: transmitter->receiver (%s)", packetTypeToString(pkt->packetType, false));
         }
     }
-    else if (QString::compare(sender->toString(), RECEIVER_IP) == 0 && senderPort == RECEIVER_PORT)
+    else if (endpointEquals(sender, &receiverEndpoint))
     {
         // Send to Transmitter
+        int route = learnedStream(pkt);
         rowColor = QColor(0, 60, 121, 75);
-        updatePacketTable(pkt, sender, senderPort, TRANSMITTER_IP, TRANSMITTER_PORT, true, relTimeString, rowColor);
-        logToFile(static_cast<LogType>(INFO), pkt, "DROPPED: receiver->transmitter (ackNum: %d)", pkt->ackNum);
+        updatePacketTable(pkt, sender, (route >= 0) ? &streamRoutes[route].endpoint : &transmitterEndpoint, true, relTime, relTimeString, rowColor);
+        if (pkt->packetType == ACK)
+        {
+            logToFile(static_cast<LogType>(INFO), pkt, "DROPPED: receiver->transmitter (ackNum: %d)", pkt->ackNum);
+        }
+        else
+        {
+            logToFile(static_cast<LogType>(INFO), pkt, "DROPPED: receiver->transmitter (%s)", packetTypeToString(pkt->packetType, false));
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::fromTransmitter
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool NetworkEmulator::fromTransmitter(const Endpoint* sender)
+ *
+ * RETURNS:        bool, true if the datagram came from a transmitter socket
+ *
+ * NOTES:
+ * The streams of a multi-stream transfer send from ports of their own, so any port on the transmitter's address
+ * counts, except the receiver's when both run on one host
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool NetworkEmulator::fromTransmitter(const Endpoint* sender)
+{
+    return endpointSameAddress(sender, &transmitterEndpoint) && !endpointEquals(sender, &receiverEndpoint);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::learnStream
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Keyed by connection id and stream id, so concurrent transfers each keep theirs;
+ *                                      the oldest entry is replaced once the table is full
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void NetworkEmulator::learnStream(const Endpoint* sender)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Remembers sender as the transmitter socket of the stream of the DATA, SYN or EOT packet being processed, so that
+ * the stream's ACKs, and the SYN_ACK and EOT_ACKs, can be relayed back to it; the address is the configured transmitter's with the sender's port
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void NetworkEmulator::learnStream(const Endpoint* sender)
+{
+    int route = learnedStream(pkt);
+
+    if (pkt->streamId < 0 || pkt->streamId >= EMULATOR_MAX_STREAMS || (route >= 0 && streamRoutes[route].endpoint.port == sender->port))
+    {
+        return;
     }
+    if (route < 0)
+    {
+        if (streamRouteCount < EMULATOR_MAX_ROUTES)
+        {
+            route = streamRouteCount++;
+        }
+        else
+        {
+            route = streamRouteNext;
+            streamRouteNext = (streamRouteNext + 1) % EMULATOR_MAX_ROUTES;
+        }
+    }
+    StreamRoute* entry = &streamRoutes[route];
+    entry->connectionId = pkt->connectionId;
+    entry->streamId = pkt->streamId;
+    entry->endpoint = *sender;
+    entry->sockaddr = transmitterSockaddr;
+    if (transmitterSockaddr.ss_family == AF_INET6)
+    {
+        reinterpret_cast<struct sockaddr_in6*>(&entry->sockaddr)->sin6_port = htons(sender->port);
+    }
+    else
+    {
+        reinterpret_cast<struct sockaddr_in*>(&entry->sockaddr)->sin_port = htons(sender->port);
+    }
+    logToFile(static_cast<LogType>(INFO), NULL, "stream %d of connection %d is on transmitter port %d", pkt->streamId, pkt->connectionId, sender->port);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::learnedStream
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Looks up the connection id as well as the stream id
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int NetworkEmulator::learnedStream(const struct packet* pkt)
+ *
+ * RETURNS:        int, the streamRoutes entry of pkt's connection and stream, or -1 if its transmitter socket has not
+ *                 been seen
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int NetworkEmulator::learnedStream(const struct packet* pkt)
+{
+    for (int i = 0; i < streamRouteCount; i++)
+    {
+        if (streamRoutes[i].connectionId == pkt->connectionId && streamRoutes[i].streamId == pkt->streamId)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       NetworkEmulator::formatEndpointAddress
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      QString NetworkEmulator::formatEndpointAddress(const Endpoint* endpoint)
+ *
+ * RETURNS:        QString, the endpoint's address in its usual text form
+ *
+ * NOTES:
+ * Only used for display, never on the forwarding decision
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+QString NetworkEmulator::formatEndpointAddress(const Endpoint* endpoint)
+{
+    if (endpointIsIPv4(endpoint))
+    {
+        return QHostAddress(endpointIPv4(endpoint)).toString();
+    }
+
+    Q_IPV6ADDR bytes;
+    for (int i = 0; i < 8; i++)
+    {
+        bytes.c[i] = static_cast<quint8>(endpoint->addressHigh >> (56 - 8 * i));
+        bytes.c[8 + i] = static_cast<quint8>(endpoint->addressLow >> (56 - 8 * i));
+    }
+    return QHostAddress(bytes).toString();
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------
@@ -766,14 +1817,18 @@ void NetworkEmulator::recordPacket(QHostAddress* sender, quint16 senderPort, QTi
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Also appends the packet to the packet record store
+ *                 October 18th, 2026 - Destination is the configured address; headless runs only keep the record
+ *                 October 18th, 2026 - Packet type label comes from the constant string table, no longer leaked
+ *                 October 18th, 2026 - Source and destination are endpoint keys, only formatted for the table
+ *                 October 18th, 2026 - The record keeps the endpoint keys instead of their IPv4 addresses
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
  * PROGRAMMER:     Derek Wong, Maksym Chumak
  *
- * INTERFACE:      void NetworkEmulator::updatePacketTable(struct packet* packet, QHostAddress* sourceIP,
- *                     quint16 sourcePort, const char* destinationIP, int destinationPort, bool isDropped, QString relTime, QColor rowColor
+ * INTERFACE:      void NetworkEmulator::updatePacketTable(struct packet* packet, const Endpoint* source,
+ *                     const Endpoint* destination, bool isDropped, QTime* relTime, QString relTimeString, QColor rowColor
  *                 )
  *
  * RETURNS:        void
@@ -781,20 +1836,37 @@ void NetworkEmulator::recordPacket(QHostAddress* sender, quint16 senderPort, QTi
  * NOTES:
  * Updates packet table with a new packet data
  * ----------------------------------------------------------------------------------------------------------------------------*/
-void NetworkEmulator::updatePacketTable(struct packet* packet, QHostAddress* sourceIP, quint16 sourcePort, const char* destinationIP, int destinationPort, bool isDropped, QString relTime, QColor rowColor)
+void NetworkEmulator::updatePacketTable(struct packet* packet, const Endpoint* source, const Endpoint* destination, bool isDropped, QTime* relTime, QString relTimeString, QColor rowColor)
 {
+    PacketRecord record;
+    record.relTimeMs = relTime->msecsSinceStartOfDay();
+    record.windowSize = packet->windowSize;
+    record.seqNum = packet->seqNum;
+    record.ackNum = packet->ackNum;
+    record.source = *source;
+    record.destination = *destination;
+    record.packetType = packet->packetType;
+    record.dropped = isDropped;
+    record.retransmit = packet->retransmit;
+    packetRecords.append(record);
+
+    if (headless)
+    {
+        return;
+    }
+
     QString ackNum = QString::number(packet->ackNum);
     QString seqNum = QString::number(packet->seqNum);
-    QString srcIP = sourceIP->toString();
-    QString srcPt = QString::number(sourcePort);
-    QString dstIP = destinationIP;
-    QString destPt = QString::number(destinationPort);
-    QString pktType = packetTypeToString(packet->packetType, isDropped);
+    QString srcIP = formatEndpointAddress(source);
+    QString srcPt = QString::number(source->port);
+    QString dstIP = formatEndpointAddress(destination);
+    QString destPt = QString::number(destination->port);
+    QString pktType = QString::fromLatin1(packetTypeToString(packet->packetType, isDropped));
     QString windowSize = QString::number(packet->windowSize);
     QString retransmit = (packet->retransmit == true) ? "Yes" : "No";
 
     // Set Packet Table UI modifications
-    packetTableModel->setItem(packetTableRowIndex, RELATIVE_TIME_INDEX, new QStandardItem(relTime));
+    packetTableModel->setItem(packetTableRowIndex, RELATIVE_TIME_INDEX, new QStandardItem(relTimeString));
     packetTableModel->setItem(packetTableRowIndex, SEQUENCE_NUM_INDEX, new QStandardItem(seqNum));
     packetTableModel->setItem(packetTableRowIndex, ACKNOWLEDGEMENT_NUM_INDEX, new QStandardItem(ackNum));
     packetTableModel->setItem(packetTableRowIndex, SOURCE_IP_INDEX, new QStandardItem(srcIP));
@@ -821,25 +1893,37 @@ void NetworkEmulator::updatePacketTable(struct packet* packet, QHostAddress* sou
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Runs from the summary timer instead of per packet; reads the metrics registry
+ *                                      and updates the existing items instead of creating new ones
+ *                 October 18th, 2026 - Dropped count includes SYN, SYN_ACK and EOT_ACK
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
  * PROGRAMMER:     Derek Wong, Maksym Chumak
  *
- * INTERFACE:      void NetworkEmulator::updateNetworkSummaryTable(QString relTime)
+ * INTERFACE:      void NetworkEmulator::updateNetworkSummaryTable()
  *
  * RETURNS:        void
  *
  * NOTES:
  * Updates summary table
+ * Counts are relative to the last reset
  * ----------------------------------------------------------------------------------------------------------------------------*/
-void NetworkEmulator::updateNetworkSummaryTable(QString relTime)
+void NetworkEmulator::updateNetworkSummaryTable()
 {
-    summaryTableModel->setItem(1, totalCaptureTimeIndex, new QStandardItem(relTime));
-    summaryTableModel->setItem(1, packetCountIndex, new QStandardItem(QString::number(packetTableRowIndex-1)));
-    summaryTableModel->setItem(1, droppedPacketsIndex, new QStandardItem(QString::number(droppedPackets)));
-    summaryTableModel->setItem(1, retransmitIndex, new QStandardItem(QString::number(retransmits)));
+    MetricsSnapshot metrics;
+    MetricsRegistry::instance().snapshot(metrics);
+
+    uint64_t dropped = 0;
+    for (int counter = DATA_DROPPED; counter <= EOT_ACK_DROPPED; counter++)
+    {
+        dropped += metrics.counters[counter] - metricsBaseline.counters[counter];
+    }
+
+    summaryTableModel->item(1, totalCaptureTimeIndex)->setText(lastRelTimeString);
+    summaryTableModel->item(1, packetCountIndex)->setText(QString::number(packetRecords.size()));
+    summaryTableModel->item(1, droppedPacketsIndex)->setText(QString::number(dropped));
+    summaryTableModel->item(1, retransmitIndex)->setText(QString::number(metrics.counters[RETRANSMITS] - metricsBaseline.counters[RETRANSMITS]));
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------
@@ -847,43 +1931,27 @@ void NetworkEmulator::updateNetworkSummaryTable(QString relTime)
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Points go to the decimated series and are drawn by refreshTimeSequence;
+ *                                      time keeps millisecond resolution
+ *                 October 18th, 2026 - Source is matched by endpoint key
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
  * PROGRAMMER:     Derek Wong, Maksym Chumak
  *
- * INTERFACE:      void NetworkEmulator::updateTimeSequence(struct packet* pkt, QHostAddress* sourceIP, QTime* relTime)
+ * INTERFACE:      void NetworkEmulator::updateTimeSequence(struct packet* pkt, const Endpoint* source, QTime* relTime)
  *
  * RETURNS:        void
  *
  * NOTES:
  * Updates Time Sequence graph
  * ----------------------------------------------------------------------------------------------------------------------------*/
-void NetworkEmulator::updateTimeSequence(struct packet* pkt, QHostAddress* sourceIP, QTime* relTime)
+void NetworkEmulator::updateTimeSequence(struct packet* pkt, const Endpoint* source, QTime* relTime)
 {
     // Only add data from transmitter to receiver to time sequence chart
-    if (QString::compare(sourceIP->toString(), TRANSMITTER_IP) == 0)
+    if (endpointSameAddress(source, &transmitterEndpoint) && pkt->packetType == DATA)
     {
-        double totalSeconds = 0;
-        double minutes = relTime->minute();
-        double seconds = relTime->second();
-        totalSeconds = minutes * 60 + seconds;
-
-        int seqNum = pkt->seqNum;
-        if(pkt->packetType == DATA)
-        {
-            series->append(totalSeconds, seqNum);
-            if (maxX < totalSeconds)
-            {
-                maxX = totalSeconds;
-                axisX->setMax(maxX+1);
-            }
-            else if(maxY < seqNum)
-            {
-                maxY = seqNum;
-                axisY->setMax(maxY+1);
-            }
-        }
+        double totalSeconds = relTime->msecsSinceStartOfDay() / 1000.0;
+        timeSequence.append(totalSeconds, pkt->seqNum);
     }
 }
@@ -3,7 +3,18 @@
  *
  * DATE:                                        December 3rd, 2020
  *
- * REVISIONS:                                   N/A
+ * REVISIONS:                                   October 18th, 2026 - Endpoints, impairments and headless operation come from an EmulatorConfig
+ *                                              October 18th, 2026 - Delayed packets are packet pool handles instead of byte arrays
+ *                                              October 18th, 2026 - Forwarding uses a native datagram socket read in batches
+ *                                              October 18th, 2026 - Packets are classified by numeric endpoint keys
+ *                                              October 18th, 2026 - Optional io_uring forwarding socket
+ *                                              October 18th, 2026 - Optional packet ring forwarding path
+ *                                              October 18th, 2026 - Transmitter sockets of a multi-stream transfer
+ *                                              October 18th, 2026 - Stream sockets are learned per connection id
+ *                                              October 18th, 2026 - Bit flip impairment in place of drops
+ *                                              October 18th, 2026 - File count of each connection, to finish after its last EOT_ACK
+ *                                              October 18th, 2026 - Length of the datagram being processed, which varies with its data
+ *                                              October 18th, 2026 - Capture file, snap length and rotation size are settings
  *
  * DESIGNER:                                    Maksym Chumak, Derek Wong
  *
@@ -23,10 +34,16 @@
 
 #include <QFile>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QSaveFile>
 #include <QTextStream>
 #include <QStandardItemModel>
 
+#include <QElapsedTimer>
+#include <QHash>
+#include <QQueue>
+#include <QTimer>
+
 #include <QtCharts/QChartView>
 #include <QtCharts/QLineSeries>
 #include <QValueAxis>
@@ -34,7 +51,18 @@
 #include <QMainWindow>
 #include <QStandardItemModel>
 
-#include <QUdpSocket>
+#include <QHostAddress>
+#include <QSocketNotifier>
+
+#include "csvexporter.h"
+#include "datagramsocket.h"
+#include "endpoint.h"
+#include "decimatedseries.h"
+#include "metrics.h"
+#include "metricsserver.h"
+#include "packetrecordstore.h"
+#include "pcapngwriter.h"
+#include "tracereplay.h"
 
 /*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
 #define NETWORK_DELAY_MS            30
@@ -45,18 +73,79 @@
 #define MAX_ERROR_RATE_PERCENT      100
 #define INITIAL_MAX_X               3
 #define INITIAL_MAX_Y               5
+#define TO_RECEIVER_LINK            0
+#define TO_TRANSMITTER_LINK         1
+#define LINK_COUNT                  2
+#define CAPTURE_SNAPLEN             0       // Default bytes kept per captured frame, 0 keeps whole frames
+#define MAX_CAPTURE_SNAPLEN         65535
+#define CAPTURE_ROTATE_MB           0       // Default size in MB at which a new capture file is started, 0 disables rotation
+#define MAX_CAPTURE_ROTATE_MB       65536
+#define EXPORT_PROGRESS_INTERVAL_MS 100
+#define TIME_SEQUENCE_FRAME_MS      16      // Time-sequence chart refresh interval, about 60 fps
+#define SUMMARY_REFRESH_INTERVAL_MS 250
+#define EOT_LINGER_MS               500     // Headless runs keep relaying this long after the last EOT_ACK before exiting
+#define EMULATOR_POOL_PACKETS       65536   // Datagrams held at once across both link queues
+#define EMULATOR_MAX_STREAMS        8       // MAX_STREAMS of common.h, which only one translation unit may include
+#define EMULATOR_MAX_ROUTES         64      // Stream sockets remembered across concurrent transfers
+
+struct packetPool;
+struct packetPoolCache;
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class NetworkEmulator; }
 QT_END_NAMESPACE
 using namespace QtCharts;
 
+/*------------------------------------------------ Structs --------------------------------------------------------------------------*/
+// Startup configuration from the command line; empty addresses, zero ports and negative impairments keep the defaults
+struct EmulatorConfig
+{
+    QString transmitterIP;
+    quint16 transmitterPort = 0;
+    QString receiverIP;
+    quint16 receiverPort = 0;
+    QString emulatorIP;
+    quint16 emulatorPort = 0;
+    int delayMs = -1;
+    int errorRatePercent = -1;
+    bool corrupt = false;                   // Packets the error rate picks get a bit flipped instead of being dropped
+    QString profilePath;
+    bool headless = false;
+    bool exitAfterEOT = false;
+    bool ioUring = false;
+    QString packetRingInterface;
+    QString capturePath;                    // Capture started at launch, so headless runs can capture too
+    int captureSnaplen = CAPTURE_SNAPLEN;
+    int captureRotateMB = CAPTURE_ROTATE_MB;
+};
+
+struct DelayedPacket
+{
+    qint64 arrivalUs;
+    qint64 releaseUs;
+    quint32 handle;             // Packet pool slot holding the datagram, returned to the pool once relayed
+    qint64 length;
+    Endpoint sender;
+    QTime relTime;
+    QString relTimeString;
+};
+
+// Transmitter socket one stream of one transfer sends from
+struct StreamRoute
+{
+    int connectionId;
+    int streamId;
+    Endpoint endpoint;
+    struct sockaddr_storage sockaddr;
+};
+
 /*-----------------------------------------------------------------------------------------------------------------------------------
  * CLASS:           NetworkEmulator
  *
  * DATE:            December 3rd, 2020
  *
- * REVISIONS:       N/A
+ * REVISIONS:       October 18th, 2026 - Can run headless: forwarding starts at once and the window, packet table
+ *                                       and charts are left alone
  *
  * DESIGNER:        Maksym Chumak, Derek Wong
  *
@@ -71,7 +160,7 @@ class NetworkEmulator : public QMainWindow
 
 public:
     // constructor
-    NetworkEmulator(QWidget *parent = nullptr);
+    NetworkEmulator(const EmulatorConfig& config = EmulatorConfig(), QWidget *parent = nullptr);
     // destructor
     ~NetworkEmulator();
 
@@ -91,6 +180,22 @@ public slots:
 
     void onBitErrorRateSliderChange();
 
+    void onCorruptCheckBoxToggled(bool checked);
+
+    void on_loadProfileButton_clicked();
+
+    void on_captureButton_clicked();
+
+    void releaseDelayedPackets();
+
+    void updateExportProgress();
+
+    void refreshTimeSequence();
+
+    void updateNetworkSummaryTable();
+
+    void finishHeadless();
+
 private:
     Ui::NetworkEmulator *ui;
     QChart *chart = nullptr;
@@ -107,10 +212,59 @@ private:
     QString destinationIP;
     QValueAxis* axisX = nullptr;
     QValueAxis* axisY = nullptr;
-    QUdpSocket* udpSocket = nullptr;
+    DatagramSocket datagramSocket;
+    QSocketNotifier* readNotifier = nullptr;
+    quint32 receiveRing[DATAGRAM_BATCH_SIZE];           // Pool slots the next batch is read into
+    void* receiveBuffers[DATAGRAM_BATCH_SIZE];
+    DatagramInfo receiveInfos[DATAGRAM_BATCH_SIZE];
+    struct sockaddr_storage transmitterSockaddr;        // Relay destinations, resolved once
+    socklen_t transmitterSockaddrLen = 0;
+    struct sockaddr_storage receiverSockaddr;
+    socklen_t receiverSockaddrLen = 0;
+    Endpoint transmitterEndpoint;                       // Numeric keys the packets are classified by
+    Endpoint receiverEndpoint;
+    Endpoint emulatorEndpoint;
+    StreamRoute streamRoutes[EMULATOR_MAX_ROUTES];      // Transmitter socket of each stream, learned from its DATA
+    int streamRouteCount = 0;
+    int streamRouteNext = 0;                            // Entry replaced next once the table is full
+    QTimer* releaseTimer = nullptr;
+    QElapsedTimer linkClock;
+    QQueue<DelayedPacket> linkQueues[LINK_COUNT];
+    qint64 linkFreeUs[LINK_COUNT] = {0, 0};
+    TraceReplay traceReplay;
+    qint64 profileStartMs = -1;
+    PcapngWriter pcapngWriter;
+    quint32 captureTransmitterAddr = 0;
+    quint32 captureReceiverAddr = 0;
+    quint32 captureEmulatorAddr = 0;
+    int captureSnaplen = CAPTURE_SNAPLEN;
+    int captureRotateMB = CAPTURE_ROTATE_MB;
+    PacketRecordStore packetRecords;
+    CsvExporter csvExporter;
+    QTimer* exportTimer = nullptr;
+    DecimatedSeries timeSequence;
+    QVector<QPointF> timeSequencePoints;
+    QTimer* chartTimer = nullptr;
+    QTimer* summaryTimer = nullptr;
+    MetricsServer* metricsServer = nullptr;
+    MetricsSnapshot metricsBaseline;
+    bool holdTimesLogged = false;
+    QHash<int, int> connectionTransfers;    // Files each connection carries, from its SYN_ACK
+    bool finishScheduled = false;
+    QString transmitterAddress;
+    quint16 transmitterUdpPort = 0;
+    QString receiverAddress;
+    quint16 receiverUdpPort = 0;
+    QString emulatorAddress;
+    quint16 emulatorUdpPort = 0;
+    int defaultNetworkDelay = NETWORK_DELAY_MS;
+    int defaultErrorRatePercent = ERROR_RATE_PERCENT;
+    bool headless = false;
+    bool exitAfterEOT = false;
+    bool ioUring = false;
+    QString packetRingInterface;
+    QString lastRelTimeString;
 
-    int droppedPackets = 0;
-    int retransmits = 0;
     int packetTableRowIndex = 0;
     bool pause;
     const int minX = 0;
@@ -119,9 +273,12 @@ private:
     int maxY = INITIAL_MAX_Y;
     int networkDelay = NETWORK_DELAY_MS;
     int errorRatePercent = ERROR_RATE_PERCENT;
+    bool corrupt = false;
 
-    struct packet* pkt = nullptr;
-    int packetSize = 0;
+    struct packetPool* packetPool = nullptr;
+    struct packetPoolCache* packetCache = nullptr;
+    struct packet* pkt = nullptr;           // Slot of the packet being processed, owned by the packet pool
+    int packetSize = 0;                     // Length of that datagram; only the data in use is sent
 
     struct timeval start{0,0}, end{0,0};
 
@@ -129,12 +286,24 @@ private:
     void init();
     void resetFiguresState();
     QStandardItemModel* convertAbstractModelToStandard(QAbstractItemModel* model);
+    socklen_t resolveSockaddr(const QString& address, quint16 port, struct sockaddr_storage* out);
+    void processDatagram(quint32 handle, qint64 length, const struct sockaddr_storage* source);
     bool dropPkt(int prob);
-    void averagePktDelay(int delay);
-    void relayPacket(QHostAddress* sender, quint16 senderPort, QTime* relTime, QString relTimeString);
-    void recordPacket(QHostAddress* sender, quint16 senderPort, QTime* relTime, QString relTimeString);
-    void updatePacketTable(struct packet* pkt, QHostAddress* sourceIP, quint16 sourcePort, const char* destinationIP, int destinationPort, bool isDropped, QString relTime, QColor rowColor);
-    void updateNetworkSummaryTable(QString relTime);
-    void updateTimeSequence(struct packet* pkt, QHostAddress* sourceIP, QTime* relTime);
+    void corruptPkt(quint32 handle, qint64 length);
+    void delayPacket(quint32 handle, qint64 length, const Endpoint* sender, QTime* relTime, QString relTimeString, int delayMs, int bandwidthKbps);
+    void scheduleRelease();
+    void setSlidersEnabled(bool enabled);
+    bool loadProfile(const QString& filename);
+    bool startCapture(const QString& filename);
+    void stopCapture();
+    void capturePacket(int interfaceId, quint32 sourceAddr, quint16 sourcePort, quint32 destinationAddr, quint16 destinationPort, const char* comment);
+    void relayPacket(const Endpoint* sender, QTime* relTime, QString relTimeString);
+    void recordPacket(const Endpoint* sender, QTime* relTime, QString relTimeString);
+    bool fromTransmitter(const Endpoint* sender);
+    void learnStream(const Endpoint* sender);
+    int learnedStream(const struct packet* pkt);
+    QString formatEndpointAddress(const Endpoint* endpoint);
+    void updatePacketTable(struct packet* pkt, const Endpoint* source, const Endpoint* destination, bool isDropped, QTime* relTime, QString relTimeString, QColor rowColor);
+    void updateTimeSequence(struct packet* pkt, const Endpoint* source, QTime* relTime);
 };
 #endif // NETWORKEMULATOR_H
@@ -0,0 +1,155 @@
+/*----------------------------------------------------------------------------------------------------------------------------
+ * SOURCE FILE:    packetrecordstore.cpp
+ *
+ * FUNCTIONS:      PacketRecordStore::~PacketRecordStore()
+ *                 void PacketRecordStore::append(const PacketRecord& record)
+ *                 size_t PacketRecordStore::size() const
+ *                 const PacketRecord* PacketRecordStore::chunk(size_t chunkIndex) const
+ *                 void PacketRecordStore::clear()
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * NOTES:
+ * Chunked, append-only store of the packets recorded by the Network Emulator
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+
+#include "packetrecordstore.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRecordStore::~PacketRecordStore
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      PacketRecordStore::~PacketRecordStore()
+ *
+ * NOTES:
+ * Destructor of PacketRecordStore class
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+PacketRecordStore::~PacketRecordStore()
+{
+    clear();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRecordStore::append
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void PacketRecordStore::append(const PacketRecord& record)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Appends a record, allocating a new chunk when the current one is full; only the chunk list is locked
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void PacketRecordStore::append(const PacketRecord& record)
+{
+    size_t index = count.load(std::memory_order_relaxed);
+    size_t offset = index % PACKET_RECORD_CHUNK_SIZE;
+
+    if (offset == 0)
+    {
+        PacketRecord* newChunk = new PacketRecord[PACKET_RECORD_CHUNK_SIZE];
+        std::lock_guard<std::mutex> guard(chunksLock);
+        chunks.push_back(newChunk);
+        tail = newChunk;
+    }
+
+    tail[offset] = record;
+    count.store(index + 1, std::memory_order_release);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRecordStore::size
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      size_t PacketRecordStore::size() const
+ *
+ * RETURNS:        size_t, number of records that are safe to read
+ *
+ * NOTES:
+ * Returns a snapshot of the record count
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+size_t PacketRecordStore::size() const
+{
+    return count.load(std::memory_order_acquire);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRecordStore::chunk
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      const PacketRecord* PacketRecordStore::chunk(size_t chunkIndex) const
+ *
+ * RETURNS:        const PacketRecord*, first record of the chunk or nullptr if it does not exist
+ *
+ * NOTES:
+ * Returns the chunk holding records [chunkIndex * PACKET_RECORD_CHUNK_SIZE, (chunkIndex + 1) * PACKET_RECORD_CHUNK_SIZE)
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+const PacketRecord* PacketRecordStore::chunk(size_t chunkIndex) const
+{
+    std::lock_guard<std::mutex> guard(chunksLock);
+    return (chunkIndex < chunks.size()) ? chunks[chunkIndex] : nullptr;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRecordStore::clear
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void PacketRecordStore::clear()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Frees every record
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void PacketRecordStore::clear()
+{
+    std::lock_guard<std::mutex> guard(chunksLock);
+    for (PacketRecord* recordChunk : chunks)
+    {
+        delete[] recordChunk;
+    }
+    chunks.clear();
+    tail = nullptr;
+    count.store(0, std::memory_order_release);
+}
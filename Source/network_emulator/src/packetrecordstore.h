@@ -0,0 +1,87 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * PACKETRECORDSTORE CLASS DECLARATION FILE:    packetrecordstore.h
+ *
+ * DATE:                                        October 18th, 2026
+ *
+ * REVISIONS:                                   October 18th, 2026 - Records keep the endpoint keys, so IPv6 addresses survive
+ *
+ * DESIGNER:                                    Derek Wong
+ *
+ * PROGRAMMER:                                  Derek Wong
+ *
+ * NOTES:
+ * Declaration file for PacketRecordStore class
+ *
+ * Every packet shown in the packet table is also kept here as a fixed-size record, so exports and statistics
+ * can read the capture without going back through the table model.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef PACKETRECORDSTORE_H
+#define PACKETRECORDSTORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "endpoint.h"
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define PACKET_RECORD_CHUNK_SIZE    65536       // Records per chunk, chunks never move once allocated
+
+/*------------------------------------------------ Structs --------------------------------------------------------------------------*/
+struct PacketRecord
+{
+    int32_t relTimeMs;
+    int32_t windowSize;
+    int32_t seqNum;
+    int32_t ackNum;
+    struct Endpoint source;
+    struct Endpoint destination;
+    uint8_t packetType;
+    bool dropped;
+    bool retransmit;
+};
+
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * CLASS:           PacketRecordStore
+ *
+ * DATE:            October 18th, 2026
+ *
+ * REVISIONS:       N/A
+ *
+ * DESIGNER:        Derek Wong
+ *
+ * PROGRAMMER:      Derek Wong
+ *
+ * NOTES:
+ * Append-only packet record storage with a single writer and any number of readers.
+ * Records live in fixed-size chunks so a record's address is stable; the writer publishes the record count with
+ * release ordering, and a reader that snapshots size() may read every record below it without further locking.
+ * clear() must not be called while a reader is active.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+class PacketRecordStore
+{
+public:
+    // constructor
+    PacketRecordStore() = default;
+    // destructor
+    ~PacketRecordStore();
+
+    PacketRecordStore(const PacketRecordStore&) = delete;
+    PacketRecordStore& operator=(const PacketRecordStore&) = delete;
+
+    void append(const PacketRecord& record);
+    size_t size() const;
+    const PacketRecord* chunk(size_t chunkIndex) const;
+    void clear();
+
+private:
+    std::vector<PacketRecord*> chunks;
+    PacketRecord* tail = nullptr;
+    std::atomic<size_t> count{0};
+    mutable std::mutex chunksLock;
+};
+#endif // PACKETRECORDSTORE_H
@@ -0,0 +1,593 @@
+/*----------------------------------------------------------------------------------------------------------------------------
+ * SOURCE FILE:    packetring.cpp
+ *
+ * FUNCTIONS:      PacketRing::PacketRing()
+ *                 PacketRing::~PacketRing()
+ *                 bool PacketRing::open(const char* interfaceName, const struct sockaddr_in* local)
+ *                 void PacketRing::close()
+ *                 int PacketRing::descriptor() const
+ *                 int PacketRing::receive(void* const* buffers, size_t capacity, struct DatagramInfo* infos, int count)
+ *                 bool PacketRing::send(const void* data, size_t length, const struct sockaddr_in* destination)
+ *                 void PacketRing::flush()
+ *                 bool PacketRing::attachFilter()
+ *                 void PacketRing::learn(uint32_t address, const unsigned char* mac)
+ *                 const unsigned char* PacketRing::lookup(uint32_t address) const
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * NOTES:
+ * The file contains the PACKET_MMAP forwarding path of the emulator
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+
+#include "packetring.h"
+
+#if defined(PACKET_RING_SUPPORTED)
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <linux/filter.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define ETHERNET_HEADER_LEN     14
+#define IPV4_HEADER_LEN         20                  // Sent without options
+#define UDP_HEADER_LEN          8
+#define IPV4_DEFAULT_TTL        64
+#define IPV4_DONT_FRAGMENT      0x4000
+#define TX_DATA_OFFSET          (TPACKET_ALIGN(sizeof(struct tpacket3_hdr)))
+
+/*------------------------------------------------ Macros ---------------------------------------------------------------------------*/
+// Frame and block status words are shared with the kernel
+#define RING_STATUS_LOAD(pointer)           __atomic_load_n((pointer), __ATOMIC_ACQUIRE)
+#define RING_STATUS_STORE(pointer, value)   __atomic_store_n((pointer), (value), __ATOMIC_RELEASE)
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ipv4Checksum
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static uint16_t ipv4Checksum(const unsigned char* header, size_t length)
+ *
+ * RETURNS:        uint16_t, the header checksum in network byte order
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static uint16_t ipv4Checksum(const unsigned char* header, size_t length)
+{
+    uint32_t sum = 0;
+    for (size_t i = 0; i + 1 < length; i += 2)
+    {
+        sum += (uint32_t)(header[i] << 8 | header[i + 1]);
+    }
+    while (sum >> 16)
+    {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    return htons((uint16_t)~sum);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRing::PacketRing
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      PacketRing::PacketRing()
+ *
+ * RETURNS:        an instance of PacketRing
+ *
+ * NOTES:
+ * Constructor of PacketRing class, the ring is created by open()
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+PacketRing::PacketRing()
+{
+    memset(localMac, 0, sizeof(localMac));
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRing::~PacketRing
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      PacketRing::~PacketRing()
+ *
+ * NOTES:
+ * Destructor of PacketRing class
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+PacketRing::~PacketRing()
+{
+    close();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRing::open
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool PacketRing::open(const char* interfaceName, const struct sockaddr_in* local)
+ *
+ * RETURNS:        bool, false if the interface does not exist, the process lacks CAP_NET_RAW or the rings cannot be
+ *                 set up
+ *
+ * NOTES:
+ * Creates the receive and transmit rings on interfaceName for datagrams addressed to local
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool PacketRing::open(const char* interfaceName, const struct sockaddr_in* local)
+{
+    struct tpacket_req3 rxRequest, txRequest;
+    struct sockaddr_ll link;
+    struct ifreq request;
+    int version = TPACKET_V3;
+
+    close();
+    unsigned int interfaceIndex = if_nametoindex(interfaceName);
+    if (interfaceIndex == 0 || strlen(interfaceName) >= sizeof(request.ifr_name))
+    {
+        return false;
+    }
+    localAddress = local->sin_addr.s_addr;
+    localPort = local->sin_port;
+
+    // The protocol is given at bind time, once the rings exist, so nothing is queued outside them
+    if ((fd = socket(AF_PACKET, SOCK_RAW, 0)) < 0)
+    {
+        return false;
+    }
+    memset(&request, 0, sizeof(request));
+    strcpy(request.ifr_name, interfaceName);
+    if (ioctl(fd, SIOCGIFHWADDR, &request) < 0 || setsockopt(fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0
+        || !attachFilter())
+    {
+        close();
+        return false;
+    }
+    memcpy(localMac, request.ifr_hwaddr.sa_data, sizeof(localMac));
+
+    memset(&rxRequest, 0, sizeof(rxRequest));
+    rxRequest.tp_block_size = PACKET_RING_BLOCK_SIZE;
+    rxRequest.tp_block_nr = PACKET_RING_BLOCKS;
+    rxRequest.tp_frame_size = PACKET_RING_FRAME_SIZE;
+    rxRequest.tp_frame_nr = PACKET_RING_BLOCK_SIZE / PACKET_RING_FRAME_SIZE * PACKET_RING_BLOCKS;
+    rxRequest.tp_retire_blk_tov = PACKET_RING_BLOCK_TIMEOUT;
+    memset(&txRequest, 0, sizeof(txRequest));
+    txRequest.tp_block_size = PACKET_RING_FRAME_SIZE * PACKET_RING_TX_FRAMES;
+    txRequest.tp_block_nr = 1;
+    txRequest.tp_frame_size = PACKET_RING_FRAME_SIZE;
+    txRequest.tp_frame_nr = PACKET_RING_TX_FRAMES;
+    if (setsockopt(fd, SOL_PACKET, PACKET_RX_RING, &rxRequest, sizeof(rxRequest)) < 0
+        || setsockopt(fd, SOL_PACKET, PACKET_TX_RING, &txRequest, sizeof(txRequest)) < 0)
+    {
+        close();
+        return false;
+    }
+
+    size_t rxLen = (size_t)PACKET_RING_BLOCK_SIZE * PACKET_RING_BLOCKS;
+    mapLen = rxLen + (size_t)PACKET_RING_FRAME_SIZE * PACKET_RING_TX_FRAMES;
+    void* address = mmap(NULL, mapLen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, fd, 0);
+    if (address == MAP_FAILED)
+    {
+        // MAP_LOCKED needs RLIMIT_MEMLOCK headroom; the ring works unlocked too
+        address = mmap(NULL, mapLen, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (address == MAP_FAILED)
+    {
+        close();
+        return false;
+    }
+    map = static_cast<unsigned char*>(address);
+    txFrames = map + rxLen;
+
+    memset(&link, 0, sizeof(link));
+    link.sll_family = AF_PACKET;
+    link.sll_protocol = htons(ETH_P_IP);
+    link.sll_ifindex = (int)interfaceIndex;
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&link), sizeof(link)) < 0)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRing::close
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void PacketRing::close()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Sends the frames written so far and releases the rings
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void PacketRing::close()
+{
+    if (fd >= 0)
+    {
+        flush();
+    }
+    if (map != nullptr)
+    {
+        munmap(map, mapLen);
+        map = nullptr;
+        txFrames = nullptr;
+    }
+    if (fd >= 0)
+    {
+        ::close(fd);
+        fd = -1;
+    }
+    rxBlock = 0;
+    rxPacketsLeft = 0;
+    rxPacket = nullptr;
+    txNext = 0;
+    txPending = 0;
+    neighbourCount = 0;
+    neighbourNext = 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRing::descriptor
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int PacketRing::descriptor() const
+ *
+ * RETURNS:        int, the packet socket, readable when a receive block has been handed over
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int PacketRing::descriptor() const
+{
+    return fd;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRing::receive
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int PacketRing::receive(void* const* buffers, size_t capacity, struct DatagramInfo* infos, int count)
+ *
+ * RETURNS:        int, the number of datagrams read, 0 when none are waiting
+ *
+ * NOTES:
+ * Copies the UDP payloads of up to count frames into buffers, truncated to capacity, with their IPv4 source in
+ * infos. A block is returned to the kernel once all of its frames have been read.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int PacketRing::receive(void* const* buffers, size_t capacity, struct DatagramInfo* infos, int count)
+{
+    int received = 0;
+
+    while (received < count)
+    {
+        struct tpacket_block_desc* block = reinterpret_cast<struct tpacket_block_desc*>(map + (size_t)rxBlock * PACKET_RING_BLOCK_SIZE);
+        if (rxPacket == nullptr)
+        {
+            if (!(RING_STATUS_LOAD(&block->hdr.bh1.block_status) & TP_STATUS_USER))
+            {
+                break;
+            }
+            rxPacketsLeft = block->hdr.bh1.num_pkts;
+            rxPacket = reinterpret_cast<unsigned char*>(block) + block->hdr.bh1.offset_to_first_pkt;
+        }
+        if (rxPacketsLeft == 0)
+        {
+            RING_STATUS_STORE(&block->hdr.bh1.block_status, (uint32_t)TP_STATUS_KERNEL);
+            rxBlock = (rxBlock + 1) % PACKET_RING_BLOCKS;
+            rxPacket = nullptr;
+            continue;
+        }
+
+        struct tpacket3_hdr* header = reinterpret_cast<struct tpacket3_hdr*>(rxPacket);
+        const unsigned char* frame = rxPacket + header->tp_mac;
+        uint32_t frameLen = header->tp_snaplen;
+        rxPacket += header->tp_next_offset;
+        rxPacketsLeft--;
+
+        // The kernel filter has checked the protocol, destination and port; the lengths are checked here
+        if (frameLen < ETHERNET_HEADER_LEN + IPV4_HEADER_LEN)
+        {
+            continue;
+        }
+        const unsigned char* ip = frame + ETHERNET_HEADER_LEN;
+        size_t ipHeaderLen = (size_t)(ip[0] & 0x0F) * 4;
+        if (frameLen < ETHERNET_HEADER_LEN + ipHeaderLen + UDP_HEADER_LEN)
+        {
+            continue;
+        }
+        const unsigned char* udp = ip + ipHeaderLen;
+        size_t udpLen = (size_t)(udp[4] << 8 | udp[5]);
+        size_t available = frameLen - ETHERNET_HEADER_LEN - ipHeaderLen;
+        if (udpLen < UDP_HEADER_LEN || udpLen > available)
+        {
+            continue;
+        }
+
+        uint32_t source;
+        memcpy(&source, ip + 12, sizeof(source));
+        learn(source, frame + 6);
+
+        size_t payloadLen = udpLen - UDP_HEADER_LEN;
+        size_t length = (payloadLen < capacity) ? payloadLen : capacity;
+        memcpy(buffers[received], udp + UDP_HEADER_LEN, length);
+        struct sockaddr_in* from = reinterpret_cast<struct sockaddr_in*>(&infos[received].source);
+        memset(&infos[received].source, 0, sizeof(infos[received].source));
+        from->sin_family = AF_INET;
+        from->sin_addr.s_addr = source;
+        memcpy(&from->sin_port, udp, sizeof(from->sin_port));
+        infos[received].length = (int64_t)length;
+        received++;
+    }
+    return received;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRing::send
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool PacketRing::send(const void* data, size_t length, const struct sockaddr_in* destination)
+ *
+ * RETURNS:        bool, true if the datagram was written to the transmit ring
+ *
+ * NOTES:
+ * Writes the datagram as a frame from the local address and port; it leaves with the next flush()
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool PacketRing::send(const void* data, size_t length, const struct sockaddr_in* destination)
+{
+    const unsigned char* mac = lookup(destination->sin_addr.s_addr);
+    size_t frameLen = ETHERNET_HEADER_LEN + IPV4_HEADER_LEN + UDP_HEADER_LEN + length;
+    if (mac == nullptr || TX_DATA_OFFSET + frameLen > PACKET_RING_FRAME_SIZE)
+    {
+        return false;
+    }
+
+    unsigned char* slot = txFrames + (size_t)txNext * PACKET_RING_FRAME_SIZE;
+    struct tpacket3_hdr* header = reinterpret_cast<struct tpacket3_hdr*>(slot);
+    if (RING_STATUS_LOAD(&header->tp_status) != TP_STATUS_AVAILABLE)
+    {
+        return false;
+    }
+
+    unsigned char* frame = slot + TX_DATA_OFFSET;
+    memcpy(frame, mac, 6);
+    memcpy(frame + 6, localMac, 6);
+    frame[12] = ETH_P_IP >> 8;
+    frame[13] = ETH_P_IP & 0xFF;
+
+    unsigned char* ip = frame + ETHERNET_HEADER_LEN;
+    uint16_t totalLen = htons((uint16_t)(IPV4_HEADER_LEN + UDP_HEADER_LEN + length));
+    uint16_t id = htons(ipId++);
+    uint16_t flags = htons(IPV4_DONT_FRAGMENT);
+    ip[0] = 0x45;
+    ip[1] = 0;
+    memcpy(ip + 2, &totalLen, 2);
+    memcpy(ip + 4, &id, 2);
+    memcpy(ip + 6, &flags, 2);
+    ip[8] = IPV4_DEFAULT_TTL;
+    ip[9] = IPPROTO_UDP;
+    ip[10] = ip[11] = 0;
+    memcpy(ip + 12, &localAddress, 4);
+    memcpy(ip + 16, &destination->sin_addr.s_addr, 4);
+    uint16_t checksum = ipv4Checksum(ip, IPV4_HEADER_LEN);
+    memcpy(ip + 10, &checksum, 2);
+
+    // A zero UDP checksum means none over IPv4
+    unsigned char* udp = ip + IPV4_HEADER_LEN;
+    uint16_t udpLen = htons((uint16_t)(UDP_HEADER_LEN + length));
+    memcpy(udp, &localPort, 2);
+    memcpy(udp + 2, &destination->sin_port, 2);
+    memcpy(udp + 4, &udpLen, 2);
+    udp[6] = udp[7] = 0;
+    memcpy(udp + UDP_HEADER_LEN, data, length);
+
+    header->tp_len = (uint32_t)frameLen;
+    header->tp_snaplen = (uint32_t)frameLen;
+    header->tp_next_offset = 0;
+    RING_STATUS_STORE(&header->tp_status, (uint32_t)TP_STATUS_SEND_REQUEST);
+    txNext = (txNext + 1) % PACKET_RING_TX_FRAMES;
+    txPending++;
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRing::flush
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void PacketRing::flush()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Asks the kernel to transmit every frame written since the last flush, without waiting for them
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void PacketRing::flush()
+{
+    if (txPending == 0)
+    {
+        return;
+    }
+    while (::send(fd, NULL, 0, MSG_DONTWAIT) < 0 && errno == EINTR)
+    {
+    }
+    txPending = 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRing::attachFilter
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool PacketRing::attachFilter()
+ *
+ * RETURNS:        bool, true if the filter was attached
+ *
+ * NOTES:
+ * Passes unfragmented IPv4 UDP frames addressed to the local address and port, which also keeps out the frames the
+ * ring transmits itself
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool PacketRing::attachFilter()
+{
+    struct sock_filter code[] =
+    {
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 12),                                 // EtherType
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ETH_P_IP, 0, 10),
+        BPF_STMT(BPF_LD | BPF_B | BPF_ABS, ETHERNET_HEADER_LEN + 9),            // IPv4 protocol
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 0, 8),
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, ETHERNET_HEADER_LEN + 16),           // IPv4 destination
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ntohl(localAddress), 0, 6),
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, ETHERNET_HEADER_LEN + 6),            // Fragment offset
+        BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, 0x1FFF, 4, 0),
+        BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, ETHERNET_HEADER_LEN),               // IPv4 header length
+        BPF_STMT(BPF_LD | BPF_H | BPF_IND, ETHERNET_HEADER_LEN + 2),            // UDP destination port
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ntohs(localPort), 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, 0xFFFF),
+        BPF_STMT(BPF_RET | BPF_K, 0),
+    };
+    struct sock_fprog program;
+    program.len = sizeof(code) / sizeof(code[0]);
+    program.filter = code;
+    return setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof(program)) == 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRing::learn
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void PacketRing::learn(uint32_t address, const unsigned char* mac)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Records the MAC address a peer sent from; a full table replaces its entries in turn
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void PacketRing::learn(uint32_t address, const unsigned char* mac)
+{
+    for (int i = 0; i < neighbourCount; i++)
+    {
+        if (neighbours[i].address == address)
+        {
+            memcpy(neighbours[i].mac, mac, sizeof(neighbours[i].mac));
+            return;
+        }
+    }
+    int index = neighbourCount;
+    if (neighbourCount < PACKET_RING_NEIGHBOURS)
+    {
+        neighbourCount++;
+    }
+    else
+    {
+        index = neighbourNext;
+        neighbourNext = (neighbourNext + 1) % PACKET_RING_NEIGHBOURS;
+    }
+    neighbours[index].address = address;
+    memcpy(neighbours[index].mac, mac, sizeof(neighbours[index].mac));
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PacketRing::lookup
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      const unsigned char* PacketRing::lookup(uint32_t address) const
+ *
+ * RETURNS:        const unsigned char*, the MAC address learned for address, or nullptr
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+const unsigned char* PacketRing::lookup(uint32_t address) const
+{
+    for (int i = 0; i < neighbourCount; i++)
+    {
+        if (neighbours[i].address == address)
+        {
+            return neighbours[i].mac;
+        }
+    }
+    return nullptr;
+}
+
+#endif // PACKET_RING_SUPPORTED
@@ -0,0 +1,104 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * PACKETRING CLASS DECLARATION FILE:           packetring.h
+ *
+ * DATE:                                        October 18th, 2026
+ *
+ * REVISIONS:                                   N/A
+ *
+ * DESIGNER:                                    Derek Wong
+ *
+ * PROGRAMMER:                                  Derek Wong
+ *
+ * NOTES:
+ * Declaration file for PacketRing class
+ *
+ * A PACKET_MMAP (TPACKET_V3) receive and transmit ring on one network interface, for forwarding UDP datagrams
+ * without the socket layer. Frames are read from and written to memory shared with the kernel; only IPv4 without
+ * options on the wire is handled. Linux only.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef PACKETRING_H
+#define PACKETRING_H
+
+#if defined(__linux__)
+
+#define PACKET_RING_SUPPORTED 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <netinet/in.h>
+
+#include "datagramsocket.h"
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define PACKET_RING_BLOCK_SIZE      (1 << 18)       // Receive block; the kernel hands over whole blocks
+#define PACKET_RING_BLOCKS          8
+#define PACKET_RING_BLOCK_TIMEOUT   1               // ms before a partly filled block is handed over anyway
+#define PACKET_RING_FRAME_SIZE      2048            // Transmit frame
+#define PACKET_RING_TX_FRAMES       256
+#define PACKET_RING_NEIGHBOURS      16              // Link-layer addresses learned from received frames
+
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * CLASS:           PacketRing
+ *
+ * DATE:            October 18th, 2026
+ *
+ * REVISIONS:       N/A
+ *
+ * DESIGNER:        Derek Wong
+ *
+ * PROGRAMMER:      Derek Wong
+ *
+ * NOTES:
+ * A kernel filter passes only UDP frames addressed to the local address and port. The owner watches descriptor()
+ * and drains the ring with receive(); send() builds the Ethernet, IPv4 and UDP headers in a transmit frame and
+ * flush() hands every frame written since to the kernel with one system call.
+ * The MAC address of each peer is learned from the frames it sends; send() returns false for a peer not seen yet,
+ * or when the transmit ring is full, and the caller sends through the socket layer instead.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+class PacketRing
+{
+public:
+    // constructor
+    PacketRing();
+    // destructor
+    ~PacketRing();
+
+    bool open(const char* interfaceName, const struct sockaddr_in* local);
+    void close();
+    int descriptor() const;
+    int receive(void* const* buffers, size_t capacity, struct DatagramInfo* infos, int count);
+    bool send(const void* data, size_t length, const struct sockaddr_in* destination);
+    void flush();
+
+private:
+    struct Neighbour
+    {
+        uint32_t address;                           // Network byte order
+        unsigned char mac[6];
+    };
+
+    bool attachFilter();
+    void learn(uint32_t address, const unsigned char* mac);
+    const unsigned char* lookup(uint32_t address) const;
+
+    int fd = -1;
+    unsigned char* map = nullptr;                   // Receive blocks followed by transmit frames
+    size_t mapLen = 0;
+    unsigned char* txFrames = nullptr;
+    int rxBlock = 0;                                // Block being read
+    uint32_t rxPacketsLeft = 0;                     // Packets of rxBlock not read yet
+    unsigned char* rxPacket = nullptr;              // Next packet of rxBlock, nullptr until the block is ready
+    int txNext = 0;
+    int txPending = 0;                              // Frames written since the last flush
+    uint32_t localAddress = 0;                      // Network byte order
+    uint16_t localPort = 0;                         // Network byte order
+    unsigned char localMac[6];
+    uint16_t ipId = 0;
+    Neighbour neighbours[PACKET_RING_NEIGHBOURS];
+    int neighbourCount = 0;
+    int neighbourNext = 0;                          // Entry replaced next once the table is full
+};
+
+#endif // __linux__
+#endif // PACKETRING_H
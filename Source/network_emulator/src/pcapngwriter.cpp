@@ -0,0 +1,682 @@
+/*----------------------------------------------------------------------------------------------------------------------------
+ * SOURCE FILE:    pcapngwriter.cpp
+ *
+ * FUNCTIONS:      bool PcapngWriter::open(const std::string& path, uint32_t snaplen, uint64_t rotateBytes)
+ *                 void PcapngWriter::close()
+ *                 bool PcapngWriter::isOpen() const
+ *                 uint64_t PcapngWriter::droppedRecords() const
+ *                 void PcapngWriter::writePacket(int interfaceId, uint64_t timestampNs, uint32_t srcAddr, uint16_t srcPort,
+ *                     uint32_t dstAddr, uint16_t dstPort, const void* payload, uint32_t length, const char* comment)
+ *                 bool PcapngWriter::openFile()
+ *                 bool PcapngWriter::writeHeaderBlocks()
+ *                 void PcapngWriter::submitBuffer(int index)
+ *                 int PcapngWriter::acquireBuffer()
+ *                 void PcapngWriter::writerLoop()
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Partly filled buffers are flushed by the writer thread after
+ *                                      CAPTURE_FLUSH_INTERVAL_NS, whether or not more packets arrive
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * NOTES:
+ * The file contains the pcapng capture writer used by the forwarding path
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+
+#include "pcapngwriter.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+/*------------------------------------------------ pcapng Block Constants -----------------------------------------------------*/
+static const uint32_t SECTION_HEADER_BLOCK = 0x0A0D0D0A;
+static const uint32_t INTERFACE_DESCRIPTION_BLOCK = 0x00000001;
+static const uint32_t ENHANCED_PACKET_BLOCK = 0x00000006;
+static const uint32_t BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+static const uint16_t LINKTYPE_RAW = 101;
+static const uint16_t OPT_ENDOFOPT = 0;
+static const uint16_t OPT_COMMENT = 1;
+static const uint16_t SHB_USERAPPL = 4;
+static const uint16_t IF_NAME = 2;
+static const uint16_t IF_TSRESOL = 9;
+static const uint16_t EPB_FLAGS = 2;
+static const uint32_t EPB_FLAG_INBOUND = 1;
+static const uint32_t EPB_FLAG_OUTBOUND = 2;
+static const uint32_t IP_UDP_HEADER_LEN = 28;
+static const uint32_t EPB_FIXED_LEN = 28;
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       pad4
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static uint32_t pad4(uint32_t len)
+ *
+ * RETURNS:        uint32_t
+ *
+ * NOTES:
+ * Rounds a length up to the 32-bit boundary required between pcapng fields
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static uint32_t pad4(uint32_t len)
+{
+    return (len + 3) & ~3u;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       putOption
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static unsigned char* putOption(unsigned char* out, uint16_t code, const void* value, uint16_t len)
+ *
+ * RETURNS:        unsigned char*, the position after the padded option
+ *
+ * NOTES:
+ * Serializes one pcapng option
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static unsigned char* putOption(unsigned char* out, uint16_t code, const void* value, uint16_t len)
+{
+    memcpy(out, &code, 2);
+    memcpy(out + 2, &len, 2);
+    memset(out + 4, 0, pad4(len));
+    if (len > 0) memcpy(out + 4, value, len);
+    return out + 4 + pad4(len);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ipChecksum
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static uint16_t ipChecksum(const unsigned char* header, int len)
+ *
+ * RETURNS:        uint16_t in network byte order
+ *
+ * NOTES:
+ * Computes the Internet checksum of the synthesized IPv4 header
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static uint16_t ipChecksum(const unsigned char* header, int len)
+{
+    uint32_t sum = 0;
+    for (int i = 0; i < len; i += 2)
+    {
+        sum += (header[i] << 8) | header[i + 1];
+    }
+    while (sum >> 16)
+    {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    return (uint16_t)~sum;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PcapngWriter::PcapngWriter
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      PcapngWriter::PcapngWriter()
+ *
+ * RETURNS:        an instance of PcapngWriter
+ *
+ * NOTES:
+ * Constructor of PcapngWriter class
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+PcapngWriter::PcapngWriter()
+{
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PcapngWriter::~PcapngWriter
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      PcapngWriter::~PcapngWriter()
+ *
+ * NOTES:
+ * Destructor of PcapngWriter class, flushes any pending records
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+PcapngWriter::~PcapngWriter()
+{
+    close();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PcapngWriter::open
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool PcapngWriter::open(const std::string& path, uint32_t snaplen, uint64_t rotateBytes)
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * Starts a capture; snaplen of 0 captures whole frames and rotateBytes of 0 disables file rotation
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool PcapngWriter::open(const std::string& path, uint32_t snaplen, uint64_t rotateBytes)
+{
+    close();
+
+    basePath = path;
+    this->snaplen = snaplen;
+    this->rotateBytes = rotateBytes;
+    fileIndex = 0;
+    if (!openFile())
+    {
+        return false;
+    }
+
+    for (int i = 0; i < CAPTURE_BUFFER_COUNT; i++)
+    {
+        buffers[i] = (unsigned char *)malloc(CAPTURE_BUFFER_SIZE);
+        bufferFill[i] = 0;
+        freeStack[i] = i;
+    }
+    freeCount = CAPTURE_BUFFER_COUNT;
+    filledHead = 0;
+    filledCount = 0;
+    currentBuffer = -1;
+    stopping = false;
+    dropped = 0;
+    opened = true;
+
+    writerThread = std::thread(&PcapngWriter::writerLoop, this);
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PcapngWriter::close
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void PcapngWriter::close()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Flushes the buffer being filled, waits for the writer to drain the ring and closes the file
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void PcapngWriter::close()
+{
+    if (!opened)
+    {
+        return;
+    }
+
+    submitBuffer(currentBuffer.exchange(-1));
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    filledCondition.notify_one();
+    writerThread.join();
+
+    if (fp != nullptr)
+    {
+        fclose(fp);
+        fp = nullptr;
+    }
+    for (int i = 0; i < CAPTURE_BUFFER_COUNT; i++)
+    {
+        free(buffers[i]);
+        buffers[i] = nullptr;
+    }
+    opened = false;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PcapngWriter::isOpen
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool PcapngWriter::isOpen() const
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * Returns true while a capture is running
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool PcapngWriter::isOpen() const
+{
+    return opened;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PcapngWriter::droppedRecords
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      uint64_t PcapngWriter::droppedRecords() const
+ *
+ * RETURNS:        uint64_t
+ *
+ * NOTES:
+ * Returns the number of records that could not be captured because the disk fell behind
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+uint64_t PcapngWriter::droppedRecords() const
+{
+    return dropped;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PcapngWriter::writePacket
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Takes the current buffer out of currentBuffer while appending to it
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void PcapngWriter::writePacket(int interfaceId, uint64_t timestampNs, uint32_t srcAddr, uint16_t srcPort,
+ *                     uint32_t dstAddr, uint16_t dstPort, const void* payload, uint32_t length, const char* comment
+ *                 )
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Appends an Enhanced Packet Block for one datagram to the current buffer;
+ * addresses and ports are in host byte order, timestamp is in nanoseconds since the epoch
+ * and comment, when not NULL, annotates the packet (for example as dropped)
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void PcapngWriter::writePacket(int interfaceId, uint64_t timestampNs, uint32_t srcAddr, uint16_t srcPort, uint32_t dstAddr, uint16_t dstPort,
+                               const void* payload, uint32_t length, const char* comment)
+{
+    if (!opened)
+    {
+        return;
+    }
+
+    uint32_t frameLen = IP_UDP_HEADER_LEN + length;
+    uint32_t capLen = (snaplen != 0 && frameLen > snaplen) ? snaplen : frameLen;
+    uint16_t commentLen = (comment != nullptr) ? (uint16_t)strnlen(comment, CAPTURE_MAX_COMMENT_LEN) : 0;
+    uint32_t blockLen = EPB_FIXED_LEN + pad4(capLen) + 8 + (commentLen > 0 ? 4 + pad4(commentLen) : 0) + 4 + 4;
+
+    // While it is taken out, the writer thread cannot flush the buffer from under this record
+    int index = currentBuffer.exchange(-1);
+    if (index >= 0 && (bufferFill[index] + blockLen > CAPTURE_BUFFER_SIZE
+                       || timestampNs - currentBufferStartNs >= (uint64_t)CAPTURE_FLUSH_INTERVAL_NS))
+    {
+        submitBuffer(index);
+        index = -1;
+    }
+    if (index < 0)
+    {
+        if ((index = acquireBuffer()) < 0)
+        {
+            dropped++;
+            return;
+        }
+        currentBufferStartNs = timestampNs;
+    }
+
+    // Synthesize the IPv4 and UDP headers the datagram travelled with
+    unsigned char headers[IP_UDP_HEADER_LEN] = {0};
+    headers[0] = 0x45;
+    headers[2] = (frameLen >> 8) & 0xFF;
+    headers[3] = frameLen & 0xFF;
+    headers[6] = 0x40;
+    headers[8] = 64;
+    headers[9] = 17;
+    for (int i = 0; i < 4; i++)
+    {
+        headers[12 + i] = (srcAddr >> (24 - 8 * i)) & 0xFF;
+        headers[16 + i] = (dstAddr >> (24 - 8 * i)) & 0xFF;
+    }
+    uint16_t checksum = ipChecksum(headers, 20);
+    headers[10] = checksum >> 8;
+    headers[11] = checksum & 0xFF;
+    headers[20] = srcPort >> 8;
+    headers[21] = srcPort & 0xFF;
+    headers[22] = dstPort >> 8;
+    headers[23] = dstPort & 0xFF;
+    headers[24] = ((8 + length) >> 8) & 0xFF;
+    headers[25] = (8 + length) & 0xFF;
+
+    unsigned char* out = buffers[index] + bufferFill[index];
+    uint32_t words[7] = {
+        ENHANCED_PACKET_BLOCK, blockLen, (uint32_t)interfaceId,
+        (uint32_t)(timestampNs >> 32), (uint32_t)(timestampNs & 0xFFFFFFFF), capLen, frameLen
+    };
+    memcpy(out, words, sizeof(words));
+    out += sizeof(words);
+
+    uint32_t headerBytes = (capLen < IP_UDP_HEADER_LEN) ? capLen : IP_UDP_HEADER_LEN;
+    memcpy(out, headers, headerBytes);
+    if (capLen > IP_UDP_HEADER_LEN)
+    {
+        memcpy(out + IP_UDP_HEADER_LEN, payload, capLen - IP_UDP_HEADER_LEN);
+    }
+    memset(out + capLen, 0, pad4(capLen) - capLen);
+    out += pad4(capLen);
+
+    uint32_t flags = (interfaceId == CAPTURE_INGRESS_INTERFACE) ? EPB_FLAG_INBOUND : EPB_FLAG_OUTBOUND;
+    out = putOption(out, EPB_FLAGS, &flags, sizeof(flags));
+    if (commentLen > 0)
+    {
+        out = putOption(out, OPT_COMMENT, comment, commentLen);
+    }
+    out = putOption(out, OPT_ENDOFOPT, nullptr, 0);
+    memcpy(out, &blockLen, 4);
+
+    bufferFill[index] += blockLen;
+    bufferRecords[index]++;
+    currentBuffer.store(index);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PcapngWriter::openFile
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool PcapngWriter::openFile()
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * Opens the next capture file; rotated files get a _NNNNN suffix before the extension
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool PcapngWriter::openFile()
+{
+    std::string path = basePath;
+    if (fileIndex > 0)
+    {
+        char suffix[16];
+        snprintf(suffix, sizeof(suffix), "_%05d", fileIndex);
+        size_t dot = path.find_last_of('.');
+        size_t slash = path.find_last_of("/\\");
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        {
+            dot = path.size();
+        }
+        path.insert(dot, suffix);
+    }
+
+    fp = fopen(path.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        perror("could not open capture file");
+        return false;
+    }
+    fileBytes = 0;
+    return writeHeaderBlocks();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PcapngWriter::writeHeaderBlocks
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool PcapngWriter::writeHeaderBlocks()
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * Writes the Section Header Block and the ingress and egress Interface Description Blocks with nanosecond resolution
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool PcapngWriter::writeHeaderBlocks()
+{
+    unsigned char block[256];
+    unsigned char* out;
+    uint32_t blockLen;
+
+    // Section Header Block
+    static const char userAppl[] = "network_emulator";
+    uint16_t majorVersion = 1, minorVersion = 0;
+    int64_t sectionLength = -1;
+    out = block + 8;
+    memcpy(out, &BYTE_ORDER_MAGIC, 4);
+    memcpy(out + 4, &majorVersion, 2);
+    memcpy(out + 6, &minorVersion, 2);
+    memcpy(out + 8, &sectionLength, 8);
+    out = putOption(out + 16, SHB_USERAPPL, userAppl, sizeof(userAppl) - 1);
+    out = putOption(out, OPT_ENDOFOPT, nullptr, 0);
+    blockLen = (uint32_t)(out - block) + 4;
+    memcpy(block, &SECTION_HEADER_BLOCK, 4);
+    memcpy(block + 4, &blockLen, 4);
+    memcpy(out, &blockLen, 4);
+    if (fwrite(block, 1, blockLen, fp) != blockLen) return false;
+    fileBytes += blockLen;
+
+    // Interface Description Blocks
+    static const char* const interfaceNames[] = { "ingress", "egress" };
+    uint8_t tsresol = 9;
+    uint16_t reserved = 0;
+    uint32_t idbSnaplen = snaplen;
+    for (int i = 0; i < 2; i++)
+    {
+        out = block + 8;
+        memcpy(out, &LINKTYPE_RAW, 2);
+        memcpy(out + 2, &reserved, 2);
+        memcpy(out + 4, &idbSnaplen, 4);
+        out = putOption(out + 8, IF_NAME, interfaceNames[i], (uint16_t)strlen(interfaceNames[i]));
+        out = putOption(out, IF_TSRESOL, &tsresol, 1);
+        out = putOption(out, OPT_ENDOFOPT, nullptr, 0);
+        blockLen = (uint32_t)(out - block) + 4;
+        memcpy(block, &INTERFACE_DESCRIPTION_BLOCK, 4);
+        memcpy(block + 4, &blockLen, 4);
+        memcpy(out, &blockLen, 4);
+        if (fwrite(block, 1, blockLen, fp) != blockLen) return false;
+        fileBytes += blockLen;
+    }
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PcapngWriter::submitBuffer
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Takes the buffer to submit; an empty one goes back to the ring
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void PcapngWriter::submitBuffer(int index)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Hands a buffer taken out of currentBuffer to the writer thread; index -1 does nothing
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void PcapngWriter::submitBuffer(int index)
+{
+    if (index < 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (bufferFill[index] == 0)
+        {
+            freeStack[freeCount++] = index;
+            return;
+        }
+        filledQueue[(filledHead + filledCount) % CAPTURE_BUFFER_COUNT] = index;
+        filledCount++;
+    }
+    filledCondition.notify_one();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PcapngWriter::acquireBuffer
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Returns the buffer instead of setting currentBuffer
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int PcapngWriter::acquireBuffer()
+ *
+ * RETURNS:        int, index of the buffer; -1 when all of them are waiting to be written
+ *
+ * NOTES:
+ * Takes an empty buffer from the ring
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int PcapngWriter::acquireBuffer()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (freeCount == 0)
+    {
+        return -1;
+    }
+    int index = freeStack[--freeCount];
+    bufferFill[index] = 0;
+    bufferRecords[index] = 0;
+    return index;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       PcapngWriter::writerLoop
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Wakes every CAPTURE_FLUSH_INTERVAL_NS to flush a buffer no record has
+ *                                      filled since; each buffer written is flushed out of stdio
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void PcapngWriter::writerLoop()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Background thread writing filled buffers to disk and rotating files once they reach the configured size;
+ * when nothing has been submitted for a flush interval, it takes the buffer being filled itself if that is
+ * older than the interval and not being appended to
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void PcapngWriter::writerLoop()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true)
+    {
+        if (!filledCondition.wait_for(guard, std::chrono::nanoseconds(CAPTURE_FLUSH_INTERVAL_NS), [this] { return filledCount > 0 || stopping; }))
+        {
+            uint64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            int index;
+            if (currentBuffer.load() < 0 || nowNs - currentBufferStartNs < (uint64_t)CAPTURE_FLUSH_INTERVAL_NS
+                || (index = currentBuffer.exchange(-1)) < 0)
+            {
+                continue;
+            }
+            if (bufferFill[index] == 0)
+            {
+                freeStack[freeCount++] = index;
+                continue;
+            }
+            filledQueue[(filledHead + filledCount) % CAPTURE_BUFFER_COUNT] = index;
+            filledCount++;
+        }
+        if (filledCount == 0)
+        {
+            break;
+        }
+
+        int index = filledQueue[filledHead];
+        filledHead = (filledHead + 1) % CAPTURE_BUFFER_COUNT;
+        filledCount--;
+        guard.unlock();
+
+        if (fp != nullptr && rotateBytes != 0 && fileBytes >= rotateBytes)
+        {
+            fclose(fp);
+            fileIndex++;
+            if (!openFile() && fp != nullptr)
+            {
+                fclose(fp);
+                fp = nullptr;
+            }
+        }
+
+        // Flushed from stdio too, so a buffer handed over on an idle link is on disk and not just out of the ring
+        if (fp != nullptr && fwrite(buffers[index], 1, bufferFill[index], fp) == bufferFill[index] && fflush(fp) == 0)
+        {
+            fileBytes += bufferFill[index];
+        }
+        else
+        {
+            dropped += bufferRecords[index];
+        }
+
+        guard.lock();
+        freeStack[freeCount++] = index;
+    }
+}
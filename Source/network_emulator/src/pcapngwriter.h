@@ -0,0 +1,106 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * PCAPNGWRITER CLASS DECLARATION FILE:         pcapngwriter.h
+ *
+ * DATE:                                        October 18th, 2026
+ *
+ * REVISIONS:                                   October 18th, 2026 - The writer thread hands itself a buffer left partly filled
+ *
+ * DESIGNER:                                    Derek Wong
+ *
+ * PROGRAMMER:                                  Derek Wong
+ *
+ * NOTES:
+ * Declaration file for PcapngWriter class
+ *
+ * Captured datagrams are wrapped in synthesized IPv4/UDP headers (LINKTYPE_RAW) so Wireshark can decode them.
+ * Every file has one interface for packets arriving at the emulator and one for packets it relays.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef PCAPNGWRITER_H
+#define PCAPNGWRITER_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define CAPTURE_INGRESS_INTERFACE   0
+#define CAPTURE_EGRESS_INTERFACE    1
+#define CAPTURE_BUFFER_COUNT        8
+#define CAPTURE_BUFFER_SIZE         (1 << 20)           // 1 MiB per buffer
+#define CAPTURE_FLUSH_INTERVAL_NS   1000000000LL        // Hand a partially filled buffer to the writer after 1 s
+#define CAPTURE_MAX_COMMENT_LEN     64
+
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * CLASS:           PcapngWriter
+ *
+ * DATE:            October 18th, 2026
+ *
+ * REVISIONS:       N/A
+ *
+ * DESIGNER:        Derek Wong
+ *
+ * PROGRAMMER:      Derek Wong
+ *
+ * NOTES:
+ * Writes pcapng captures from the forwarding path; records are appended to a ring of preallocated buffers by the
+ * forwarding thread and flushed to disk by a background writer thread, which also rotates files by size.
+ * When every buffer is waiting on the disk, records are counted as dropped instead of stalling the forwarding path.
+ * The buffer being filled is parked in currentBuffer between records, so on an idle link the writer can take it
+ * once it is CAPTURE_FLUSH_INTERVAL_NS old instead of waiting for the next record.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+class PcapngWriter
+{
+public:
+    // constructor
+    PcapngWriter();
+    // destructor
+    ~PcapngWriter();
+
+    bool open(const std::string& path, uint32_t snaplen, uint64_t rotateBytes);
+    void close();
+    bool isOpen() const;
+    uint64_t droppedRecords() const;
+    void writePacket(int interfaceId, uint64_t timestampNs, uint32_t srcAddr, uint16_t srcPort, uint32_t dstAddr, uint16_t dstPort,
+                     const void* payload, uint32_t length, const char* comment);
+
+private:
+    std::string basePath;
+    uint32_t snaplen = 0;
+    uint64_t rotateBytes = 0;
+    FILE* fp = nullptr;
+    uint64_t fileBytes = 0;
+    int fileIndex = 0;
+    bool opened = false;
+
+    // Ring of capture buffers, indices pass between the producer and the writer through the filled queue
+    unsigned char* buffers[CAPTURE_BUFFER_COUNT] = {};
+    size_t bufferFill[CAPTURE_BUFFER_COUNT] = {};
+    uint64_t bufferRecords[CAPTURE_BUFFER_COUNT] = {};
+    int filledQueue[CAPTURE_BUFFER_COUNT] = {};
+    int filledHead = 0;
+    int filledCount = 0;
+    int freeCount = 0;
+    int freeStack[CAPTURE_BUFFER_COUNT] = {};
+    std::atomic<int> currentBuffer{-1};             // -1 while a record is being appended to it, or none is taken
+    std::atomic<uint64_t> currentBufferStartNs{0};
+
+    std::mutex lock;
+    std::condition_variable filledCondition;
+    std::thread writerThread;
+    bool stopping = false;
+    std::atomic<uint64_t> dropped{0};
+
+    /*------------------------------------------------- Funtion Prototypes ---------------------------------------------------------------*/
+    bool openFile();
+    bool writeHeaderBlocks();
+    void submitBuffer(int index);
+    int acquireBuffer();
+    void writerLoop();
+};
+#endif // PCAPNGWRITER_H
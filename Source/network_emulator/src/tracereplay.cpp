@@ -0,0 +1,442 @@
+/*----------------------------------------------------------------------------------------------------------------------------
+ * SOURCE FILE:    tracereplay.cpp
+ *
+ * FUNCTIONS:      bool TraceReplay::open(const QString& path, QString* error)
+ *                 void TraceReplay::close()
+ *                 bool TraceReplay::rewind()
+ *                 bool TraceReplay::isOpen() const
+ *                 bool TraceReplay::isFinished() const
+ *                 QString TraceReplay::fileName() const
+ *                 const ImpairmentSample& TraceReplay::sampleAt(qint64 elapsedMs)
+ *                 bool TraceReplay::dropPkt(double lossPercent)
+ *                 bool TraceReplay::prime()
+ *                 bool TraceReplay::readSample(ImpairmentSample* sample)
+ *                 bool TraceReplay::readTextSample(ImpairmentSample* sample)
+ *                 bool TraceReplay::readBinarySample(ImpairmentSample* sample)
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Profiles can be rewound to replay them again
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * NOTES:
+ * The file contains the streaming reader used to replay recorded delay/loss/bandwidth profiles
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+
+#include "tracereplay.h"
+
+#include <QStringList>
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       TraceReplay::TraceReplay
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      TraceReplay::TraceReplay()
+ *
+ * RETURNS:        an instance of TraceReplay
+ *
+ * NOTES:
+ * Constructor of TraceReplay class
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+TraceReplay::TraceReplay()
+    : rng(TRACE_REPLAY_SEED)
+{
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       TraceReplay::~TraceReplay
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      TraceReplay::~TraceReplay()
+ *
+ * NOTES:
+ * Destructor of TraceReplay class
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+TraceReplay::~TraceReplay()
+{
+    close();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       TraceReplay::open
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Priming moved to prime so rewind can share it
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool TraceReplay::open(const QString& path, QString* error)
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * Opens a CSV or binary profile and primes the first two samples;
+ * the first sample applies from the start of the replay regardless of its timestamp
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool TraceReplay::open(const QString& path, QString* error)
+{
+    close();
+
+    file.setFileName(path);
+    if (!file.open(QFile::ReadOnly))
+    {
+        *error = file.errorString();
+        return false;
+    }
+
+    binary = (file.peek(TRACE_PROFILE_MAGIC_LEN) == QByteArray(TRACE_PROFILE_MAGIC));
+    if (binary)
+    {
+        file.read(TRACE_PROFILE_MAGIC_LEN);
+        binaryStream.setDevice(&file);
+        binaryStream.setByteOrder(QDataStream::LittleEndian);
+        binaryStream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    }
+
+    if (!prime())
+    {
+        *error = "profile does not contain any samples";
+        close();
+        return false;
+    }
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       TraceReplay::close
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void TraceReplay::close()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Closes the profile file
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void TraceReplay::close()
+{
+    binaryStream.setDevice(nullptr);
+    if (file.isOpen())
+    {
+        file.close();
+    }
+    hasNext = false;
+    finished = false;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       TraceReplay::rewind
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool TraceReplay::rewind()
+ *
+ * RETURNS:        bool, false if no profile is loaded or it can no longer be read
+ *
+ * NOTES:
+ * Goes back to the first sample of the loaded profile and reseeds the loss generator, so the replay starts over
+ * exactly as it did when the profile was opened
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool TraceReplay::rewind()
+{
+    if (!file.isOpen() || !file.seek(binary ? TRACE_PROFILE_MAGIC_LEN : 0))
+    {
+        return false;
+    }
+    binaryStream.resetStatus();
+    return prime();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       TraceReplay::isOpen
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool TraceReplay::isOpen() const
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * Returns true while a profile is loaded
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool TraceReplay::isOpen() const
+{
+    return file.isOpen();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       TraceReplay::isFinished
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool TraceReplay::isFinished() const
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * Returns true once the replay has moved past the last sample; the last sample stays in effect
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool TraceReplay::isFinished() const
+{
+    return finished;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       TraceReplay::fileName
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      QString TraceReplay::fileName() const
+ *
+ * RETURNS:        QString
+ *
+ * NOTES:
+ * Returns the path of the loaded profile
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+QString TraceReplay::fileName() const
+{
+    return file.fileName();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       TraceReplay::sampleAt
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      const ImpairmentSample& TraceReplay::sampleAt(qint64 elapsedMs)
+ *
+ * RETURNS:        const ImpairmentSample&
+ *
+ * NOTES:
+ * Returns the sample in effect at the given time since the replay started;
+ * time only moves forward, so samples are read from disk as they are passed and then discarded
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+const ImpairmentSample& TraceReplay::sampleAt(qint64 elapsedMs)
+{
+    while (hasNext && next.timeMs <= elapsedMs)
+    {
+        current = next;
+        hasNext = readSample(&next);
+    }
+    finished = !hasNext;
+    return current;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       TraceReplay::dropPkt
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool TraceReplay::dropPkt(double lossPercent)
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * Drops packet based on probability, using the replay's own seeded generator
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool TraceReplay::dropPkt(double lossPercent)
+{
+    return lossDistribution(rng) < lossPercent;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       TraceReplay::prime
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool TraceReplay::prime()
+ *
+ * RETURNS:        bool, false if the profile has no sample from where it is read
+ *
+ * NOTES:
+ * Reads the first two samples and seeds the loss generator; the first sample applies from the start of the replay
+ * regardless of its timestamp
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool TraceReplay::prime()
+{
+    if (!readSample(&current))
+    {
+        return false;
+    }
+    current.timeMs = 0;
+    hasNext = readSample(&next);
+    finished = false;
+    rng.seed(TRACE_REPLAY_SEED);
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       TraceReplay::readSample
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool TraceReplay::readSample(ImpairmentSample* sample)
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * Reads the next sample from the profile, returns false at the end of the file
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool TraceReplay::readSample(ImpairmentSample* sample)
+{
+    return binary ? readBinarySample(sample) : readTextSample(sample);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       TraceReplay::readTextSample
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool TraceReplay::readTextSample(ImpairmentSample* sample)
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * Reads the next CSV line, skipping blank lines, comments, headers and malformed rows
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool TraceReplay::readTextSample(ImpairmentSample* sample)
+{
+    while (!file.atEnd())
+    {
+        QString line = QString::fromLatin1(file.readLine()).trimmed();
+        if (line.isEmpty() || line.startsWith('#'))
+        {
+            continue;
+        }
+
+        QStringList fields = line.split(',');
+        if (fields.size() < 4)
+        {
+            continue;
+        }
+
+        bool timeOk, delayOk, lossOk, bandwidthOk;
+        sample->timeMs = fields[0].trimmed().toLongLong(&timeOk);
+        sample->delayMs = fields[1].trimmed().toInt(&delayOk);
+        sample->lossPercent = fields[2].trimmed().toDouble(&lossOk);
+        sample->bandwidthKbps = fields[3].trimmed().toInt(&bandwidthOk);
+        if (timeOk && delayOk && lossOk && bandwidthOk)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       TraceReplay::readBinarySample
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool TraceReplay::readBinarySample(ImpairmentSample* sample)
+ *
+ * RETURNS:        bool
+ *
+ * NOTES:
+ * Reads the next fixed size record, returns false at the end of the file or on a truncated record
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool TraceReplay::readBinarySample(ImpairmentSample* sample)
+{
+    qint64 timeMs;
+    qint32 delayMs, bandwidthKbps;
+    float lossPercent;
+
+    binaryStream >> timeMs >> delayMs >> lossPercent >> bandwidthKbps;
+    if (binaryStream.status() != QDataStream::Ok)
+    {
+        return false;
+    }
+
+    sample->timeMs = timeMs;
+    sample->delayMs = delayMs;
+    sample->lossPercent = lossPercent;
+    sample->bandwidthKbps = bandwidthKbps;
+    return true;
+}
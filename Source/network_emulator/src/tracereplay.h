@@ -0,0 +1,97 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * TRACEREPLAY CLASS DECLARATION FILE:          tracereplay.h
+ *
+ * DATE:                                        October 18th, 2026
+ *
+ * REVISIONS:                                   N/A
+ *
+ * DESIGNER:                                    Derek Wong
+ *
+ * PROGRAMMER:                                  Derek Wong
+ *
+ * NOTES:
+ * Declaration file for TraceReplay class
+ *
+ * A profile is a time series of impairment samples, either as CSV text:
+ *
+ *     # time_ms,delay_ms,loss_percent,bandwidth_kbps
+ *     0,30,0.5,10000
+ *     1500,120,2.0,2000
+ *
+ * or as a binary file starting with TRACE_PROFILE_MAGIC followed by little-endian records of
+ * (qint64 time_ms, qint32 delay_ms, float loss_percent, qint32 bandwidth_kbps).
+ * A bandwidth of 0 means the link is not rate limited.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef TRACEREPLAY_H
+#define TRACEREPLAY_H
+
+#include <random>
+
+#include <QDataStream>
+#include <QFile>
+#include <QString>
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define TRACE_PROFILE_MAGIC         "NEPROF01"
+#define TRACE_PROFILE_MAGIC_LEN     8
+#define TRACE_REPLAY_SEED           7005    // Fixed seed so that a replay drops the same packets every run
+
+/*------------------------------------------------ Structs --------------------------------------------------------------------------*/
+struct ImpairmentSample
+{
+    qint64 timeMs;
+    int delayMs;
+    double lossPercent;
+    int bandwidthKbps;
+};
+
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * CLASS:           TraceReplay
+ *
+ * DATE:            October 18th, 2026
+ *
+ * REVISIONS:       N/A
+ *
+ * DESIGNER:        Derek Wong
+ *
+ * PROGRAMMER:      Derek Wong
+ *
+ * NOTES:
+ * Streams an impairment profile from disk, holding only the current and the next sample in memory
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+class TraceReplay
+{
+public:
+    // constructor
+    TraceReplay();
+    // destructor
+    ~TraceReplay();
+
+    bool open(const QString& path, QString* error);
+    void close();
+    bool rewind();
+    bool isOpen() const;
+    bool isFinished() const;
+    QString fileName() const;
+    const ImpairmentSample& sampleAt(qint64 elapsedMs);
+    bool dropPkt(double lossPercent);
+
+private:
+    QFile file;
+    QDataStream binaryStream;
+    bool binary = false;
+    bool finished = false;
+    bool hasNext = false;
+    ImpairmentSample current{0, 0, 0, 0};
+    ImpairmentSample next{0, 0, 0, 0};
+    std::mt19937 rng;
+    std::uniform_real_distribution<double> lossDistribution{0.0, 100.0};
+
+    /*------------------------------------------------- Funtion Prototypes ---------------------------------------------------------------*/
+    bool prime();
+    bool readSample(ImpairmentSample* sample);
+    bool readTextSample(ImpairmentSample* sample);
+    bool readBinarySample(ImpairmentSample* sample);
+};
+#endif // TRACEREPLAY_H
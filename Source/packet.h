@@ -2,37 +2,67 @@
  * HEADER FILE:              packet.h
  *
  * FUNCTIONS:                void makePacket(struct packet* pkt, enum PacketType packetType)
- *                           struct packet copyPacket(struct packet* pkt)
- *                           char* packetTypeToString(int packetType, bool isDropped)
- *                           char* retransmitToString(bool retransmit)
+ *                           void copyPacket(struct packet* dest, const struct packet* src)
+ *                           const char* packetTypeToString(int packetType, bool isDropped)
+ *                           const char* retransmitToString(bool retransmit)
+ *                           void sealPacket(struct packet* pkt)
+ *                           bool packetIntact(const struct packet* pkt)
+ *                           int packetLength(const struct packet* pkt)
+ *                           void setHandshake(struct packet* pkt, const struct handshake* hs)
+ *                           bool getHandshake(const struct packet* pkt, struct handshake* hs)
+ *                           void setResumeRanges(struct packet* pkt, const struct resumeRange* ranges, int count)
+ *                           int getResumeRanges(const struct packet* pkt, struct resumeRange* ranges, int maxRanges)
  *
  * DATE:                     December 3rd, 2020
  *
- * REVISIONS:                N/A
+ * REVISIONS:                October 18th, 2026 - String helpers return entries of constant tables instead of heap copies;
+ *                                                copyPacket copies into a caller-provided packet
+ *                           October 18th, 2026 - Stream id, file offset and length of the payload
+ *                           October 18th, 2026 - Connection id naming the transfer a packet belongs to
+ *                           October 18th, 2026 - CRC32C of every packet, and of the whole file on EOT
+ *                           October 18th, 2026 - SYN, SYN_ACK and EOT_ACK for connection setup and teardown; the handshake
+ *                                                they carry; transfer index of the file a packet belongs to
+ *                           October 18th, 2026 - Resume feature: a SYN_ACK can list the byte ranges already received
+ *                           October 18th, 2026 - Compression feature: a DATA payload may be an LZ4 block standing for
+ *                                                several chunks of the file
+ *                           October 18th, 2026 - Notes that the helpers are defined, not declared, here
+ *                           October 18th, 2026 - The payload comes last and only its dataLen bytes go on the wire, so a
+ *                                                datagram is PACKET_HEADER_LEN bytes plus the data in use
  *
  * DESIGNER:                 Maksym Chumak, Derek Wong
  *
  * PROGRAMMER:               Maksym Chumak, Derek Wong
  *
  * NOTES:
- * Header file containing packet struct definition and related helper functions
+ * Header file containing packet struct definition and related helper functions.
+ * The helpers are defined here rather than declared, so a program includes this header from one translation unit
+ * only; another file that needs one of them declares it itself.
  * ----------------------------------------------------------------------------------------------------------------------------------*/
 
 #ifndef PACKET_H
 #define PACKET_H
 
 #include "common.h"
+#include "crc32c.h"
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 
 /* ------------------------------------------------- Enums ----------------------------------------------------------------------------*/
-enum PacketType { DATA, ACK, EOT };
+enum PacketType { DATA, ACK, EOT, SYN, SYN_ACK, EOT_ACK };
 
 /* ------------------------------------------------- Symbolic Constants ---------------------------------------------------------------*/
 #define MAX_READ_SIZE   150
 #define INVALID_SEQ_NUM 0
 #define INVALID_ACK_NUM 0
+#define PROTOCOL_VERSION        1
+#define FEATURE_FILE_CHECKSUM   0x01    // The receiver checks each file against its EOT and returns the result in the EOT_ACK
+#define FEATURE_RESUME          0x02    // The receiver keeps the progress of a connection so a new transmitter can pick it up
+#define FEATURE_COMPRESSION     0x04    // DATA payloads may be LZ4 blocks, rawLen giving the bytes of the file they expand to
+#define SUPPORTED_FEATURES      (FEATURE_FILE_CHECKSUM | FEATURE_RESUME | FEATURE_COMPRESSION)
+#define COMPRESSED_BLOCK_CHUNKS 16      // Most payload lengths of the file one compressed DATA packet stands for
+#define COMPRESSED_BLOCK_LEN    (COMPRESSED_BLOCK_CHUNKS * PAYLOAD_LEN)
 
 /* ------------------------------------------------- Enums ----------------------------------------------------------------------------*/
 #pragma pack(push, 1)
@@ -40,19 +70,52 @@ struct packet
 {
     enum PacketType packetType;
     int seqNum;
-    char data[PAYLOAD_LEN];
     int windowSize;
     int ackNum;
     bool retransmit;
+    int streamId;               // Flow of a multi-stream transfer; sequence numbers count per stream
+    int64_t offset;             // Where data goes in the file
+    int dataLen;                // Bytes of data in use; the payload is not terminated
+    int connectionId;           // Connection the packet belongs to, chosen by the transmitter; never 0
+    int transfer;               // Which of the connection's files, from 0
+    int rawLen;                 // DATA: bytes of the file a compressed payload expands to; 0 if data is the bytes themselves
+    uint32_t fileChecksum;      // EOT: CRC32C of the whole file, whose length is in offset; EOT_ACK: the receiver's copy's
+    uint32_t checksum;          // CRC32C of every field above and of the data in use
+    char data[PAYLOAD_LEN];     // Must stay last; only dataLen bytes of it are sent
+};
+
+// Carried in the data of SYN and SYN_ACK: the transmitter's proposal, and what the receiver accepted of it
+struct handshake
+{
+    int version;
+    int maxWindowSize;
+    int payloadLen;             // Bytes of data in a full DATA packet
+    int streams;
+    int transfers;              // Files the connection carries, one after the other
+    uint32_t features;          // FEATURE_ bits
+};
+
+// Follows the handshake in a SYN_ACK granting FEATURE_RESUME: bytes of the file named by transfer already received
+struct resumeRange
+{
+    int64_t start;
+    int64_t end;                // One past the last byte
 };
 #pragma pack(pop)
 
+#define PACKET_HEADER_LEN   ((int)offsetof(struct packet, data))   // Bytes of a datagram before the payload
+#define RESUME_RANGES   ((int)((PAYLOAD_LEN - sizeof(struct handshake)) / sizeof(struct resumeRange)))   // Most a SYN_ACK holds
+
 /*---------------------------------------------------------------------------------------------------------------------------------------
  * FUNCTION:       makePacket
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Clears the payload in place
+ *                 October 18th, 2026 - An ACK keeps the stream id and offset of the DATA it acknowledges
+ *                 October 18th, 2026 - ACK and EOT keep the connection id
+ *                 October 18th, 2026 - SYN, SYN_ACK and EOT_ACK; every type keeps the connection id and transfer
+ *                 October 18th, 2026 - Clears rawLen
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
@@ -73,15 +136,26 @@ void makePacket(struct packet* pkt, enum PacketType packetType)
             pkt->packetType = ACK;
             pkt->ackNum = pkt->seqNum;
             pkt->seqNum = INVALID_SEQ_NUM;
-            strcpy(pkt->data, "\0");
+            pkt->data[0] = '\0';
+            pkt->dataLen = 0;
+            pkt->rawLen = 0;
             pkt->retransmit = false;
             break;
         case EOT:
-            pkt->packetType = EOT;
+        case SYN:
+        case SYN_ACK:
+        case EOT_ACK:
+            // The caller fills in the handshake, or the file length and checksum, afterwards
+            pkt->packetType = packetType;
             pkt->ackNum = INVALID_ACK_NUM;
-            strcpy(pkt->data, "\0");
+            pkt->data[0] = '\0';
+            pkt->dataLen = 0;
+            pkt->rawLen = 0;
+            pkt->offset = 0;
+            pkt->streamId = 0;
             pkt->seqNum = INVALID_SEQ_NUM;
             pkt->retransmit = false;
+            pkt->fileChecksum = 0;
             break;
         default:
             perror("Not a valid packet type");
@@ -94,31 +168,23 @@ void makePacket(struct packet* pkt, enum PacketType packetType)
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Copies into a preallocated packet; the whole struct is copied so ackNum is
+ *                                      preserved and the payload no longer depends on a terminating NUL
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
  * PROGRAMMER:     Derek Wong, Maksym Chumak
  *
- * INTERFACE:      struct packet copyPacket(struct packet* pkt)
+ * INTERFACE:      void copyPacket(struct packet* dest, const struct packet* src)
  *
- * RETURNS:        struct packet
+ * RETURNS:        void
  *
  * NOTES:
  * Creates a shallow copy of a packet
  * -------------------------------------------------------------------------------------------------------------------------------------*/
-struct packet copyPacket(struct packet* pkt)
+void copyPacket(struct packet* dest, const struct packet* src)
 {
-    struct packet copyPkt;
-
-    copyPkt.packetType = pkt->packetType;
-    copyPkt.seqNum = pkt->seqNum;
-    strcpy(copyPkt.data, pkt->data);
-    copyPkt.windowSize = pkt->windowSize;
-    copyPkt.ackNum = pkt->seqNum;
-    copyPkt.retransmit = pkt->retransmit;
-
-    return copyPkt;
+    memcpy(dest, src, sizeof(struct packet));
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------------
@@ -126,65 +192,30 @@ struct packet copyPacket(struct packet* pkt)
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Returns an entry of a constant table; callers must not free the result
+ *                 October 18th, 2026 - Handshake packet types
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
  * PROGRAMMER:     Derek Wong, Maksym Chumak
  *
- * INTERFACE:      packetTypeToString(int packetType, bool isDropped)
+ * INTERFACE:      const char* packetTypeToString(int packetType, bool isDropped)
  *
- * RETURNS:        char*
+ * RETURNS:        const char*
  *
  * NOTES:
  * Converts numeric packet type to human readable string
  * -------------------------------------------------------------------------------------------------------------------------------------*/
-char* packetTypeToString(int packetType, bool isDropped)
+const char* packetTypeToString(int packetType, bool isDropped)
 {
-    char* type;
-    if(isDropped)
-    {
-        switch (packetType)
-        {
-        case DATA:
-            type = (char *)malloc(15);
-            strcpy(type, (char *)"DATA (DROPPED)");
-            break;
-        case ACK:
-            type = (char *)malloc(14);
-            strcpy(type, (char *)"ACK (DROPPED)");
-            break;
-        case EOT:
-            type = (char *)malloc(14);
-            strcpy(type, (char *)"EOT (DROPPED)");
-            break;
-        default:
-            type = (char *)malloc(8);
-            strcpy(type, (char *)"INVALID");
-        }
-    }
-    else
+    static const char* const types[] = { "DATA", "ACK", "EOT", "SYN", "SYN_ACK", "EOT_ACK" };
+    static const char* const droppedTypes[] = { "DATA (DROPPED)", "ACK (DROPPED)", "EOT (DROPPED)", "SYN (DROPPED)", "SYN_ACK (DROPPED)", "EOT_ACK (DROPPED)" };
+
+    if (packetType < DATA || packetType > EOT_ACK)
     {
-        switch (packetType)
-        {
-        case DATA:
-            type = (char *)malloc(5);
-            strcpy(type, (char *)"DATA");
-            break;
-        case ACK:
-            type = (char *)malloc(4);
-            strcpy(type, (char *)"ACK");
-            break;
-        case EOT:
-            type = (char *)malloc(4);
-            strcpy(type, (char *)"EOT");
-            break;
-        default:
-            type = (char *)malloc(8);
-            strcpy(type, (char *)"INVALID");
-        }
+        return "INVALID";
     }
-    return type;
+    return isDropped ? droppedTypes[packetType] : types[packetType];
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------------
@@ -192,34 +223,213 @@ char* packetTypeToString(int packetType, bool isDropped)
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Returns a string literal; callers must not free the result
  *
  * DESIGNER:       Derek Wong, Maksym Chumak
  *
  * PROGRAMMER:     Derek Wong, Maksym Chumak
  *
- * INTERFACE:      char* retransmitToString(bool retransmit)
+ * INTERFACE:      const char* retransmitToString(bool retransmit)
  *
- * RETURNS:        char*
+ * RETURNS:        const char*
  *
  * NOTES:
  * Converts bool retransmit value to a human readable string
  * -------------------------------------------------------------------------------------------------------------------------------------*/
-char* retransmitToString(bool retransmit)
+const char* retransmitToString(bool retransmit)
 {
-    char* str;
-    if (retransmit)
+    return retransmit ? "true" : "false";
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       packetLength
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int packetLength(const struct packet* pkt)
+ *
+ * RETURNS:        int, bytes of the datagram carrying the packet
+ *
+ * NOTES:
+ * The header and the dataLen bytes of data in use; a dataLen out of range counts as none or the whole payload
+ * -------------------------------------------------------------------------------------------------------------------------------------*/
+int packetLength(const struct packet* pkt)
+{
+    if (pkt->dataLen <= 0)
     {
-        str = (char *)malloc(5);
-        strcpy(str, (char *)"true");
+        return PACKET_HEADER_LEN;
     }
-    else
+    return PACKET_HEADER_LEN + (pkt->dataLen < PAYLOAD_LEN ? pkt->dataLen : PAYLOAD_LEN);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       sealPacket
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Covers only the data in use, which is all that is sent
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void sealPacket(struct packet* pkt)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Sets the packet's checksum; called last, once every other field has its final value
+ * -------------------------------------------------------------------------------------------------------------------------------------*/
+void sealPacket(struct packet* pkt)
+{
+    uint32_t crc = crc32cUpdate(0, pkt, offsetof(struct packet, checksum));
+
+    pkt->checksum = crc32cUpdate(crc, pkt->data, (size_t)(packetLength(pkt) - PACKET_HEADER_LEN));
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       packetIntact
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Covers only the data in use; a dataLen out of range is damage
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool packetIntact(const struct packet* pkt)
+ *
+ * RETURNS:        bool, false if the packet was damaged on the way
+ * -------------------------------------------------------------------------------------------------------------------------------------*/
+bool packetIntact(const struct packet* pkt)
+{
+    uint32_t crc;
+
+    if (pkt->dataLen < 0 || pkt->dataLen > PAYLOAD_LEN)
+    {
+        return false;
+    }
+    crc = crc32cUpdate(0, pkt, offsetof(struct packet, checksum));
+    return pkt->checksum == crc32cUpdate(crc, pkt->data, (size_t)pkt->dataLen);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       setHandshake
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void setHandshake(struct packet* pkt, const struct handshake* hs)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Puts the handshake in the data of a SYN or SYN_ACK
+ * -------------------------------------------------------------------------------------------------------------------------------------*/
+void setHandshake(struct packet* pkt, const struct handshake* hs)
+{
+    memcpy(pkt->data, hs, sizeof(struct handshake));
+    pkt->dataLen = sizeof(struct handshake);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       getHandshake
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Accepts resume ranges after the handshake
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool getHandshake(const struct packet* pkt, struct handshake* hs)
+ *
+ * RETURNS:        bool, false if the packet does not carry a handshake
+ *
+ * NOTES:
+ * Resume ranges may follow the handshake
+ * -------------------------------------------------------------------------------------------------------------------------------------*/
+bool getHandshake(const struct packet* pkt, struct handshake* hs)
+{
+    if ((pkt->packetType != SYN && pkt->packetType != SYN_ACK) || pkt->dataLen < (int)sizeof(struct handshake)
+        || pkt->dataLen > PAYLOAD_LEN)
     {
-        str = (char *)malloc(6);
-        strcpy(str, (char *)"false");
+        return false;
     }
+    memcpy(hs, pkt->data, sizeof(struct handshake));
+    return true;
+}
 
-    return str;
+/*---------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       setResumeRanges
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void setResumeRanges(struct packet* pkt, const struct resumeRange* ranges, int count)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Puts up to RESUME_RANGES ranges after the handshake of a SYN_ACK; setHandshake must have been called first
+ * -------------------------------------------------------------------------------------------------------------------------------------*/
+void setResumeRanges(struct packet* pkt, const struct resumeRange* ranges, int count)
+{
+    if (count > RESUME_RANGES)
+    {
+        count = RESUME_RANGES;
+    }
+    memcpy(pkt->data + sizeof(struct handshake), ranges, sizeof(struct resumeRange) * (size_t)count);
+    pkt->dataLen = (int)(sizeof(struct handshake) + sizeof(struct resumeRange) * (size_t)count);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       getResumeRanges
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int getResumeRanges(const struct packet* pkt, struct resumeRange* ranges, int maxRanges)
+ *
+ * RETURNS:        int, ranges copied into ranges
+ * -------------------------------------------------------------------------------------------------------------------------------------*/
+int getResumeRanges(const struct packet* pkt, struct resumeRange* ranges, int maxRanges)
+{
+    int count = (pkt->dataLen - (int)sizeof(struct handshake)) / (int)sizeof(struct resumeRange);
+
+    if (pkt->packetType != SYN_ACK || count <= 0)
+    {
+        return 0;
+    }
+    if (count > maxRanges)
+    {
+        count = maxRanges;
+    }
+    memcpy(ranges, pkt->data + sizeof(struct handshake), sizeof(struct resumeRange) * (size_t)count);
+    return count;
 }
 
 #endif
@@ -0,0 +1,408 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * HEADER FILE:              packetpool.h
+ *
+ * FUNCTIONS:                void packetPoolInit(struct packetPool* pool, uint32_t maxPackets)
+ *                           void packetPoolDestroy(struct packetPool* pool)
+ *                           struct packet* packetPoolGet(const struct packetPool* pool, packetHandle handle)
+ *                           void packetPoolCacheInit(struct packetPoolCache* cache, struct packetPool* pool)
+ *                           packetHandle packetPoolAlloc(struct packetPoolCache* cache)
+ *                           void packetPoolFree(struct packetPoolCache* cache, packetHandle handle)
+ *                           void packetPoolCacheFlush(struct packetPoolCache* cache)
+ *
+ * DATE:                     October 18th, 2026
+ *
+ * REVISIONS:                N/A
+ *
+ * DESIGNER:                 Derek Wong
+ *
+ * PROGRAMMER:               Derek Wong
+ *
+ * NOTES:
+ * Header file containing a fixed-size packet pool shared by the transmitter, receiver and network emulator.
+ * Packets live in cache-line aligned slots of PACKET_POOL_SLOT_LEN bytes, carved out of slabs that are allocated on
+ * demand up to the pool's limit and only released when the pool is destroyed. A packet is named by a 32-bit handle
+ * (slab and slot index) which is what the stages of a program pass around instead of copying the packet.
+ * Free slots form an intrusive freelist behind a spinlock; each thread allocates and frees through its own
+ * packetPoolCache, which only touches the shared freelist to move half a cache of handles at a time.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef PACKETPOOL_H
+#define PACKETPOOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #include <malloc.h>
+#endif
+
+#include "packet.h"
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define PACKET_POOL_CACHE_LINE      64
+#define PACKET_POOL_SLOT_LEN        ((sizeof(struct packet) + PACKET_POOL_CACHE_LINE - 1) / PACKET_POOL_CACHE_LINE * PACKET_POOL_CACHE_LINE)
+#define PACKET_POOL_SLAB_BITS       6
+#define PACKET_POOL_SLAB_SLOTS      (1u << PACKET_POOL_SLAB_BITS)       // 64 slots, 20 KB per slab
+#define PACKET_POOL_MAX_SLABS       1024                                // At most 65536 packets per pool
+#define PACKET_POOL_CACHE_SIZE      32                                  // Handles a thread holds before returning half of them
+#define PACKET_HANDLE_NONE          UINT32_MAX
+
+/*------------------------------------------------ Types ----------------------------------------------------------------------------*/
+typedef uint32_t packetHandle;
+
+/*------------------------------------------------ Structs --------------------------------------------------------------------------*/
+struct packetPool
+{
+    unsigned char* slabs[PACKET_POOL_MAX_SLABS];
+    uint32_t slabCount;
+    uint32_t maxSlabs;
+    packetHandle freeHead;          // The next free handle is stored in the first bytes of each free slot
+    unsigned char lock;
+};
+
+struct packetPoolCache
+{
+    struct packetPool* pool;
+    uint32_t count;
+    packetHandle handles[PACKET_POOL_CACHE_SIZE];
+};
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       packetPoolInit
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void packetPoolInit(struct packetPool* pool, uint32_t maxPackets)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Prepares an empty pool that will grow to hold at most maxPackets, rounded up to whole slabs
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void packetPoolInit(struct packetPool* pool, uint32_t maxPackets)
+{
+    memset(pool, 0, sizeof(struct packetPool));
+    pool->maxSlabs = (maxPackets + PACKET_POOL_SLAB_SLOTS - 1) / PACKET_POOL_SLAB_SLOTS;
+    if (pool->maxSlabs == 0) pool->maxSlabs = 1;
+    if (pool->maxSlabs > PACKET_POOL_MAX_SLABS) pool->maxSlabs = PACKET_POOL_MAX_SLABS;
+    pool->freeHead = PACKET_HANDLE_NONE;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       packetPoolDestroy
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void packetPoolDestroy(struct packetPool* pool)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Releases every slab; handles and packet pointers from the pool are invalid afterwards
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void packetPoolDestroy(struct packetPool* pool)
+{
+    for (uint32_t i = 0; i < pool->slabCount; i++)
+    {
+        #if defined(_WIN32)
+            _aligned_free(pool->slabs[i]);
+        #else
+            free(pool->slabs[i]);
+        #endif
+        pool->slabs[i] = NULL;
+    }
+    pool->slabCount = 0;
+    pool->freeHead = PACKET_HANDLE_NONE;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       packetPoolGet
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      struct packet* packetPoolGet(const struct packetPool* pool, packetHandle handle)
+ *
+ * RETURNS:        struct packet*, the start of a PACKET_POOL_SLOT_LEN byte slot
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline struct packet* packetPoolGet(const struct packetPool* pool, packetHandle handle)
+{
+    return (struct packet*)(pool->slabs[handle >> PACKET_POOL_SLAB_BITS] + (handle & (PACKET_POOL_SLAB_SLOTS - 1)) * PACKET_POOL_SLOT_LEN);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       packetPoolLock
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void packetPoolLock(struct packetPool* pool)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Spins for the shared freelist; it is only held to move a batch of handles
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void packetPoolLock(struct packetPool* pool)
+{
+    while (__atomic_test_and_set(&pool->lock, __ATOMIC_ACQUIRE))
+    {
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       packetPoolUnlock
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void packetPoolUnlock(struct packetPool* pool)
+ *
+ * RETURNS:        void
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void packetPoolUnlock(struct packetPool* pool)
+{
+    __atomic_clear(&pool->lock, __ATOMIC_RELEASE);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       packetPoolPush
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void packetPoolPush(struct packetPool* pool, packetHandle handle)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Puts a slot on the shared freelist; the lock must be held
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void packetPoolPush(struct packetPool* pool, packetHandle handle)
+{
+    memcpy(packetPoolGet(pool, handle), &pool->freeHead, sizeof(packetHandle));
+    pool->freeHead = handle;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       packetPoolGrow
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool packetPoolGrow(struct packetPool* pool)
+ *
+ * RETURNS:        bool, false when the pool is at its limit or the slab could not be allocated
+ *
+ * NOTES:
+ * Allocates a slab and puts all of its slots on the shared freelist; the lock must be held
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline bool packetPoolGrow(struct packetPool* pool)
+{
+    void* slab = NULL;
+    size_t size = PACKET_POOL_SLAB_SLOTS * PACKET_POOL_SLOT_LEN;
+
+    if (pool->slabCount >= pool->maxSlabs)
+    {
+        return false;
+    }
+    #if defined(_WIN32)
+        slab = _aligned_malloc(size, PACKET_POOL_CACHE_LINE);
+    #else
+        if (posix_memalign(&slab, PACKET_POOL_CACHE_LINE, size) != 0) slab = NULL;
+    #endif
+    if (slab == NULL)
+    {
+        return false;
+    }
+    memset(slab, 0, size);
+
+    pool->slabs[pool->slabCount] = (unsigned char*)slab;
+    // Pushed in reverse so the slab is handed out front to back
+    for (uint32_t slot = PACKET_POOL_SLAB_SLOTS; slot > 0; slot--)
+    {
+        packetPoolPush(pool, (pool->slabCount << PACKET_POOL_SLAB_BITS) | (slot - 1));
+    }
+    pool->slabCount++;
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       packetPoolCacheInit
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void packetPoolCacheInit(struct packetPoolCache* cache, struct packetPool* pool)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Prepares an empty per-thread cache; a cache must only be used by one thread
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void packetPoolCacheInit(struct packetPoolCache* cache, struct packetPool* pool)
+{
+    cache->pool = pool;
+    cache->count = 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       packetPoolAlloc
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      packetHandle packetPoolAlloc(struct packetPoolCache* cache)
+ *
+ * RETURNS:        packetHandle, or PACKET_HANDLE_NONE when the pool is exhausted
+ *
+ * NOTES:
+ * Takes a slot from the thread's cache, refilling it with half a cache from the shared freelist when it is empty.
+ * The slot's contents are whatever its last user left there.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline packetHandle packetPoolAlloc(struct packetPoolCache* cache)
+{
+    if (cache->count == 0)
+    {
+        struct packetPool* pool = cache->pool;
+
+        packetPoolLock(pool);
+        while (cache->count < PACKET_POOL_CACHE_SIZE / 2)
+        {
+            if (pool->freeHead == PACKET_HANDLE_NONE && !packetPoolGrow(pool))
+            {
+                break;
+            }
+            packetHandle handle = pool->freeHead;
+            memcpy(&pool->freeHead, packetPoolGet(pool, handle), sizeof(packetHandle));
+            cache->handles[cache->count++] = handle;
+        }
+        packetPoolUnlock(pool);
+
+        if (cache->count == 0)
+        {
+            return PACKET_HANDLE_NONE;
+        }
+    }
+    return cache->handles[--cache->count];
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       packetPoolFree
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void packetPoolFree(struct packetPoolCache* cache, packetHandle handle)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Returns a slot to the thread's cache; a full cache gives half of its handles back to the shared freelist.
+ * A slot may be freed by a different thread than the one that allocated it.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void packetPoolFree(struct packetPoolCache* cache, packetHandle handle)
+{
+    if (handle == PACKET_HANDLE_NONE)
+    {
+        return;
+    }
+    if (cache->count == PACKET_POOL_CACHE_SIZE)
+    {
+        struct packetPool* pool = cache->pool;
+
+        packetPoolLock(pool);
+        while (cache->count > PACKET_POOL_CACHE_SIZE / 2)
+        {
+            packetPoolPush(pool, cache->handles[--cache->count]);
+        }
+        packetPoolUnlock(pool);
+    }
+    cache->handles[cache->count++] = handle;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       packetPoolCacheFlush
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void packetPoolCacheFlush(struct packetPoolCache* cache)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Gives every cached handle back to the shared freelist, e.g. before the owning thread exits
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void packetPoolCacheFlush(struct packetPoolCache* cache)
+{
+    struct packetPool* pool = cache->pool;
+
+    packetPoolLock(pool);
+    while (cache->count > 0)
+    {
+        packetPoolPush(pool, cache->handles[--cache->count]);
+    }
+    packetPoolUnlock(pool);
+}
+
+#endif
@@ -3,33 +3,175 @@
  *
  * PROGRAM:        receiver
  *
- * FUNCTIONS:      void flushBuffer(struct packet* buffer, long long *nextSeqNum, long long *newWindowSeqNum, int windowSize)
- *                 sendACK(int sd, struct packet *pkt, int pktSize, struct sockaddr_in *transmitter, socklen_t transmitterLen)
- *                 void saveData(char *data)
+ * FUNCTIONS:      void sendACK(struct receiverWorker* worker, const struct packet* pkt, const struct sockaddr_in* transmitter, socklen_t transmitterLen)
+ *                 bool saveData(struct receiverWorker* worker, const struct session* session, const struct packet* pkt)
+ *                 void handlePacket(struct receiverWorker* worker, packetHandle handle, const struct sockaddr_in* source, socklen_t sourceLen)
+ *                 void sendPacket(struct receiverWorker* worker, struct packet* pkt, const struct sockaddr_in* destination, socklen_t destinationLen)
+ *                 void acceptConnection(struct receiverWorker* worker, struct packet* pkt, const struct sockaddr_in* source, socklen_t sourceLen)
+ *                 struct transferResult endTransfer(struct receiverWorker* worker, struct session* session, const struct packet* eot)
+ *                 const struct transferResult* findFinished(const struct receiverWorker* worker, const struct session* session, int connectionId)
+ *                 struct session* findSession(struct receiverWorker* worker, int connectionId, bool create)
+ *                 bool openSession(struct receiverWorker* worker, struct session* session, int connectionId)
+ *                 bool openTransferFile(struct session* session, int transfer)
+ *                 void closeTransferFile(struct session* session, bool complete)
+ *                 void closeSession(struct receiverWorker* worker, struct session* session, bool complete)
+ *                 bool verifySession(const struct session* session, int64_t length, uint32_t checksum, uint32_t* computed)
+ *                 bool openResume(struct session* session, struct handshake* accepted)
+ *                 bool mapResume(struct session* session, int64_t chunks)
+ *                 void checkpointSession(struct session* session)
+ *                 void closeResume(struct session* session, bool complete)
+ *                 void workerInit(struct receiverWorker* worker, int id, bool threaded)
+ *                 void workerPost(struct receiverWorker* worker, packetHandle handle, const struct sockaddr_in* source, socklen_t sourceLen)
+ *                 void workerDrain(struct receiverWorker* worker)
+ *                 void workerStop(struct receiverWorker* worker)
+ *                 void* runWorker(void* arg)
+ *                 void requestLatencyDump(int signalNumber)
+ *                 void endLinger(int signalNumber)
+ *                 void recordInterArrival(uint64_t arrivalUs)
+ *                 void logJitterHistogram()
+ *                 bool ioInit(int sd, enum ioEngine engine)
+ *                 int ioReceive(struct packet* pkt, struct sockaddr_in* source, socklen_t* sourceLen)
+ *                 void ioSend(const struct packet* pkt, int pktSize, const struct sockaddr_in* destination, socklen_t destinationLen)
+ *                 void ioWrite(int fd, const char* data, size_t length, off_t position)
+ *                 char* ioWriteSpace(int fd, size_t length, off_t position)
+ *                 void ioWriteCommit(size_t length)
+ *                 void ioFlushFile(int fd)
+ *                 void ioCloseFile(int fd)
+ *                 void ioClose()
+ *                 static void ioFlushSends()
+ *                 static void ioFlushWrites()
+ *                 static bool ioRingStart()
+ *                 static struct io_uring_sqe* ioRingNextSqe()
+ *                 static int ioRingWait()
+ *                 static void ioRingReap()
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Inter-arrival jitter histogram, dumped at EOT and on SIGUSR1
+ *                 October 18th, 2026 - No heap allocation per packet: the reorder buffer is allocated once and the
+ *                                      output file stays open
+ *                 October 18th, 2026 - Packets are received into packet pool slots; out of order packets are buffered
+ *                                      by handle instead of being copied
+ *                 October 18th, 2026 - Selectable I/O engine: blocking calls per packet, epoll with batched receives,
+ *                                      ACKs and writes, or io_uring with all three submitted asynchronously
+ *                 October 18th, 2026 - Sequence numbers and reorder buffers are per stream; data is written at the
+ *                                      file offset it carries
+ *                 October 18th, 2026 - A session per connection id, each with its own streams and output file; the
+ *                                      sessions can be spread over worker threads and the receiver outlives an EOT
+ *                 October 18th, 2026 - DATA is written at its offset as it arrives, out of order or not; the byte
+ *                                      ranges received are tracked instead of reordering packets
+ *                 October 18th, 2026 - Packets failing their CRC32C are dropped; at EOT the file is read back and
+ *                                      checked against the length and CRC32C the transmitter sent
+ *                 October 18th, 2026 - A SYN opens the session and is answered with the window, payload length and
+ *                                      features accepted; every EOT is answered with an EOT_ACK, and a session
+ *                                      receives as many files as its SYN announced before it closes
+ *                 October 18th, 2026 - With FEATURE_RESUME a session checkpoints what reached the disk to a progress
+ *                                      file, and a SYN for the connection, from a new transmitter or after a
+ *                                      restart, picks the transfer up where it stopped
+ *                 October 18th, 2026 - With FEATURE_COMPRESSION a DATA payload may be an LZ4 block standing for
+ *                                      several chunks of the file, expanded before it is written
+ *                 October 18th, 2026 - Datagrams hold the header and the data in use; one of any other length is
+ *                                      dropped
  *
  * DESIGNER:       Maksym Chumak
  *
  * PROGRAMMER:     Maksym Chumak
  *
  * NOTES:
- * The program accepts packets from transmitter over a UDP socket and responds with acknowledgement(ACK) packets;
- * when EOT packet is received the program terminates
+ * The program accepts packets from transmitters over a UDP socket and responds with acknowledgement(ACK) packets;
+ * every packet carries the connection id of its transfer, and each id gets a session of its own: an output file
+ * named after the id and the set of byte ranges written to it; the receiver carries on with the other sessions as
+ * one ends, so transfers can come one after another or at once without a restart;
+ * a session is opened by its transmitter's SYN, which proposes a maximum window size, payload length, stream count,
+ * file count and feature bits; the SYN_ACK grants no more than the proposal, the window capped by -w, the payload
+ * by PAYLOAD_LEN and the features to those this receiver supports, or refuses with no window when the protocol
+ * version differs; DATA and EOT of a connection without a session are dropped;
+ * an EOT ends the session's current file and is answered by an EOT_ACK carrying how much of it arrived and, with
+ * FEATURE_FILE_CHECKSUM, its checksum; the next file of the connection goes to message-<id>-<n>.txt in the same
+ * session, and the session closes after its last. The result of the last file ended is kept, with the session or
+ * after it closed, so a repeated EOT whose EOT_ACK was lost gets the same answer;
+ * with FEATURE_RESUME a session keeps a progress file, message-<id>.resume, mapped into memory: the file being
+ * received, where it starts in its output file and a bitmap with a bit per payloadLen chunk on disk, DATA of such a
+ * session having to start on a chunk; every RESUME_CHECKPOINT_BYTES, and when the session is evicted or the receiver
+ * stops, the output is flushed and synced before the chunks written since are marked, so the bitmap never claims
+ * data the disk may not hold. A SYN asking to resume a connection is answered with the file it is on and the byte
+ * ranges already received, from the open session or, after a restart, from the progress file, and the transmitter
+ * sends only the rest; the progress file is removed when the last file ends, and a session closed before then is
+ * not remembered as closed so it can be resumed;
+ * with FEATURE_COMPRESSION a DATA packet whose rawLen is not 0 carries an LZ4 block, expanded straight into the
+ * staged output block of the epoll and uring engines, or into a block of the worker's own to be written, as the
+ * rawLen bytes at its offset; rawLen may be up to COMPRESSED_BLOCK_CHUNKS
+ * payload lengths, and everything else about the packet, its range, ACK and checkpoint, goes by those bytes. A
+ * block that does not expand to exactly rawLen is dropped without an ACK, like a corrupt packet;
+ * with -n count the receiver stops once that many sessions have ended with their last EOT, after answering any
+ * repeated EOTs until none has come for CLOSE_LINGER_MS;
+ * every DATA packet carries the offset of its payload in the file and is written there the moment it arrives, so
+ * nothing waits behind a gap and the byte ranges of a transfer's streams end up side by side whatever order they
+ * arrive in; a payload whose range was already written is only ACKed again; on EOT the ranges show whether the
+ * file is whole;
+ * every packet carries a CRC32C of its contents, and one that fails it is dropped without an ACK, so the transmitter
+ * resends it as if it had been lost; ACKs are sealed the same way; the EOT carries the length and CRC32C of the
+ * whole file, and the session's file is read back and checked against them before it is closed;
+ * with -j workers the sessions are shared out by connection id among that many threads; the I/O thread only
+ * receives and queues each datagram to the worker owning its session, which writes the data and sends the ACKs
+ * itself; without -j the I/O thread handles every session;
+ * with -e epoll or -e uring, datagrams are received and ACKs sent in batches and the output is written in blocks,
+ * all pending ACKs and data going out whenever the receiver is about to wait; uring falls back to epoll when
+ * io_uring is unavailable; worker threads write and send with plain system calls;
+ * a session that goes quiet for SESSION_IDLE_US gives up its slot once a new one needs it;
+ * the variation between consecutive DATA inter-arrival gaps is recorded in a latency histogram whose percentiles
+ * are logged as each session ends, or at any time with kill -USR1 <pid>
  * ----------------------------------------------------------------------------------------------------------------------------*/
 
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE     // recvmmsg and sendmmsg
+#endif
+
 #include "../../common.h"
 #include "../../logger.h"
+#include "../../histogram.h"
+#include "../../packetpool.h"
+#include "../../ioring.h"
+#include "../../intervalset.h"
+#include "../../lz4block.h"
 #include "receiver.h"
 
+static volatile sig_atomic_t latencyDumpRequested = 0;
+static struct histogram jitterHistogram;
+static struct receiverIo receiverIo;
+static struct packetPool packetPool;
+static int sessionsClosed = 0;          // Sessions ended by their EOT; updated atomically
+static int windowLimit = MAX_READ_SIZE; // Largest window granted to a transmitter
+static volatile sig_atomic_t lingerOver = 0;
+
+static void ioFlushSends();
+static void ioFlushWrites();
+#if defined(IO_RING_SUPPORTED)
+static bool ioRingStart();
+static struct io_uring_sqe* ioRingNextSqe();
+static int ioRingWait();
+static void ioRingReap();
+#endif
+
 /*----------------------------------------------------------------------------------------------------------------------------
  * FUNCTION:       main
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Records DATA inter-arrival jitter; recvfrom is restarted after SIGUSR1
+ *                 October 18th, 2026 - Reorder buffer is allocated once for MAX_READ_SIZE packets; DATA with a window
+ *                                      size outside that range is skipped
+ *                 October 18th, 2026 - Reorder buffer holds packet pool handles; the ACK is built in a separate slot
+ *                 October 18th, 2026 - -e selects the I/O engine; pending ACKs and writes are drained at EOT
+ *                 October 18th, 2026 - Window tracking and reorder buffer per stream id; DATA with an invalid stream
+ *                                      id or length is skipped
+ *                 October 18th, 2026 - Only receives and dispatches; packets are handled by the worker owning their
+ *                                      connection id. -j starts worker threads, -n exits after that many sessions
+ *                 October 18th, 2026 - Packets are never held, so the receive slot is reused unless it was queued
+ *                 October 18th, 2026 - -w caps the window granted to transmitters; with -n, lingers answering
+ *                                      repeated EOTs before exiting
+ *                 October 18th, 2026 - Drops datagrams whose length is not the header plus the dataLen they give
+ *                 October 18th, 2026 - Opens the log file before anything can log
  *
  * DESIGNER:       Maksym Chumak
  *
@@ -44,10 +186,84 @@
  * ----------------------------------------------------------------------------------------------------------------------------*/
 int main(int argc, char **argv)
 {
-    int sd, pktSize, latestWindowSize, index;
-    long long nextSeqNum, newWindowSeqNum;
+    const char* const programName = argv[0];
+    int sd, opt, workerCount = 0, sessionLimit = 0;
+    static struct receiverWorker workers[MAX_WORKERS];
+    struct receiverWorker* worker;
+    struct packetPoolCache packetCache;
     socklen_t transmitterLen;
     struct sockaddr_in receiver, transmitter;
+    struct sigaction dumpAction, lingerAction;
+    struct itimerval linger = { { 0, 0 }, { CLOSE_LINGER_MS / 1000, (CLOSE_LINGER_MS % 1000) * 1000 } };
+    sigset_t lingerSignal;
+    bool lingering = false;
+    enum ioEngine engine = IO_ENGINE_BLOCKING;
+
+    // The workers share the log file, so it is opened before any of them start
+    openLog();
+
+    // Get user options
+    while ((opt = getopt(argc, argv, "e:j:n:w:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'e':
+                if (strcmp(optarg, "blocking") == 0)
+                    engine = IO_ENGINE_BLOCKING;
+                else if (strcmp(optarg, "epoll") == 0)
+                    engine = IO_ENGINE_EPOLL;
+                else if (strcmp(optarg, "uring") == 0)
+                    engine = IO_ENGINE_URING;
+                else
+                {
+                    logToFile(ERROR, NULL, "Unknown I/O engine %s", optarg);
+                    exit(1);
+                }
+                break;
+            case 'j':
+                workerCount = atoi(optarg);
+                if (workerCount < 0 || workerCount > MAX_WORKERS)
+                {
+                    logToFile(ERROR, NULL, "Workers must be 0-%d", MAX_WORKERS);
+                    exit(1);
+                }
+                break;
+            case 'n':
+                sessionLimit = atoi(optarg);
+                if (sessionLimit < 0)
+                {
+                    logToFile(ERROR, NULL, "Session count must not be negative");
+                    exit(1);
+                }
+                break;
+            case 'w':
+                windowLimit = atoi(optarg);
+                if (windowLimit < INITIAL_WINDOW_SIZE || windowLimit > MAX_READ_SIZE)
+                {
+                    logToFile(ERROR, NULL, "Window size must be %d-%d", INITIAL_WINDOW_SIZE, MAX_READ_SIZE);
+                    exit(1);
+                }
+                break;
+            default:
+                logToFile(ERROR, NULL, "Usage: %s [-e blocking|epoll|uring] [-j workers] [-n sessions] [-w maxWindowSize]", programName);
+                exit(1);
+        }
+    }
+
+    // dump jitter percentiles on demand; no SA_RESTART so a blocked recvfrom returns and the dump happens at once
+    histogramInit(&jitterHistogram);
+    memset(&dumpAction, 0, sizeof(dumpAction));
+    dumpAction.sa_handler = requestLatencyDump;
+    sigemptyset(&dumpAction.sa_mask);
+    sigaction(SIGUSR1, &dumpAction, NULL);
+
+    // the linger timer interrupts the I/O thread's wait the same way; the workers block it so it always lands there
+    memset(&lingerAction, 0, sizeof(lingerAction));
+    lingerAction.sa_handler = endLinger;
+    sigemptyset(&lingerAction.sa_mask);
+    sigaction(SIGALRM, &lingerAction, NULL);
+    sigemptyset(&lingerSignal);
+    sigaddset(&lingerSignal, SIGALRM);
 
     // create a socket
     if ((sd = socket(AF_INET, SOCK_DGRAM, 0)) == -1)
@@ -66,130 +282,179 @@ int main(int argc, char **argv)
         logToFile(ERROR, NULL, "can't bind name to socket");
         exit(1);
     }
+    if (!ioInit(sd, engine))
+    {
+        logToFile(ERROR, NULL, "can't set up I/O");
+        exit(1);
+    }
 
-    pktSize = sizeof(struct packet);
-    transmitterLen = sizeof(transmitter);
-    nextSeqNum = INITIAL_SEQ_NUM;
-    newWindowSeqNum = nextSeqNum + INITIAL_WINDOW_SIZE;
-    latestWindowSize = INITIAL_WINDOW_SIZE;
-    struct packet* packetBuffer = malloc(pktSize * INITIAL_WINDOW_SIZE);
-    for (int i = 0; i < INITIAL_WINDOW_SIZE; i++)
-        packetBuffer[i].seqNum = INVALID_SEQ_NUM;
-    struct packet* pkt = malloc(pktSize);
-    while (true)
+    // datagrams are received into pool slots so they can be queued to a worker without a copy
+    packetPoolInit(&packetPool, RECEIVER_POOL_PACKETS);
+    packetPoolCacheInit(&packetCache, &packetPool);
+    if (workerCount == 0)
+        workerInit(&workers[0], 0, false);
+    pthread_sigmask(SIG_BLOCK, &lingerSignal, NULL);
+    for (int i = 0; i < workerCount; i++)
+    {
+        workerInit(&workers[i], i, true);
+        if (pthread_create(&workers[i].thread, NULL, runWorker, &workers[i]) != 0)
+        {
+            logToFile(ERROR, NULL, "can't start worker %d", i);
+            exit(1);
+        }
+    }
+    pthread_sigmask(SIG_UNBLOCK, &lingerSignal, NULL);
+    logToFile(INFO, NULL, "receiving on port %d with %d worker threads", RECEIVER_PORT, workerCount);
+
+    packetHandle pktHandle = packetPoolAlloc(&packetCache);
+    if (pktHandle == PACKET_HANDLE_NONE)
     {
-        if ((recvfrom(sd, pkt, pktSize, 0, (struct sockaddr *)&transmitter, &transmitterLen)) < 0)
+        logToFile(ERROR, NULL, "packet pool exhausted");
+        exit(1);
+    }
+    struct packet* pkt = packetPoolGet(&packetPool, pktHandle);
+    while (!lingerOver)
+    {
+        if (latencyDumpRequested)
+        {
+            latencyDumpRequested = 0;
+            logJitterHistogram();
+        }
+        // like TCP's TIME_WAIT: the last EOT_ACK may be lost, so the receiver stays until the repeated EOTs stop
+        if (!lingering && sessionLimit > 0 && __atomic_load_n(&sessionsClosed, __ATOMIC_ACQUIRE) >= sessionLimit)
+        {
+            logToFile(INFO, NULL, "%d sessions complete, lingering for repeated EOTs", sessionLimit);
+            lingering = true;
+            setitimer(ITIMER_REAL, &linger, NULL);
+        }
+        transmitterLen = sizeof(transmitter);
+        int length = ioReceive(pkt, &transmitter, &transmitterLen);
+        if (length < 0)
         {
+            if (errno == EINTR)
+                continue;
             logToFile(ERROR, NULL, "recvfrom error");
             exit(1);
         }
-        switch (pkt->packetType)
+        // the bytes past the datagram are left over from an earlier one, so its length must match what it claims
+        if (length < PACKET_HEADER_LEN || length != packetLength(pkt))
         {
-            case DATA:
-                // new window
-                if (pkt->seqNum >= newWindowSeqNum)
-                {
-                    flushBuffer(packetBuffer, &nextSeqNum, &newWindowSeqNum, latestWindowSize);
+            logToFile(ERROR, NULL, "dropping %d-byte datagram that is not a whole packet", length);
+            continue;
+        }
+        if (lingering)
+            setitimer(ITIMER_REAL, &linger, NULL);
+        enum PacketType packetType = pkt->packetType;
+        if (packetType == DATA)
+            recordInterArrival(monotonicUs());
 
-                    latestWindowSize = pkt->windowSize;
-                    newWindowSeqNum = newWindowSeqNum + pkt->windowSize;
+        if (workerCount == 0)
+        {
+            handlePacket(&workers[0], pktHandle, &transmitter, transmitterLen);
+            continue;
+        }
 
-                    free(packetBuffer);
-                    packetBuffer = malloc(pktSize * pkt->windowSize);
-                    for (int i = 0; i < pkt->windowSize; i++)
-                        packetBuffer[i].seqNum = INVALID_SEQ_NUM;
-                }
-                logToFile(INFO, pkt, "received DATA (seqNum: %d)", pkt->seqNum);
-                index = pkt->seqNum - newWindowSeqNum + pkt->windowSize;
+        // a connection's packets always go to the same worker, so its session is only ever touched by one thread
+        worker = &workers[(unsigned)pkt->connectionId % (unsigned)workerCount];
+        workerPost(worker, pktHandle, &transmitter, transmitterLen);
+        // wait for the EOT to be handled so the session count is up to date before the loop checks it
+        if (packetType == EOT && sessionLimit > 0)
+            workerDrain(worker);
 
-                // save packet in order
-                if (pkt->seqNum == nextSeqNum)
-                {
-                    saveData(pkt->data);
-                    packetBuffer[index].seqNum = INVALID_SEQ_NUM;
-                    nextSeqNum++;
-                }
-                // buffer packet out of order
-                else if (pkt->seqNum > nextSeqNum && pkt->seqNum != packetBuffer[index].seqNum)
-                {
-                    struct packet copyPkt = copyPacket(pkt);
-                    packetBuffer[index] = copyPkt;
-                }
-                sendACK(sd, pkt, pktSize, &transmitter, transmitterLen);
-                break;
-            case EOT:
-                flushBuffer(packetBuffer, &nextSeqNum, &newWindowSeqNum, latestWindowSize);
-                logToFile(INFO, pkt, "received EOT packet", pkt);
-                logToFile(INFO, pkt, "terminating receiver...", NULL);
-                free(packetBuffer);
-                close(sd);
-                return 0;
-                break;
-            default:
-                logToFile(ERROR, pkt, "received invalid packet, skipping");
+        // the slot was queued, the next datagram goes into a fresh one; queued slots come back as the workers catch up
+        if ((pktHandle = packetPoolAlloc(&packetCache)) == PACKET_HANDLE_NONE)
+        {
+            logToFile(ERROR, NULL, "packet pool exhausted");
+            exit(1);
+        }
+        pkt = packetPoolGet(&packetPool, pktHandle);
+    }
+
+    logToFile(INFO, NULL, "%d sessions complete, terminating receiver...", sessionLimit);
+    for (int i = 0; i < workerCount; i++)
+        workerStop(&workers[i]);
+    for (int i = 0; i < (workerCount == 0 ? 1 : workerCount); i++)
+    {
+        for (int s = 0; s < MAX_SESSIONS; s++)
+        {
+            if (workers[i].sessions[s].connectionId != 0)
+                closeSession(&workers[i], &workers[i].sessions[s], false);
         }
     }
+    ioClose();
+    packetPoolDestroy(&packetPool);
+    close(sd);
     return 0;
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------
- * FUNCTION:       flushBuffer
+ * FUNCTION:       sendACK
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Builds the ACK in its own packet so the DATA packet can stay buffered
+ *                 October 18th, 2026 - Sent through the I/O engine, which may queue it
+ *                 October 18th, 2026 - Carries the stream id and offset of the DATA packet
+ *                 October 18th, 2026 - Built in the worker's ACK packet and carries the connection id; a worker thread
+ *                                      sends it itself
+ *                 October 18th, 2026 - Sealed with its CRC32C
+ *                 October 18th, 2026 - Carries the file of the DATA; sent by sendPacket
  *
  * DESIGNER:       Maksym Chumak
  *
  * PROGRAMMER:     Maksym Chumak
  *
- * INTERFACE:      void flushBuffer(struct packet* buffer, long long *nextSeqNum, long long *newWindowSeqNum, int windowSize)
+ * INTERFACE:      void sendACK(struct receiverWorker* worker, const struct packet* pkt, const struct sockaddr_in* transmitter, socklen_t transmitterLen)
  *
  * RETURNS:        void
  *
  * NOTES:
- * iterates over an ordered array of buffered packets and writes data to a file
+ * creates an acknowledgement and sends it to the transmitter
  * ----------------------------------------------------------------------------------------------------------------------------*/
-void flushBuffer(struct packet* buffer, long long *nextSeqNum, long long *newWindowSeqNum, int windowSize)
+void sendACK(struct receiverWorker* worker, const struct packet* pkt, const struct sockaddr_in* transmitter, socklen_t transmitterLen)
 {
-    for (int i = (newWindowSeqNum - nextSeqNum - 1); i < windowSize; i++)
-    {
-        if (buffer[i].seqNum != INVALID_SEQ_NUM)
-        {
-            saveData(buffer[i].data);
-            buffer[i].seqNum = INVALID_SEQ_NUM;
-            nextSeqNum++;
-        }
-    }
+    struct packet* ack = worker->ack;
+
+    ack->seqNum = pkt->seqNum;
+    ack->windowSize = pkt->windowSize;
+    ack->streamId = pkt->streamId;
+    ack->offset = pkt->offset;
+    ack->connectionId = pkt->connectionId;
+    ack->transfer = pkt->transfer;
+    makePacket(ack, ACK);
+    sendPacket(worker, ack, transmitter, transmitterLen);
+    logToFile(INFO, ack, "sent ACK packet (ackNum: %d)", ack->ackNum);
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------
- * FUNCTION:       sendACK
+ * FUNCTION:       sendPacket
  *
- * DATE:           December 3rd, 2020
+ * DATE:           October 18th, 2026
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Sends the header and the data in use only
  *
- * DESIGNER:       Maksym Chumak
+ * DESIGNER:       Derek Wong
  *
- * PROGRAMMER:     Maksym Chumak
+ * PROGRAMMER:     Derek Wong
  *
- * INTERFACE:      void sendACK(int sd, struct packet *pkt, int pktSize, struct sockaddr_in *transmitter, socklen_t transmitterLen)
+ * INTERFACE:      void sendPacket(struct receiverWorker* worker, struct packet* pkt, const struct sockaddr_in* destination, socklen_t destinationLen)
  *
  * RETURNS:        void
  *
  * NOTES:
- * creates an acknowledgement and sends it to the transmitter
+ * seals a packet built in the worker's ACK slot and sends it through the I/O engine, or with sendto from a worker
+ * thread
  * ----------------------------------------------------------------------------------------------------------------------------*/
-void sendACK(int sd, struct packet *pkt, int pktSize, struct sockaddr_in *transmitter, socklen_t transmitterLen)
+void sendPacket(struct receiverWorker* worker, struct packet* pkt, const struct sockaddr_in* destination, socklen_t destinationLen)
 {
-    makePacket(pkt, ACK);
-    if (sendto(sd, pkt, pktSize, 0,(struct sockaddr *)transmitter, transmitterLen) != pktSize)
+    sealPacket(pkt);
+    if (!worker->threaded)
+        ioSend(pkt, packetLength(pkt), destination, destinationLen);
+    else if (sendto(receiverIo.sd, pkt, packetLength(pkt), 0, (const struct sockaddr*)destination, destinationLen) != packetLength(pkt))
     {
         logToFile(ERROR, NULL, "sendto error");
         exit(1);
     }
-    logToFile(INFO, pkt, "sent ACK packet (ackNum: %d)", pkt->ackNum);
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------
@@ -197,27 +462,2044 @@ void sendACK(int sd, struct packet *pkt, int pktSize, struct sockaddr_in *transm
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Opens the output file once instead of per packet
+ *                 October 18th, 2026 - Written through the I/O engine
+ *                 October 18th, 2026 - Takes the packet; writes dataLen bytes at its offset instead of a string
+ *                 October 18th, 2026 - Writes to the session's file; a worker thread writes with pwrite itself
+ *                 October 18th, 2026 - Expands compressed data into the staged output block, or the worker's
  *
  * DESIGNER:       Maksym Chumak
  *
  * PROGRAMMER:     Maksym Chumak
  *
- * INTERFACE:      void saveData(char *data)
+ * INTERFACE:      bool saveData(struct receiverWorker* worker, const struct session* session, const struct packet* pkt)
+ *
+ * RETURNS:        bool, false if compressed data did not expand to rawLen bytes and nothing was written
+ *
+ * NOTES:
+ * writes packet data to the session's file
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool saveData(struct receiverWorker* worker, const struct session* session, const struct packet* pkt)
+{
+    off_t position = session->fileBase + (off_t)pkt->offset;
+    const char* data = pkt->data;
+    size_t length = (size_t)pkt->dataLen;
+
+    if (pkt->rawLen != 0)
+    {
+        char* space = session->direct ? NULL : ioWriteSpace(session->fileFd, (size_t)pkt->rawLen, position);
+        if (lz4Decompress(pkt->data, pkt->dataLen, (space != NULL) ? space : worker->block, pkt->rawLen) != pkt->rawLen)
+        {
+            logToFile(ERROR, NULL, "compressed DATA at offset %lld of session %d does not expand to %d bytes, skipping",
+                      (long long)pkt->offset, session->connectionId, pkt->rawLen);
+            return false;
+        }
+        if (space != NULL)
+        {
+            ioWriteCommit((size_t)pkt->rawLen);
+            return true;
+        }
+        data = worker->block;
+        length = (size_t)pkt->rawLen;
+    }
+
+    if (!session->direct)
+    {
+        ioWrite(session->fileFd, data, length, position);
+        return true;
+    }
+    while (length > 0)
+    {
+        ssize_t written = pwrite(session->fileFd, data, length, position);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written < 0)
+        {
+            perror("could not write output file");
+            exit(1);
+        }
+        position += written;
+        data += written;
+        length -= written;
+    }
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       handlePacket
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - DATA is written at its offset on arrival and its range recorded; nothing is
+ *                                      buffered, so the slot is always the caller's to reuse
+ *                 October 18th, 2026 - Packets failing their checksum are dropped; EOT verifies the file
+ *                 October 18th, 2026 - SYN opens the session; DATA is checked against what was negotiated and
+ *                                      dropped unless it is of the current file; EOT is answered with an EOT_ACK
+ *                 October 18th, 2026 - DATA of a resumable session must start on a chunk and is checkpointed
+ *                 October 18th, 2026 - Compressed DATA goes by the length it expands to and is dropped if it
+ *                                      does not expand
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void handlePacket(struct receiverWorker* worker, packetHandle handle, const struct sockaddr_in* source, socklen_t sourceLen)
  *
  * RETURNS:        void
  *
  * NOTES:
- * writes packet data to a file
+ * the packet handling main used to do, for the session the packet's connection id names: SYN opens it, DATA is
+ * written where it belongs and ACKed, EOT ends the current file and is answered, as is an EOT repeated because its
+ * EOT_ACK was lost
  * ----------------------------------------------------------------------------------------------------------------------------*/
-void saveData(char *data)
+void handlePacket(struct receiverWorker* worker, packetHandle handle, const struct sockaddr_in* source, socklen_t sourceLen)
 {
-    FILE *fptr = fopen(OUTPUT_FILE_PATH, "a");
-    if (fptr == NULL)
+    struct packet* pkt = packetPoolGet(&packetPool, handle);
+    struct session* session;
+    const struct transferResult* finished;
+    struct transferResult result;
+    int64_t length;
+
+    // nothing in a damaged packet can be trusted, not even which session it belongs to
+    if (!packetIntact(pkt))
     {
-        perror("could not open output file");
-        exit(1);
+        logToFile(ERROR, NULL, "dropping corrupt packet (checksum %08x)", pkt->checksum);
+        return;
+    }
+
+    switch (pkt->packetType)
+    {
+        case DATA:
+            if (pkt->streamId < 0 || pkt->streamId >= MAX_STREAMS || pkt->dataLen < 0 || pkt->dataLen > PAYLOAD_LEN
+                || pkt->rawLen < 0 || pkt->rawLen > COMPRESSED_BLOCK_LEN || pkt->offset < 0 || pkt->offset > INT64_MAX - COMPRESSED_BLOCK_LEN)
+            {
+                logToFile(ERROR, pkt, "received DATA with invalid stream id %d, offset or length %d, skipping", pkt->streamId, pkt->dataLen);
+                return;
+            }
+            if ((session = findSession(worker, pkt->connectionId, false)) == NULL)
+                return;
+            // stragglers of a file already ended
+            if (pkt->transfer != session->transfer)
+            {
+                logToFile(DEBUG, pkt, "dropping DATA of file %d, session %d is on file %d", pkt->transfer, session->connectionId, session->transfer);
+                return;
+            }
+            if (pkt->streamId >= session->accepted.streams || pkt->dataLen > session->accepted.payloadLen)
+            {
+                logToFile(ERROR, pkt, "received DATA beyond what session %d negotiated (stream id %d, length %d), skipping",
+                          session->connectionId, pkt->streamId, pkt->dataLen);
+                return;
+            }
+            if (pkt->rawLen != 0 && (!(session->accepted.features & FEATURE_COMPRESSION)
+                || pkt->rawLen > COMPRESSED_BLOCK_CHUNKS * session->accepted.payloadLen))
+            {
+                logToFile(ERROR, pkt, "received compressed DATA session %d did not negotiate (expanded length %d), skipping",
+                          session->connectionId, pkt->rawLen);
+                return;
+            }
+            if (session->resume != NULL && pkt->offset % session->accepted.payloadLen != 0)
+            {
+                logToFile(ERROR, pkt, "received DATA at offset %lld, not on a chunk of resumable session %d, skipping",
+                          (long long)pkt->offset, session->connectionId);
+                return;
+            }
+            session->lastActiveUs = monotonicUs();
+            logToFile(INFO, pkt, "received DATA (connection: %d, stream: %d, seqNum: %d)", pkt->connectionId, pkt->streamId, pkt->seqNum);
+
+            // a retransmission of data already written is only ACKed again
+            length = (pkt->rawLen != 0) ? pkt->rawLen : pkt->dataLen;
+            if (!intervalSetContains(&session->received, pkt->offset, pkt->offset + length))
+            {
+                if (!saveData(worker, session, pkt))
+                    return;
+                if (!intervalSetAdd(&session->received, pkt->offset, pkt->offset + length))
+                {
+                    logToFile(ERROR, NULL, "out of memory tracking session %d", session->connectionId);
+                    exit(1);
+                }
+                session->packets++;
+                if (session->resume != NULL)
+                {
+                    if (!intervalSetAdd(&session->pending, pkt->offset, pkt->offset + length))
+                    {
+                        logToFile(ERROR, NULL, "out of memory tracking session %d", session->connectionId);
+                        exit(1);
+                    }
+                    if ((session->pendingBytes += length) >= RESUME_CHECKPOINT_BYTES)
+                        checkpointSession(session);
+                }
+            }
+            sendACK(worker, pkt, source, sourceLen);
+            return;
+        case SYN:
+            acceptConnection(worker, pkt, source, sourceLen);
+            return;
+        case EOT:
+            session = findSession(worker, pkt->connectionId, false);
+            if (session != NULL && pkt->transfer == session->transfer)
+            {
+                logToFile(INFO, pkt, "received EOT packet (connection: %d, file: %d)", pkt->connectionId, pkt->transfer);
+                result = endTransfer(worker, session, pkt);
+                logJitterHistogram();
+            }
+            else if ((finished = findFinished(worker, session, pkt->connectionId)) != NULL && finished->transfer == pkt->transfer)
+            {
+                logToFile(INFO, pkt, "received repeated EOT (connection: %d, file: %d)", pkt->connectionId, pkt->transfer);
+                result = *finished;
+            }
+            else
+            {
+                logToFile(DEBUG, pkt, "dropping EOT of file %d of connection %d", pkt->transfer, pkt->connectionId);
+                return;
+            }
+
+            worker->ack->connectionId = pkt->connectionId;
+            worker->ack->transfer = result.transfer;
+            makePacket(worker->ack, EOT_ACK);
+            worker->ack->offset = result.length;
+            worker->ack->fileChecksum = result.checksum;
+            sendPacket(worker, worker->ack, source, sourceLen);
+            logToFile(INFO, worker->ack, "sent EOT_ACK (connection: %d, file: %d)", pkt->connectionId, result.transfer);
+            return;
+        default:
+            logToFile(ERROR, pkt, "received invalid packet, skipping");
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       acceptConnection
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Resumes connections: the SYN_ACK names the file the session is on and lists
+ *                                      the ranges of it already received
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void acceptConnection(struct receiverWorker* worker, struct packet* pkt, const struct sockaddr_in* source, socklen_t sourceLen)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * answers a SYN with a SYN_ACK granting the smaller of each proposed limit and the receiver's, and the proposed
+ * features it supports, opening a session for the connection. A proposal of another protocol version, or one that
+ * cannot be met, is refused with a SYN_ACK granting no window and no session is opened. A repeated SYN, whose
+ * SYN_ACK was lost, gets the answer already given.
+ * With FEATURE_RESUME a new session takes up the connection's progress file, if it left one; the SYN_ACK carries
+ * the file the session is on and the ranges of it received, the largest if they do not all fit, so the transmitter
+ * can skip them. A transmitter resuming with another number of files is refused.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void acceptConnection(struct receiverWorker* worker, struct packet* pkt, const struct sockaddr_in* source, socklen_t sourceLen)
+{
+    struct handshake proposal, accepted;
+    struct session* session;
+    struct resumeRange ranges[RESUME_RANGES];
+    int rangeCount = 0;
+
+    if (!getHandshake(pkt, &proposal))
+    {
+        logToFile(ERROR, pkt, "received SYN without a handshake, skipping");
+        return;
+    }
+    logToFile(INFO, pkt, "received SYN (connection: %d, version: %d, window: %d, payload: %d, streams: %d, files: %d, features: %#x)",
+              pkt->connectionId, proposal.version, proposal.maxWindowSize, proposal.payloadLen, proposal.streams, proposal.transfers, proposal.features);
+
+    if ((session = findSession(worker, pkt->connectionId, false)) != NULL)
+    {
+        accepted = session->accepted;
+        if ((proposal.features & accepted.features & FEATURE_RESUME) && proposal.transfers != accepted.transfers)
+        {
+            logToFile(ERROR, NULL, "refusing to resume connection %d: %d files proposed, %d in progress",
+                      pkt->connectionId, proposal.transfers, accepted.transfers);
+            accepted.maxWindowSize = 0;
+            session = NULL;
+        }
+    }
+    else
+    {
+        memset(&accepted, 0, sizeof(accepted));
+        accepted.version = PROTOCOL_VERSION;
+        if (proposal.version == PROTOCOL_VERSION && proposal.maxWindowSize >= INITIAL_WINDOW_SIZE && proposal.payloadLen >= 1
+            && proposal.streams >= 1 && proposal.transfers >= 1)
+        {
+            accepted.maxWindowSize = (proposal.maxWindowSize < windowLimit) ? proposal.maxWindowSize : windowLimit;
+            accepted.payloadLen = (proposal.payloadLen < PAYLOAD_LEN) ? proposal.payloadLen : PAYLOAD_LEN;
+            accepted.streams = (proposal.streams < MAX_STREAMS) ? proposal.streams : MAX_STREAMS;
+            accepted.transfers = proposal.transfers;
+            accepted.features = proposal.features & SUPPORTED_FEATURES;
+        }
+
+        if (accepted.maxWindowSize == 0)
+            logToFile(ERROR, NULL, "refusing connection %d", pkt->connectionId);
+        else if ((session = findSession(worker, pkt->connectionId, true)) == NULL)
+            return;
+        else
+        {
+            // a receiver that cannot keep progress still takes the connection, only not resumably
+            if ((accepted.features & FEATURE_RESUME) && !openResume(session, &accepted))
+                accepted.features &= ~FEATURE_RESUME;
+            session->accepted = accepted;
+        }
+    }
+
+    worker->ack->connectionId = pkt->connectionId;
+    worker->ack->transfer = (session != NULL) ? session->transfer : 0;
+    makePacket(worker->ack, SYN_ACK);
+    setHandshake(worker->ack, &accepted);
+    if (session != NULL && (accepted.features & FEATURE_RESUME))
+    {
+        // when they do not all fit, the largest ranges save the transmitter the most
+        for (int i = 0; i < session->received.count; i++)
+        {
+            const struct interval* received = &session->received.intervals[i];
+            int slot = rangeCount;
+
+            if (rangeCount == RESUME_RANGES)
+            {
+                slot = 0;
+                for (int r = 1; r < RESUME_RANGES; r++)
+                {
+                    if (ranges[r].end - ranges[r].start < ranges[slot].end - ranges[slot].start)
+                        slot = r;
+                }
+                if (received->end - received->start <= ranges[slot].end - ranges[slot].start)
+                    continue;
+            }
+            else
+                rangeCount++;
+            ranges[slot].start = received->start;
+            ranges[slot].end = received->end;
+        }
+        setResumeRanges(worker->ack, ranges, rangeCount);
+    }
+    sendPacket(worker, worker->ack, source, sourceLen);
+    logToFile(INFO, worker->ack, "sent SYN_ACK (connection: %d, window: %d, payload: %d, streams: %d, features: %#x, file: %d, ranges: %d)",
+              pkt->connectionId, accepted.maxWindowSize, accepted.payloadLen, accepted.streams, accepted.features, worker->ack->transfer, rangeCount);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       endTransfer
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      struct transferResult endTransfer(struct receiverWorker* worker, struct session* session, const struct packet* eot)
+ *
+ * RETURNS:        struct transferResult, for the EOT_ACK
+ *
+ * NOTES:
+ * ends the session's current file on its EOT: with FEATURE_FILE_CHECKSUM the file is verified against the EOT and
+ * the checksum read back reported, then it is closed and the connection's next file opened in the same session.
+ * After the last file the session is closed.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+struct transferResult endTransfer(struct receiverWorker* worker, struct session* session, const struct packet* eot)
+{
+    struct transferResult result;
+
+    result.transfer = session->transfer;
+    result.length = intervalSetPrefix(&session->received);
+    result.checksum = 0;
+    if (session->accepted.features & FEATURE_FILE_CHECKSUM)
+        verifySession(session, eot->offset, eot->fileChecksum, &result.checksum);
+    session->finished = result;
+
+    if (session->transfer + 1 >= session->accepted.transfers)
+    {
+        closeSession(worker, session, true);
+        return result;
+    }
+    closeTransferFile(session, true);
+    if (!openTransferFile(session, session->transfer + 1))
+        closeSession(worker, session, false);
+    return result;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       findFinished
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      const struct transferResult* findFinished(const struct receiverWorker* worker, const struct session* session, int connectionId)
+ *
+ * RETURNS:        const struct transferResult*, NULL if no file of the connection has ended
+ *
+ * NOTES:
+ * the result of the connection's last file ended: kept in its session while open, in the closed list after
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+const struct transferResult* findFinished(const struct receiverWorker* worker, const struct session* session, int connectionId)
+{
+    if (session != NULL)
+        return (session->finished.transfer >= 0) ? &session->finished : NULL;
+    for (int i = 0; i < CLOSED_SESSIONS; i++)
+    {
+        if (worker->closed[i].connectionId == connectionId && connectionId != 0)
+            return &worker->closed[i].finished;
+    }
+    return NULL;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       findSession
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Only opens a session when asked to, for a SYN
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      struct session* findSession(struct receiverWorker* worker, int connectionId, bool create)
+ *
+ * RETURNS:        struct session*, NULL if the connection has none
+ *
+ * NOTES:
+ * looks the connection id up in the worker's session table, probing from connectionId % MAX_SESSIONS, and with
+ * create opens a session for an id without one. Ids of recently closed sessions are not reopened, so a stray SYN
+ * of a finished transfer is dropped. When the table is full the session idle the longest is closed to make room,
+ * provided it has been silent for SESSION_IDLE_US.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+struct session* findSession(struct receiverWorker* worker, int connectionId, bool create)
+{
+    struct session* freeSlot = NULL;
+    struct session* idlest = NULL;
+
+    if (connectionId == 0)
+    {
+        logToFile(ERROR, NULL, "received packet without a connection id, skipping");
+        return NULL;
+    }
+    for (int i = 0; i < MAX_SESSIONS; i++)
+    {
+        struct session* session = &worker->sessions[((unsigned)connectionId + i) % MAX_SESSIONS];
+        if (session->connectionId == connectionId)
+            return session;
+        if (session->connectionId == 0)
+        {
+            if (freeSlot == NULL)
+                freeSlot = session;
+        }
+        else if (idlest == NULL || session->lastActiveUs < idlest->lastActiveUs)
+            idlest = session;
+    }
+    if (!create)
+    {
+        logToFile(DEBUG, NULL, "dropping packet of connection %d, which has no session", connectionId);
+        return NULL;
+    }
+    for (int i = 0; i < CLOSED_SESSIONS; i++)
+    {
+        if (worker->closed[i].connectionId == connectionId)
+        {
+            logToFile(DEBUG, NULL, "dropping packet of closed connection %d", connectionId);
+            return NULL;
+        }
+    }
+
+    if (freeSlot == NULL)
+    {
+        if (monotonicUs() - idlest->lastActiveUs < SESSION_IDLE_US)
+        {
+            logToFile(ERROR, NULL, "no session free for connection %d, dropping packet", connectionId);
+            return NULL;
+        }
+        closeSession(worker, idlest, false);
+        freeSlot = idlest;
+    }
+    return openSession(worker, freeSlot, connectionId) ? freeSlot : NULL;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       openSession
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Opens the file read-write so it can be verified
+ *                 October 18th, 2026 - The file is opened by openTransferFile; no file has ended yet
+ *                 October 18th, 2026 - No progress file until the SYN_ACK grants FEATURE_RESUME
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool openSession(struct receiverWorker* worker, struct session* session, int connectionId)
+ *
+ * RETURNS:        bool, false if the output file could not be opened
+ *
+ * NOTES:
+ * takes the slot for the connection and opens the output file of its first file
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool openSession(struct receiverWorker* worker, struct session* session, int connectionId)
+{
+    session->connectionId = connectionId;
+    session->direct = worker->threaded;
+    session->finished.transfer = -1;
+    session->resume = NULL;
+    if (!openTransferFile(session, 0))
+    {
+        session->connectionId = 0;
+        return false;
+    }
+    logToFile(INFO, NULL, "session %d opened by worker %d", connectionId, worker->id);
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       openTransferFile
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Starts the progress file over for the new file
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool openTransferFile(struct session* session, int transfer)
+ *
+ * RETURNS:        bool, false if the output file could not be opened
+ *
+ * NOTES:
+ * opens the output file of one of the session's files for appending, remembering where it ended as offset 0 of the
+ * transfer, and empties the set of ranges received; the file is opened for reading too, for verifySession. The
+ * first file of a connection is named after its id alone, the later ones after the id and their number. A
+ * resumable session's progress file moves on to the new file with no chunks received.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool openTransferFile(struct session* session, int transfer)
+{
+    char path[64];
+
+    if (transfer == 0)
+        snprintf(path, sizeof(path), SESSION_FILE_FORMAT, session->connectionId);
+    else
+        snprintf(path, sizeof(path), SESSION_TRANSFER_FILE_FORMAT, session->connectionId, transfer);
+    if ((session->fileFd = open(path, O_RDWR | O_CREAT, 0644)) < 0
+        || (session->fileBase = lseek(session->fileFd, 0, SEEK_END)) < 0)
+    {
+        logToFile(ERROR, NULL, "could not open output file %s: %s", path, strerror(errno));
+        if (session->fileFd >= 0)
+            close(session->fileFd);
+        return false;
+    }
+    session->transfer = transfer;
+    session->lastActiveUs = monotonicUs();
+    session->packets = 0;
+    intervalSetClear(&session->received);
+    if (session->resume != NULL)
+    {
+        session->resume->transfer = transfer;
+        session->resume->fileBase = session->fileBase;
+        session->resume->contiguous = 0;
+        session->resume->end = 0;
+        memset(session->resume + 1, 0, session->resumeLen - sizeof(struct resumeHeader));
+        intervalSetClear(&session->pending);
+        session->pendingBytes = 0;
     }
-    fprintf(fptr, "%s", data);
-    fclose(fptr);
-}
\ No newline at end of file
+    logToFile(INFO, NULL, "session %d writing %s", session->connectionId, path);
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       closeTransferFile
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void closeTransferFile(struct session* session, bool complete)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * closes the output file of the session's current file, logging how much of it arrived. complete is true when the
+ * file ended with its EOT rather than being evicted or cut short.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void closeTransferFile(struct session* session, bool complete)
+{
+    int64_t contiguous = intervalSetPrefix(&session->received);
+    int gaps = session->received.count - (contiguous > 0 ? 1 : 0);
+
+    if (session->direct)
+        close(session->fileFd);
+    else
+        ioCloseFile(session->fileFd);
+
+    logToFile((complete && gaps == 0) ? INFO : ERROR, NULL, "session %d file %d %s after %lld packets: %lld contiguous bytes, %d gaps",
+              session->connectionId, session->transfer, complete ? "complete" : "closed before its EOT", session->packets, (long long)contiguous, gaps);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       closeSession
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - The file is closed by closeTransferFile; the result of the last file ended
+ *                                      is remembered with the id
+ *                 October 18th, 2026 - Closes the progress file; a resumable session cut short is not remembered
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void closeSession(struct receiverWorker* worker, struct session* session, bool complete)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * closes the current file and frees the slot; the id is remembered as closed along with the result of its last
+ * file ended, for a repeated EOT. complete is true when the session ended with its last EOT rather than being
+ * evicted or cut short. A resumable session cut short is checkpointed and not remembered, so a SYN can resume it.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void closeSession(struct receiverWorker* worker, struct session* session, bool complete)
+{
+    bool resumable = !complete && session->resume != NULL;
+
+    closeResume(session, complete);
+    closeTransferFile(session, complete);
+    if (!resumable)
+    {
+        worker->closed[worker->closedNext].connectionId = session->connectionId;
+        worker->closed[worker->closedNext].finished = session->finished;
+        worker->closedNext = (worker->closedNext + 1) % CLOSED_SESSIONS;
+    }
+    session->connectionId = 0;
+    if (complete)
+        __atomic_add_fetch(&sessionsClosed, 1, __ATOMIC_RELEASE);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       verifySession
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Hands back the checksum read, for the EOT_ACK
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool verifySession(const struct session* session, int64_t length, uint32_t checksum, uint32_t* computed)
+ *
+ * RETURNS:        bool, true if the file holds exactly length bytes with CRC32C checksum
+ *
+ * NOTES:
+ * checks what reached the disk rather than what arrived: the data staged for the file is written out, then the
+ * transfer's part of the file is read back and checksummed, the result going to computed. A file with gaps fails
+ * without being read, leaving computed 0.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool verifySession(const struct session* session, int64_t length, uint32_t checksum, uint32_t* computed)
+{
+    char buffer[VERIFY_BUFFER_LEN];
+    uint32_t crc = 0;
+    int64_t done = 0;
+
+    *computed = 0;
+    if (length < 0 || intervalSetPrefix(&session->received) != length || session->received.count > 1)
+    {
+        logToFile(ERROR, NULL, "session %d failed verification: %lld bytes expected, %lld contiguous received",
+                  session->connectionId, (long long)length, (long long)intervalSetPrefix(&session->received));
+        return false;
+    }
+    if (!session->direct)
+        ioFlushFile(session->fileFd);
+
+    while (done < length)
+    {
+        size_t chunk = (length - done < VERIFY_BUFFER_LEN) ? (size_t)(length - done) : VERIFY_BUFFER_LEN;
+        ssize_t bytesRead = pread(session->fileFd, buffer, chunk, session->fileBase + (off_t)done);
+        if (bytesRead < 0 && errno == EINTR)
+            continue;
+        if (bytesRead <= 0)
+        {
+            logToFile(ERROR, NULL, "session %d failed verification: could not read back byte %lld", session->connectionId, (long long)done);
+            return false;
+        }
+        crc = crc32cUpdate(crc, buffer, (size_t)bytesRead);
+        done += bytesRead;
+    }
+    *computed = crc;
+
+    if (crc != checksum)
+    {
+        logToFile(ERROR, NULL, "session %d failed verification: checksum %08x, expected %08x", session->connectionId, crc, checksum);
+        return false;
+    }
+    logToFile(INFO, NULL, "session %d verified: %lld bytes, checksum %08x", session->connectionId, (long long)length, crc);
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       openResume
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool openResume(struct session* session, struct handshake* accepted)
+ *
+ * RETURNS:        bool, false if the progress file could not be opened or mapped
+ *
+ * NOTES:
+ * opens and maps the progress file of a session just granted FEATURE_RESUME. One left by an earlier session of the
+ * connection, for the same number of files and chunks no larger than the payload granted, is taken up: the session
+ * moves to its file, at the offset that file started at, the payload granted is cut to its chunk size and the
+ * chunks its bitmap marks become the ranges received. Anything else, missing, damaged or not matching, is started
+ * over for the session's first file.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool openResume(struct session* session, struct handshake* accepted)
+{
+    char path[64], outputPath[64];
+    struct resumeHeader stored;
+    struct stat resumeStat, outputStat;
+    const unsigned char* bitmap;
+    int64_t runStart = -1;
+    int firstFd;
+    off_t firstBase;
+    bool resumed = false;
+
+    snprintf(path, sizeof(path), RESUME_FILE_FORMAT, session->connectionId);
+    if ((session->resumeFd = open(path, O_RDWR | O_CREAT, 0644)) < 0)
+    {
+        logToFile(ERROR, NULL, "could not open progress file %s: %s", path, strerror(errno));
+        return false;
+    }
+
+    // the stored progress is only trusted if the output it describes is still there
+    if (fstat(session->resumeFd, &resumeStat) == 0 && resumeStat.st_size >= (off_t)sizeof(stored)
+        && pread(session->resumeFd, &stored, sizeof(stored), 0) == (ssize_t)sizeof(stored)
+        && stored.magic == RESUME_MAGIC && stored.transfers == accepted->transfers
+        && stored.transfer >= 0 && stored.transfer < stored.transfers
+        && stored.payloadLen >= 1 && stored.payloadLen <= accepted->payloadLen
+        && stored.fileBase >= 0 && stored.end >= 0 && stored.chunks >= 1
+        && stored.end <= stored.chunks * stored.payloadLen
+        && resumeStat.st_size >= (off_t)(sizeof(stored) + (size_t)((stored.chunks + 7) / 8)))
+    {
+        if (stored.transfer == 0)
+            snprintf(outputPath, sizeof(outputPath), SESSION_FILE_FORMAT, session->connectionId);
+        else
+            snprintf(outputPath, sizeof(outputPath), SESSION_TRANSFER_FILE_FORMAT, session->connectionId, stored.transfer);
+        resumed = stat(outputPath, &outputStat) == 0 && outputStat.st_size >= stored.fileBase + stored.end;
+    }
+
+    if (!resumed)
+    {
+        if (!mapResume(session, RESUME_INITIAL_CHUNKS))
+        {
+            close(session->resumeFd);
+            return false;
+        }
+        memset(session->resume, 0, session->resumeLen);
+        session->resume->magic = RESUME_MAGIC;
+        session->resume->transfer = session->transfer;
+        session->resume->transfers = accepted->transfers;
+        session->resume->payloadLen = accepted->payloadLen;
+        session->resume->fileBase = session->fileBase;
+        session->resume->chunks = RESUME_INITIAL_CHUNKS;
+        intervalSetClear(&session->pending);
+        session->pendingBytes = 0;
+        return true;
+    }
+
+    // nothing has been written to the first file's output yet; the stored file takes its place
+    firstFd = session->fileFd;
+    firstBase = session->fileBase;
+    if (!openTransferFile(session, stored.transfer))
+    {
+        session->fileFd = firstFd;
+        session->fileBase = firstBase;
+        close(session->resumeFd);
+        return false;
+    }
+    if (!mapResume(session, stored.chunks))
+    {
+        close(session->fileFd);
+        session->fileFd = firstFd;
+        session->fileBase = firstBase;
+        session->transfer = 0;
+        close(session->resumeFd);
+        return false;
+    }
+    close(firstFd);
+    session->fileBase = (off_t)stored.fileBase;
+    accepted->payloadLen = stored.payloadLen;
+    intervalSetClear(&session->pending);
+    session->pendingBytes = 0;
+
+    // each run of marked chunks is a range received; only the last chunk of the file may be short
+    bitmap = (const unsigned char*)(session->resume + 1);
+    for (int64_t chunk = 0; chunk * stored.payloadLen < stored.end; chunk++)
+    {
+        bool marked = (bitmap[chunk / 8] >> (chunk % 8)) & 1;
+        if (marked && runStart < 0)
+            runStart = chunk;
+        else if (!marked && runStart >= 0)
+        {
+            if (!intervalSetAdd(&session->received, runStart * stored.payloadLen, chunk * stored.payloadLen))
+            {
+                logToFile(ERROR, NULL, "out of memory tracking session %d", session->connectionId);
+                exit(1);
+            }
+            runStart = -1;
+        }
+    }
+    if (runStart >= 0 && !intervalSetAdd(&session->received, runStart * stored.payloadLen, stored.end))
+    {
+        logToFile(ERROR, NULL, "out of memory tracking session %d", session->connectionId);
+        exit(1);
+    }
+    logToFile(INFO, NULL, "session %d resuming file %d: %lld contiguous bytes, %d ranges received", session->connectionId,
+              session->transfer, (long long)intervalSetPrefix(&session->received), session->received.count);
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       mapResume
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool mapResume(struct session* session, int64_t chunks)
+ *
+ * RETURNS:        bool, false if the progress file could not be sized or mapped
+ *
+ * NOTES:
+ * sizes the progress file for a bitmap of chunks bits and maps it in place of the old mapping; growing the file adds
+ * cleared bits
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool mapResume(struct session* session, int64_t chunks)
+{
+    size_t length = sizeof(struct resumeHeader) + (size_t)((chunks + 7) / 8);
+    void* mapped;
+
+    if (ftruncate(session->resumeFd, (off_t)length) < 0
+        || (mapped = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, session->resumeFd, 0)) == MAP_FAILED)
+    {
+        logToFile(ERROR, NULL, "could not map progress file of session %d: %s", session->connectionId, strerror(errno));
+        return false;
+    }
+    if (session->resume != NULL)
+        munmap(session->resume, session->resumeLen);
+    session->resume = mapped;
+    session->resumeLen = length;
+    session->resume->chunks = chunks;
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       checkpointSession
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void checkpointSession(struct session* session)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * marks in the progress file the chunks written since the last checkpoint. The output is written out and synced
+ * first, so a chunk is never marked before it is on disk; DATA starts on a chunk, so the chunks starting in the
+ * ranges written are exactly the packets written. The bitmap doubles when a chunk lies beyond it.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void checkpointSession(struct session* session)
+{
+    unsigned char* bitmap;
+    int64_t payloadLen, chunks;
+
+    if (session->resume == NULL || session->pending.count == 0)
+        return;
+    if (!session->direct)
+        ioFlushFile(session->fileFd);
+    if (fdatasync(session->fileFd) < 0)
+    {
+        logToFile(ERROR, NULL, "could not sync output of session %d: %s", session->connectionId, strerror(errno));
+        return;
+    }
+
+    payloadLen = session->resume->payloadLen;
+    for (int i = 0; i < session->pending.count; i++)
+    {
+        const struct interval* written = &session->pending.intervals[i];
+        int64_t first = (written->start + payloadLen - 1) / payloadLen;
+        int64_t last = (written->end - 1) / payloadLen;
+
+        if (last >= session->resume->chunks)
+        {
+            for (chunks = session->resume->chunks * 2; chunks <= last; chunks *= 2)
+                ;
+            if (!mapResume(session, chunks))
+                return;
+        }
+        bitmap = (unsigned char*)(session->resume + 1);
+        for (int64_t chunk = first; chunk <= last; chunk++)
+            bitmap[chunk / 8] |= (unsigned char)(1u << (chunk % 8));
+    }
+    // all that was received is on disk now, so the ranges received are what the bitmap holds
+    session->resume->contiguous = intervalSetPrefix(&session->received);
+    session->resume->end = session->received.intervals[session->received.count - 1].end;
+    intervalSetClear(&session->pending);
+    session->pendingBytes = 0;
+    logToFile(DEBUG, NULL, "session %d checkpoint: %lld contiguous bytes of file %d", session->connectionId,
+              (long long)session->resume->contiguous, session->transfer);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       closeResume
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void closeResume(struct session* session, bool complete)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * unmaps and closes the session's progress file, if it has one. It is removed once the session is complete, and
+ * otherwise checkpointed first so the connection can be resumed from where it stopped.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void closeResume(struct session* session, bool complete)
+{
+    char path[64];
+
+    if (session->resume == NULL)
+        return;
+    if (complete)
+    {
+        snprintf(path, sizeof(path), RESUME_FILE_FORMAT, session->connectionId);
+        unlink(path);
+    }
+    else
+    {
+        checkpointSession(session);
+        logToFile(INFO, NULL, "session %d left at %lld contiguous bytes of file %d, to be resumed", session->connectionId,
+                  (long long)session->resume->contiguous, session->transfer);
+    }
+    munmap(session->resume, session->resumeLen);
+    close(session->resumeFd);
+    session->resume = NULL;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       workerInit
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void workerInit(struct receiverWorker* worker, int id, bool threaded)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * prepares an empty session table, the worker's pool cache and ACK slot, and for a threaded worker its queue
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void workerInit(struct receiverWorker* worker, int id, bool threaded)
+{
+    worker->id = id;
+    worker->threaded = threaded;
+    packetPoolCacheInit(&worker->cache, &packetPool);
+    packetHandle ackHandle = packetPoolAlloc(&worker->cache);
+    if (ackHandle == PACKET_HANDLE_NONE)
+    {
+        logToFile(ERROR, NULL, "packet pool exhausted");
+        exit(1);
+    }
+    worker->ack = packetPoolGet(&packetPool, ackHandle);
+    for (int s = 0; s < MAX_SESSIONS; s++)
+        worker->sessions[s].connectionId = 0;
+    for (int i = 0; i < CLOSED_SESSIONS; i++)
+        worker->closed[i].connectionId = 0;
+    worker->closedNext = 0;
+    worker->queueHead = 0;
+    worker->queueCount = 0;
+    worker->busy = false;
+    worker->stopping = false;
+    if (threaded)
+    {
+        pthread_mutex_init(&worker->lock, NULL);
+        pthread_cond_init(&worker->ready, NULL);
+        pthread_cond_init(&worker->space, NULL);
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       workerPost
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void workerPost(struct receiverWorker* worker, packetHandle handle, const struct sockaddr_in* source, socklen_t sourceLen)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * hands a received packet to a worker thread, waiting while its queue is full; the worker owns the slot from then on
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void workerPost(struct receiverWorker* worker, packetHandle handle, const struct sockaddr_in* source, socklen_t sourceLen)
+{
+    pthread_mutex_lock(&worker->lock);
+    while (worker->queueCount == WORKER_QUEUE_LEN)
+        pthread_cond_wait(&worker->space, &worker->lock);
+    struct queuedPacket* item = &worker->queue[(worker->queueHead + worker->queueCount) % WORKER_QUEUE_LEN];
+    item->handle = handle;
+    item->source = *source;
+    item->sourceLen = sourceLen;
+    worker->queueCount++;
+    pthread_cond_signal(&worker->ready);
+    pthread_mutex_unlock(&worker->lock);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       workerDrain
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void workerDrain(struct receiverWorker* worker)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * waits until the worker has handled everything queued to it
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void workerDrain(struct receiverWorker* worker)
+{
+    pthread_mutex_lock(&worker->lock);
+    while (worker->queueCount > 0 || worker->busy)
+        pthread_cond_wait(&worker->space, &worker->lock);
+    pthread_mutex_unlock(&worker->lock);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       workerStop
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void workerStop(struct receiverWorker* worker)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * lets the worker thread finish its queue, then joins it; its sessions are left for the caller to close
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void workerStop(struct receiverWorker* worker)
+{
+    pthread_mutex_lock(&worker->lock);
+    worker->stopping = true;
+    pthread_cond_signal(&worker->ready);
+    pthread_mutex_unlock(&worker->lock);
+    pthread_join(worker->thread, NULL);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       runWorker
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void* runWorker(void* arg)
+ *
+ * RETURNS:        void*, NULL
+ *
+ * NOTES:
+ * thread body of a worker: takes packets off its queue in arrival order, handles them and returns their slots to
+ * the pool
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void* runWorker(void* arg)
+{
+    struct receiverWorker* worker = (struct receiverWorker*)arg;
+    struct queuedPacket item;
+
+    pthread_mutex_lock(&worker->lock);
+    while (true)
+    {
+        while (worker->queueCount == 0 && !worker->stopping)
+        {
+            worker->busy = false;
+            pthread_cond_broadcast(&worker->space);
+            pthread_cond_wait(&worker->ready, &worker->lock);
+        }
+        if (worker->queueCount == 0)
+            break;
+        item = worker->queue[worker->queueHead];
+        worker->queueHead = (worker->queueHead + 1) % WORKER_QUEUE_LEN;
+        worker->queueCount--;
+        worker->busy = true;
+        pthread_cond_broadcast(&worker->space);
+        pthread_mutex_unlock(&worker->lock);
+
+        handlePacket(worker, item.handle, &item.source, item.sourceLen);
+        packetPoolFree(&worker->cache, item.handle);
+
+        pthread_mutex_lock(&worker->lock);
+    }
+    worker->busy = false;
+    pthread_cond_broadcast(&worker->space);
+    pthread_mutex_unlock(&worker->lock);
+    packetPoolCacheFlush(&worker->cache);
+    return NULL;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       requestLatencyDump
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void requestLatencyDump(int signalNumber)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * SIGUSR1 handler; only sets a flag, the main loop logs the histogram
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void requestLatencyDump(int signalNumber)
+{
+    (void)signalNumber;
+    latencyDumpRequested = 1;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       endLinger
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void endLinger(int signalNumber)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * SIGALRM handler; the linger timer ran out without a packet, so the main loop ends
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void endLinger(int signalNumber)
+{
+    (void)signalNumber;
+    lingerOver = 1;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       recordInterArrival
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void recordInterArrival(uint64_t arrivalUs)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * records |gap(i) - gap(i - 1)| in microseconds, where gap(i) is the time between DATA arrivals i - 1 and i;
+ * the first two arrivals only prime the gaps
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void recordInterArrival(uint64_t arrivalUs)
+{
+    static uint64_t lastArrivalUs = 0, lastGapUs = 0;
+    static int arrivals = 0;
+    uint64_t gapUs;
+
+    if (arrivals > 0)
+    {
+        gapUs = arrivalUs - lastArrivalUs;
+        if (arrivals > 1)
+            histogramRecord(&jitterHistogram, (gapUs > lastGapUs) ? gapUs - lastGapUs : lastGapUs - gapUs);
+        lastGapUs = gapUs;
+    }
+    lastArrivalUs = arrivalUs;
+    if (arrivals < 2)
+        arrivals++;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       logJitterHistogram
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void logJitterHistogram()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * logs the inter-arrival jitter percentiles in microseconds
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void logJitterHistogram()
+{
+    char summary[HISTOGRAM_SUMMARY_LEN];
+
+    histogramFormat(&jitterHistogram, summary, sizeof(summary), "us");
+    logToFile(INFO, NULL, "inter-arrival jitter: %s", summary);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioInit
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool ioInit(int sd, enum ioEngine engine)
+ *
+ * RETURNS:        bool, false if the engine could not be set up
+ *
+ * NOTES:
+ * prepares the I/O engine for the bound socket sd; io_uring falls back to epoll when the kernel does not offer it
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+bool ioInit(int sd, enum ioEngine engine)
+{
+    receiverIo.engine = IO_ENGINE_BLOCKING;
+    receiverIo.sd = sd;
+    if (engine == IO_ENGINE_BLOCKING)
+        return true;
+
+#if defined(__linux__)
+    struct epoll_event event;
+
+    for (int i = 0; i < IO_BATCH_SIZE; i++)
+    {
+        receiverIo.recvVectors[i].iov_base = &receiverIo.recvPackets[i];
+        receiverIo.recvVectors[i].iov_len = sizeof(struct packet);
+        receiverIo.recvHeaders[i].msg_hdr.msg_iov = &receiverIo.recvVectors[i];
+        receiverIo.recvHeaders[i].msg_hdr.msg_iovlen = 1;
+        receiverIo.recvHeaders[i].msg_hdr.msg_name = &receiverIo.recvSources[i];
+        receiverIo.sendVectors[i].iov_base = &receiverIo.sendPackets[i];
+        receiverIo.sendHeaders[i].msg_hdr.msg_iov = &receiverIo.sendVectors[i];
+        receiverIo.sendHeaders[i].msg_hdr.msg_iovlen = 1;
+        receiverIo.sendHeaders[i].msg_hdr.msg_name = &receiverIo.sendDestinations[i];
+    }
+
+    #if defined(IO_RING_SUPPORTED)
+    if (engine == IO_ENGINE_URING)
+    {
+        if (ioRingStart())
+        {
+            receiverIo.engine = IO_ENGINE_URING;
+            logToFile(INFO, NULL, "using io_uring I/O");
+            return true;
+        }
+        logToFile(INFO, NULL, "io_uring unavailable, falling back to epoll");
+    }
+    #endif
+
+    if ((receiverIo.epollFd = epoll_create1(0)) < 0)
+        return false;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = sd;
+    if (epoll_ctl(receiverIo.epollFd, EPOLL_CTL_ADD, sd, &event) < 0)
+        return false;
+    receiverIo.engine = IO_ENGINE_EPOLL;
+    logToFile(INFO, NULL, "using epoll I/O");
+    return true;
+#else
+    logToFile(INFO, NULL, "batched I/O needs Linux, using blocking I/O");
+    return true;
+#endif
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioReceive
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int ioReceive(struct packet* pkt, struct sockaddr_in* source, socklen_t* sourceLen)
+ *
+ * RETURNS:        int, the datagram length, or -1 with errno set; EINTR when a signal interrupted the wait
+ *
+ * NOTES:
+ * reads the next datagram into pkt; the batched engines hand out the rest of the last batch before waiting again and
+ * send the queued ACKs and data before they wait
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+int ioReceive(struct packet* pkt, struct sockaddr_in* source, socklen_t* sourceLen)
+{
+    switch (receiverIo.engine)
+    {
+#if defined(__linux__)
+        case IO_ENGINE_EPOLL:
+        {
+            struct epoll_event event;
+            while (receiverIo.recvNext == receiverIo.recvCount)
+            {
+                ioFlushSends();
+                ioFlushWrites();
+                if (epoll_wait(receiverIo.epollFd, &event, 1, -1) < 0)
+                    return -1;
+                for (int i = 0; i < IO_BATCH_SIZE; i++)
+                    receiverIo.recvHeaders[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+                int received = recvmmsg(receiverIo.sd, receiverIo.recvHeaders, IO_BATCH_SIZE, MSG_DONTWAIT, NULL);
+                if (received < 0)
+                {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK)
+                        continue;
+                    return -1;
+                }
+                receiverIo.recvCount = received;
+                receiverIo.recvNext = 0;
+            }
+            int next = receiverIo.recvNext++;
+            unsigned length = receiverIo.recvHeaders[next].msg_len;
+            memcpy(pkt, &receiverIo.recvPackets[next], length);
+            memcpy(source, &receiverIo.recvSources[next], sizeof(struct sockaddr_in));
+            *sourceLen = receiverIo.recvHeaders[next].msg_hdr.msg_namelen;
+            return (int)length;
+        }
+#endif
+#if defined(IO_RING_SUPPORTED)
+        case IO_ENGINE_URING:
+        {
+            struct ioRecvMsg received;
+            while (receiverIo.recvQueueCount == 0)
+            {
+                if (ioRingWait() < 0)
+                    return -1;
+            }
+            uint16_t bufferId = receiverIo.recvQueueIds[receiverIo.recvQueueHead];
+            unsigned length = receiverIo.recvQueueLens[receiverIo.recvQueueHead];
+            receiverIo.recvQueueHead = (receiverIo.recvQueueHead + 1) % IO_RECV_BUFFERS;
+            receiverIo.recvQueueCount--;
+
+            if (ioRecvMsgParse(receiverIo.recvArea[bufferId], length, &receiverIo.recvMsg, &received))
+            {
+                length = (received.payloadLen < sizeof(struct packet)) ? received.payloadLen : sizeof(struct packet);
+                memcpy(pkt, received.payload, length);
+                memset(source, 0, sizeof(struct sockaddr_in));
+                memcpy(source, received.name, received.nameLen);
+                *sourceLen = received.nameLen;
+            }
+            else
+                length = 0;
+
+            // the buffer goes straight back to the kernel
+            ioBufferRingAdd(&receiverIo.recvRing, receiverIo.recvArea[bufferId], sizeof(receiverIo.recvArea[bufferId]), bufferId, 0);
+            ioBufferRingAdvance(&receiverIo.recvRing, 1);
+            return (int)length;
+        }
+#endif
+        default:
+            return (int)recvfrom(receiverIo.sd, pkt, sizeof(struct packet), 0, (struct sockaddr*)source, sourceLen);
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioSend
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void ioSend(const struct packet* pkt, int pktSize, const struct sockaddr_in* destination, socklen_t destinationLen)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * sends pkt, or with a batched engine copies it into a send slot to go out with the next batch
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void ioSend(const struct packet* pkt, int pktSize, const struct sockaddr_in* destination, socklen_t destinationLen)
+{
+    int slot = -1;
+
+    switch (receiverIo.engine)
+    {
+#if defined(__linux__)
+        case IO_ENGINE_EPOLL:
+            if (receiverIo.sendCount == IO_BATCH_SIZE)
+                ioFlushSends();
+            slot = receiverIo.sendCount++;
+            break;
+#endif
+#if defined(IO_RING_SUPPORTED)
+        case IO_ENGINE_URING:
+            while (slot < 0)
+            {
+                for (int i = 0; i < IO_BATCH_SIZE && slot < 0; i++)
+                {
+                    if (!receiverIo.sendBusy[i])
+                        slot = i;
+                }
+                if (slot < 0 && ioRingWait() < 0 && errno != EINTR)
+                {
+                    logToFile(ERROR, NULL, "io_uring_enter error");
+                    exit(1);
+                }
+            }
+            break;
+#endif
+        default:
+            if (sendto(receiverIo.sd, pkt, pktSize, 0, (const struct sockaddr*)destination, destinationLen) != pktSize)
+            {
+                logToFile(ERROR, NULL, "sendto error");
+                exit(1);
+            }
+            return;
+    }
+
+#if defined(__linux__)
+    memcpy(&receiverIo.sendPackets[slot], pkt, pktSize);
+    memcpy(&receiverIo.sendDestinations[slot], destination, destinationLen);
+    receiverIo.sendVectors[slot].iov_len = pktSize;
+    receiverIo.sendHeaders[slot].msg_hdr.msg_namelen = destinationLen;
+    #if defined(IO_RING_SUPPORTED)
+    if (receiverIo.engine == IO_ENGINE_URING)
+    {
+        struct io_uring_sqe* sqe = ioRingNextSqe();
+        ioRingPrepSendMsg(sqe, receiverIo.sd, &receiverIo.sendHeaders[slot].msg_hdr);
+        sqe->user_data = IO_USER_DATA(IO_TAG_SEND, slot);
+        receiverIo.sendBusy[slot] = true;
+        receiverIo.inFlight++;
+    }
+    #endif
+#endif
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioWrite
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Writes at offset from where the file ended when it was opened; a staged block
+ *                                      is written out before data that does not follow on from it
+ *                 October 18th, 2026 - Takes the file and the position in it; files are opened by the sessions
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void ioWrite(int fd, const char* data, size_t length, off_t position)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * writes data at position in file fd; the batched engines stage it and write whole blocks, so data arriving in file
+ * order (one stream of one session) still goes out in large writes
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void ioWrite(int fd, const char* data, size_t length, off_t position)
+{
+    if (receiverIo.engine == IO_ENGINE_BLOCKING)
+    {
+        while (length > 0)
+        {
+            ssize_t written = pwrite(fd, data, length, position);
+            if (written < 0 && errno == EINTR)
+                continue;
+            if (written < 0)
+            {
+                perror("could not write output file");
+                exit(1);
+            }
+            position += written;
+            data += written;
+            length -= written;
+        }
+        return;
+    }
+
+    if (receiverIo.writeFill > 0 && (receiverIo.writeFd != fd || receiverIo.writeOffset + (off_t)receiverIo.writeFill != position))
+        ioFlushWrites();
+    if (receiverIo.writeFill == 0)
+    {
+        receiverIo.writeFd = fd;
+        receiverIo.writeOffset = position;
+    }
+
+    while (length > 0)
+    {
+        size_t space = IO_WRITE_BUFFER_LEN - receiverIo.writeFill;
+        size_t chunk = (length < space) ? length : space;
+        memcpy(receiverIo.writeBuffers[receiverIo.writeCurrent] + receiverIo.writeFill, data, chunk);
+        receiverIo.writeFill += chunk;
+        data += chunk;
+        length -= chunk;
+        if (receiverIo.writeFill == IO_WRITE_BUFFER_LEN)
+            ioFlushWrites();
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioWriteSpace
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      char* ioWriteSpace(int fd, size_t length, off_t position)
+ *
+ * RETURNS:        char*, where length bytes for position in file fd can be put; NULL if the engine stages nothing
+ *
+ * NOTES:
+ * lets data be produced straight into the staged block instead of being copied there by ioWrite, as compressed DATA
+ * is expanded. The block is written out first if the data would not follow on from it or not fit after it. Nothing
+ * is staged until ioWriteCommit, so space that is not committed is simply used again.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+char* ioWriteSpace(int fd, size_t length, off_t position)
+{
+    if (receiverIo.engine == IO_ENGINE_BLOCKING || length > IO_WRITE_BUFFER_LEN)
+        return NULL;
+
+    if (receiverIo.writeFill > 0 && (receiverIo.writeFd != fd || receiverIo.writeOffset + (off_t)receiverIo.writeFill != position
+        || IO_WRITE_BUFFER_LEN - receiverIo.writeFill < length))
+        ioFlushWrites();
+    if (receiverIo.writeFill == 0)
+    {
+        receiverIo.writeFd = fd;
+        receiverIo.writeOffset = position;
+    }
+    return receiverIo.writeBuffers[receiverIo.writeCurrent] + receiverIo.writeFill;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioWriteCommit
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void ioWriteCommit(size_t length)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * stages the length bytes put where the last ioWriteSpace said, writing the block out once it is full
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void ioWriteCommit(size_t length)
+{
+    receiverIo.writeFill += length;
+    if (receiverIo.writeFill == IO_WRITE_BUFFER_LEN)
+        ioFlushWrites();
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioFlushFile
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void ioFlushFile(int fd)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * writes out the data staged for fd and waits for its writes in flight, so a read of the file sees all of it
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void ioFlushFile(int fd)
+{
+    if (receiverIo.writeFill > 0 && receiverIo.writeFd == fd)
+        ioFlushWrites();
+#if defined(IO_RING_SUPPORTED)
+    if (receiverIo.engine == IO_ENGINE_URING)
+    {
+        for (int i = 0; i < IO_WRITE_BUFFERS; i++)
+        {
+            while (receiverIo.writeBusy[i] && receiverIo.writeFds[i] == fd)
+            {
+                if (ioRingWait() < 0 && errno != EINTR)
+                {
+                    logToFile(ERROR, NULL, "io_uring_enter error");
+                    exit(1);
+                }
+            }
+        }
+    }
+#endif
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioCloseFile
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Flushing split out into ioFlushFile
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void ioCloseFile(int fd)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * writes out the data staged for fd, waits for its writes in flight and closes it
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void ioCloseFile(int fd)
+{
+    ioFlushFile(fd);
+    close(fd);
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioClose
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Output files belong to the sessions and are closed with ioCloseFile
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void ioClose()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * sends the queued ACKs, writes the staged data, waits for everything in flight and releases the engine
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+void ioClose()
+{
+#if defined(__linux__)
+    ioFlushSends();
+    ioFlushWrites();
+    if (receiverIo.engine == IO_ENGINE_EPOLL)
+        close(receiverIo.epollFd);
+    #if defined(IO_RING_SUPPORTED)
+    if (receiverIo.engine == IO_ENGINE_URING)
+    {
+        while (receiverIo.inFlight > 0)
+        {
+            if (ioRingWait() < 0 && errno != EINTR)
+                break;
+        }
+        ioBufferRingDestroy(&receiverIo.ring, &receiverIo.recvRing);
+        ioRingDestroy(&receiverIo.ring);
+    }
+    #endif
+#endif
+    receiverIo.engine = IO_ENGINE_BLOCKING;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioFlushSends
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static void ioFlushSends()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * sends the queued ACKs with sendmmsg; io_uring sends are submitted with the next wait instead
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static void ioFlushSends()
+{
+#if defined(__linux__)
+    int sent = 0;
+
+    if (receiverIo.engine != IO_ENGINE_EPOLL)
+        return;
+    while (sent < receiverIo.sendCount)
+    {
+        int result = sendmmsg(receiverIo.sd, receiverIo.sendHeaders + sent, receiverIo.sendCount - sent, 0);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result < 0)
+        {
+            logToFile(ERROR, NULL, "sendto error");
+            exit(1);
+        }
+        sent += result;
+    }
+    receiverIo.sendCount = 0;
+#endif
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioFlushWrites
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Writes to the file the block was staged for
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static void ioFlushWrites()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * writes the staged block at its position in the file it was staged for; with io_uring it is queued as a fixed-buffer write and staging moves
+ * on to a free buffer, waiting for one if all are being written
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static void ioFlushWrites()
+{
+    if (receiverIo.writeFill == 0)
+        return;
+
+#if defined(IO_RING_SUPPORTED)
+    if (receiverIo.engine == IO_ENGINE_URING)
+    {
+        int current = receiverIo.writeCurrent;
+        struct io_uring_sqe* sqe = ioRingNextSqe();
+        ioRingPrepWriteFixed(sqe, receiverIo.writeFd, receiverIo.writeBuffers[current], (unsigned)receiverIo.writeFill, receiverIo.writeOffset, (uint16_t)current);
+        sqe->user_data = IO_USER_DATA(IO_TAG_WRITE, current);
+        receiverIo.writeBusy[current] = true;
+        receiverIo.writeFds[current] = receiverIo.writeFd;
+        receiverIo.writeOffsets[current] = receiverIo.writeOffset;
+        receiverIo.writeLengths[current] = receiverIo.writeFill;
+        receiverIo.inFlight++;
+        receiverIo.writeOffset += receiverIo.writeFill;
+        receiverIo.writeFill = 0;
+
+        while (receiverIo.writeBusy[receiverIo.writeCurrent])
+        {
+            for (int i = 1; i <= IO_WRITE_BUFFERS; i++)
+            {
+                if (!receiverIo.writeBusy[(current + i) % IO_WRITE_BUFFERS])
+                {
+                    receiverIo.writeCurrent = (current + i) % IO_WRITE_BUFFERS;
+                    break;
+                }
+            }
+            if (receiverIo.writeBusy[receiverIo.writeCurrent] && ioRingWait() < 0 && errno != EINTR)
+            {
+                logToFile(ERROR, NULL, "io_uring_enter error");
+                exit(1);
+            }
+        }
+        return;
+    }
+#endif
+
+    const char* data = receiverIo.writeBuffers[receiverIo.writeCurrent];
+    size_t length = receiverIo.writeFill;
+    receiverIo.writeFill = 0;
+    while (length > 0)
+    {
+        ssize_t written = pwrite(receiverIo.writeFd, data, length, receiverIo.writeOffset);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written < 0)
+        {
+            perror("could not write output file");
+            exit(1);
+        }
+        receiverIo.writeOffset += written;
+        data += written;
+        length -= written;
+    }
+}
+
+#if defined(IO_RING_SUPPORTED)
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRingStart
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static bool ioRingStart()
+ *
+ * RETURNS:        bool, false if io_uring or one of the features used is unavailable; nothing is left set up then
+ *
+ * NOTES:
+ * creates the ring, registers the write buffers and the receive buffer ring and arms the multishot recvmsg
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static bool ioRingStart()
+{
+    struct iovec writeVectors[IO_WRITE_BUFFERS];
+    struct io_uring_cqe* cqe;
+
+    if (ioRingInit(&receiverIo.ring, IO_RING_ENTRIES) < 0)
+        return false;
+
+    for (int i = 0; i < IO_WRITE_BUFFERS; i++)
+    {
+        writeVectors[i].iov_base = receiverIo.writeBuffers[i];
+        writeVectors[i].iov_len = IO_WRITE_BUFFER_LEN;
+    }
+    if (ioRingRegister(&receiverIo.ring, IORING_REGISTER_BUFFERS, writeVectors, IO_WRITE_BUFFERS) < 0
+        || ioBufferRingInit(&receiverIo.ring, &receiverIo.recvRing, IO_RECV_BUFFERS, IO_RECV_GROUP) < 0)
+    {
+        ioRingDestroy(&receiverIo.ring);
+        return false;
+    }
+    for (int i = 0; i < IO_RECV_BUFFERS; i++)
+        ioBufferRingAdd(&receiverIo.recvRing, receiverIo.recvArea[i], sizeof(receiverIo.recvArea[i]), (uint16_t)i, i);
+    ioBufferRingAdvance(&receiverIo.recvRing, IO_RECV_BUFFERS);
+
+    // kernels without multishot recvmsg reject it as soon as it is submitted
+    memset(&receiverIo.recvMsg, 0, sizeof(receiverIo.recvMsg));
+    receiverIo.recvMsg.msg_namelen = sizeof(struct sockaddr_in);
+    struct io_uring_sqe* sqe = ioRingGetSqe(&receiverIo.ring);
+    ioRingPrepRecvMsgMultishot(sqe, receiverIo.sd, &receiverIo.recvMsg, IO_RECV_GROUP);
+    sqe->user_data = IO_USER_DATA(IO_TAG_RECV, 0);
+    if (ioRingSubmit(&receiverIo.ring, 0) < 0
+        || ((cqe = ioRingPeekCqe(&receiverIo.ring)) != NULL && cqe->res < 0 && !(cqe->flags & IORING_CQE_F_MORE)))
+    {
+        ioBufferRingDestroy(&receiverIo.ring, &receiverIo.recvRing);
+        ioRingDestroy(&receiverIo.ring);
+        return false;
+    }
+    receiverIo.recvArmed = true;
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRingNextSqe
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static struct io_uring_sqe* ioRingNextSqe()
+ *
+ * RETURNS:        struct io_uring_sqe*, a free submission entry
+ *
+ * NOTES:
+ * submits what is queued when the submission ring is full
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static struct io_uring_sqe* ioRingNextSqe()
+{
+    struct io_uring_sqe* sqe;
+
+    while ((sqe = ioRingGetSqe(&receiverIo.ring)) == NULL)
+    {
+        int result = ioRingSubmit(&receiverIo.ring, 0);
+        if (result < 0 && result != -EINTR && result != -EAGAIN && result != -EBUSY)
+        {
+            logToFile(ERROR, NULL, "io_uring_enter error");
+            exit(1);
+        }
+        ioRingReap();
+    }
+    return sqe;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRingWait
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static int ioRingWait()
+ *
+ * RETURNS:        int, 0 once completions have been processed, -1 with errno set otherwise
+ *
+ * NOTES:
+ * re-arms the receive if it stopped, then submits everything queued and waits for a completion in one system call
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static int ioRingWait()
+{
+    // with every buffer still queued the receive would only fail with ENOBUFS again
+    if (!receiverIo.recvArmed && receiverIo.recvQueueCount < IO_RECV_BUFFERS)
+    {
+        struct io_uring_sqe* sqe = ioRingNextSqe();
+        ioRingPrepRecvMsgMultishot(sqe, receiverIo.sd, &receiverIo.recvMsg, IO_RECV_GROUP);
+        sqe->user_data = IO_USER_DATA(IO_TAG_RECV, 0);
+        receiverIo.recvArmed = true;
+    }
+    ioFlushWrites();
+
+    if (ioRingPeekCqe(&receiverIo.ring) == NULL)
+    {
+        int result = ioRingSubmit(&receiverIo.ring, 1);
+        if (result < 0)
+        {
+            errno = -result;
+            return -1;
+        }
+    }
+    ioRingReap();
+    return 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       ioRingReap
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - A short write is finished on the file it was queued for
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      static void ioRingReap()
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * processes every available completion: received buffers are queued for ioReceive, send and write slots are freed
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static void ioRingReap()
+{
+    struct io_uring_cqe* cqe;
+
+    while ((cqe = ioRingPeekCqe(&receiverIo.ring)) != NULL)
+    {
+        unsigned index = (uint32_t)cqe->user_data;
+        switch (cqe->user_data >> 32)
+        {
+            case IO_TAG_RECV:
+                if (cqe->res >= 0 && (cqe->flags & IORING_CQE_F_BUFFER))
+                {
+                    int tail = (receiverIo.recvQueueHead + receiverIo.recvQueueCount) % IO_RECV_BUFFERS;
+                    receiverIo.recvQueueIds[tail] = (uint16_t)(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+                    receiverIo.recvQueueLens[tail] = (unsigned)cqe->res;
+                    receiverIo.recvQueueCount++;
+                }
+                else if (cqe->res < 0 && cqe->res != -ENOBUFS)
+                    logToFile(ERROR, NULL, "recvmsg error %d", -cqe->res);
+                if (!(cqe->flags & IORING_CQE_F_MORE))
+                    receiverIo.recvArmed = false;
+                break;
+            case IO_TAG_SEND:
+                receiverIo.sendBusy[index] = false;
+                receiverIo.inFlight--;
+                if (cqe->res < 0)
+                    logToFile(ERROR, NULL, "sendmsg error %d", -cqe->res);
+                break;
+            case IO_TAG_WRITE:
+                receiverIo.writeBusy[index] = false;
+                receiverIo.inFlight--;
+                if (cqe->res < 0)
+                {
+                    errno = -cqe->res;
+                    perror("could not write output file");
+                    exit(1);
+                }
+                // a short write is finished synchronously
+                for (size_t done = cqe->res; done < receiverIo.writeLengths[index];)
+                {
+                    ssize_t written = pwrite(receiverIo.writeFds[index], receiverIo.writeBuffers[index] + done, receiverIo.writeLengths[index] - done, receiverIo.writeOffsets[index] + done);
+                    if (written < 0 && errno != EINTR)
+                    {
+                        perror("could not write output file");
+                        exit(1);
+                    }
+                    if (written > 0)
+                        done += written;
+                }
+                break;
+        }
+        ioRingCqeSeen(&receiverIo.ring);
+    }
+}
+#endif
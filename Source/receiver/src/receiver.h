@@ -1,13 +1,56 @@
 /*-----------------------------------------------------------------------------------------------------------------------------------
  * HEADER FILE:              receiver.h
  *
- * FUNCTION PROTOTYPES:      void flushBuffer(struct packet* buffer, long long *nextSeqNum, long long *newWindowSeqNum, int windowSize)
- *                           sendACK(int sd, struct packet *pkt, int pktSize, struct sockaddr_in *transmitter, socklen_t transmitterLen)
- *                           void saveData(char *data)
+ * FUNCTION PROTOTYPES:      void sendACK(struct receiverWorker* worker, const struct packet* pkt, const struct sockaddr_in* transmitter, socklen_t transmitterLen)
+ *                           bool saveData(struct receiverWorker* worker, const struct session* session, const struct packet* pkt)
+ *                           void handlePacket(struct receiverWorker* worker, packetHandle handle, const struct sockaddr_in* source, socklen_t sourceLen)
+ *                           void sendPacket(struct receiverWorker* worker, struct packet* pkt, const struct sockaddr_in* destination, socklen_t destinationLen)
+ *                           void acceptConnection(struct receiverWorker* worker, struct packet* pkt, const struct sockaddr_in* source, socklen_t sourceLen)
+ *                           struct transferResult endTransfer(struct receiverWorker* worker, struct session* session, const struct packet* eot)
+ *                           const struct transferResult* findFinished(const struct receiverWorker* worker, const struct session* session, int connectionId)
+ *                           struct session* findSession(struct receiverWorker* worker, int connectionId, bool create)
+ *                           bool openSession(struct receiverWorker* worker, struct session* session, int connectionId)
+ *                           bool openTransferFile(struct session* session, int transfer)
+ *                           void closeTransferFile(struct session* session, bool complete)
+ *                           void closeSession(struct receiverWorker* worker, struct session* session, bool complete)
+ *                           bool verifySession(const struct session* session, int64_t length, uint32_t checksum, uint32_t* computed)
+ *                           bool openResume(struct session* session, struct handshake* accepted)
+ *                           bool mapResume(struct session* session, int64_t chunks)
+ *                           void checkpointSession(struct session* session)
+ *                           void closeResume(struct session* session, bool complete)
+ *                           void workerInit(struct receiverWorker* worker, int id, bool threaded)
+ *                           void workerPost(struct receiverWorker* worker, packetHandle handle, const struct sockaddr_in* source, socklen_t sourceLen)
+ *                           void workerDrain(struct receiverWorker* worker)
+ *                           void workerStop(struct receiverWorker* worker)
+ *                           void* runWorker(void* arg)
+ *                           bool ioInit(int sd, enum ioEngine engine)
+ *                           int ioReceive(struct packet* pkt, struct sockaddr_in* source, socklen_t* sourceLen)
+ *                           void ioSend(const struct packet* pkt, int pktSize, const struct sockaddr_in* destination, socklen_t destinationLen)
+ *                           void ioWrite(int fd, const char* data, size_t length, off_t position)
+ *                           char* ioWriteSpace(int fd, size_t length, off_t position)
+ *                           void ioWriteCommit(size_t length)
+ *                           void ioFlushFile(int fd)
+ *                           void ioCloseFile(int fd)
+ *                           void ioClose()
+ *                           void requestLatencyDump(int signalNumber)
+ *                           void endLinger(int signalNumber)
+ *                           void recordInterArrival(uint64_t arrivalUs)
+ *                           void logJitterHistogram()
  *
  * DATE:                     December 3rd, 2020
  *
- * REVISIONS:                N/A
+ * REVISIONS:                October 18th, 2026 - Inter-arrival jitter histogram, dumped at EOT and on SIGUSR1
+ *                           October 18th, 2026 - Reorder buffer of packet pool handles
+ *                           October 18th, 2026 - Blocking, epoll and io_uring I/O engines
+ *                           October 18th, 2026 - Per-stream window state
+ *                           October 18th, 2026 - Sessions per connection id and the workers that own them
+ *                           October 18th, 2026 - Received byte ranges of a session replace its streams' reorder buffers
+ *                           October 18th, 2026 - Whole-file checksum verification at EOT
+ *                           October 18th, 2026 - Sessions opened by a SYN keep what was negotiated and receive one file
+ *                                                after another; results of ended files for repeated EOTs
+ *                           October 18th, 2026 - Progress files of resumable sessions and their checkpoints
+ *                           October 18th, 2026 - Each worker has a block to decompress DATA into when it cannot go
+ *                                                straight into the staged output
  *
  * DESIGNER:                 Maksym Chumak
  *
@@ -17,8 +60,11 @@
  * Header file containing constants and function prototypes for receiver.c
  * -----------------------------------------------------------------------------------------------------------------------------------*/
 
+#include <errno.h>
+#include <signal.h>
 #include <stdio.h>
 #include <time.h>
+#include <sys/time.h>
 #include <string.h>
 #include <stdlib.h>
 #include <sys/types.h>
@@ -27,11 +73,207 @@
 #include <strings.h>
 #include <unistd.h>
 #include <arpa/inet.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(__linux__)
+    #include <sys/epoll.h>
+#endif
 
 /*------------------------------------------------- Default Strings ---------------------------------------------------------------------*/
-#define OUTPUT_FILE_PATH	"./data/message.txt"
+#define SESSION_FILE_FORMAT	"./data/message-%d.txt"     // Output file of each connection id
+#define SESSION_TRANSFER_FILE_FORMAT	"./data/message-%d-%d.txt"  // Output of the second and later files of a connection
+#define RESUME_FILE_FORMAT	"./data/message-%d.resume"      // Progress of a connection granted FEATURE_RESUME
+
+/*------------------------------------------------- Symbolic Constants ------------------------------------------------------------------*/
+#define HISTOGRAM_SUMMARY_LEN   256     // Buffer length for a one-line histogram summary
+#define MAX_SESSIONS            32      // Sessions one worker has open at once
+#define CLOSED_SESSIONS         64      // Closed connections a worker remembers, so late DATA is dropped and repeated EOTs answered
+#define CLOSE_LINGER_MS         2000    // With -n, how long the receiver keeps answering repeated EOTs once no more arrive
+#define SESSION_IDLE_US         30000000    // A session silent this long gives up its slot when the table is full
+#define MAX_WORKERS             16
+#define WORKER_QUEUE_LEN        1024    // Datagrams waiting for one worker before the I/O thread blocks
+#define RECEIVER_POOL_PACKETS   (MAX_WORKERS * (WORKER_QUEUE_LEN + PACKET_POOL_CACHE_SIZE + 1) + PACKET_POOL_CACHE_SIZE + 1)   // Full queues, the slots each cache may hold, an ACK slot per worker and the receive slot
+#define VERIFY_BUFFER_LEN       65536   // Read size when checksumming a finished file
+#define RESUME_MAGIC            0x52534d31  // First word of a progress file
+#define RESUME_INITIAL_CHUNKS   65536   // Chunks the bitmap of a new progress file has room for; it doubles as needed
+#define RESUME_CHECKPOINT_BYTES 1048576 // Data a resumable session writes between checkpoints
+#define IO_BATCH_SIZE           32      // Datagrams received, or ACKs sent, per system call
+#define IO_WRITE_BUFFERS        4       // Output staging buffers, registered with the ring
+#define IO_WRITE_BUFFER_LEN     65536
+#define IO_RING_ENTRIES         64
+#define IO_RECV_BUFFERS         64      // Provided buffers for multishot recvmsg, a power of two
+#define IO_RECV_GROUP           0
+#define IO_TAG_RECV             0       // Completion kinds, in the upper half of user_data
+#define IO_TAG_SEND             1
+#define IO_TAG_WRITE            2
+
+/*------------------------------------------------- Macros ------------------------------------------------------------------------------*/
+#define IO_USER_DATA(tag, index)    (((uint64_t)(tag) << 32) | (uint32_t)(index))
+
+/*------------------------------------------------- Enums -------------------------------------------------------------------------------*/
+enum ioEngine
+{
+    IO_ENGINE_BLOCKING,                 // recvfrom, sendto and write per packet
+    IO_ENGINE_EPOLL,                    // epoll_wait, then recvmmsg; ACKs by sendmmsg, data written in blocks
+    IO_ENGINE_URING                     // Multishot recvmsg, sendmsg and fixed-buffer writes on one io_uring
+};
+
+/*------------------------------------------------- Structs -----------------------------------------------------------------------------*/
+// What the EOT_ACK of a file reports
+struct transferResult
+{
+    int transfer;                                   // -1 until the connection's first file ends
+    int64_t length;                                 // Contiguous bytes received
+    uint32_t checksum;                              // CRC32C of them as read back, 0 if not verified
+};
+
+// Start of a progress file, followed by a bitmap with a bit for each payloadLen chunk of the current file on disk
+struct resumeHeader
+{
+    uint32_t magic;
+    int transfer;                                   // File being received
+    int transfers;                                  // Files the connection carries
+    int payloadLen;                                 // Size of a chunk; a resumed connection keeps it
+    int64_t fileBase;                               // Offset 0 of the transfer in its output file
+    int64_t contiguous;                             // Bytes on disk from offset 0 at the last checkpoint
+    int64_t end;                                    // One past the furthest byte on disk at the last checkpoint
+    int64_t chunks;                                 // Bits the bitmap has room for
+};
+
+// One connection, named by the connection id its packets carry, receiving its files one after another
+struct session
+{
+    int connectionId;                               // 0 while the slot is free
+    struct handshake accepted;                      // Granted by the SYN_ACK, sent again for a repeated SYN
+    int transfer;                                   // File being received
+    struct transferResult finished;                 // Last file ended, for a repeated EOT
+    int fileFd;
+    off_t fileBase;                                 // End of the file when the session opened; offset 0 of the transfer
+    bool direct;                                    // Written with pwrite rather than through the I/O engine
+    uint64_t lastActiveUs;
+    long long packets;                              // DATA packets written
+    struct intervalSet received;                    // Byte ranges written so far, relative to fileBase
+    int resumeFd;                                   // Progress file, with FEATURE_RESUME
+    struct resumeHeader* resume;                    // Progress file mapped, NULL without FEATURE_RESUME
+    size_t resumeLen;                               // Bytes mapped
+    struct intervalSet pending;                     // Ranges written since the last checkpoint
+    int64_t pendingBytes;
+};
+
+struct closedSession
+{
+    int connectionId;
+    struct transferResult finished;
+};
+
+struct queuedPacket
+{
+    packetHandle handle;
+    struct sockaddr_in source;
+    socklen_t sourceLen;
+};
+
+// Owner of a share of the sessions; run on the I/O thread, or on its own thread fed through a queue
+struct receiverWorker
+{
+    int id;
+    bool threaded;                                  // Writes and ACKs bypass the I/O engine, which only the I/O thread uses
+    struct packetPoolCache cache;
+    struct packet* ack;                             // ACKs are built here
+    char block[COMPRESSED_BLOCK_LEN];               // Compressed DATA is expanded here when it is not staged
+    struct session sessions[MAX_SESSIONS];          // Probed from connectionId % MAX_SESSIONS
+    struct closedSession closed[CLOSED_SESSIONS];
+    int closedNext;                                 // Entry of closed overwritten next
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t ready;                           // Signalled when a datagram is queued or the worker is stopped
+    pthread_cond_t space;                           // Signalled when a datagram is taken or the queue runs dry
+    struct queuedPacket queue[WORKER_QUEUE_LEN];
+    int queueHead;
+    int queueCount;
+    bool busy;                                      // Set from taking a datagram until the queue runs dry
+    bool stopping;
+};
+
+struct receiverIo
+{
+    enum ioEngine engine;
+    int sd;
+    int writeFd;                                    // File the staged block belongs to
+    off_t writeOffset;                              // Where the staged block goes
+    char writeBuffers[IO_WRITE_BUFFERS][IO_WRITE_BUFFER_LEN];
+    size_t writeFill;                               // Bytes staged in writeBuffers[writeCurrent]
+    int writeCurrent;
+#if defined(__linux__)
+    int epollFd;
+    struct packet recvPackets[IO_BATCH_SIZE];
+    struct sockaddr_in recvSources[IO_BATCH_SIZE];
+    struct mmsghdr recvHeaders[IO_BATCH_SIZE];
+    struct iovec recvVectors[IO_BATCH_SIZE];
+    int recvCount;
+    int recvNext;
+    // ACKs waiting for sendmmsg; with io_uring, the slots of sendmsg requests in flight
+    struct packet sendPackets[IO_BATCH_SIZE];
+    struct sockaddr_in sendDestinations[IO_BATCH_SIZE];
+    struct mmsghdr sendHeaders[IO_BATCH_SIZE];
+    struct iovec sendVectors[IO_BATCH_SIZE];
+    int sendCount;
+#endif
+#if defined(IO_RING_SUPPORTED)
+    struct ioRing ring;
+    struct ioBufferRing recvRing;
+    unsigned char recvArea[IO_RECV_BUFFERS][sizeof(struct io_uring_recvmsg_out) + sizeof(struct sockaddr_in) + sizeof(struct packet)];
+    struct msghdr recvMsg;
+    bool recvArmed;
+    uint16_t recvQueueIds[IO_RECV_BUFFERS];         // Received buffers not yet handed to the main loop, oldest first
+    unsigned recvQueueLens[IO_RECV_BUFFERS];
+    int recvQueueHead;
+    int recvQueueCount;
+    bool sendBusy[IO_BATCH_SIZE];
+    bool writeBusy[IO_WRITE_BUFFERS];
+    int writeFds[IO_WRITE_BUFFERS];
+    off_t writeOffsets[IO_WRITE_BUFFERS];
+    size_t writeLengths[IO_WRITE_BUFFERS];
+    int inFlight;                                   // Sends and writes not yet completed
+#endif
+};
 
 /*------------------------------------------------- Funtion Prototypes ------------------------------------------------------------------*/
-void sendACK(int sd, struct packet* pkt, int pktSize, struct sockaddr_in* transmitter, socklen_t transmitterLen);
-void saveData(char* data);
-void flushBuffer(struct packet* buffer, long long* nextSeqNum, long long* newWindowSeqNum, int windowSize);
\ No newline at end of file
+void sendACK(struct receiverWorker* worker, const struct packet* pkt, const struct sockaddr_in* transmitter, socklen_t transmitterLen);
+bool saveData(struct receiverWorker* worker, const struct session* session, const struct packet* pkt);
+void handlePacket(struct receiverWorker* worker, packetHandle handle, const struct sockaddr_in* source, socklen_t sourceLen);
+void sendPacket(struct receiverWorker* worker, struct packet* pkt, const struct sockaddr_in* destination, socklen_t destinationLen);
+void acceptConnection(struct receiverWorker* worker, struct packet* pkt, const struct sockaddr_in* source, socklen_t sourceLen);
+struct transferResult endTransfer(struct receiverWorker* worker, struct session* session, const struct packet* eot);
+const struct transferResult* findFinished(const struct receiverWorker* worker, const struct session* session, int connectionId);
+struct session* findSession(struct receiverWorker* worker, int connectionId, bool create);
+bool openSession(struct receiverWorker* worker, struct session* session, int connectionId);
+bool openTransferFile(struct session* session, int transfer);
+void closeTransferFile(struct session* session, bool complete);
+void closeSession(struct receiverWorker* worker, struct session* session, bool complete);
+bool verifySession(const struct session* session, int64_t length, uint32_t checksum, uint32_t* computed);
+bool openResume(struct session* session, struct handshake* accepted);
+bool mapResume(struct session* session, int64_t chunks);
+void checkpointSession(struct session* session);
+void closeResume(struct session* session, bool complete);
+void workerInit(struct receiverWorker* worker, int id, bool threaded);
+void workerPost(struct receiverWorker* worker, packetHandle handle, const struct sockaddr_in* source, socklen_t sourceLen);
+void workerDrain(struct receiverWorker* worker);
+void workerStop(struct receiverWorker* worker);
+void* runWorker(void* arg);
+void requestLatencyDump(int signalNumber);
+void endLinger(int signalNumber);
+void recordInterArrival(uint64_t arrivalUs);
+void logJitterHistogram();
+bool ioInit(int sd, enum ioEngine engine);
+int ioReceive(struct packet* pkt, struct sockaddr_in* source, socklen_t* sourceLen);
+void ioSend(const struct packet* pkt, int pktSize, const struct sockaddr_in* destination, socklen_t destinationLen);
+void ioWrite(int fd, const char* data, size_t length, off_t position);
+char* ioWriteSpace(int fd, size_t length, off_t position);
+void ioWriteCommit(size_t length);
+void ioFlushFile(int fd);
+void ioCloseFile(int fd);
+void ioClose();
\ No newline at end of file
@@ -0,0 +1,259 @@
+/*-----------------------------------------------------------------------------------------------------------------------------------
+ * HEADER FILE:              timingwheel.h
+ *
+ * FUNCTIONS:                bool timingWheelInit(struct timingWheel* wheel, int capacity, uint64_t nowUs)
+ *                           void timingWheelDestroy(struct timingWheel* wheel)
+ *                           void timingWheelSchedule(struct timingWheel* wheel, int id, uint64_t deadlineUs)
+ *                           void timingWheelCancel(struct timingWheel* wheel, int id)
+ *                           int timingWheelExpire(struct timingWheel* wheel, uint64_t nowUs, int* expired, int maxExpired)
+ *
+ * DATE:                     October 18th, 2026
+ *
+ * REVISIONS:                N/A
+ *
+ * DESIGNER:                 Derek Wong
+ *
+ * PROGRAMMER:               Derek Wong
+ *
+ * NOTES:
+ * Header file containing a hashed timing wheel of one-shot timers, named by small integer ids chosen by the caller.
+ * Time is cut into ticks of TIMING_WHEEL_TICK_US; a timer hangs off the slot of its deadline tick modulo
+ * TIMING_WHEEL_SLOTS, so scheduling and cancelling are O(1) and expiring only visits the slots of the ticks that have
+ * passed. Deadlines further out than one turn of the wheel share a slot with nearer ones and are skipped until their
+ * own turn comes round.
+ * ----------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/*------------------------------------------------ Symbolic Constants ---------------------------------------------------------------*/
+#define TIMING_WHEEL_TICK_US        1000                            // 1 ms per slot
+#define TIMING_WHEEL_SLOTS          512                             // Power of two; one turn is 512 ms
+#define TIMING_WHEEL_NONE           -1
+
+/*------------------------------------------------ Structs --------------------------------------------------------------------------*/
+struct timingWheelTimer
+{
+    uint64_t deadlineTick;
+    int next;                       // Timers of one slot form a doubly linked list of ids
+    int prev;
+    int slot;                       // TIMING_WHEEL_NONE while the timer is not armed
+};
+
+struct timingWheel
+{
+    struct timingWheelTimer* timers;
+    int capacity;
+    int armed;
+    uint64_t cursorTick;            // Oldest tick whose slot may still hold expired timers
+    int heads[TIMING_WHEEL_SLOTS];
+};
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       timingWheelInit
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool timingWheelInit(struct timingWheel* wheel, int capacity, uint64_t nowUs)
+ *
+ * RETURNS:        bool, false if the timers could not be allocated
+ *
+ * NOTES:
+ * Prepares a wheel for timer ids 0 to capacity - 1, all disarmed
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline bool timingWheelInit(struct timingWheel* wheel, int capacity, uint64_t nowUs)
+{
+    wheel->timers = (struct timingWheelTimer*)malloc(sizeof(struct timingWheelTimer) * (size_t)capacity);
+    if (wheel->timers == NULL)
+    {
+        wheel->capacity = 0;
+        return false;
+    }
+    wheel->capacity = capacity;
+    wheel->armed = 0;
+    wheel->cursorTick = nowUs / TIMING_WHEEL_TICK_US;
+    for (int i = 0; i < capacity; i++)
+    {
+        wheel->timers[i].slot = TIMING_WHEEL_NONE;
+    }
+    for (int i = 0; i < TIMING_WHEEL_SLOTS; i++)
+    {
+        wheel->heads[i] = TIMING_WHEEL_NONE;
+    }
+    return true;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       timingWheelDestroy
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void timingWheelDestroy(struct timingWheel* wheel)
+ *
+ * RETURNS:        void
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void timingWheelDestroy(struct timingWheel* wheel)
+{
+    free(wheel->timers);
+    wheel->timers = NULL;
+    wheel->capacity = 0;
+    wheel->armed = 0;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       timingWheelCancel
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void timingWheelCancel(struct timingWheel* wheel, int id)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Disarms the timer; does nothing if it is not armed
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void timingWheelCancel(struct timingWheel* wheel, int id)
+{
+    struct timingWheelTimer* timer = &wheel->timers[id];
+
+    if (timer->slot == TIMING_WHEEL_NONE)
+    {
+        return;
+    }
+    if (timer->prev != TIMING_WHEEL_NONE)
+    {
+        wheel->timers[timer->prev].next = timer->next;
+    }
+    else
+    {
+        wheel->heads[timer->slot] = timer->next;
+    }
+    if (timer->next != TIMING_WHEEL_NONE)
+    {
+        wheel->timers[timer->next].prev = timer->prev;
+    }
+    timer->slot = TIMING_WHEEL_NONE;
+    wheel->armed--;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       timingWheelSchedule
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void timingWheelSchedule(struct timingWheel* wheel, int id, uint64_t deadlineUs)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Arms the timer, replacing its deadline if it was already armed. A deadline in the past expires on the next call to
+ * timingWheelExpire.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline void timingWheelSchedule(struct timingWheel* wheel, int id, uint64_t deadlineUs)
+{
+    struct timingWheelTimer* timer = &wheel->timers[id];
+    uint64_t deadlineTick = deadlineUs / TIMING_WHEEL_TICK_US;
+
+    timingWheelCancel(wheel, id);
+    if (deadlineTick < wheel->cursorTick)
+    {
+        deadlineTick = wheel->cursorTick;
+    }
+    timer->deadlineTick = deadlineTick;
+    timer->slot = (int)(deadlineTick & (TIMING_WHEEL_SLOTS - 1));
+    timer->prev = TIMING_WHEEL_NONE;
+    timer->next = wheel->heads[timer->slot];
+    if (timer->next != TIMING_WHEEL_NONE)
+    {
+        wheel->timers[timer->next].prev = id;
+    }
+    wheel->heads[timer->slot] = id;
+    wheel->armed++;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       timingWheelExpire
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int timingWheelExpire(struct timingWheel* wheel, uint64_t nowUs, int* expired, int maxExpired)
+ *
+ * RETURNS:        int, the number of ids written to expired
+ *
+ * NOTES:
+ * Disarms up to maxExpired timers whose deadline has passed, oldest tick first, and stores their ids in expired.
+ * Timers left over when maxExpired is reached stay armed and come out of the next call, which lets the caller spread
+ * a burst of expiries over several calls.
+ * ----------------------------------------------------------------------------------------------------------------------------*/
+static inline int timingWheelExpire(struct timingWheel* wheel, uint64_t nowUs, int* expired, int maxExpired)
+{
+    uint64_t nowTick = nowUs / TIMING_WHEEL_TICK_US;
+    int count = 0;
+
+    if (wheel->armed == 0)
+    {
+        // Nothing to visit; jump straight to the present
+        if (nowTick > wheel->cursorTick) wheel->cursorTick = nowTick;
+        return 0;
+    }
+    while (wheel->cursorTick <= nowTick)
+    {
+        int id = wheel->heads[wheel->cursorTick & (TIMING_WHEEL_SLOTS - 1)];
+        while (id != TIMING_WHEEL_NONE)
+        {
+            int next = wheel->timers[id].next;
+            if (wheel->timers[id].deadlineTick <= wheel->cursorTick)
+            {
+                if (count == maxExpired)
+                {
+                    return count;
+                }
+                timingWheelCancel(wheel, id);
+                expired[count++] = id;
+            }
+            id = next;
+        }
+        if (wheel->cursorTick == nowTick)
+        {
+            break;
+        }
+        wheel->cursorTick++;
+    }
+    return count;
+}
+
+#endif
@@ -9,12 +9,36 @@
 --					int getUnACKCount(struct node* head);
 --					void freeUnACKs(struct node** headRef);
 --					void printUnACKs(struct node* node);
---					void retransmitUnACKs(int socketFileDescriptor, struct packet* arrPackets, struct node* head, int packetSize, struct sockaddr_in* receiver, socklen_t receiverLen);
---					void updateTimeoutInterval(int* timeoutInterval, int* sampleRTT, struct timeval* start, struct timeval* end, int* estimatedRTT, int* devRTT);
+--					int retransmitExpired(int socketFileDescriptor, struct packet* arrPackets, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen);
+--					void retransmitPacket(int socketFileDescriptor, struct packet* arrPackets, int index, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen);
+--					void armRetransmitTimer(struct transmissions* sent, int index, int timeoutInterval);
+--					void updateTimeoutInterval(int* timeoutInterval, int sampleRTT, int* estimatedRTT, int* devRTT);
+--					void pacerInit(struct pacer* pacer, int socketFileDescriptor);
+--					uint64_t pacerGap(const struct pacer* pacer, int windowSize, int estimatedRTT, bool rttMeasured, int packetSize);
+--					ssize_t pacedSend(int socketFileDescriptor, struct pacer* pacer, const struct packet* pkt, uint64_t gapUs, struct sockaddr_in* receiver, socklen_t receiverLen);
+--					void requestLatencyDump(int signalNumber);
+--					void logRTTHistogram(int streamId, const struct histogram* rttHistogram);
+--					int fastRetransmit(int socketFileDescriptor, struct packet* arrPackets, struct node* head, int ackNum, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen);
+--					void* sendStream(void* arg);
+--					bool exchangeControl(struct stream* stream, struct packet* request, enum PacketType replyType, int timeoutInterval, uint64_t* rttUs);
+--					ssize_t readCompressed(struct stream* stream, struct packet* pkt);
 --
 --	DATE:			December 3, 2020
 --
---	REVISIONS:		N/A
+--	REVISIONS:		October 18th, 2026 - Per-packet RTT histogram, dumped at EOT and on SIGUSR1
+--					October 18th, 2026 - Options for the maximum window size; retransmits are counted
+--					October 18th, 2026 - ACK and EOT packets come from the shared packet pool
+--					October 18th, 2026 - Fast retransmit of a packet once three later packets are ACKed
+--					October 18th, 2026 - Per-packet retransmission timers in a timing wheel replace the resend-all timeout
+--					October 18th, 2026 - DATA packets of a window are paced instead of sent back to back
+--					October 18th, 2026 - The file is sent as binary chunks by one or more parallel streams
+--					October 18th, 2026 - Every packet carries a connection id so one receiver can take several transfers at once
+--					October 18th, 2026 - Every packet carries a CRC32C and the EOT the CRC32C of the whole file
+--					October 18th, 2026 - SYN/SYN_ACK handshake negotiates the window, payload length and features;
+--										 the EOT is resent on a timer until the receiver's EOT_ACK; several files per connection
+--					October 18th, 2026 - -c names the connection; a resumed connection skips what the receiver already has
+--					October 18th, 2026 - -z compresses DATA payloads, several payload lengths of the file to a packet
+--					October 18th, 2026 - Datagrams carry only the data in use, so compressing any payload saves bytes
 
 --
 --	DESIGNERS:		Derek Wong
@@ -25,22 +49,80 @@
 -- The program will establish a TCP connection to a user specifed network emulator and file.
 -- The server can be specified using an IP address.  File has to be specified with full path.
 -- With no arguments, the server will default configurations, as with the file.
+-- Usage: transmitter [-w maxWindowSize] [-p off|timer|txtime] [-r rateKbps] [-s streams] [-l payloadLen] [-c connectionId] [-z] [hostName] [fileName...]
 -- The program will transmit a file's contents in packets windows.  Then wait for ACKs.
--- If all ACKs in a window arrive before the calculated timeout interval value, 
---	send new window with adjusted timeout values and data
--- If not, transmitter will selectively retransmit all DATA packets that haven't been ACKed
--- Once the file contents is successfully received, send EOT packet to terminate connection
+-- With -s the file is cut into that many byte ranges, each sent by its own thread and socket with its own window,
+--	timers and pacer (and -r rate); every packet carries its stream id and file offset, and the receiver writes it there
+-- Every packet of a transfer, EOT included, carries a random connection id; the receiver keeps a session per id and
+--	writes each to its own file, so several transmitters can send to it at once. Should another transmitter hold the
+--	well-known port, the first stream binds any free one instead
+-- Once all ACKs in a window arrive, send new window with adjusted timeout values and data
+-- The packets of a window are spread over part of the estimated RTT (or sent at a fixed -r rate): with -p timer, the default,
+--	the transmitter sleeps until each departure time; with -p txtime the departure time goes to the kernel with
+--	SO_TXTIME and an fq or etf qdisc on the interface holds the packet until then
+-- Every DATA packet has its own retransmission timer, doubled each time the packet is resent; a packet is resent
+--	when its timer expires, at most RETRANSMIT_BURST per pass of the main loop so resends are spread out
+-- A DATA packet still unACKed once DUP_ACK_THRESHOLD later packets have been ACKed is presumed lost and resent
+--	on its own right away, without waiting for the timeout
+-- The connection opens with a SYN proposing the maximum window size, payload length (-l), stream count and features;
+--	the receiver's SYN_ACK answers with what it accepts, no more than was proposed, and the transfer uses that. The
+--	SYN's round trip seeds the RTT estimate of every stream
+-- Once the file contents is successfully received, send EOT packet to end the file. The EOT is resent on a doubling
+--	timer until the receiver's EOT_ACK, which confirms the file's length and checksum; a connection given more than
+--	one file sends them one after the other, each ended by its own EOT, without opening a new one
+-- The RTT of every packet ACKed on its first transmission is recorded in a latency histogram per stream;
+--	the percentiles of all streams are logged after the EOT is sent, or of each stream at any time with kill -USR1 <pid>
+-- With -c the connection id is given instead of picked at random, so a transfer cut short can be started again under the
+--	id it had, logged when it began. The SYN asks to resume; a receiver that kept the connection's progress answers with
+--	the file it is on and the byte ranges of it already on its disk: earlier files are skipped, and the streams still
+--	read the ranges received, for the file's checksum, but send only the rest
+-- With -z the SYN proposes FEATURE_COMPRESSION. Once granted, each stream reads up to COMPRESSED_BLOCK_CHUNKS payload
+--	lengths of its range at a time and sends them as one LZ4 block if it fits in a payload, trying half as many until
+--	one does. Only the header and the dataLen bytes in use are sent, so a single payload length is kept compressed
+--	whenever it comes out shorter: any shrink saves bandwidth, and spans that fit several payload lengths into one
+--	packet save packets too, retransmissions included. Data that does not shrink at all goes out as it is, the stream
+--	backing off from trying for longer each time. Blocks are independent, so a lost packet costs nothing but itself
+-- Every packet is sealed with a CRC32C of its contents and ACKs failing theirs are ignored like lost ones; each stream
+--	checksums its range as it reads it, and the EOT carries the file length and the streams' checksums combined into
+--	the file's, for the receiver to check what it wrote
  * ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------*/
 #include "../../common.h"
 #include "../../logger.h"
+#include "../../histogram.h"
+#include "../../packetpool.h"
+#include "../../timingwheel.h"
+#include "../../intervalset.h"
+#include "../../lz4block.h"
 #include "transmitter.h"
 
+static volatile sig_atomic_t latencyDumpGeneration = 0;
+
  /*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * FUNCTION:       main
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Records per-packet RTTs (Karn's rule) into a histogram
+ *                 October 18th, 2026 - Options are parsed with getopt ahead of the positional arguments;
+ *                                      logs a transfer summary line for scripts
+ *                 October 18th, 2026 - ACK and EOT packets are pool slots instead of separate allocations
+ *                 October 18th, 2026 - Fast retransmit on ACK gaps; the window is halved once per window sent
+ *                 October 18th, 2026 - Only packets whose own retransmission timer expired are resent; the timeout
+ *                                      interval is estimated from per-packet RTT samples
+ *                 October 18th, 2026 - Paces the DATA packets of each window; -p and -r options; retransmission
+ *                                      timers are checked only when no ACK is waiting
+ *                 October 18th, 2026 - Splits the file into byte ranges sent by -s streams, each on its own thread;
+ *                                      the sending loop moved to sendStream
+ *                 October 18th, 2026 - Picks the connection id of the transfer; the first stream falls back to any
+ *                                      free port when the well-known one is taken
+ *                 October 18th, 2026 - The EOT carries the file length and CRC32C, combined from those of the streams
+ *                 October 18th, 2026 - Opens the connection with a SYN handshake; -l option; sends each file given
+ *                                      in turn, waiting for the receiver's EOT_ACK of each instead of repeating the EOT
+ *                 October 18th, 2026 - -c option; resumes where the receiver's SYN_ACK says the connection stopped
+ *                 October 18th, 2026 - -z option proposes compression; compressed packets are counted
+ *                 October 18th, 2026 - The summary counts the DATA packets the streams sent, not payload lengths
+ *                 October 18th, 2026 - Closes the sockets of streams the SYN_ACK refused
+ *                 October 18th, 2026 - Opens the log file before anything can log
  *
  * DESIGNER:       Derek Wong
  *
@@ -57,30 +139,113 @@ int main(int argc, char** argv)
 {
 	const char* const programName = argv[0];
 	const char* host = NULL;
-	char const* fileName = DATA_FILE_PATH;
-
-	FILE* dataFP = NULL;
+	const char* defaultFileName = DATA_FILE_PATH;
+	const char* const* fileNames = &defaultFileName;
 
 	int	port = NETWORK_EMULATOR_PORT;
-	int windowSize = INITIAL_WINDOW_SIZE, seqNum = INITIAL_SEQ_NUM, packetSize = sizeof(struct packet);
-	int timeoutInterval = DEFAULT_ESTIMATED_RTT + 4 * DEFAULT_DEV_RTT, estimatedRTT = DEFAULT_ESTIMATED_RTT, devRTT = DEFAULT_DEV_RTT, sampleRTT = 0;
-	int	socketFileDescriptor =	0;
-
-	struct node* unACKHead = NULL;
+	int maxWindowSize = MAX_WINDOW_SIZE, streamCount = 1, payloadLen = PAYLOAD_LEN, fileCount = 1, opt;
+	int connectionId = 0, resumeTransfer = 0, skipped = 0;
+	int fileFds[MAX_FILES];
+	int64_t packetsSent = 0, resumedBytes = 0;
+	struct intervalSet resumed;
+	struct resumeRange ranges[RESUME_RANGES];
+	int rangeCount;
 
 	struct hostent* hp;
 	struct sockaddr_in receiver, transmitter;
-	struct timeval start, end, readTimeout;
+	struct stat fileStats[MAX_FILES];
+	struct timeval readTimeout;
 	readTimeout.tv_sec = 0;
 	readTimeout.tv_usec = DEFAULT_READ_TIMEOUT;
 
-	struct packet arrPackets[MAX_READ_SIZE];
-	struct packet* arrPacketsPtr;
-	arrPacketsPtr = &arrPackets[0];
+	// The stream threads share the log file, so it is opened before any of them start
+	openLog();
 
-	struct packet* ACKPacketPtr = malloc(packetSize);
+	static struct packetPool packetPool;
+	struct packetPoolCache packetCache;
+	packetPoolInit(&packetPool, TRANSMITTER_POOL_PACKETS);
+	packetPoolCacheInit(&packetCache, &packetPool);
+	packetHandle controlHandle = packetPoolAlloc(&packetCache);
+	if (controlHandle == PACKET_HANDLE_NONE)
+	{
+		logToFile(ERROR, NULL, "packet pool exhausted");
+		exit(1);
+	}
 
-	socklen_t receiverLen;
+	static struct stream streams[MAX_STREAMS];
+	static struct histogram rttHistogram;
+	struct sigaction dumpAction;
+	struct pacer pacer = { PacingTimer, 0, 0 };
+	struct handshake proposal, accepted;
+	int retransmits = 0, fastRetransmits = 0, compressedPackets = 0, verified = 0;
+	bool compress = false;
+	uint64_t handshakeRttUs = 0;
+
+	// Get user options
+	while ((opt = getopt(argc, argv, "w:p:r:s:l:c:z")) != -1)
+	{
+		switch (opt)
+		{
+			case 'w':
+				maxWindowSize = atoi(optarg);
+				if (maxWindowSize < INITIAL_WINDOW_SIZE || maxWindowSize > MAX_READ_SIZE)
+				{
+					logToFile(ERROR, NULL, "Maximum window size must be between %d and %d", INITIAL_WINDOW_SIZE, MAX_READ_SIZE);
+					exit(1);
+				}
+				break;
+			case 'p':
+				if (strcmp(optarg, "off") == 0) pacer.mode = PacingOff;
+				else if (strcmp(optarg, "timer") == 0) pacer.mode = PacingTimer;
+				else if (strcmp(optarg, "txtime") == 0) pacer.mode = PacingTxTime;
+				else
+				{
+					logToFile(ERROR, NULL, "Pacing must be off, timer or txtime");
+					exit(1);
+				}
+				break;
+			case 'r':
+				pacer.rateKbps = atoi(optarg);
+				if (pacer.rateKbps < 0)
+				{
+					logToFile(ERROR, NULL, "Pacing rate must be positive, or 0 to pace over the RTT");
+					exit(1);
+				}
+				break;
+			case 's':
+				streamCount = atoi(optarg);
+				if (streamCount < 1 || streamCount > MAX_STREAMS)
+				{
+					logToFile(ERROR, NULL, "Number of streams must be between 1 and %d", MAX_STREAMS);
+					exit(1);
+				}
+				break;
+			case 'l':
+				payloadLen = atoi(optarg);
+				if (payloadLen < 1 || payloadLen > PAYLOAD_LEN)
+				{
+					logToFile(ERROR, NULL, "Payload length must be between 1 and %d", PAYLOAD_LEN);
+					exit(1);
+				}
+				break;
+			case 'c':
+				connectionId = atoi(optarg);
+				if (connectionId < 1)
+				{
+					logToFile(ERROR, NULL, "Connection id must be positive");
+					exit(1);
+				}
+				break;
+			case 'z':
+				compress = true;
+				break;
+			default:
+				logToFile(ERROR, NULL, "Usage: %s [-w maxWindowSize] [-p off|timer|txtime] [-r rateKbps] [-s streams] [-l payloadLen] [-c connectionId] [-z] [hostName] [fileName...]", programName);
+				exit(1);
+		}
+	}
+	argc -= optind - 1;
+	argv += optind - 1;
 
 	// Get user parameters
 	switch (argc)
@@ -105,7 +270,12 @@ int main(int argc, char** argv)
 			}
 			logToFile(INFO, NULL, "Host found: %s", host);
 			break;
-		case 3: // User specifies two arguments
+		default: // User specifies the host and one or more files, sent one after the other
+			if (argc - 2 > MAX_FILES)
+			{
+				logToFile(ERROR, NULL, "At most %d files can be sent at once", MAX_FILES);
+				exit(1);
+			}
 			// Get receiver IP either using FQDN or IP address
 			host = argv[1];
 			if ((hp = gethostbyname(host)) == NULL)
@@ -114,124 +284,410 @@ int main(int argc, char** argv)
 				exit(1);
 			}
 			logToFile(INFO, NULL, "Host found: %s", host);
-
-			// Verify file is valid
-			dataFP = fopen(argv[2], "r");
-			if (dataFP != NULL)
-			{
-				fclose(dataFP);
-				fileName = argv[2];
-			}
-			else
-			{
-				logToFile(ERROR, NULL, "File: %s could not be opened", argv[2]);
-				exit(1);
-			}
+			fileNames = (const char* const*)&argv[2];
+			fileCount = argc - 2;
 			break;
-		default:
-			logToFile(ERROR, NULL, "Usage: %s [hostName] [fileName]", programName);
-			exit(1);
 	}
 
-	// Create a datagram socket
-	if ((socketFileDescriptor = socket(AF_INET, SOCK_DGRAM, 0)) == -1)
+	// Verify the files are valid before connecting; the streams read their ranges of them with pread
+	for (int t = 0; t < fileCount; t++)
 	{
-		logToFile(ERROR, NULL, "Can't create a socket\n");
-		exit(1);
+		if ((fileFds[t] = open(fileNames[t], O_RDONLY)) == -1 || fstat(fileFds[t], &fileStats[t]) == -1)
+		{
+			logToFile(ERROR, NULL, "File: %s could not be opened", fileNames[t]);
+			exit(1);
+		}
 	}
 
+	// Dump RTT percentiles on demand
+	memset(&dumpAction, 0, sizeof(dumpAction));
+	dumpAction.sa_handler = requestLatencyDump;
+	sigemptyset(&dumpAction.sa_mask);
+	dumpAction.sa_flags = SA_RESTART;
+	sigaction(SIGUSR1, &dumpAction, NULL);
+
 	// Store receiver's information
 	bzero((char*)&receiver, sizeof(receiver));
 	receiver.sin_family = AF_INET;
 	receiver.sin_port = htons(port);
-	receiverLen = sizeof(receiver);
 
 	logToFile(INFO, NULL, "The network emulator's port is: %d", port);
 	bcopy(hp->h_addr, (char*)&receiver.sin_addr, hp->h_length);
 
-	// Set Socket Options
-	if (setsockopt(socketFileDescriptor, SOL_SOCKET, SO_RCVTIMEO, &readTimeout, sizeof(readTimeout)) < 0)
+	// Any non-zero id will do; it only has to differ from those of other connections the receiver has open
+	if (connectionId == 0)
 	{
-		logToFile(ERROR, NULL, "setsockopt failed");
-		exit(1);
+		srand((unsigned)time(NULL) ^ ((unsigned)getpid() << 16) ^ (unsigned)monotonicUs());
+		connectionId = rand() % INT_MAX + 1;
 	}
+	logToFile(INFO, NULL, "Connection id: %d", connectionId);
 
-	// Bind local address to the socket on transmitter
-	bzero((char*)&transmitter, sizeof(transmitter));
-	transmitter.sin_family = AF_INET;
-	transmitter.sin_port = htons(TRANSMITTER_PORT);
-	transmitter.sin_addr.s_addr = htonl(INADDR_ANY);
+	for (int i = 0; i < streamCount; i++)
+	{
+		struct stream* stream = &streams[i];
 
-	if (bind(socketFileDescriptor, (struct sockaddr*)&transmitter, sizeof(transmitter)) == -1)
+		stream->id = i;
+		stream->connectionId = connectionId;
+		stream->receiver = receiver;
+		stream->receiverLen = sizeof(receiver);
+		stream->pacer = pacer;
+
+		packetHandle ACKHandle = packetPoolAlloc(&packetCache);
+		if (ACKHandle == PACKET_HANDLE_NONE)
+		{
+			logToFile(ERROR, NULL, "packet pool exhausted");
+			exit(1);
+		}
+		stream->ACKPacket = packetPoolGet(&packetPool, ACKHandle);
+
+		if (!timingWheelInit(&stream->sent.wheel, MAX_READ_SIZE, monotonicUs()))
+		{
+			logToFile(ERROR, NULL, "Can't allocate retransmission timers");
+			exit(1);
+		}
+		histogramInit(&stream->rttHistogram);
+
+		// Create a datagram socket
+		if ((stream->socketFileDescriptor = socket(AF_INET, SOCK_DGRAM, 0)) == -1)
+		{
+			logToFile(ERROR, NULL, "Can't create a socket\n");
+			exit(1);
+		}
+
+		// Set Socket Options
+		if (setsockopt(stream->socketFileDescriptor, SOL_SOCKET, SO_RCVTIMEO, &readTimeout, sizeof(readTimeout)) < 0)
+		{
+			logToFile(ERROR, NULL, "setsockopt failed");
+			exit(1);
+		}
+
+		pacerInit(&stream->pacer, stream->socketFileDescriptor);
+
+		// Bind local address to the socket on transmitter; the first stream keeps the well-known port, the
+		// others take any free one and the emulator learns it from their DATA packets
+		bzero((char*)&transmitter, sizeof(transmitter));
+		transmitter.sin_family = AF_INET;
+		transmitter.sin_port = htons(i == 0 ? TRANSMITTER_PORT : 0);
+		transmitter.sin_addr.s_addr = htonl(INADDR_ANY);
+
+		if (bind(stream->socketFileDescriptor, (struct sockaddr*)&transmitter, sizeof(transmitter)) == -1)
+		{
+			// Another transfer is running from this host; the emulator learns this port like the others
+			transmitter.sin_port = htons(0);
+			if (errno != EADDRINUSE || bind(stream->socketFileDescriptor, (struct sockaddr*)&transmitter, sizeof(transmitter)) == -1)
+			{
+				logToFile(ERROR, NULL, "Can't bind name to socket");
+				exit(1);
+			}
+			logToFile(INFO, NULL, "Port %d is in use, stream %d sends from another port", TRANSMITTER_PORT, i);
+		}
+	}
+
+	// Open the connection: the receiver answers the proposal with what it accepts of it
+	struct packet* control = packetPoolGet(&packetPool, controlHandle);
+	struct packet* reply = streams[0].ACKPacket;
+	proposal.version = PROTOCOL_VERSION;
+	proposal.maxWindowSize = maxWindowSize;
+	proposal.payloadLen = payloadLen;
+	proposal.streams = streamCount;
+	proposal.transfers = fileCount;
+	proposal.features = compress ? SUPPORTED_FEATURES : (SUPPORTED_FEATURES & ~FEATURE_COMPRESSION);
+	control->connectionId = connectionId;
+	control->transfer = 0;
+	makePacket(control, SYN);
+	setHandshake(control, &proposal);
+	sealPacket(control);
+	logToFile(INFO, NULL, "Sending SYN");
+	if (!exchangeControl(&streams[0], control, SYN_ACK, DEFAULT_ESTIMATED_RTT, &handshakeRttUs))
 	{
-		logToFile(ERROR, NULL, "Can't bind name to socket");
+		logToFile(ERROR, NULL, "No answer from the receiver");
 		exit(1);
 	}
-
-	logToFile(INFO, NULL, "Sending data in file path: %s", DATA_FILE_PATH);
-	if (sizeof(arrPackets) > MAX_BUF_LEN)
+	if (!getHandshake(reply, &accepted) || accepted.version != PROTOCOL_VERSION
+		|| accepted.maxWindowSize < INITIAL_WINDOW_SIZE || accepted.maxWindowSize > maxWindowSize
+		|| accepted.payloadLen < 1 || accepted.payloadLen > payloadLen
+		|| accepted.streams < 1 || accepted.streams > streamCount || accepted.transfers != fileCount
+		|| ((accepted.features & FEATURE_RESUME) && (reply->transfer < 0 || reply->transfer >= fileCount)))
 	{
-		logToFile(ERROR, NULL, "Loaded Data is larger than buffer size");
+		logToFile(ERROR, NULL, "Receiver refused the connection");
 		exit(1);
 	}
 
-	// Store all the file data in an array of structs
-	int lineCounter = 0;
-	int totalLines = 0;
+	// Where the receiver says the connection stopped, read before the reply slot is reused
+	intervalSetInit(&resumed);
+	if (accepted.features & FEATURE_RESUME)
+	{
+		resumeTransfer = reply->transfer;
+		rangeCount = getResumeRanges(reply, ranges, RESUME_RANGES);
+		for (int r = 0; r < rangeCount; r++)
+		{
+			if (ranges[r].start >= 0 && ranges[r].start < ranges[r].end && !intervalSetAdd(&resumed, ranges[r].start, ranges[r].end))
+			{
+				logToFile(ERROR, NULL, "Can't allocate the resumed ranges");
+				exit(1);
+			}
+		}
+		if (resumeTransfer > 0 || resumed.count > 0)
+			logToFile(INFO, NULL, "Resuming at file %d, %lld bytes of it already received", resumeTransfer, (long long)intervalSetPrefix(&resumed));
+	}
+	maxWindowSize = accepted.maxWindowSize;
+	payloadLen = accepted.payloadLen;
+	// Streams the receiver refused never send; their sockets and timers go now
+	for (int i = accepted.streams; i < streamCount; i++)
+	{
+		timingWheelDestroy(&streams[i].sent.wheel);
+		close(streams[i].socketFileDescriptor);
+	}
+	streamCount = accepted.streams;
+	logToFile(INFO, NULL, "Connection open: window %d, payload %d, streams %d, features %#x, RTT %.3f ms", maxWindowSize, payloadLen,
+		streamCount, accepted.features, handshakeRttUs / 1000.0);
 
-	dataFP = fopen(fileName, "r");
-	while (fgets(arrPackets[lineCounter].data, PAYLOAD_LEN, dataFP))
+	// The handshake's RTT, when the SYN was answered first time, replaces the defaults of every stream
+	for (int i = 0; i < streamCount; i++)
 	{
-		lineCounter++;
+		streams[i].maxWindowSize = maxWindowSize;
+		streams[i].payloadLen = payloadLen;
+		streams[i].compress = (accepted.features & FEATURE_COMPRESSION) != 0;
+		streams[i].spanChunks = COMPRESSED_BLOCK_CHUNKS;
+		streams[i].compressSkip = 0;
+		streams[i].compressBackoff = 1;
+		lz4Init(&streams[i].lz4);
+		streams[i].estimatedRTT = DEFAULT_ESTIMATED_RTT;
+		streams[i].devRTT = DEFAULT_DEV_RTT;
+		streams[i].timeoutInterval = DEFAULT_ESTIMATED_RTT + 4 * DEFAULT_DEV_RTT;
+		streams[i].rttMeasured = (handshakeRttUs > 0);
+		if (streams[i].rttMeasured)
+		{
+			streams[i].estimatedRTT = (int)((handshakeRttUs + 500) / 1000);
+			streams[i].devRTT = streams[i].estimatedRTT / 2;
+			updateTimeoutInterval(&streams[i].timeoutInterval, streams[i].estimatedRTT, &streams[i].estimatedRTT, &streams[i].devRTT);
+		}
 	}
 
-	totalLines = lineCounter;
-	lineCounter = 0;
+	for (int t = 0; t < fileCount; t++)
+	{
+		int64_t fileSize = (int64_t)fileStats[t].st_size;
+		int64_t filePackets = (fileSize + payloadLen - 1) / payloadLen;
+		uint32_t fileChecksum = 0;
+		int timeoutInterval = 0;
+
+		// Ended by the transmitter this connection is resuming
+		if (t < resumeTransfer)
+		{
+			logToFile(INFO, NULL, "Skipping %s, already received", fileNames[t]);
+			close(fileFds[t]);
+			skipped++;
+			continue;
+		}
+
+		logToFile(INFO, NULL, "Sending data in file path: %s", fileNames[t]);
+		logToFile(INFO, NULL, "File is %lld bytes in %lld payload lengths over %d streams", (long long)fileSize, (long long)filePackets, streamCount);
+
+		// Cut the file into streamCount ranges of whole packets
+		for (int i = 0; i < streamCount; i++)
+		{
+			struct stream* stream = &streams[i];
+
+			stream->transfer = t;
+			stream->fileFd = fileFds[t];
+			stream->start = filePackets * i / streamCount * payloadLen;
+			stream->offset = stream->start;
+			stream->end = filePackets * (i + 1) / streamCount * payloadLen;
+			if (stream->end > fileSize) stream->end = fileSize;
+			stream->checksum = 0;
+			stream->skip = (t == resumeTransfer && resumed.count > 0) ? &resumed : NULL;
+			stream->skippedBytes = 0;
 
-	logToFile(INFO, NULL, "Number of lines in the file are: %d", totalLines);
+			if (pthread_create(&stream->thread, NULL, sendStream, stream) != 0)
+			{
+				logToFile(ERROR, NULL, "Can't start stream %d", i);
+				exit(1);
+			}
+		}
+
+		for (int i = 0; i < streamCount; i++)
+		{
+			pthread_join(streams[i].thread, NULL);
+			// The ranges are in file order, so their checksums chain into the file's
+			fileChecksum = crc32cCombine(fileChecksum, streams[i].checksum, streams[i].end - streams[i].start);
+			if (streams[i].timeoutInterval > timeoutInterval) timeoutInterval = streams[i].timeoutInterval;
+			resumedBytes += streams[i].skippedBytes;
+		}
+		close(fileFds[t]);
+
+		// End the transfer: the EOT is resent on a timer until the receiver confirms it
+		logToFile(INFO, NULL, "Completed Data Transfer");
+		logToFile(INFO, NULL, "Sending EOT Packet");
+		control->connectionId = connectionId;
+		control->transfer = t;
+		makePacket(control, EOT);
+		control->offset = fileSize;
+		control->fileChecksum = fileChecksum;
+		sealPacket(control);
+		logToFile(INFO, NULL, "File checksum: %08x", fileChecksum);
+		if (!exchangeControl(&streams[0], control, EOT_ACK, timeoutInterval, NULL))
+		{
+			logToFile(ERROR, NULL, "Receiver did not confirm the end of %s", fileNames[t]);
+			exit(1);
+		}
+		if (!(accepted.features & FEATURE_FILE_CHECKSUM))
+		{
+			logToFile(INFO, NULL, "Receiver confirmed %s", fileNames[t]);
+		}
+		else if (reply->offset == fileSize && reply->fileChecksum == fileChecksum)
+		{
+			logToFile(INFO, NULL, "Receiver verified %s", fileNames[t]);
+			verified++;
+		}
+		else
+		{
+			logToFile(ERROR, NULL, "Receiver's copy of %s differs: %lld bytes, checksum %08x", fileNames[t], (long long)reply->offset, reply->fileChecksum);
+		}
+	}
+
+	histogramInit(&rttHistogram);
+	for (int i = 0; i < streamCount; i++)
+	{
+		histogramMerge(&rttHistogram, &streams[i].rttHistogram);
+		retransmits += streams[i].retransmits;
+		fastRetransmits += streams[i].fastRetransmits;
+		compressedPackets += streams[i].compressedPackets;
+		packetsSent += streams[i].packetCount;
+	}
+
+	logRTTHistogram(-1, &rttHistogram);
+	logToFile(INFO, NULL, "Transfer summary: packets=%lld retransmits=%d fastRetransmits=%d streams=%d connection=%d files=%d verified=%d skipped=%d resumedBytes=%lld compressed=%d",
+		(long long)packetsSent, retransmits, fastRetransmits, streamCount, connectionId, fileCount, verified, skipped, (long long)resumedBytes, compressedPackets);
+	logToFile(INFO, NULL, "Terminating Transmitter...");
+
+	for (int i = 0; i < streamCount; i++)
+	{
+		timingWheelDestroy(&streams[i].sent.wheel);
+		close(streams[i].socketFileDescriptor);
+	}
+	intervalSetDestroy(&resumed);
+	packetPoolDestroy(&packetPool);
+	return((accepted.features & FEATURE_FILE_CHECKSUM) && verified + skipped != fileCount ? 1 : 0);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       sendStream
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Seals DATA packets, checksums the range as it is read and skips corrupt ACKs
+ *                 October 18th, 2026 - Uses the negotiated payload length; the RTT estimate is kept in the stream
+ *                                      from one file to the next; ACKs of an earlier file are ignored
+ *                 October 18th, 2026 - Payloads the receiver already has are checksummed but not sent
+ *                 October 18th, 2026 - Reads through readCompressed when compression was granted
+ *                 October 18th, 2026 - Sends the header and the data in use only, paced by that length
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void* sendStream(void* arg)
+ *
+ * RETURNS:        void*, NULL
+ *
+ * NOTES:
+ * Thread body of one stream, the sending loop main used to run: sends the stream's byte range window by window on
+ * its own socket, with its own window size, RTT estimate, retransmission timers and pacer. Packets are read from the
+ * file as they are sent into a ring of MAX_READ_SIZE slots; a window is never larger than the ring and the next one
+ * starts only once all of it is ACKed, so a slot is free again by the time its sequence number comes round.
+ * ACKs of other streams, connections or files that reach this socket are ignored. A payload lying in the stream's
+ * skip ranges is read for the checksum only, taking neither a sequence number nor a place in the window.
+ * ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------*/
+void* sendStream(void* arg)
+{
+	struct stream* stream = (struct stream*)arg;
+	struct packet* ACKPacketPtr = stream->ACKPacket;
+	struct transmissions* sent = &stream->sent;
+	struct node* unACKHead = NULL;
+
+	int windowSize = INITIAL_WINDOW_SIZE, seqNum = INITIAL_SEQ_NUM;
+	int timeoutInterval = stream->timeoutInterval, estimatedRTT = stream->estimatedRTT, devRTT = stream->devRTT;
+	bool windowReduced = false, rttMeasured = stream->rttMeasured;
+	sig_atomic_t dumpGeneration = latencyDumpGeneration;
+
+	logToFile(INFO, NULL, "Stream %d sending bytes %lld to %lld of file %d", stream->id, (long long)stream->offset, (long long)stream->end, stream->transfer);
 
 	// Send a window of packets and wait for ACKs before creating new window
-	enum State state = SendingPackets;
+	enum State state = (stream->offset < stream->end) ? SendingPackets : AllPacketsSent;
 	while (state != AllPacketsSent)
 	{
+		if (dumpGeneration != latencyDumpGeneration)
+		{
+			dumpGeneration = latencyDumpGeneration;
+			logRTTHistogram(stream->id, &stream->rttHistogram);
+		}
+
 		switch (state)
 		{
 			case SendingPackets:
-				logToFile(INFO, NULL, "Current window size: %d", windowSize);
+				logToFile(INFO, NULL, "Stream %d window size: %d", stream->id, windowSize);
+				windowReduced = false;
 				// Create a window of packets to send and transmit datagrams to the receiver
-				for (int windowCounter = 0; windowCounter < windowSize; ++windowCounter, lineCounter++)
+				for (int windowCounter = 0; windowCounter < windowSize && stream->offset < stream->end; ++windowCounter)
 				{
+					int slot = PACKET_SLOT(seqNum);
+					struct packet* pkt = &stream->packets[slot];
+					int64_t remaining = stream->end - stream->offset;
+					const char* raw = stream->compress ? stream->block : pkt->data;
+					// dataLen is the bytes of the file the packet carries, compressed or not
+					ssize_t dataLen = stream->compress ? readCompressed(stream, pkt)
+						: pread(stream->fileFd, pkt->data, (size_t)(remaining < stream->payloadLen ? remaining : stream->payloadLen), stream->offset);
+					if (dataLen <= 0)
+					{
+						logToFile(ERROR, NULL, "Can't read the file at %lld", (long long)stream->offset);
+						exit(1);
+					}
+					if (stream->skip != NULL && intervalSetContains(stream->skip, stream->offset, stream->offset + dataLen))
+					{
+						stream->checksum = crc32cUpdate(stream->checksum, raw, (size_t)dataLen);
+						stream->offset += dataLen;
+						stream->skippedBytes += dataLen;
+						--windowCounter;
+						continue;
+					}
+
 					// Generate a list of unACK packets containing sequence numbers
 					appendToUnACKs(&unACKHead, seqNum);
 
 					// Initialize remaining packet fields
-					arrPackets[lineCounter].packetType = DATA;
-					arrPackets[lineCounter].seqNum = seqNum++;
-					arrPackets[lineCounter].windowSize = windowSize;
-					arrPackets[lineCounter].ackNum = INVALID_ACK_NUM;
-					arrPackets[lineCounter].retransmit = false;
-
-					// Send to receiver
-					if (sendto(socketFileDescriptor, arrPacketsPtr++, packetSize, 0, (struct sockaddr*)&receiver, receiverLen) == -1)
+					pkt->packetType = DATA;
+					pkt->seqNum = seqNum++;
+					pkt->windowSize = windowSize;
+					pkt->ackNum = INVALID_ACK_NUM;
+					pkt->retransmit = false;
+					pkt->streamId = stream->id;
+					pkt->offset = stream->offset;
+					if (!stream->compress)
 					{
-						logToFile(ERROR, NULL, "sendto failure");
-						exit(1);
+						pkt->dataLen = (int)dataLen;
+						pkt->rawLen = 0;
 					}
-					logToFile(INFO, arrPacketsPtr-1, "Sent DATA (seqNum: %d)", arrPackets[lineCounter].seqNum);
-					
-					// If last data packet is sent, update line counter immediately, stop sending and immediately wait for ACKs
-					if (lineCounter + 1 == totalLines)
+					pkt->connectionId = stream->connectionId;
+					pkt->transfer = stream->transfer;
+					sealPacket(pkt);
+					stream->checksum = crc32cUpdate(stream->checksum, raw, (size_t)dataLen);
+					stream->offset += dataLen;
+					stream->packetCount++;
+
+					// Send to receiver, spaced by the time this packet's bytes take
+					uint64_t gapUs = pacerGap(&stream->pacer, windowSize, estimatedRTT, rttMeasured, packetLength(pkt));
+					if (pacedSend(stream->socketFileDescriptor, &stream->pacer, pkt, gapUs, &stream->receiver, stream->receiverLen) == -1)
 					{
-						lineCounter += 1;
-						state = WaitForACKs;
-						gettimeofday(&start, NULL);
-						break;
+						logToFile(ERROR, NULL, "sendto failure");
+						exit(1);
 					}
+					sent->sentUs[slot] = monotonicUs();
+					sent->count[slot] = 1;
+					sent->laterACKs[slot] = 0;
+					armRetransmitTimer(sent, slot, timeoutInterval);
+					logToFile(INFO, pkt, "Sent DATA (stream: %d, seqNum: %d)", stream->id, pkt->seqNum);
 				}
 
-				// Start delay measure for timeout events
-				gettimeofday(&start, NULL);
-
 				logToFile(INFO, NULL, "Window of packets sent, waiting for ACKs");
 				state = WaitForACKs;
 				break;
@@ -244,37 +700,23 @@ int main(int argc, char** argv)
 					break;
 				}
 				
-				// Check for timeout events, with end delay measure 
-				gettimeofday(&end, NULL);
-				logToFile(DEBUG, NULL, "Current delay = %ld ms.\n", delay(start, end));
-
-				if (delay(start, end) >= timeoutInterval && getUnACKCount(unACKHead)> 0)
-				{
-					logToFile(INFO, NULL, "RTT (%ld) >= Timeout Interval (=%d), packet loss event detected", delay(start, end), timeoutInterval);
-					logToFile(INFO, NULL, "Retransmitting %d unACKs...", getUnACKCount(unACKHead));
-					if (DEFAULT_LOGGER_LEVEL == DEBUG) printUnACKs(unACKHead);
-
-					// Retransmit unACKed packets
-					retransmitUnACKs(socketFileDescriptor, arrPackets, unACKHead, packetSize, &receiver, receiverLen);
-
-					// Update Timeout Interval based
-					updateTimeoutInterval(&timeoutInterval, &sampleRTT, &start, &end, &estimatedRTT, &devRTT);
-
-					// Reset delay measure for timeout events
-					gettimeofday(&start, NULL);
-
-					// Reduce window size by half
-					windowSize /= 2;
-				}
-
 				// Receive data from the receiver (non-blocking)
-				if (recvfrom(socketFileDescriptor, ACKPacketPtr, packetSize, 0, (struct sockaddr*)&receiver, &receiverLen) >= 0)
+				if (recvfrom(stream->socketFileDescriptor, ACKPacketPtr, sizeof(struct packet), 0, (struct sockaddr*)&stream->receiver, &stream->receiverLen) >= 0)
 				{
+					if (!packetIntact(ACKPacketPtr))
+					{
+						logToFile(ERROR, NULL, "Stream %d ignoring corrupt ACK", stream->id);
+						break;
+					}
+					if (ACKPacketPtr->packetType != ACK || ACKPacketPtr->streamId != stream->id || ACKPacketPtr->connectionId != stream->connectionId
+						|| ACKPacketPtr->transfer != stream->transfer)
+					{
+						logToFile(DEBUG, ACKPacketPtr, "Stream %d ignoring %s of stream %d, connection %d, file %d", stream->id, packetTypeToString(ACKPacketPtr->packetType, false),
+							ACKPacketPtr->streamId, ACKPacketPtr->connectionId, ACKPacketPtr->transfer);
+						break;
+					}
 					logToFile(DEBUG, NULL, "Size of unACKs list: %d", getUnACKCount(unACKHead));
-					logToFile(INFO, ACKPacketPtr, "Received ACK (ackNum: %d)", ACKPacketPtr->ackNum);
-
-					// Update Timeout Interval based on sampleRTT
-					updateTimeoutInterval(&timeoutInterval, &sampleRTT, &start, &end, &estimatedRTT, &devRTT);
+					logToFile(INFO, ACKPacketPtr, "Received ACK (stream: %d, ackNum: %d)", stream->id, ACKPacketPtr->ackNum);
 
 					// Check to see if data from receiver contains ACK we haven't received yet
 					struct node* current = unACKHead;
@@ -283,56 +725,236 @@ int main(int argc, char** argv)
 						// Matching ACK found
 						if (current->data == ACKPacketPtr->ackNum)
 						{
+							int slot = PACKET_SLOT(ACKPacketPtr->ackNum);
 							logToFile(DEBUG, NULL, "ACK found: %d, removing now...", ACKPacketPtr->ackNum);
+
+							timingWheelCancel(&sent->wheel, slot);
+
+							// Karn's rule: an ACK for a retransmitted packet can't be matched to one transmission
+							if (sent->count[slot] == 1)
+							{
+								uint64_t rttUs = monotonicUs() - sent->sentUs[slot];
+								int sampleRTT = (int)((rttUs + 500) / 1000);
+								histogramRecord(&stream->rttHistogram, rttUs);
+								// The first sample replaces the defaults rather than being averaged with them
+								if (!rttMeasured)
+								{
+									estimatedRTT = sampleRTT;
+									devRTT = sampleRTT / 2;
+									rttMeasured = true;
+								}
+								updateTimeoutInterval(&timeoutInterval, sampleRTT, &estimatedRTT, &devRTT);
+							}
 							deleteFromUnACKs(&unACKHead, ACKPacketPtr->ackNum);
+
+							// Packets sent before this one and still unACKed may have been lost
+							int resent = fastRetransmit(stream->socketFileDescriptor, stream->packets, unACKHead, ACKPacketPtr->ackNum, sent, timeoutInterval, &stream->receiver, stream->receiverLen);
+							if (resent > 0)
+							{
+								stream->retransmits += resent;
+								stream->fastRetransmits += resent;
+								// Halve the window once per window of packets, not once per lost packet
+								if (!windowReduced)
+								{
+									windowSize = (windowSize / 2 > INITIAL_WINDOW_SIZE) ? windowSize / 2 : INITIAL_WINDOW_SIZE;
+									windowReduced = true;
+								}
+							}
 							if (DEFAULT_LOGGER_LEVEL == DEBUG) printUnACKs(unACKHead);
 
 							// Increase window size by one
-							if(windowSize!=MAX_WINDOW_SIZE)	windowSize++;
+							if(windowSize<stream->maxWindowSize)	windowSize++;
 							break;
 						}
 						// No match found, continue to next node
 						current = current->next;
 					}
 				}
+				else
+				{
+					// No ACK waiting: resend the packets whose retransmission timer expired, a few per pass. Checking only
+					// once queued ACKs are read keeps a paced window's late-read ACKs from looking like timeouts
+					int expired = retransmitExpired(stream->socketFileDescriptor, stream->packets, sent, timeoutInterval, &stream->receiver, stream->receiverLen);
+					if (expired > 0)
+					{
+						stream->retransmits += expired;
+						if (DEFAULT_LOGGER_LEVEL == DEBUG) printUnACKs(unACKHead);
+
+						// Halve the window once per window of packets, not once per lost packet
+						if (!windowReduced)
+						{
+							windowSize = (windowSize / 2 > INITIAL_WINDOW_SIZE) ? windowSize / 2 : INITIAL_WINDOW_SIZE;
+							windowReduced = true;
+						}
+					}
+				}
 				break;
 			case AllACKsReceived:
-				logToFile(DEBUG, NULL, "Line Counter %d", lineCounter);
-				logToFile(DEBUG, NULL, "Total lines %d", totalLines);
-				state = (lineCounter == totalLines) ? AllPacketsSent : SendingPackets;
+				logToFile(DEBUG, NULL, "Stream %d at offset %lld of %lld", stream->id, (long long)stream->offset, (long long)stream->end);
+				state = (stream->offset == stream->end) ? AllPacketsSent : SendingPackets;
 				freeUnACKs(&unACKHead);
 				break;
 			default:
 				logToFile(ERROR, NULL, "Unknown state: %d", state);
-				freeUnACKs(&unACKHead);
-				free(ACKPacketPtr);
 				exit(1);
 		}
 	}
 
-	logToFile(INFO, NULL, "Completed Data Transfer");
-	logToFile(INFO, NULL, "Sending EOT Packet");
-	struct packet* EOTPacket = malloc(packetSize);
-	makePacket(EOTPacket, EOT);
+	logToFile(INFO, NULL, "Stream %d sent %d packets, %d retransmits", stream->id, stream->packetCount, stream->retransmits);
+	freeUnACKs(&unACKHead);
+	stream->timeoutInterval = timeoutInterval;
+	stream->estimatedRTT = estimatedRTT;
+	stream->devRTT = devRTT;
+	stream->rttMeasured = rttMeasured;
+	return NULL;
+}
 
-	// Ensure EOT delivery
-	for (int i = 0; i < 10; ++i) 
+/*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       exchangeControl
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Sends the request's header and data in use only
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      bool exchangeControl(struct stream* stream, struct packet* request, enum PacketType replyType, int timeoutInterval, uint64_t* rttUs)
+ *
+ * RETURNS:        bool, true once the reply is in stream->ACKPacket; false if none came after CONTROL_ATTEMPTS transmissions
+ *
+ * NOTES:
+ * Sends a sealed SYN or EOT on the stream's socket and waits for the receiver's reply of replyType with the same
+ * connection id and, for an EOT, the same file. The request is resent whenever timeoutInterval ms pass without one,
+ * the interval doubling each time up to MAX_TIMEOUT_INTERVAL. DATA ACKs still arriving for the streams are read and
+ * dropped. If rttUs is not NULL it is set to the round trip time of the request when its first transmission was
+ * answered, or 0 when it had to be resent (Karn's rule).
+ * ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------*/
+bool exchangeControl(struct stream* stream, struct packet* request, enum PacketType replyType, int timeoutInterval, uint64_t* rttUs)
+{
+	struct packet* reply = stream->ACKPacket;
+
+	if (rttUs != NULL) *rttUs = 0;
+	for (int attempt = 1; attempt <= CONTROL_ATTEMPTS; attempt++)
 	{
-		// Send EOT to receiver 
-		if (sendto(socketFileDescriptor, EOTPacket, packetSize, 0, (struct sockaddr*)&receiver, receiverLen) == -1)
+		uint64_t sentUs = monotonicUs();
+		uint64_t deadlineUs = sentUs + (uint64_t)timeoutInterval * 1000;
+
+		if (sendto(stream->socketFileDescriptor, request, packetLength(request), 0, (struct sockaddr*)&stream->receiver, stream->receiverLen) == -1)
 		{
 			logToFile(ERROR, NULL, "sendto failure");
 			exit(1);
 		}
+		logToFile(INFO, request, "Sent %s (attempt %d)", packetTypeToString(request->packetType, false), attempt);
+
+		while (monotonicUs() < deadlineUs)
+		{
+			if (recvfrom(stream->socketFileDescriptor, reply, sizeof(struct packet), 0, (struct sockaddr*)&stream->receiver, &stream->receiverLen) < 0)
+			{
+				continue;
+			}
+			if (!packetIntact(reply) || reply->packetType != replyType || reply->connectionId != request->connectionId
+				|| (replyType == EOT_ACK && reply->transfer != request->transfer))
+			{
+				continue;
+			}
+			if (rttUs != NULL && attempt == 1) *rttUs = monotonicUs() - sentUs;
+			logToFile(INFO, reply, "Received %s", packetTypeToString(reply->packetType, false));
+			return true;
+		}
+
+		timeoutInterval = (timeoutInterval * 2 < MAX_TIMEOUT_INTERVAL) ? timeoutInterval * 2 : MAX_TIMEOUT_INTERVAL;
 	}
+	return false;
+}
 
-	logToFile(INFO, NULL, "Terminating Transmitter...");
+/*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       readCompressed
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Tries down to one payload length, kept compressed whenever it comes out shorter
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      ssize_t readCompressed(struct stream* stream, struct packet* pkt)
+ *
+ * RETURNS:        ssize_t, bytes of the file read at stream->offset and carried by pkt; 0 or -1 if the read failed
+ *
+ * NOTES:
+ * Reads the next spanChunks payload lengths of the stream's range into stream->block and compresses as many of them
+ * as fit in one payload into pkt, trying half as many each time down to one. One payload length or less is kept
+ * compressed only if it came out shorter; since only dataLen bytes are sent, that still saves bandwidth. pkt's
+ * dataLen and rawLen are set; the bytes it stands for stay in stream->block for the file's checksum. A span that
+ * fitted the first time is doubled for the next packet. When not even one payload length compresses, it goes out
+ * as it is and the next compressBackoff packets are sent without trying, that count doubling up to
+ * COMPRESS_BACKOFF_MAX while the data keeps refusing to compress. Payloads the receiver already has are read one at
+ * a time, to be skipped.
+ * ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------*/
+ssize_t readCompressed(struct stream* stream, struct packet* pkt)
+{
+	int64_t remaining = stream->end - stream->offset;
+	int chunks = stream->spanChunks;
+	int lastSpan = 0;
+	bool tryCompress = true;
+	ssize_t readLen;
+	int rawLen;
 
-	free(EOTPacket);
-	freeUnACKs(&unACKHead);
-	free(ACKPacketPtr);
-	close(socketFileDescriptor);
-	return(0);
+	if (stream->skip != NULL && intervalSetContains(stream->skip, stream->offset, stream->offset + (remaining < stream->payloadLen ? remaining : stream->payloadLen)))
+	{
+		chunks = 1;
+		tryCompress = false;
+	}
+	else if (stream->compressSkip > 0)
+	{
+		stream->compressSkip--;
+		chunks = 1;
+		tryCompress = false;
+	}
+
+	readLen = pread(stream->fileFd, stream->block, (size_t)(remaining < (int64_t)chunks * stream->payloadLen ? remaining : (int64_t)chunks * stream->payloadLen), stream->offset);
+	if (readLen <= 0)
+	{
+		return readLen;
+	}
+
+	for (int k = chunks; tryCompress && k >= 1; k /= 2)
+	{
+		int span = (readLen < (ssize_t)k * stream->payloadLen) ? (int)readLen : k * stream->payloadLen;
+		int compressedLen;
+
+		// a short read leaves the larger spans all the same length; each is only tried once
+		if (span == lastSpan)
+		{
+			continue;
+		}
+		lastSpan = span;
+		// a span that would fit as it is must come out shorter to be worth sending compressed
+		if ((compressedLen = lz4Compress(&stream->lz4, stream->block, span, pkt->data, (span > stream->payloadLen) ? stream->payloadLen : span - 1)) > 0)
+		{
+			pkt->dataLen = compressedLen;
+			pkt->rawLen = span;
+			stream->spanChunks = (k == chunks && k * 2 <= COMPRESSED_BLOCK_CHUNKS) ? k * 2 : k;
+			stream->compressBackoff = 1;
+			stream->compressedPackets++;
+			return span;
+		}
+	}
+
+	rawLen = (readLen < stream->payloadLen) ? (int)readLen : stream->payloadLen;
+	memcpy(pkt->data, stream->block, (size_t)rawLen);
+	pkt->dataLen = rawLen;
+	pkt->rawLen = 0;
+	if (tryCompress)
+	{
+		stream->spanChunks = 2;
+		stream->compressSkip = stream->compressBackoff;
+		stream->compressBackoff = (stream->compressBackoff * 2 < COMPRESS_BACKOFF_MAX) ? stream->compressBackoff * 2 : COMPRESS_BACKOFF_MAX;
+	}
+	return rawLen;
 }
 
 /*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -340,28 +962,225 @@ int main(int argc, char** argv)
  *
  * DATE:           December 3rd, 2020
  *
- * REVISIONS:      N/A
+ * REVISIONS:      October 18th, 2026 - Takes one packet's RTT in ms instead of the time since the window was sent;
+ *                                      the deviation term is at least TIMER_GRANULARITY
  *
  * DESIGNER:       Derek Wong
  *
  * PROGRAMMER:     Derek Wong
  *
- * INTERFACE:      void updateTimeoutInterval(int* timeoutInterval, int* sampleRTT, struct timeval* start, struct timeval* end, int* estimatedRTT, int* devRTT)
+ * INTERFACE:      void updateTimeoutInterval(int* timeoutInterval, int sampleRTT, int* estimatedRTT, int* devRTT)
  *
  * RETURNS:        void
  *
  * NOTES:
  * Update the timeout interval with each sample data RTT
  * ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------*/
-void updateTimeoutInterval(int* timeoutInterval, int* sampleRTT, struct timeval* start, struct timeval* end, int* estimatedRTT, int* devRTT)
+void updateTimeoutInterval(int* timeoutInterval, int sampleRTT, int* estimatedRTT, int* devRTT)
 {
-	*sampleRTT = delay(*start, *end);
-	*estimatedRTT = (1 - DEFAULT_RTT_ALPHA) * (*estimatedRTT) + DEFAULT_RTT_ALPHA * (*sampleRTT);
-	*devRTT = (1 - DEFAULT_RTT_BETA) * (*devRTT) + DEFAULT_RTT_BETA * abs(*sampleRTT - *estimatedRTT);
-	*timeoutInterval = (MAX_TIMEOUT_INTERVAL > (*estimatedRTT + 4 * (*devRTT))) ? *estimatedRTT + 4 * (*devRTT) : MAX_TIMEOUT_INTERVAL;
+	*estimatedRTT = (1 - DEFAULT_RTT_ALPHA) * (*estimatedRTT) + DEFAULT_RTT_ALPHA * sampleRTT;
+	*devRTT = (1 - DEFAULT_RTT_BETA) * (*devRTT) + DEFAULT_RTT_BETA * abs(sampleRTT - *estimatedRTT);
+	// Millisecond samples of a steady path drive devRTT to 0, which would put the timeout right on the RTT
+	int variance = (4 * (*devRTT) > TIMER_GRANULARITY) ? 4 * (*devRTT) : TIMER_GRANULARITY;
+	*timeoutInterval = (MAX_TIMEOUT_INTERVAL > (*estimatedRTT + variance)) ? *estimatedRTT + variance : MAX_TIMEOUT_INTERVAL;
 	logToFile(INFO, NULL, "Updating timeout interval: %d", *timeoutInterval);
 }
 
+/*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       pacerInit
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      N/A
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void pacerInit(struct pacer* pacer, int socketFileDescriptor)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Enables SO_TXTIME on the socket for -p txtime; where the kernel refuses it, falls back to pacing with a timer.
+ * Departure times are on CLOCK_MONOTONIC, which is the clock the fq qdisc expects.
+ * ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------*/
+void pacerInit(struct pacer* pacer, int socketFileDescriptor)
+{
+	pacer->nextDepartureUs = 0;
+	if (pacer->mode != PacingTxTime)
+	{
+		return;
+	}
+#if defined(SO_TXTIME)
+	struct sock_txtime txtime;
+	memset(&txtime, 0, sizeof(txtime));
+	txtime.clockid = CLOCK_MONOTONIC;
+	if (setsockopt(socketFileDescriptor, SOL_SOCKET, SO_TXTIME, &txtime, sizeof(txtime)) == 0)
+	{
+		logToFile(INFO, NULL, "Pacing with SO_TXTIME");
+		return;
+	}
+#else
+	(void)socketFileDescriptor;
+#endif
+	logToFile(INFO, NULL, "SO_TXTIME unavailable, pacing with a timer");
+	pacer->mode = PacingTimer;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       pacerGap
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - packetSize is the length of the datagram about to be sent
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      uint64_t pacerGap(const struct pacer* pacer, int windowSize, int estimatedRTT, bool rttMeasured, int packetSize)
+ *
+ * RETURNS:        uint64_t, the spacing of DATA packets in us
+ *
+ * NOTES:
+ * A fixed rate gives the time one packet takes at that rate; otherwise the window is spread over the estimated RTT
+ * divided by PACING_GAIN, since the next window waits for the last ACK of this one.
+ * Until the first RTT sample there is nothing to pace against and the gap is 0.
+ * ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------*/
+uint64_t pacerGap(const struct pacer* pacer, int windowSize, int estimatedRTT, bool rttMeasured, int packetSize)
+{
+	if (pacer->mode == PacingOff)
+	{
+		return 0;
+	}
+	if (pacer->rateKbps > 0)
+	{
+		return (uint64_t)packetSize * 8 * 1000 / (uint64_t)pacer->rateKbps;
+	}
+	if (!rttMeasured || windowSize <= 0)
+	{
+		return 0;
+	}
+	return (uint64_t)estimatedRTT * 1000 / ((uint64_t)windowSize * PACING_GAIN);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       pacedSend
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Sends the header and the data in use; the length comes from the packet
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      ssize_t pacedSend(int socketFileDescriptor, struct pacer* pacer, const struct packet* pkt, uint64_t gapUs, struct sockaddr_in* receiver, socklen_t receiverLen)
+ *
+ * RETURNS:        ssize_t, as sendto
+ *
+ * NOTES:
+ * Sends the packet no earlier than gapUs after the previous one. The timer mode sleeps until the departure time
+ * (absolute, so time spent sending is not added to the gap); the txtime mode sends at once with the departure time
+ * attached for the qdisc.
+ * ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------*/
+ssize_t pacedSend(int socketFileDescriptor, struct pacer* pacer, const struct packet* pkt, uint64_t gapUs, struct sockaddr_in* receiver, socklen_t receiverLen)
+{
+	uint64_t nowUs = monotonicUs();
+	uint64_t departureUs = (pacer->nextDepartureUs > nowUs) ? pacer->nextDepartureUs : nowUs;
+
+	pacer->nextDepartureUs = departureUs + gapUs;
+#if defined(SO_TXTIME)
+	if (pacer->mode == PacingTxTime)
+	{
+		uint64_t departureNs = departureUs * 1000;
+		char control[CMSG_SPACE(sizeof(departureNs))];
+		struct iovec iov = { (void*)pkt, (size_t)packetLength(pkt) };
+		struct msghdr msg;
+		memset(&msg, 0, sizeof(msg));
+		memset(control, 0, sizeof(control));
+		msg.msg_name = receiver;
+		msg.msg_namelen = receiverLen;
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+		struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+		cmsg->cmsg_level = SOL_SOCKET;
+		cmsg->cmsg_type = SCM_TXTIME;
+		cmsg->cmsg_len = CMSG_LEN(sizeof(departureNs));
+		memcpy(CMSG_DATA(cmsg), &departureNs, sizeof(departureNs));
+		return sendmsg(socketFileDescriptor, &msg, 0);
+	}
+#endif
+	if (pacer->mode == PacingTimer && departureUs >= nowUs + PACING_MIN_SLEEP)
+	{
+		struct timespec departure;
+		departure.tv_sec = (time_t)(departureUs / 1000000);
+		departure.tv_nsec = (long)(departureUs % 1000000) * 1000;
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &departure, NULL) == EINTR);
+	}
+	return sendto(socketFileDescriptor, pkt, packetLength(pkt), 0, (struct sockaddr*)receiver, receiverLen);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       requestLatencyDump
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Counts requests, so that every stream sees each one
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void requestLatencyDump(int signalNumber)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * SIGUSR1 handler; only bumps a counter, each stream logs its histogram when it sees the counter change
+ * ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------*/
+void requestLatencyDump(int signalNumber)
+{
+	(void)signalNumber;
+	latencyDumpGeneration++;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       logRTTHistogram
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Labels the histogram of a single stream
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void logRTTHistogram(int streamId, const struct histogram* rttHistogram)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Logs the per-packet RTT percentiles in microseconds, of one stream or, for a negative streamId, of all of them
+ * ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------*/
+void logRTTHistogram(int streamId, const struct histogram* rttHistogram)
+{
+	char summary[HISTOGRAM_SUMMARY_LEN];
+
+	histogramFormat(rttHistogram, summary, sizeof(summary), "us");
+	if (streamId < 0)
+	{
+		logToFile(INFO, NULL, "Per-packet RTT: %s", summary);
+	}
+	else
+	{
+		logToFile(INFO, NULL, "Per-packet RTT of stream %d: %s", streamId, summary);
+	}
+}
+
 /*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * FUNCTION:       appendToUnACKs
  *
@@ -530,9 +1349,76 @@ void printUnACKs(struct node* node)
 }
 
 /*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
- * FUNCTION:       retransmitUnACKs
+ * FUNCTION:       retransmitExpired
  *
- * DATE:           December 3rd, 2020
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Packets give their own datagram length
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int retransmitExpired(int socketFileDescriptor, struct packet* arrPackets, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen)
+ *
+ * RETURNS:        int, the number of packets resent
+ *
+ * NOTES:
+ * Resends the unACKed packets whose retransmission timer has expired, at most RETRANSMIT_BURST of them; the rest
+ * stay due on the timing wheel and are resent on the following calls. Replaces resending the whole unACKed list
+ * whenever the window's timeout passed.
+ * ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------*/
+int retransmitExpired(int socketFileDescriptor, struct packet* arrPackets, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen)
+{
+	int expired[RETRANSMIT_BURST];
+	int count = timingWheelExpire(&sent->wheel, monotonicUs(), expired, RETRANSMIT_BURST);
+
+	for (int i = 0; i < count; i++)
+	{
+		logToFile(INFO, NULL, "Retransmission timeout for DATA (seqNum: %d) after %d transmissions", arrPackets[expired[i]].seqNum, sent->count[expired[i]]);
+		retransmitPacket(socketFileDescriptor, arrPackets, expired[i], sent, timeoutInterval, receiver, receiverLen);
+	}
+	return count;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       retransmitPacket
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Reseals the packet, whose retransmit flag the checksum covers
+ *                 October 18th, 2026 - Sends the header and the data in use only
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      void retransmitPacket(int socketFileDescriptor, struct packet* arrPackets, int index, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen)
+ *
+ * RETURNS:        void
+ *
+ * NOTES:
+ * Resends arrPackets[index] flagged as a retransmission and rearms its timer with the backed off interval
+ * ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------*/
+void retransmitPacket(int socketFileDescriptor, struct packet* arrPackets, int index, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen)
+{
+	arrPackets[index].retransmit = true;
+	sealPacket(&arrPackets[index]);
+	if (sendto(socketFileDescriptor, &arrPackets[index], packetLength(&arrPackets[index]), 0, (struct sockaddr*)receiver, receiverLen) == -1)
+	{
+		perror("sendto retransmit failure");
+		exit(1);
+	}
+	sent->sentUs[index] = monotonicUs();
+	sent->count[index]++;
+	sent->laterACKs[index] = 0;
+	armRetransmitTimer(sent, index, timeoutInterval);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       armRetransmitTimer
+ *
+ * DATE:           October 18th, 2026
  *
  * REVISIONS:      N/A
  *
@@ -540,26 +1426,64 @@ void printUnACKs(struct node* node)
  *
  * PROGRAMMER:     Derek Wong
  *
- * INTERFACE:      void retransmitUnACKs(int socketFileDescriptor, struct packet* arrPackets, struct node* head, int packetSize, struct sockaddr_in* receiver, socklen_t receiverLen)
+ * INTERFACE:      void armRetransmitTimer(struct transmissions* sent, int index, int timeoutInterval)
  *
  * RETURNS:        void
  *
  * NOTES:
- * Resend all currently unACKed packets based on their sequence numbers
+ * Schedules the packet's retransmission timeoutInterval ms after its latest transmission, doubled for every
+ * earlier transmission of the packet and capped at MAX_TIMEOUT_INTERVAL
  * ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------*/
-void retransmitUnACKs(int socketFileDescriptor, struct packet* arrPackets, struct node* head, int packetSize, struct sockaddr_in* receiver, socklen_t receiverLen)
+void armRetransmitTimer(struct transmissions* sent, int index, int timeoutInterval)
 {
+	long interval = timeoutInterval;
+	for (int i = 1; i < sent->count[index] && interval < MAX_TIMEOUT_INTERVAL; i++)
+	{
+		interval *= 2;
+	}
+	if (interval > MAX_TIMEOUT_INTERVAL) interval = MAX_TIMEOUT_INTERVAL;
+	timingWheelSchedule(&sent->wheel, index, sent->sentUs[index] + (uint64_t)interval * 1000);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * FUNCTION:       fastRetransmit
+ *
+ * DATE:           October 18th, 2026
+ *
+ * REVISIONS:      October 18th, 2026 - Only ACKs of packets sent after the latest transmission count; resending
+ *                                      rearms the packet's retransmission timer
+ *                 October 18th, 2026 - Packets are found by their ring slot
+ *                 October 18th, 2026 - Packets give their own datagram length
+ *
+ * DESIGNER:       Derek Wong
+ *
+ * PROGRAMMER:     Derek Wong
+ *
+ * INTERFACE:      int fastRetransmit(int socketFileDescriptor, struct packet* arrPackets, struct node* head, int ackNum, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen)
+ *
+ * RETURNS:        int, the number of packets resent
+ *
+ * NOTES:
+ * Called with the unACKed list once the packet ackNum has been ACKed for the first time. Every packet still unACKed
+ * with a lower sequence number, last sent before ackNum was, gains one later ACK; the packet that reaches
+ * DUP_ACK_THRESHOLD is resent. The count keeps growing past the threshold, so each transmission is fast
+ * retransmitted at most once.
+ * ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------*/
+int fastRetransmit(int socketFileDescriptor, struct packet* arrPackets, struct node* head, int ackNum, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen)
+{
+	int resent = 0;
+	uint64_t ackedSentUs = sent->sentUs[PACKET_SLOT(ackNum)];
 	struct node* current = head;
 	while (current != NULL)
 	{
-		struct packet* arrPacketsPtr;
-		arrPacketsPtr = &arrPackets[current->data - 1];
-		arrPacketsPtr->retransmit = true;
-		if (sendto(socketFileDescriptor, arrPacketsPtr, packetSize, 0, (struct sockaddr*)receiver, receiverLen) == -1)
+		int index = PACKET_SLOT(current->data);
+		if (current->data < ackNum && sent->sentUs[index] <= ackedSentUs && ++sent->laterACKs[index] == DUP_ACK_THRESHOLD)
 		{
-			perror("sendto retransmit failure");
-			exit(1);
+			logToFile(INFO, &arrPackets[index], "Fast retransmit of DATA (seqNum: %d) after %d later ACKs", current->data, DUP_ACK_THRESHOLD);
+			retransmitPacket(socketFileDescriptor, arrPackets, index, sent, timeoutInterval, receiver, receiverLen);
+			resent++;
 		}
 		current = current->next;
 	}
+	return resent;
 }
\ No newline at end of file
@@ -7,12 +7,35 @@
 --								int getUnACKCount(struct node* head);
 --								void freeUnACKs(struct node** headRef);
 --								void printUnACKs(struct node* node);
---								void retransmitUnACKs(int socketFileDescriptor, struct packet* arrPackets, struct node* head, int packetSize, struct sockaddr_in* receiver, socklen_t receiverLen);
---								void updateTimeoutInterval(int* timeoutInterval, int* sampleRTT, struct timeval* start, struct timeval* end, int* estimatedRTT, int* devRTT);
+--								int retransmitExpired(int socketFileDescriptor, struct packet* arrPackets, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen);
+--								void retransmitPacket(int socketFileDescriptor, struct packet* arrPackets, int index, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen);
+--								void armRetransmitTimer(struct transmissions* sent, int index, int timeoutInterval);
+--								void updateTimeoutInterval(int* timeoutInterval, int sampleRTT, int* estimatedRTT, int* devRTT);
+--								void pacerInit(struct pacer* pacer, int socketFileDescriptor);
+--								uint64_t pacerGap(const struct pacer* pacer, int windowSize, int estimatedRTT, bool rttMeasured, int packetSize);
+--								ssize_t pacedSend(int socketFileDescriptor, struct pacer* pacer, const struct packet* pkt, uint64_t gapUs, struct sockaddr_in* receiver, socklen_t receiverLen);
+--								void requestLatencyDump(int signalNumber);
+--								void logRTTHistogram(int streamId, const struct histogram* rttHistogram);
+--								int fastRetransmit(int socketFileDescriptor, struct packet* arrPackets, struct node* head, int ackNum, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen);
+--								void* sendStream(void* arg);
+--								bool exchangeControl(struct stream* stream, struct packet* request, enum PacketType replyType, int timeoutInterval, uint64_t* rttUs);
+--								ssize_t readCompressed(struct stream* stream, struct packet* pkt);
 --
 --	DATE:			December 3, 2020
 --
---	REVISIONS:		N/A
+--	REVISIONS:		October 18th, 2026 - Per-packet RTT histogram, dumped at EOT and on SIGUSR1
+--					October 18th, 2026 - Options for the maximum window size; retransmits are counted
+--					October 18th, 2026 - Pool size for the ACK and EOT packets
+--					October 18th, 2026 - Duplicate ACK threshold for fast retransmit
+--					October 18th, 2026 - Per-packet transmission records and retransmission timers
+--					October 18th, 2026 - Pacing modes and state
+--					October 18th, 2026 - Per-stream state; packets in flight live in a ring
+--					October 18th, 2026 - Connection id of the transfer in each stream
+--					October 18th, 2026 - Each stream keeps the CRC32C of its byte range
+--					October 18th, 2026 - Several files per connection; streams keep their RTT estimate from one file to the next
+--					October 18th, 2026 - Ranges the receiver already has, skipped by the streams of a resumed connection
+--					October 18th, 2026 - Compression context, block buffer and span of each stream
+--					October 18th, 2026 - The send functions take the datagram length from the packet
 
 --
 --	DESIGNERS:		Derek Wong
@@ -32,13 +55,25 @@
 #include <strings.h>
 #include <arpa/inet.h>
 #include <stdlib.h>
+#include <getopt.h>
 #include <unistd.h>
 #include <string.h>
+#include <signal.h>
 #include <sys/time.h>
+#include <time.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <limits.h>
+
+#if defined(__linux__)
+	#include <linux/net_tstamp.h>
+#endif
 
 
 /*-------------------------------------------------------------------------------------Enums--------------------------------------------------------------------------------------------*/
 enum State { SendingPackets, WaitForACKs, AllACKsReceived, AllPacketsSent };
+enum PacingMode { PacingOff, PacingTimer, PacingTxTime };
 
 /*-------------------------------------------------------------------------------Symbolic Constants-------------------------------------------------------------------------------------*/
 #define MAX_BUF_LEN				65000   // Maximum Buffer length
@@ -48,6 +83,19 @@ enum State { SendingPackets, WaitForACKs, AllACKsReceived, AllPacketsSent };
 #define DEFAULT_RTT_ALPHA		0.125	// Default constant value used to determine the estimatedRTT
 #define DEFAULT_RTT_BETA		0.25	// Default constant value used to determine the deviation in sample RTT
 #define DEFAULT_READ_TIMEOUT	300		// Default recvfrom timeout value in us (prevents indefinite blocking)
+#define HISTOGRAM_SUMMARY_LEN	256		// Buffer length for a one-line histogram summary
+#define TRANSMITTER_POOL_PACKETS	(MAX_STREAMS + 1)	// ACK of each stream and EOT; DATA packets live in the stream rings
+#define DUP_ACK_THRESHOLD		3		// ACKs for later packets before an unACKed packet is presumed lost
+#define RETRANSMIT_BURST		4		// Expired packets resent per pass of the main loop
+#define TIMER_GRANULARITY		10		// Lower bound on the deviation term of the timeout interval in ms
+#define PACING_MIN_SLEEP		50		// Departures closer than this in us are sent without sleeping
+#define PACING_GAIN				2		// The window is sent over 1/PACING_GAIN of the RTT, leaving room for the window to grow
+#define MAX_FILES				64		// Files sent one after the other over one connection
+#define CONTROL_ATTEMPTS		6		// Transmissions of a SYN or EOT before the receiver is given up on
+#define COMPRESS_BACKOFF_MAX	64		// Most packets sent uncompressed, without trying, after data that would not compress
+
+/*-------------------------------------------------------------------------------------Macros-------------------------------------------------------------------------------------------*/
+#define PACKET_SLOT(seqNum)		(((seqNum) - 1) % MAX_READ_SIZE)	// Ring slot of a DATA packet and its transmission record
 
 /*----------------------------------------------------------------------------------Default Strings-------------------------------------------------------------------------------------*/
 #define DATA_FILE_PATH		"./resource/message.txt"
@@ -59,6 +107,62 @@ struct node
 	struct node* next;
 };
 
+// Indexed like the packet ring
+struct transmissions
+{
+	struct timingWheel wheel;				// Retransmission timer of every unACKed packet
+	uint64_t sentUs[MAX_READ_SIZE];			// Latest transmission
+	int count[MAX_READ_SIZE];				// Transmissions so far; the retransmission timeout doubles with each
+	int laterACKs[MAX_READ_SIZE];			// Later packets ACKed since the latest transmission
+};
+
+struct pacer
+{
+	enum PacingMode mode;
+	int rateKbps;							// Fixed rate; 0 paces the window over one estimated RTT
+	uint64_t nextDepartureUs;				// Earliest departure of the next DATA packet
+};
+
+// One byte range of the file and the connection sending it
+struct stream
+{
+	int id;
+	int connectionId;						// Same for every stream of the transfer
+	int transfer;							// Which of the connection's files the range is of
+	int socketFileDescriptor;
+	struct sockaddr_in receiver;
+	socklen_t receiverLen;
+	int fileFd;								// Shared by the streams; read with pread only
+	int64_t start;							// First byte of the range
+	int64_t offset;							// Next byte of the range to send
+	int64_t end;							// One past the last byte of the range
+	uint32_t checksum;						// CRC32C of the range up to offset, accumulated as it is first read
+	const struct intervalSet* skip;			// Bytes the receiver already has, NULL unless the file is being resumed
+	int64_t skippedBytes;					// Read for the checksum but not sent, as skip holds them
+	bool compress;							// FEATURE_COMPRESSION was granted
+	struct lz4Context lz4;					// Kept from one packet, and file, to the next
+	char block[COMPRESSED_BLOCK_LEN];		// Bytes of the file read for the next compressed packet
+	int spanChunks;							// Payload lengths of the file the next packet tries to compress into one
+	int compressSkip;						// Packets still to send uncompressed before trying again
+	int compressBackoff;					// compressSkip after the next packet that would not compress
+	int compressedPackets;
+	int maxWindowSize;						// Negotiated with the receiver, as is payloadLen
+	int payloadLen;
+	int estimatedRTT;						// RTT estimate and timeout in ms, carried from one file to the next
+	int devRTT;
+	int timeoutInterval;
+	bool rttMeasured;
+	struct pacer pacer;
+	struct packet* ACKPacket;
+	struct packet packets[MAX_READ_SIZE];	// Packets in flight, at PACKET_SLOT of their sequence number
+	struct transmissions sent;
+	struct histogram rttHistogram;
+	int packetCount;
+	int retransmits;
+	int fastRetransmits;
+	pthread_t thread;
+};
+
 /*---------------------------------------------------------------------------------Function Prototypes----------------------------------------------------------------------------------*/
 long delay(struct timeval t1, struct timeval t2);
 void appendToUnACKs(struct node** headRef, int seqNum);
@@ -66,5 +170,16 @@ void deleteFromUnACKs(struct node** headRef, int seqNum);
 int getUnACKCount(struct node* head);
 void freeUnACKs(struct node** headRef);
 void printUnACKs(struct node* node);
-void retransmitUnACKs(int socketFileDescriptor, struct packet* arrPackets, struct node* head, int packetSize, struct sockaddr_in* receiver, socklen_t receiverLen);
-void updateTimeoutInterval(int* timeoutInterval, int* sampleRTT, struct timeval* start, struct timeval* end, int* estimatedRTT, int* devRTT);
\ No newline at end of file
+int retransmitExpired(int socketFileDescriptor, struct packet* arrPackets, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen);
+void retransmitPacket(int socketFileDescriptor, struct packet* arrPackets, int index, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen);
+void armRetransmitTimer(struct transmissions* sent, int index, int timeoutInterval);
+void updateTimeoutInterval(int* timeoutInterval, int sampleRTT, int* estimatedRTT, int* devRTT);
+void requestLatencyDump(int signalNumber);
+void logRTTHistogram(int streamId, const struct histogram* rttHistogram);
+int fastRetransmit(int socketFileDescriptor, struct packet* arrPackets, struct node* head, int ackNum, struct transmissions* sent, int timeoutInterval, struct sockaddr_in* receiver, socklen_t receiverLen);
+void pacerInit(struct pacer* pacer, int socketFileDescriptor);
+uint64_t pacerGap(const struct pacer* pacer, int windowSize, int estimatedRTT, bool rttMeasured, int packetSize);
+ssize_t pacedSend(int socketFileDescriptor, struct pacer* pacer, const struct packet* pkt, uint64_t gapUs, struct sockaddr_in* receiver, socklen_t receiverLen);
+void* sendStream(void* arg);
+bool exchangeControl(struct stream* stream, struct packet* request, enum PacketType replyType, int timeoutInterval, uint64_t* rttUs);
+ssize_t readCompressed(struct stream* stream, struct packet* pkt);
\ No newline at end of file